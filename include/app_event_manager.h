@@ -59,6 +59,13 @@ enum app_event_type_flags {
 	APP_EVENT_TYPE_FLAGS_COUNT,
 	/** marks beginning of user-specific flags.*/
 	APP_EVENT_TYPE_FLAGS_USER_DEFINED_START = APP_EVENT_TYPE_FLAGS_COUNT,
+	/** processes event before events without the flag.
+	 *  Flag set by user. Used only if
+	 *  @kconfig{CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES} is enabled.
+	 *  Uses the last bit of the flags, so that the user-specific flags keep
+	 *  their values. User-specific flags must be lower than this flag.
+	 */
+	APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY = 7,
 };
 
 /** @brief Get event type flag's value.
@@ -383,7 +390,8 @@ int app_event_manager_init(void);
 /** @brief Allocate event.
  *
  * The behavior of this function depends on the actual implementation.
- * The default implementation of this function is same as k_malloc.
+ * The default implementation of this function is same as k_malloc, unless
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB} is enabled.
  * It is annotated as weak and can be overridden by user.
  *
  * @param size  Amount of memory requested (in bytes).
@@ -395,7 +403,8 @@ void *app_event_manager_alloc(size_t size);
 /** @brief Free memory occupied by the event.
  *
  * The behavior of this function depends on the actual implementation.
- * The default implementation of this function is same as k_free.
+ * The default implementation of this function is same as k_free, unless
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB} is enabled.
  * It is annotated as weak and can be overridden by user.
  *
  * @param addr  Pointer to previously allocated memory.
@@ -403,6 +412,104 @@ void *app_event_manager_alloc(size_t size);
 void app_event_manager_free(void *addr);
 
 
+/** @brief Statistics of a single size class of the slab event allocator.
+ */
+struct app_event_manager_slab_stats {
+	/** Size of a single block in bytes. */
+	size_t block_size;
+
+	/** Number of blocks in the size class. */
+	uint32_t block_cnt;
+
+	/** Number of blocks currently in use. */
+	uint32_t used_cnt;
+
+	/** Maximum number of blocks used at the same time (high-water mark). */
+	uint32_t max_used_cnt;
+
+	/** Number of allocations that did not fit into the exhausted size class. */
+	uint32_t fallback_cnt;
+};
+
+/** @brief Get statistics of a size class of the slab event allocator.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB} option needs to be enabled.
+ *
+ * @param class_idx  Index of the size class, starting from the smallest one.
+ * @param stats      Pointer to the structure filled with statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the size class index is out of range.
+ */
+int app_event_manager_slab_stats_get(size_t class_idx,
+				     struct app_event_manager_slab_stats *stats);
+
+/** @brief Get number of size classes of the slab event allocator.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB} option needs to be enabled.
+ *
+ * @return Number of size classes.
+ */
+size_t app_event_manager_slab_class_cnt(void);
+
+/** @brief Get number of allocations exceeding the largest size class.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB} option needs to be enabled.
+ *
+ * @return Number of allocations that were too big for any of the size classes.
+ */
+uint32_t app_event_manager_slab_oversize_cnt(void);
+
+
+/** @brief Event dispatch statistics of an event type.
+ */
+struct app_event_manager_dispatch_stats {
+	/** Number of processed events. */
+	uint32_t event_cnt;
+
+	/** Maximum number of cycles spent on processing a single event. */
+	uint32_t max_cycles;
+
+	/** Total number of cycles spent on processing events. */
+	uint64_t total_cycles;
+
+	/** Number of events dropped on submission, because the event type has no subscribers. */
+	uint32_t dropped_cnt;
+};
+
+/** @brief Get event dispatch statistics of an event type.
+ *
+ * The processing time includes the event hooks, logging and all of the event handlers
+ * that were notified about the event.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS} option needs to be enabled.
+ *
+ * @param et     Event type. Use @ref APP_EVENT_ID to get it from the event name.
+ * @param stats  Pointer to the structure filled with statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the event type is invalid.
+ */
+int app_event_manager_dispatch_stats_get(const struct event_type *et,
+					 struct app_event_manager_dispatch_stats *stats);
+
+/** @brief Reset event dispatch statistics of all event types.
+ *
+ * @note
+ * For this function to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS} option needs to be enabled.
+ */
+void app_event_manager_dispatch_stats_reset(void);
+
+
 /** @brief Log event.
  *
  * This helper macro simplifies event logging.
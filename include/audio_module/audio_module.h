@@ -248,7 +248,10 @@ struct audio_module_description {
  * @brief Module's thread configuration structure.
  */
 struct audio_module_thread_configuration {
-	/* Thread stack. */
+	/* Thread stack. If CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR is enabled, the stack can be NULL
+	 * with a stack size of 0. The module then has no thread and can only run as part of
+	 * a graph, see audio_module_graph_open().
+	 */
 	k_thread_stack_t *stack;
 
 	/* Thread stack size. */
@@ -263,7 +266,9 @@ struct audio_module_thread_configuration {
 	/* A pointer to a module's audio data transmitter FIFO, can be NULL. */
 	struct data_fifo *msg_tx;
 
-	/* A pointer to the audio data buffer slab, can be NULL. */
+	/* A pointer to the audio data buffer slab, can be NULL. The slab can have at most
+	 * CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT buffers.
+	 */
 	struct k_mem_slab *data_slab;
 
 	/* Size of each memory data buffer in bytes that will be
@@ -314,17 +319,27 @@ struct audio_module_handle {
 	/* Number of destination modules. */
 	uint8_t dest_count;
 
-	/* Semaphore to count messages between modules and on a module's TX FIFO. */
-	struct k_sem sem;
+	/* Reference counts for the output audio data items currently shared with the
+	 * destinations. A slot is free when its count is zero.
+	 */
+	atomic_t buf_ref_cnt[CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT];
 
-	/* Mutex to make the above destinations list thread safe. */
+	/* Mutex to serialize connections and disconnections of the above destinations list. */
 	struct k_mutex dest_mutex;
 
+	/* Spinlock to make the above destinations list safe to read from the module's thread. */
+	struct k_spinlock dest_lock;
+
 	/* Module's thread configuration. */
 	struct audio_module_thread_configuration thread;
 
 	/* Private context for the module. */
 	struct audio_module_context *context;
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	/* The graph executing this module, NULL if not part of a graph. */
+	struct audio_module_graph *graph;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
 };
 
 /**
@@ -339,7 +354,74 @@ struct audio_module_message {
 
 	/* Callback for when the audio data has been consumed. */
 	audio_module_response_cb response_cb;
+
+	/* Reference count shared by all consumers of the audio data, NULL if not shared. */
+	atomic_t *ref_cnt;
+};
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+/**
+ * @brief Histogram of processing times.
+ */
+struct audio_module_latency_hist {
+	/* Number of samples in each bin. Bin n counts times in the range [2^n, 2^(n+1)) us,
+	 * bin 0 also counts times below 1 us and the last bin counts all longer times.
+	 */
+	uint32_t bins[CONFIG_AUDIO_MODULE_GRAPH_LATENCY_BINS];
+
+	/* Number of samples. */
+	uint32_t count;
+
+	/* Longest time in us. */
+	uint32_t max_us;
+
+	/* Sum of all the times in us. */
+	uint64_t total_us;
+};
+
+/**
+ * @brief Graph of connected modules executed by a single thread.
+ */
+struct audio_module_graph {
+	/* The modules in processing order, the source module is first. */
+	struct audio_module_handle *modules[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Index of the module each module gets its input from, unused for the source module. */
+	uint8_t parent[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Number of modules in the graph. */
+	uint8_t module_num;
+
+	/* Output audio data of each module for the block being processed. */
+	struct audio_data out[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Reference count of each output when it is also put on the module's TX FIFO. */
+	atomic_t *out_ref_cnt[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Input message being processed, if the source module has an RX FIFO. */
+	struct audio_module_message *msg_rx;
+
+	/* Processing time of each module. */
+	struct audio_module_latency_hist module_hist[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Processing time of a block through the whole graph. */
+	struct audio_module_latency_hist graph_hist;
+
+	/* Spinlock to make the above histograms thread safe. */
+	struct k_spinlock hist_lock;
+
+	/* Posted while the source module is running, the executor waits on it when the source
+	 * module has no RX FIFO to wait on.
+	 */
+	struct k_event run_event;
+
+	/* Executor thread ID. */
+	k_tid_t thread_id;
+
+	/* Executor thread data. */
+	struct k_thread thread_data;
 };
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
 
 /**
  * @brief Open an audio module.
@@ -537,6 +619,64 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
  */
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels);
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+/**
+ * @brief Run a graph of connected modules on a single executor thread.
+ *
+ * @note The graph contains the source module and all the modules connected from it. Each
+ *       audio data item is processed by all the modules in topological order, so it passes
+ *       through the graph without any message queuing or context switch. All the modules must
+ *       have been opened without a thread, and the connections cannot change until the graph
+ *       is closed. The modules are started and stopped individually, and a module that is not
+ *       running is skipped together with the modules connected from it.
+ *
+ * @note If the source module is an input module, its data process function is called to wait
+ *       for a new audio data item. Otherwise the executor waits on the source module's RX FIFO.
+ *
+ * @param graph       [out]  Pointer to the graph.
+ * @param source      [in]   The handle of the first module of the graph.
+ * @param stack       [in]   Stack of the executor thread.
+ * @param stack_size  [in]   Size of the executor thread stack.
+ * @param priority    [in]   Priority of the executor thread.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_open(struct audio_module_graph *graph, struct audio_module_handle *source,
+			    k_thread_stack_t *stack, size_t stack_size, int priority);
+
+/**
+ * @brief Stop the executor thread of a graph and release its modules.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_close(struct audio_module_graph *graph);
+
+/**
+ * @brief Get a histogram of processing times in a graph.
+ *
+ * @param graph   [in]   Pointer to the graph.
+ * @param handle  [in]   The handle of a module in the graph, or NULL for the processing time
+ *                       of a block through the whole graph.
+ * @param hist    [out]  Pointer to the histogram.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_latency_get(struct audio_module_graph *graph,
+				   struct audio_module_handle const *const handle,
+				   struct audio_module_latency_hist *hist);
+
+/**
+ * @brief Clear all the histograms of processing times in a graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_latency_reset(struct audio_module_graph *graph);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 #ifdef __cplusplus
 }
 #endif
@@ -117,7 +117,8 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report);
 /**
  * @brief Calculates a distance estimate based on the IFFT magnitude of the input IQ values.
  * Note! After calling this function, the input IQ values in iq_tones_comb are overwritten with the
- * IFFT magnitude.
+ * IFFT power, the magnitude squared. With CONFIG_BT_CS_DE_IFFT_Q31 or CONFIG_BT_CS_DE_IFFT_Q15,
+ * the buffer holds the fixed-point IFFT and its integer power instead.
  * @param[inout] iq_tones_comb combined IQ values from two devices. The first CS_DE_NUM_CHANNELS * 2
  * elements should match the format described in @ref cs_de_combined_iq_calculate
  * @return Distance estimate between the two devices in meters
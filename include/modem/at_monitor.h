@@ -12,6 +12,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util_macro.h>
 #include <zephyr/toolchain.h>
+#include <zephyr/sys/sys_heap.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -117,6 +118,54 @@ static inline void at_monitor_resume(struct at_monitor_entry *mon)
 	mon->flags.paused = false;
 }
 
+#if defined(CONFIG_AT_MONITOR_NOTIF_SLAB) || defined(__DOXYGEN__)
+/**
+ * @brief Take a reference to a notification.
+ *
+ * Keep the notification received by a monitor handler after the handler returns,
+ * instead of copying it. The notification stays valid until it is released
+ * with @ref at_monitor_notif_unref.
+ *
+ * @note Only the notifications received by monitors defined with @ref AT_MONITOR
+ *	 are reference counted. Do not call this function from the handler of a
+ *	 monitor defined with @ref AT_MONITOR_ISR.
+ *
+ * @param notif The notification received by the monitor handler.
+ */
+void at_monitor_notif_ref(const char *notif);
+
+/**
+ * @brief Release a reference to a notification.
+ *
+ * @param notif The notification referenced with @ref at_monitor_notif_ref.
+ */
+void at_monitor_notif_unref(const char *notif);
+#endif
+
+#if defined(CONFIG_AT_MONITOR_STATS) || defined(__DOXYGEN__)
+/** @brief AT monitor library statistics. */
+struct at_monitor_stats {
+	/** Runtime statistics of the AT monitor library heap. */
+	struct sys_memory_stats heap;
+	/** Notification buffers in use. */
+	uint32_t buffers_used;
+	/** Maximum number of notification buffers in use at the same time. */
+	uint32_t buffers_max_used;
+	/** Notifications dropped because there was no memory to copy them. */
+	uint32_t dropped;
+};
+
+/**
+ * @brief Retrieve the AT monitor library statistics.
+ *
+ * @param stats Statistics.
+ *
+ * @retval 0 On success.
+ * @retval -EFAULT If @p stats is NULL.
+ */
+int at_monitor_stats_get(struct at_monitor_stats *stats);
+#endif
+
 /** @} */
 
 #ifdef __cplusplus
@@ -248,6 +248,26 @@ struct nrf_modem_lib_diag_stats {
 int nrf_modem_lib_diag_stats_get(struct nrf_modem_lib_diag_stats *stats);
 #endif
 
+#if defined(CONFIG_NRF_MODEM_LIB_SENDMSG_STATS) || defined(__DOXYGEN__)
+/** @brief Statistics of the `sendmsg` socket function. */
+struct nrf_modem_lib_sendmsg_stats {
+	/** Number of times message parts were repacked into an intermediate buffer. */
+	uint32_t bounce_copies;
+	/** Number of messages sent using more than one `sendto` call. */
+	uint32_t fragmented_sends;
+};
+
+/**
+ * @brief Retrieve `sendmsg` statistics.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 On success.
+ * @retval -EFAULT If @p stats is NULL.
+ */
+int nrf_modem_lib_sendmsg_stats_get(struct nrf_modem_lib_sendmsg_stats *stats);
+#endif
+
 /** @} */
 
 #ifdef __cplusplus
@@ -68,8 +68,9 @@ enum downloader_evt_id {
 	 * @c downloader_host_cfg.keep_connection flag is set, the downloader will stay
 	 * connected to the server. If a new download is initiated towards a different server, the
 	 * current connection is closed and the downloader will connect to the new server. The
-	 * connection can be closed by deinitializing the downloader, which will also free its
-	 * resources.
+	 * connection is closed when it has been idle for
+	 * CONFIG_DOWNLOADER_KEEP_CONNECTION_IDLE_TIMEOUT seconds. The connection can also be
+	 * closed by deinitializing the downloader, which will also free its resources.
 	 *
 	 * If the @c downloader_host_cfg.keep_connection flag is not set, the downloader
 	 * will automatically close the connection. The application should wait for the
@@ -100,6 +101,12 @@ struct downloader_fragment {
 struct downloader_evt {
 	/** Event ID. */
 	enum downloader_evt_id id;
+	/**
+	 * Downloader instance that sent the event.
+	 * Lets a callback that is shared by several downloader instances tell them apart.
+	 * NULL for the events of a parallel download that concern the whole download.
+	 */
+	struct downloader *dl;
 
 	union {
 		/** Error cause. */
@@ -169,12 +176,24 @@ struct downloader_host_cfg {
 	 * range override will be used in this case regardless of the value here.
 	 */
 	size_t range_override;
+	/**
+	 * Range end.
+	 * Offset after the last byte to download, the download is complete when the progress
+	 * reaches this offset or the end of the file.
+	 * 0 downloads until the end of the file.
+	 * Only supported by the HTTP transport, and requires the server to support range
+	 * requests.
+	 */
+	size_t range_end;
 	/** Use native TLS. */
 	bool set_native_tls;
 	/**
 	 * Keep connection to server when done.
-	 * Server is disconnected if a file is requested from another server, and when the
-	 * downloader is deinitialized.
+	 * The connection is reused by the next download from the same scheme, host and port,
+	 * with the same security and network configuration.
+	 * Server is disconnected if a file is requested from another server, when the
+	 * connection has been idle for CONFIG_DOWNLOADER_KEEP_CONNECTION_IDLE_TIMEOUT seconds,
+	 * and when the downloader is deinitialized.
 	 */
 	bool keep_connection;
 	/**
@@ -243,6 +262,8 @@ struct downloader {
 	size_t buf_offset;
 	/** Flag to signal that the download is complete. */
 	bool complete;
+	/** Hash of the security tags of the connection, to check whether it can be reused. */
+	uint32_t sec_tag_hash;
 	/**
 	 * Downloader transport, http, CoAP, MQTT, ...
 	 * Store a pointer to the selected transport per downloader instance to avoid looking it up
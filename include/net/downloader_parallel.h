@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file downloader_parallel.h
+ *
+ * @defgroup downloader_parallel Parallel downloader
+ * @ingroup downloader
+ * @{
+ * @brief Download a file over several connections at once.
+ *
+ * @details The file is split in segments that are fetched with HTTP range requests over
+ * several connections. The data is handed to the application in order, in
+ * @c DOWNLOADER_EVT_FRAGMENT events, so it can be written directly to a DFU target.
+ * A connection that receives data ahead of the application waits until the data before it
+ * has been handed over.
+ */
+
+#ifndef __DOWNLOADER_PARALLEL_H__
+#define __DOWNLOADER_PARALLEL_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/types.h>
+#include <net/downloader.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Parallel downloader configuration options.
+ */
+struct downloader_parallel_cfg {
+	/**
+	 * Event handler.
+	 *
+	 * The events are the same as for a single downloader instance:
+	 * - @c DOWNLOADER_EVT_FRAGMENT in file order.
+	 * - @c DOWNLOADER_EVT_ERROR on errors. Returning zero on @c ECONNRESET lets the
+	 *   connection reconnect and resume its segment. Any other error stops the download.
+	 * - @c DOWNLOADER_EVT_DONE when the whole file has been handed over.
+	 * - @c DOWNLOADER_EVT_STOPPED when the download has been stopped.
+	 * - @c DOWNLOADER_EVT_DEINITIALIZED when the parallel downloader is deinitialized.
+	 *
+	 * Events are never sent concurrently. The @c dl field of the event is the instance of
+	 * the connection for the fragment and error events of a connection, and NULL for the
+	 * events that concern the whole download.
+	 */
+	downloader_callback_t callback;
+	/**
+	 * Number of connections.
+	 * Use 0 to set the value of CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS.
+	 */
+	uint8_t connections;
+	/**
+	 * Number of bytes requested by a connection at a time.
+	 * Use 0 to set the value of CONFIG_DOWNLOADER_PARALLEL_SEGMENT_SIZE.
+	 */
+	size_t segment_size;
+};
+
+struct downloader_parallel;
+
+/**
+ * @brief Connection of the parallel downloader.
+ *
+ * Members are set internally by the parallel downloader.
+ */
+struct downloader_parallel_conn {
+	/** Downloader instance of the connection. */
+	struct downloader dl;
+	/** Parallel downloader the connection belongs to. */
+	struct downloader_parallel *pd;
+	/** Start of the segment being downloaded. */
+	size_t start;
+	/** Offset after the last byte of the segment being downloaded. */
+	size_t end;
+	/** The connection is downloading a segment. */
+	bool active;
+	/** Downloader buffer. */
+	char buf[CONFIG_DOWNLOADER_PARALLEL_BUF_SIZE];
+};
+
+/**
+ * @brief Parallel downloader instance.
+ *
+ * Members are set internally by the parallel downloader.
+ */
+struct downloader_parallel {
+	/** Configuration options. */
+	struct downloader_parallel_cfg cfg;
+	/** Host configuration options. */
+	struct downloader_host_cfg host_cfg;
+	/** URL of the file being downloaded. */
+	const char *url;
+	/** Connections. */
+	struct downloader_parallel_conn conn[CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS];
+	/** Size of the file being downloaded, in bytes. Zero until the first response. */
+	size_t file_size;
+	/** Start of the next segment to download. */
+	size_t next;
+	/** Number of bytes handed to the application, counted from the start of the file. */
+	size_t delivered;
+	/** Number of connections downloading a segment. */
+	uint8_t active;
+	/** A download is ongoing. */
+	bool running;
+	/** The download is being stopped. */
+	bool stopping;
+	/** Protect shared variables and serialize the events. */
+	struct k_mutex mutex;
+	/** Signaled when data has been handed to the application. */
+	struct k_condvar delivered_cond;
+};
+
+/**
+ * @brief Initialize the parallel downloader.
+ *
+ * @param[in] pd	Parallel downloader instance.
+ * @param[in] cfg	Configuration options.
+ *
+ * @return Zero on success, otherwise a negative error code.
+ */
+int downloader_parallel_init(struct downloader_parallel *pd,
+			     const struct downloader_parallel_cfg *cfg);
+
+/**
+ * @brief Deinitialize the parallel downloader.
+ *
+ * Stops any ongoing download and closes all connections.
+ *
+ * @param[in] pd	Parallel downloader instance.
+ *
+ * @return Zero on success, otherwise a negative error code.
+ */
+int downloader_parallel_deinit(struct downloader_parallel *pd);
+
+/**
+ * @brief Download a file asynchronously over several connections.
+ *
+ * The first connection requests the first segment. When the file size is known from its
+ * response, the other connections request the following segments. A connection that has
+ * finished its segment requests the next segment that has not been requested yet.
+ *
+ * The server must support range requests. Only HTTP and HTTPS are supported.
+ *
+ * @param[in] pd		Parallel downloader instance.
+ * @param[in] host_cfg		Host configuration options.
+ *				The @c range_end field must be zero, it is set per segment.
+ * @param[in] url		URL of the file. Must be kept in scope while the download is
+ *				going on.
+ * @param[in] from		Offset from where to resume the download,
+ *				or zero to download from the beginning.
+ *
+ * @return Zero on success, a negative error code otherwise.
+ */
+int downloader_parallel_get(struct downloader_parallel *pd,
+			    const struct downloader_host_cfg *host_cfg, const char *url,
+			    size_t from);
+
+/**
+ * @brief Cancel the download.
+ *
+ * Request all connections to stop. This does not block.
+ * When all connections have stopped a @c DOWNLOADER_EVT_STOPPED event is sent.
+ *
+ * @param[in] pd	Parallel downloader instance.
+ *
+ * @return Zero on success, a negative error code otherwise.
+ */
+int downloader_parallel_cancel(struct downloader_parallel *pd);
+
+/**
+ * @brief Retrieve the size of the file being downloaded, in bytes.
+ *
+ * The file size is only available after the first response from the server.
+ *
+ * @param[in]  pd	Parallel downloader instance.
+ * @param[out] size	File size.
+ *
+ * @return Zero on success, a negative error code otherwise.
+ */
+int downloader_parallel_file_size_get(struct downloader_parallel *pd, size_t *size);
+
+/**
+ * @brief Retrieve the number of bytes handed to the application so far.
+ *
+ * The offset can be used to resume the download with @ref downloader_parallel_get.
+ *
+ * @param[in]  pd	Parallel downloader instance.
+ * @param[out] size	Number of bytes handed to the application, counted from the start of
+ *			the file.
+ *
+ * @return Zero on success, a negative error code otherwise.
+ */
+int downloader_parallel_downloaded_size_get(struct downloader_parallel *pd, size_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DOWNLOADER_PARALLEL_H__ */
+
+/**@} */
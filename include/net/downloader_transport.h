@@ -93,6 +93,20 @@ struct dl_transport {
 	 * Return -ECONNRESET if the downloader can reconnect to resume the download.
 	 */
 	int (*download)(struct downloader *dl);
+	/**
+	 * Check whether the open connection can be reused for a new download.
+	 *
+	 * Called when the downloader is connected to the same host with the same
+	 * configuration. The transport prepares a new download on the open connection
+	 * if it returns true. Optional, the connection is reused if not set.
+	 *
+	 * @param dl Downloader instance.
+	 * @param uri URI of the new download.
+	 *
+	 * @retval true if the connection can be reused.
+	 * @retval false if the transport must be reinitialized and reconnected.
+	 */
+	bool (*reuse)(struct downloader *dl, const char *uri);
 };
 
 /** Downloader transport entry */
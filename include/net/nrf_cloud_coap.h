@@ -567,6 +567,83 @@ int nrf_cloud_coap_bytes_send(uint8_t *buf, size_t buf_len, bool confirmable);
  */
 int nrf_cloud_coap_obj_send(struct nrf_cloud_obj *const obj, bool confirmable);
 
+/**
+ * @brief Add a sensor value to the messages to be sent in a batch.
+ *
+ *  The value is JSON encoded and stored. The stored messages are sent together to nRF Cloud
+ *  as a confirmable CoAP message when they fill a batch, when the oldest of them reaches
+ *  CONFIG_NRF_CLOUD_COAP_BATCH_MAX_AGE_S, when the device connects, or when
+ *  @ref nrf_cloud_coap_batch_flush is called.
+ *  Requires CONFIG_NRF_CLOUD_COAP_BATCH.
+ *
+ * @param[in]     app_id The app ID identifying the type of data. See the values
+ *                       that begin with NRF_CLOUD_JSON_APPID_ in nrf_cloud_defs.h. You may
+ *                       also use custom names.
+ * @param[in]     value  Sensor reading.
+ * @param[in]     ts_ms  Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP to use
+ *                       the current time.
+ *
+ * @retval 0 The value was stored.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -E2BIG The encoded value does not fit in a batch.
+ * @retval -ENOMEM No room, because all stored messages are being sent.
+ */
+int nrf_cloud_coap_batch_sensor_add(const char *app_id, double value, int64_t ts_ms);
+
+/**
+ * @brief Add a string message to the messages to be sent in a batch.
+ *
+ *  See @ref nrf_cloud_coap_batch_sensor_add.
+ *  Requires CONFIG_NRF_CLOUD_COAP_BATCH.
+ *
+ * @param[in]     app_id     The app_id identifying the type of data. See the values in
+ *                           nrf_cloud_defs.h that begin with  NRF_CLOUD_JSON_APPID_.
+ *                           You may also use custom names.
+ * @param[in]     message    The string to send.
+ * @param[in]     ts_ms      Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP to use
+ *                           the current time.
+ *
+ * @retval 0 The message was stored.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -E2BIG The encoded message does not fit in a batch.
+ * @retval -ENOMEM No room, because all stored messages are being sent.
+ */
+int nrf_cloud_coap_batch_message_add(const char *app_id, const char *message, int64_t ts_ms);
+
+/**
+ * @brief Add the device location in the @ref nrf_cloud_gnss_data PVT field to the messages
+ *        to be sent in a batch.
+ *
+ *  See @ref nrf_cloud_coap_batch_sensor_add. Only @ref NRF_CLOUD_GNSS_TYPE_PVT is supported.
+ *  Requires CONFIG_NRF_CLOUD_COAP_BATCH.
+ *
+ * @param[in]     gnss A pointer to an @ref nrf_cloud_gnss_data struct indicating the device
+ *                     location, usually as determined by the GNSS unit.
+ *
+ * @retval 0 The location was stored.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOTSUP The location is not in PVT format.
+ * @retval -E2BIG The encoded location does not fit in a batch.
+ * @retval -ENOMEM No room, because all stored messages are being sent.
+ */
+int nrf_cloud_coap_batch_location_add(const struct nrf_cloud_gnss_data *const gnss);
+
+/**
+ * @brief Send the stored messages now.
+ *
+ *  The messages are sent in as many batches as needed. Call this function, for example,
+ *  before calling @ref nrf_cloud_coap_pause or @ref nrf_cloud_coap_disconnect.
+ *  Messages that could not be sent are kept and sent later.
+ *  Requires CONFIG_NRF_CLOUD_COAP_BATCH.
+ *
+ * @retval -EACCES Device does not have a valid nRF Cloud CoAP connection.
+ * @return 0 If successful, nonzero if failed.
+ *           Negative values are device-side errors defined in errno.h.
+ *           Positive values are cloud-side errors (CoAP result codes)
+ *           defined in zephyr/net/coap.h.
+ */
+int nrf_cloud_coap_batch_flush(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -21,6 +21,9 @@
  * @{
  */
 
+/** Mix a mono buffer into all channels of the other buffer. */
+#define PCM_MIX_CHANNEL_ALL UINT8_MAX
+
 enum pcm_mix_mode {
 	B_STEREO_INTO_A_STEREO,
 	B_MONO_INTO_A_MONO,
@@ -35,7 +38,8 @@ enum pcm_mix_mode {
  * @note Uses simple addition with hard clip protection.
  * Input can be mono or stereo as long as the inputs match.
  * By selecting the mix mode, mono can also be mixed into a stereo buffer.
- * Hard coded for the signed 16-bit PCM.
+ * Hard coded for the signed 16-bit PCM. Use pcm_mix_channels() for other bit depths and
+ * number of channels.
  *
  * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
  * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
@@ -52,6 +56,33 @@ enum pcm_mix_mode {
 int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
 	    enum pcm_mix_mode mix_mode);
 
+/**
+ * @brief Mixes two buffers of PCM data with interleaved channels.
+ *
+ * @note Uses saturating addition, with the SIMD instructions of the CPU when available.
+ * If B has as many channels as A, each sample of B is mixed into the matching sample of A.
+ * If B is mono, it is mixed into the selected channel of A, or into all channels of A.
+ * Samples are signed, and 24-bit samples are packed into three bytes, little endian.
+ *
+ * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
+ * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
+ * @param channels_a    [in]     Number of interleaved channels in A.
+ * @param pcm_b         [in]     Pointer to the PCM data buffer B.
+ * @param size_b        [in]     Size of the PCM data buffer B (in bytes).
+ * @param channels_b    [in]     Number of interleaved channels in B, 1 or channels_a.
+ * @param channel       [in]     Channel of A to mix mono B into, or PCM_MIX_CHANNEL_ALL.
+ *                               Only used when B is mono and A is not.
+ * @param pcm_bit_depth [in]     Bit depth of the PCM samples (16, 24, or 32).
+ *
+ * @retval 0            Success. Result stored in pcm_a.
+ * @retval -EINVAL      pcm_a is NULL, size_a = 0, the bit depth, number of channels or channel
+ *                      is invalid, or a size is not a multiple of the frame size.
+ * @retval -EPERM       B holds more frames than A.
+ */
+int pcm_mix_channels(void *const pcm_a, size_t size_a, uint8_t channels_a,
+		     void const *const pcm_b, size_t size_b, uint8_t channels_b, uint8_t channel,
+		     uint8_t pcm_bit_depth);
+
 /**
  * @}
  */
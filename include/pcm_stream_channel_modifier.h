@@ -148,6 +148,50 @@ int pscm_interleave(void const *const input, size_t input_size, uint8_t channel,
 int pscm_deinterleave(void const *const input, size_t input_size, uint8_t input_channels,
 		      uint8_t channel, uint8_t pcm_bit_depth, void *output, size_t output_size);
 
+/**
+ * @brief  Interleave N channels of PCM into one buffer
+ * @note:  The interleaver can not be executed inplace (i.e. inputs != output).
+ *	   Interleaving all channels at once is faster than calling
+ *	   pscm_interleave() for each channel, in particular for 16-bit stereo.
+ *
+ * @param[in]	inputs			Array of output_channels pointers to the channel
+ *					input buffers. Should be 4-bytes aligned.
+ * @param[in]	input_size		Number of bytes in each input.
+ * @param[in]	pcm_bit_depth		Bit depth of PCM samples (8, 16, 24, or 32).
+ * @param[out]	output			Pointer to the multi-channel output buffer.
+ *					Should be 4-bytes aligned.
+ * @param[in]	output_size		Number of bytes in output. Must be at least
+ *					(input_size * output_channels).
+ * @param[in]	output_channels		Number of channels in the output buffer.
+ *
+ * @return	0 if successful, error value
+ */
+int pscm_interleave_channels(void const *const inputs[], size_t input_size,
+			     uint8_t pcm_bit_depth, void *output, size_t output_size,
+			     uint8_t output_channels);
+
+/**
+ * @brief  De-interleave a buffer of N channels of PCM into N buffers
+ * @note:  The de-interleaver can not be executed inplace (i.e. input != outputs).
+ *	   De-interleaving all channels at once is faster than calling
+ *	   pscm_deinterleave() for each channel, in particular for 16-bit stereo.
+ *
+ * @param[in]	input			Pointer to the multi channel input buffer.
+ *					Should be 4-bytes aligned.
+ * @param[in]	input_size		Number of bytes in input.
+ * @param[in]	input_channels		Number of channels in the input buffer.
+ * @param[in]	pcm_bit_depth		Bit depth of PCM samples (8, 16, 24, or 32).
+ * @param[out]	outputs			Array of input_channels pointers to the channel
+ *					output buffers. Should be 4-bytes aligned.
+ * @param[in]	output_size		Number of bytes in each output. Must be at least
+ *					(input_size / input_channels).
+ *
+ * @return	0 if successful, error value
+ */
+int pscm_deinterleave_channels(void const *const input, size_t input_size,
+			       uint8_t input_channels, uint8_t pcm_bit_depth, void *const outputs[],
+			       size_t output_size);
+
 /**
  * @}
  */
@@ -42,9 +42,27 @@
 /** Filter types supported by the sample rate converter */
 enum sample_rate_converter_filter {
 	SAMPLE_RATE_FILTER_TEST = 1,
-	SAMPLE_RATE_FILTER_SIMPLE
+	SAMPLE_RATE_FILTER_SIMPLE,
+	/* Polyphase filter for arbitrary conversion ratios. */
+	SAMPLE_RATE_FILTER_POLYPHASE
 };
 
+/** Number of phases in the polyphase filter. */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES 32
+
+/** Number of filter taps in each phase of the polyphase filter. */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS 16
+
+/** Largest clock drift in parts per million that can be compensated for. */
+#define SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX 10000
+
+/**
+ * The polyphase input buffer holds a block in addition to the filter history, and one sample
+ * more for interpolating between the last and first phase.
+ */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_BUF_NUMBER_SAMPLES                                         \
+	(CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX + SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS + 2)
+
 /**
  * To maintain filter requirements the input buffer must in some cases store two samples between
  * each block processed.
@@ -83,6 +101,36 @@ struct buf_ctx {
 	size_t bytes_in_buf;
 };
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+/** Context for the polyphase conversion */
+struct sample_rate_converter_polyphase_ctx {
+	/* Filter coefficients, one row of taps for each phase. */
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	const q15_t *filter;
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	q31_t filter[SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES * SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS];
+#endif
+
+	/* Input samples per output sample without and with the drift, in Q32.32 format. */
+	uint64_t step_nominal;
+	uint64_t step;
+
+	/* Position of the next output sample in the input buffer, in Q32.32 format. */
+	uint64_t pos;
+
+	/* Clock drift of the input in parts per million. */
+	int32_t drift_ppm;
+
+	/* Input samples kept between process calls, including the filter history. */
+	size_t samples_in_buf;
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	q15_t buf[SAMPLE_RATE_CONVERTER_POLYPHASE_BUF_NUMBER_SAMPLES];
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	q31_t buf[SAMPLE_RATE_CONVERTER_POLYPHASE_BUF_NUMBER_SAMPLES];
+#endif
+};
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 /** Context for the sample rate conversion */
 struct sample_rate_converter_ctx {
 	/* Input and output sample rate to be used for the conversion. */
@@ -90,7 +138,7 @@ struct sample_rate_converter_ctx {
 	uint32_t sample_rate_output;
 
 	/* The ratio for the current conversion. When the conversion is upsampling the ratio is
-	 * positive and negative when downsampling.
+	 * positive and negative when downsampling. The ratio is 0 for the polyphase filter.
 	 */
 	int conversion_ratio;
 
@@ -123,6 +171,11 @@ struct sample_rate_converter_ctx {
 #elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
 	q31_t state_buf_31[SAMPLE_RATE_CONVERTER_STATE_BUFFER_SIZE];
 #endif
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	/* Context for the polyphase filter. */
+	struct sample_rate_converter_polyphase_ctx polyphase;
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
 };
 
 /**
@@ -151,6 +204,11 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx);
  *		based on the conversion ratio, the module will buffer both input and output bytes
  *		when needed to meet this criteria.
  *
+ *		With the polyphase filter, any ratio from 0.6 to 8 between the output and input
+ *		sample rates is supported, including equal rates for drift compensation. The
+ *		number of output bytes may then vary by one sample between calls with the same
+ *		input size.
+ *
  * @param[in,out]	ctx			Pointer to the sample rate conversion context.
  * @param[in]		filter			Filter type to be used for the conversion.
  * @param[in]		input			Pointer to samples to process.
@@ -172,6 +230,24 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 				  size_t output_size, size_t *output_written,
 				  uint32_t output_sample_rate);
 
+/**
+ * @brief	Set the clock drift of the input to compensate for.
+ *
+ * @details	Only used with the polyphase filter. The drift adjusts the conversion ratio, so
+ *		that a source with a clock running faster than its nominal sample rate is consumed
+ *		at its real rate. The drift is kept when the conversion parameters change, and is
+ *		cleared by @ref sample_rate_converter_open.
+ *
+ * @param[in,out]	ctx		Pointer to the sample rate conversion context.
+ * @param[in]		drift_ppm	Drift of the input clock in parts per million. Positive
+ *					when the input clock is faster than its nominal rate.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	NULL pointer given for context or drift out of range.
+ * @retval	-ENOTSUP	Polyphase filter not enabled.
+ */
+int sample_rate_converter_drift_set(struct sample_rate_converter_ctx *ctx, int32_t drift_ppm);
+
 /**
  * @}
  */
@@ -6,6 +6,7 @@
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/init.h>
 #include <zephyr/device.h>
 #include <nrf_modem_at.h>
@@ -15,8 +16,19 @@
 
 LOG_MODULE_REGISTER(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
 
+#if CONFIG_AT_MONITOR_MATCHER
+#define MATCH_WORDS DIV_ROUND_UP(CONFIG_AT_MONITOR_MATCHER_MONITORS, 32)
+#endif
+
 struct at_notif_fifo {
 	void *fifo_reserved;
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	atomic_t refs;	/* References held by the workqueue and the handlers */
+	bool from_slab; /* Copied in a slab block, or on the heap */
+#endif
+#if CONFIG_AT_MONITOR_MATCHER
+	uint32_t match[MATCH_WORDS]; /* Monitors whose filter matches the notification */
+#endif
 	char data[]; /* Null-terminated AT notification string */
 };
 
@@ -26,6 +38,19 @@ static K_FIFO_DEFINE(at_monitor_fifo);
 static K_HEAP_DEFINE(at_monitor_heap, CONFIG_AT_MONITOR_HEAP_SIZE);
 static K_WORK_DEFINE(at_monitor_work, at_monitor_task);
 
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+BUILD_ASSERT(CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_SIZE > sizeof(struct at_notif_fifo));
+BUILD_ASSERT(CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_SIZE % sizeof(void *) == 0,
+	     "CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_SIZE must be a multiple of the pointer size");
+
+K_MEM_SLAB_DEFINE_STATIC(at_monitor_slab, CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_SIZE,
+			 CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_COUNT, sizeof(void *));
+#endif
+
+#if CONFIG_AT_MONITOR_STATS
+static atomic_t notif_dropped;
+#endif
+
 static bool is_paused(const struct at_monitor_entry *mon)
 {
 	return mon->flags.paused;
@@ -41,6 +66,366 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
+static struct at_notif_fifo *at_notif_alloc(size_t sz_needed)
+{
+	struct at_notif_fifo *at_notif;
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	/* Notifications larger than a block, or arriving when all blocks are in use,
+	 * are copied on the heap instead.
+	 */
+	if (sz_needed <= CONFIG_AT_MONITOR_NOTIF_SLAB_BLOCK_SIZE &&
+	    k_mem_slab_alloc(&at_monitor_slab, (void **)&at_notif, K_NO_WAIT) == 0) {
+		at_notif->from_slab = true;
+		atomic_set(&at_notif->refs, 1);
+		return at_notif;
+	}
+#endif
+
+	at_notif = k_heap_alloc(&at_monitor_heap, sz_needed, K_NO_WAIT);
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	if (at_notif) {
+		at_notif->from_slab = false;
+		atomic_set(&at_notif->refs, 1);
+	}
+#endif
+
+	return at_notif;
+}
+
+static void at_notif_free(struct at_notif_fifo *at_notif)
+{
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	if (at_notif->from_slab) {
+		k_mem_slab_free(&at_monitor_slab, at_notif);
+		return;
+	}
+#endif
+
+	k_heap_free(&at_monitor_heap, at_notif);
+}
+
+static struct at_notif_fifo *at_notif_copy(const char *notif)
+{
+	struct at_notif_fifo *at_notif;
+	size_t sz_needed;
+
+	sz_needed = sizeof(struct at_notif_fifo) + strlen(notif) + sizeof(char);
+
+	at_notif = at_notif_alloc(sz_needed);
+	if (!at_notif) {
+#if CONFIG_AT_MONITOR_STATS
+		atomic_inc(&notif_dropped);
+#endif
+		LOG_WRN("No heap space for incoming notification: %s", notif);
+		__ASSERT(at_notif, "No heap space for incoming notification: %s", notif);
+		return NULL;
+	}
+
+	strcpy(at_notif->data, notif);
+
+	return at_notif;
+}
+
+/* Release the reference of the workqueue, the handlers may still hold the notification */
+static void at_notif_release(struct at_notif_fifo *at_notif)
+{
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	if (atomic_dec(&at_notif->refs) != 1) {
+		return;
+	}
+#endif
+
+	at_notif_free(at_notif);
+}
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+static struct at_notif_fifo *at_notif_from_data(const char *notif)
+{
+	return (struct at_notif_fifo *)((uintptr_t)notif - offsetof(struct at_notif_fifo, data));
+}
+
+void at_monitor_notif_ref(const char *notif)
+{
+	__ASSERT_NO_MSG(notif != NULL);
+
+	atomic_inc(&at_notif_from_data(notif)->refs);
+}
+
+void at_monitor_notif_unref(const char *notif)
+{
+	__ASSERT_NO_MSG(notif != NULL);
+
+	at_notif_release(at_notif_from_data(notif));
+}
+#endif /* CONFIG_AT_MONITOR_NOTIF_SLAB */
+
+#if CONFIG_AT_MONITOR_STATS
+int at_monitor_stats_get(struct at_monitor_stats *stats)
+{
+	if (!stats) {
+		return -EFAULT;
+	}
+
+	sys_heap_runtime_stats_get(&at_monitor_heap.heap, &stats->heap);
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	stats->buffers_used = k_mem_slab_num_used_get(&at_monitor_slab);
+	stats->buffers_max_used = k_mem_slab_max_used_get(&at_monitor_slab);
+#else
+	stats->buffers_used = 0;
+	stats->buffers_max_used = 0;
+#endif
+	stats->dropped = atomic_get(&notif_dropped);
+
+	return 0;
+}
+#endif /* CONFIG_AT_MONITOR_STATS */
+
+#if CONFIG_AT_MONITOR_MATCHER
+/* The filters of all monitors are compiled into an Aho-Corasick automaton during initialization.
+ * The automaton is a trie of the filters, where each node also links to the longest suffix of its
+ * string that is in the trie. Following the links when a character does not match, all filters
+ * occurring anywhere in the notification are found in a single scan, the same as strstr().
+ *
+ * Node 0 is the root. Because the root is never a child, 0 also means no node in the links.
+ */
+#define MONITOR_NONE UINT8_MAX
+
+BUILD_ASSERT(CONFIG_AT_MONITOR_MATCHER_NODES <= UINT8_MAX);
+BUILD_ASSERT(CONFIG_AT_MONITOR_MATCHER_MONITORS < MONITOR_NONE);
+
+struct matcher_node {
+	uint8_t child;	 /* First child */
+	uint8_t sibling; /* Next child of the same parent */
+	uint8_t fail;	 /* Longest proper suffix in the trie */
+	uint8_t dict;	 /* Nearest node on the fail links where a filter ends */
+	uint8_t monitor; /* First monitor whose filter ends here */
+	char c;
+};
+
+static struct matcher_node nodes[CONFIG_AT_MONITOR_MATCHER_NODES];
+/* Next monitor whose filter ends in the same node */
+static uint8_t monitor_next[CONFIG_AT_MONITOR_MATCHER_MONITORS];
+/* Monitors matching all notifications */
+static uint32_t match_any[MATCH_WORDS];
+static size_t node_count;
+static bool matcher_ready;
+
+static void match_set(uint32_t *match, size_t idx)
+{
+	match[idx / 32] |= BIT(idx % 32);
+}
+
+static bool match_test(const uint32_t *match, size_t idx)
+{
+	return match[idx / 32] & BIT(idx % 32);
+}
+
+static uint8_t matcher_child_find(uint8_t node, char c)
+{
+	for (uint8_t n = nodes[node].child; n != 0; n = nodes[n].sibling) {
+		if (nodes[n].c == c) {
+			return n;
+		}
+	}
+
+	return 0;
+}
+
+static int matcher_insert(const char *filter, uint8_t idx)
+{
+	uint8_t node = 0;
+
+	for (const char *p = filter; *p != '\0'; p++) {
+		uint8_t next = matcher_child_find(node, *p);
+
+		if (next == 0) {
+			if (node_count == ARRAY_SIZE(nodes)) {
+				return -ENOMEM;
+			}
+
+			next = node_count++;
+			nodes[next] = (struct matcher_node){
+				.sibling = nodes[node].child,
+				.monitor = MONITOR_NONE,
+				.c = *p,
+			};
+			nodes[node].child = next;
+		}
+
+		node = next;
+	}
+
+	monitor_next[idx] = nodes[node].monitor;
+	nodes[node].monitor = idx;
+
+	return 0;
+}
+
+/* Set the fail and dictionary links in breadth-first order, so that the links of all shorter
+ * strings are set before they are needed.
+ */
+static void matcher_links_set(void)
+{
+	uint8_t queue[CONFIG_AT_MONITOR_MATCHER_NODES];
+	size_t head = 0;
+	size_t tail = 0;
+
+	for (uint8_t n = nodes[0].child; n != 0; n = nodes[n].sibling) {
+		queue[tail++] = n;
+	}
+
+	while (head < tail) {
+		uint8_t node = queue[head++];
+
+		for (uint8_t n = nodes[node].child; n != 0; n = nodes[n].sibling) {
+			uint8_t fail = nodes[node].fail;
+			uint8_t next;
+
+			while ((next = matcher_child_find(fail, nodes[n].c)) == 0 && fail != 0) {
+				fail = nodes[fail].fail;
+			}
+
+			nodes[n].fail = next;
+			nodes[n].dict = (nodes[next].monitor != MONITOR_NONE) ? next : nodes[next].dict;
+			queue[tail++] = n;
+		}
+	}
+}
+
+static int matcher_build(void)
+{
+	struct at_monitor_entry *e;
+	size_t count;
+	int err;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+	if (count > CONFIG_AT_MONITOR_MATCHER_MONITORS) {
+		LOG_WRN("%zu monitors, increase CONFIG_AT_MONITOR_MATCHER_MONITORS", count);
+		return -ENOMEM;
+	}
+
+	nodes[0] = (struct matcher_node){.monitor = MONITOR_NONE};
+	node_count = 1;
+
+	for (size_t i = 0; i < count; i++) {
+		STRUCT_SECTION_GET(at_monitor_entry, i, &e);
+
+		/* An empty filter matches all notifications, like strstr() does */
+		if (e->filter == ANY || e->filter[0] == '\0') {
+			match_set(match_any, i);
+			continue;
+		}
+
+		err = matcher_insert(e->filter, i);
+		if (err) {
+			LOG_WRN("Out of matcher nodes, increase CONFIG_AT_MONITOR_MATCHER_NODES");
+			return err;
+		}
+	}
+
+	matcher_links_set();
+
+	LOG_DBG("Matcher built with %zu nodes for %zu monitors", node_count, count);
+
+	return 0;
+}
+
+/* Find all monitors whose filter occurs in the notification */
+static void matcher_match(const char *notif, uint32_t *match)
+{
+	uint8_t node = 0;
+
+	memcpy(match, match_any, sizeof(match_any));
+
+	for (const char *p = notif; *p != '\0'; p++) {
+		uint8_t next;
+
+		while ((next = matcher_child_find(node, *p)) == 0 && node != 0) {
+			node = nodes[node].fail;
+		}
+
+		node = next;
+
+		for (uint8_t n = (nodes[node].monitor != MONITOR_NONE) ? node : nodes[node].dict;
+		     n != 0; n = nodes[n].dict) {
+			for (uint8_t m = nodes[n].monitor; m != MONITOR_NONE; m = monitor_next[m]) {
+				match_set(match, m);
+			}
+		}
+	}
+}
+
+static void at_monitor_dispatch_indexed(const char *notif)
+{
+	uint32_t match[MATCH_WORDS];
+	struct at_monitor_entry *e;
+	struct at_notif_fifo *at_notif;
+	bool monitored;
+	size_t count;
+
+	matcher_match(notif, match);
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+
+	monitored = false;
+	for (size_t i = 0; i < count; i++) {
+		if (!match_test(match, i)) {
+			continue;
+		}
+
+		STRUCT_SECTION_GET(at_monitor_entry, i, &e);
+		if (!is_paused(e)) {
+			if (is_direct(e)) {
+				LOG_DBG("Dispatching to %p (ISR)", e->handler);
+				e->handler(notif);
+			} else {
+				/* Copy and schedule work-queue task */
+				monitored = true;
+			}
+		}
+	}
+
+	if (!monitored) {
+		/* Only copy monitored notifications to save heap */
+		return;
+	}
+
+	at_notif = at_notif_copy(notif);
+	if (!at_notif) {
+		return;
+	}
+
+	/* Keep the matches, the workqueue checks only whether the monitors are paused */
+	memcpy(at_notif->match, match, sizeof(match));
+
+	k_fifo_put(&at_monitor_fifo, at_notif);
+	k_work_submit(&at_monitor_work);
+}
+
+static void at_monitor_task_indexed(struct at_notif_fifo *at_notif)
+{
+	struct at_monitor_entry *e;
+	size_t count;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (!match_test(at_notif->match, i)) {
+			continue;
+		}
+
+		STRUCT_SECTION_GET(at_monitor_entry, i, &e);
+		if (!is_paused(e) && !is_direct(e)) {
+			LOG_DBG("Dispatching to %p", e->handler);
+			e->handler(at_notif->data);
+		}
+	}
+}
+#endif /* CONFIG_AT_MONITOR_MATCHER */
+
 /* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
  * Keep this function public so that it can be called by tests.
  * This function is called from an ISR.
@@ -49,10 +434,16 @@ void at_monitor_dispatch(const char *notif)
 {
 	bool monitored;
 	struct at_notif_fifo *at_notif;
-	size_t sz_needed;
 
 	__ASSERT_NO_MSG(notif != NULL);
 
+#if CONFIG_AT_MONITOR_MATCHER
+	if (matcher_ready) {
+		at_monitor_dispatch_indexed(notif);
+		return;
+	}
+#endif
+
 	monitored = false;
 	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 		if (!is_paused(e) && has_match(e, notif)) {
@@ -71,17 +462,11 @@ void at_monitor_dispatch(const char *notif)
 		return;
 	}
 
-	sz_needed = sizeof(struct at_notif_fifo) + strlen(notif) + sizeof(char);
-
-	at_notif = k_heap_alloc(&at_monitor_heap, sz_needed, K_NO_WAIT);
+	at_notif = at_notif_copy(notif);
 	if (!at_notif) {
-		LOG_WRN("No heap space for incoming notification: %s", notif);
-		__ASSERT(at_notif, "No heap space for incoming notification: %s", notif);
 		return;
 	}
 
-	strcpy(at_notif->data, notif);
-
 	k_fifo_put(&at_monitor_fifo, at_notif);
 	k_work_submit(&at_monitor_work);
 }
@@ -93,13 +478,20 @@ static void at_monitor_task(struct k_work *work)
 	while ((at_notif = k_fifo_get(&at_monitor_fifo, K_NO_WAIT))) {
 		/* Match notification with all monitors */
 		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
+#if CONFIG_AT_MONITOR_MATCHER
+		if (matcher_ready) {
+			at_monitor_task_indexed(at_notif);
+			at_notif_release(at_notif);
+			continue;
+		}
+#endif
 		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
 			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
 				LOG_DBG("Dispatching to %p", e->handler);
 				e->handler(at_notif->data);
 			}
 		}
-		k_heap_free(&at_monitor_heap, at_notif);
+		at_notif_release(at_notif);
 	}
 }
 
@@ -107,6 +499,11 @@ static int at_monitor_sys_init(void)
 {
 	int err;
 
+#if CONFIG_AT_MONITOR_MATCHER
+	/* Fall back to matching each filter separately if the matcher does not fit */
+	matcher_ready = (matcher_build() == 0);
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
@@ -12,6 +12,7 @@
 
 #include <nrf_modem.h>
 #include <nrf_modem_os.h>
+#include <modem/nrf_modem_lib.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <zephyr/init.h>
@@ -58,6 +59,23 @@ static struct nrf_sock_ctx {
 
 static K_MUTEX_DEFINE(ctx_lock);
 
+/* Intermediate buffers used by sendmsg() to repack data. */
+#define SENDMSG_BUF_SIZE CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE
+
+K_MEM_SLAB_DEFINE_STATIC(sendmsg_slab, ROUND_UP(SENDMSG_BUF_SIZE, sizeof(void *)),
+			 CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_COUNT, sizeof(void *));
+
+#if CONFIG_NRF_MODEM_LIB_SENDMSG_STATS
+static struct {
+	atomic_t bounce_copies;
+	atomic_t fragmented_sends;
+} sendmsg_stats;
+
+#define SENDMSG_STATS_INC(counter) atomic_inc(&sendmsg_stats.counter)
+#else
+#define SENDMSG_STATS_INC(counter)
+#endif
+
 static const struct socket_op_vtable nrf9x_socket_fd_op_vtable;
 
 /* Offloading disabled in general. */
@@ -772,82 +790,124 @@ static ssize_t nrf9x_socket_offload_sendto(void *obj, const void *buf,
 	return retval;
 }
 
+/* Send a buffer completely, unless an error occurs */
+static ssize_t sendto_all(void *obj, const uint8_t *buf, size_t len, int flags,
+			  const struct net_msghdr *msg)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	while (offset < len) {
+		ret = nrf9x_socket_offload_sendto(obj, buf + offset, len - offset, flags,
+						  msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+		offset += ret;
+	}
+
+	return len;
+}
+
 static ssize_t nrf9x_socket_offload_sendmsg(void *obj, const struct net_msghdr *msg,
 					    int flags)
 {
+	const struct net_iovec *part = NULL;
+	uint8_t *buf = NULL;
 	ssize_t len = 0;
 	ssize_t ret;
-	ssize_t offset;
-	int i;
-	static K_MUTEX_DEFINE(sendmsg_lock);
-	static uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+	size_t chunk_len;
+	size_t first;
+	size_t parts;
+	size_t i = 0;
+	int sends = 0;
 
 	if (msg == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Try to reduce number of `sendto` calls - copy data if they fit into
-	 * a single buffer
+	/* Try to reduce number of `sendto` calls - repack consecutive parts
+	 * that fit into an intermediate buffer and send them together.
+	 * Parts that do not fit are sent directly, without copying them.
 	 */
+	while (i < msg->msg_iovlen) {
+		first = i;
+		parts = 0;
+		chunk_len = 0;
+
+		while (i < msg->msg_iovlen &&
+		       chunk_len + msg->msg_iov[i].iov_len <= SENDMSG_BUF_SIZE) {
+			if (msg->msg_iov[i].iov_len > 0) {
+				part = &msg->msg_iov[i];
+				parts++;
+			}
+			chunk_len += msg->msg_iov[i].iov_len;
+			i++;
+		}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		len += msg->msg_iov[i].iov_len;
-	}
+		if (i == first) {
+			part = &msg->msg_iov[i++];
+			parts = 1;
+			chunk_len = part->iov_len;
+		}
 
-	if (len <= sizeof(buf)) {
-		/* Protect `buf` access with a mutex. */
-		k_mutex_lock(&sendmsg_lock, K_FOREVER);
-		len = 0;
+		if (parts == 0) {
+			continue;
+		} else if (parts == 1) {
+			ret = sendto_all(obj, part->iov_base, chunk_len, flags, msg);
+		} else {
+			/* Each call takes its own buffer, so that sockets
+			 * do not wait for each other while the modem is sending.
+			 */
+			if (!buf) {
+				(void)k_mem_slab_alloc(&sendmsg_slab, (void **)&buf, K_FOREVER);
+			}
 
-		for (i = 0; i < msg->msg_iovlen; i++) {
-			memcpy(buf + len, msg->msg_iov[i].iov_base,
-			       msg->msg_iov[i].iov_len);
-			len += msg->msg_iov[i].iov_len;
+			chunk_len = 0;
+			for (size_t j = first; j < i; j++) {
+				memcpy(buf + chunk_len, msg->msg_iov[j].iov_base,
+				       msg->msg_iov[j].iov_len);
+				chunk_len += msg->msg_iov[j].iov_len;
+			}
+
+			SENDMSG_STATS_INC(bounce_copies);
+			ret = sendto_all(obj, buf, chunk_len, flags, msg);
 		}
 
-		offset = 0;
-		ret = 0;
-		while ((offset < len) && (ret >= 0)) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(buf + offset), (len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret > 0) {
-				offset += ret;
-			}
+		if (ret < 0) {
+			len = ret;
+			break;
 		}
 
-		k_mutex_unlock(&sendmsg_lock);
-		return ret;
+		len += ret;
+		sends++;
 	}
 
-	/* If the data won't fit into intermediate buffer, send the buffers
-	 * separately
-	 */
+	if (buf) {
+		k_mem_slab_free(&sendmsg_slab, buf);
+	}
 
-	len = 0;
+	if (sends > 1) {
+		SENDMSG_STATS_INC(fragmented_sends);
+	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		if (msg->msg_iov[i].iov_len == 0) {
-			continue;
-		}
+	return len;
+}
 
-		offset = 0;
-		while (offset < msg->msg_iov[i].iov_len) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(((uint8_t *) msg->msg_iov[i].iov_base) + offset),
-				(msg->msg_iov[i].iov_len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret < 0) {
-				return ret;
-			}
-			offset += ret;
-			len += ret;
-		}
+#if CONFIG_NRF_MODEM_LIB_SENDMSG_STATS
+int nrf_modem_lib_sendmsg_stats_get(struct nrf_modem_lib_sendmsg_stats *stats)
+{
+	if (!stats) {
+		return -EFAULT;
 	}
 
-	return len;
+	stats->bounce_copies = atomic_get(&sendmsg_stats.bounce_copies);
+	stats->fragmented_sends = atomic_get(&sendmsg_stats.fragmented_sends);
+
+	return 0;
 }
+#endif
 
 static void nrf9x_socket_offload_freeaddrinfo(struct zsock_addrinfo *root)
 {
@@ -6,84 +6,138 @@
 
 #include <pcm_mix.h>
 
+#include <string.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+/* The DSP extension of the Cortex-M4 and M33 has saturating and SIMD additions */
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include <arm_acle.h>
+#define PCM_MIX_DSP 1
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
-/* Clip signal if amplitude is outside legal range */
-static void hard_limiter(int32_t *const pcm)
+#define PCM_MIX_24_BIT_MIN (-(1 << 23))
+#define PCM_MIX_24_BIT_MAX ((1 << 23) - 1)
+
+/* Add two samples and clip the result if the amplitude is outside the legal range */
+static inline int16_t sat_add_16(int16_t a, int16_t b)
 {
-	if (*pcm < INT16_MIN) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MIN;
-	} else if (*pcm > INT16_MAX) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MAX;
-	}
+	return (int16_t)CLAMP((int32_t)a + b, INT16_MIN, INT16_MAX);
 }
 
-/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
-static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
-			      size_t size_b)
+static inline int32_t sat_add_24(int32_t a, int32_t b)
 {
-	int32_t res;
+	return CLAMP(a + b, PCM_MIX_24_BIT_MIN, PCM_MIX_24_BIT_MAX);
+}
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
+static inline int32_t sat_add_32(int32_t a, int32_t b)
+{
+#ifdef PCM_MIX_DSP
+	return __qadd(a, b);
+#else
+	return (int32_t)CLAMP((int64_t)a + b, INT32_MIN, INT32_MAX);
+#endif
+}
 
-		hard_limiter(&res);
+/* 24-bit samples are stored in three bytes, little endian */
+static inline int32_t sample_24_get(const uint8_t *p)
+{
+	uint32_t sample = ((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24);
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
-	}
+	/* Shift back down to sign extend the sample */
+	return (int32_t)sample >> 8;
 }
 
-/* Mix mono into both channels of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
-					    void const *const pcm_b, size_t size_b)
+static inline void sample_24_set(uint8_t *p, int32_t sample)
 {
-	int32_t res;
-
-	/* Use size_b as this is the length of the mono sample.
-	 * This must be *2 to traverse the stereo sample and /2 since
-	 * the sample is two bytes in size.
-	 */
-	for (uint32_t i = 0; i < size_b; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i / 2];
+	p[0] = (uint8_t)sample;
+	p[1] = (uint8_t)(sample >> 8);
+	p[2] = (uint8_t)(sample >> 16);
+}
 
-		hard_limiter(&res);
+/* Mix num_samples samples of B into every step'th sample of A */
+static void mix_16(int16_t *pcm_a, size_t step, const int16_t *pcm_b, size_t num_samples)
+{
+#ifdef PCM_MIX_DSP
+	/* Mix two samples at a time with the saturating halfword addition */
+	if (step == 1) {
+		for (; num_samples >= 2; num_samples -= 2) {
+			int16x2_t a;
+			int16x2_t b;
+
+			memcpy(&a, pcm_a, sizeof(a));
+			memcpy(&b, pcm_b, sizeof(b));
+			a = __qadd16(a, b);
+			memcpy(pcm_a, &a, sizeof(a));
+
+			pcm_a += 2;
+			pcm_b += 2;
+		}
+	}
+#endif /* PCM_MIX_DSP */
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+	for (; num_samples > 0; num_samples--) {
+		*pcm_a = sat_add_16(*pcm_a, *pcm_b++);
+		pcm_a += step;
 	}
 }
 
-/* Mix mono into left channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+/* Mix num_samples mono samples of B into both channels of a stereo buffer A */
+static void mix_16_mono_into_stereo(int16_t *pcm_a, const int16_t *pcm_b, size_t num_samples)
 {
-	int32_t res;
-
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
-
-		hard_limiter(&res);
-
-		((int16_t *)pcm_a)[i * 2] = (int16_t)res;
+	for (; num_samples > 0; num_samples--) {
+#ifdef PCM_MIX_DSP
+		int16x2_t a;
+		int16x2_t b = (uint16_t)*pcm_b | ((uint32_t)(uint16_t)*pcm_b << 16);
+
+		memcpy(&a, pcm_a, sizeof(a));
+		a = __qadd16(a, b);
+		memcpy(pcm_a, &a, sizeof(a));
+#else
+		pcm_a[0] = sat_add_16(pcm_a[0], *pcm_b);
+		pcm_a[1] = sat_add_16(pcm_a[1], *pcm_b);
+#endif /* PCM_MIX_DSP */
+
+		pcm_a += 2;
+		pcm_b++;
 	}
 }
 
-/* Mix mono into right channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+static void mix_24(uint8_t *pcm_a, size_t step, const uint8_t *pcm_b, size_t num_samples)
 {
-	int32_t res;
-
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
+	for (; num_samples > 0; num_samples--) {
+		sample_24_set(pcm_a, sat_add_24(sample_24_get(pcm_a), sample_24_get(pcm_b)));
+		pcm_a += step * 3;
+		pcm_b += 3;
+	}
+}
 
-		hard_limiter(&res);
+static void mix_32(int32_t *pcm_a, size_t step, const int32_t *pcm_b, size_t num_samples)
+{
+	for (; num_samples > 0; num_samples--) {
+		*pcm_a = sat_add_32(*pcm_a, *pcm_b++);
+		pcm_a += step;
+	}
+}
 
-		((int16_t *)pcm_a)[i * 2 + 1] = (int16_t)res;
+static void mix_samples(void *pcm_a, size_t step, void const *pcm_b, size_t num_samples,
+			uint8_t bytes_per_sample)
+{
+	switch (bytes_per_sample) {
+	case sizeof(int16_t):
+		mix_16((int16_t *)pcm_a, step, (const int16_t *)pcm_b, num_samples);
+		break;
+	case 3:
+		mix_24((uint8_t *)pcm_a, step, (const uint8_t *)pcm_b, num_samples);
+		break;
+	case sizeof(int32_t):
+		mix_32((int32_t *)pcm_a, step, (const int32_t *)pcm_b, num_samples);
+		break;
+	default:
+		break;
 	}
 }
 
@@ -106,26 +160,27 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 		if (size_b > size_a) {
 			return -EPERM;
 		}
-		pcm_mix_identical(pcm_a, size_a, pcm_b, size_b);
+		mix_16((int16_t *)pcm_a, 1, (const int16_t *)pcm_b, size_b / sizeof(int16_t));
 		break;
 	case B_MONO_INTO_A_STEREO_LR:
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
-		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, size_a, pcm_b, size_b);
+		mix_16_mono_into_stereo((int16_t *)pcm_a, (const int16_t *)pcm_b,
+					size_b / sizeof(int16_t));
 		break;
 	case B_MONO_INTO_A_STEREO_L:
-		pcm_mix_b_mono_into_a_stereo_l(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
 			LOG_ERR("size a %d size b %d", size_a, size_b);
 			return -EPERM;
 		}
+		mix_16((int16_t *)pcm_a, 2, (const int16_t *)pcm_b, size_b / sizeof(int16_t));
 		break;
 	case B_MONO_INTO_A_STEREO_R:
-		pcm_mix_b_mono_into_a_stereo_r(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
+		mix_16((int16_t *)pcm_a + 1, 2, (const int16_t *)pcm_b, size_b / sizeof(int16_t));
 		break;
 	default:
 		return -ESRCH;
@@ -133,3 +188,61 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 
 	return 0;
 }
+
+int pcm_mix_channels(void *const pcm_a, size_t size_a, uint8_t channels_a,
+		     void const *const pcm_b, size_t size_b, uint8_t channels_b, uint8_t channel,
+		     uint8_t pcm_bit_depth)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+	size_t frames_b;
+
+	if (pcm_a == NULL || size_a == 0 || channels_a == 0 ||
+	    (channels_b != 1 && channels_b != channels_a)) {
+		return -EINVAL;
+	}
+
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
+	if (size_a % (bytes_per_sample * channels_a) != 0) {
+		return -EINVAL;
+	}
+
+	if (pcm_b == NULL || size_b == 0) {
+		/* Nothing to mix, returning */
+		return 0;
+	}
+
+	if (size_b % (bytes_per_sample * channels_b) != 0) {
+		return -EINVAL;
+	}
+
+	frames_b = size_b / (bytes_per_sample * channels_b);
+	if (frames_b > size_a / (bytes_per_sample * channels_a)) {
+		return -EPERM;
+	}
+
+	if (channels_b == channels_a) {
+		mix_samples(pcm_a, 1, pcm_b, frames_b * channels_b, bytes_per_sample);
+	} else if (channel == PCM_MIX_CHANNEL_ALL) {
+		if (bytes_per_sample == sizeof(int16_t) && channels_a == 2) {
+			mix_16_mono_into_stereo((int16_t *)pcm_a, (const int16_t *)pcm_b,
+						frames_b);
+		} else {
+			for (uint8_t i = 0; i < channels_a; i++) {
+				mix_samples((uint8_t *)pcm_a + (i * bytes_per_sample), channels_a,
+					    pcm_b, frames_b, bytes_per_sample);
+			}
+		}
+	} else if (channel < channels_a) {
+		mix_samples((uint8_t *)pcm_a + (channel * bytes_per_sample), channels_a, pcm_b,
+			    frames_b, bytes_per_sample);
+	} else {
+		LOG_ERR("Invalid channel: %d", channel);
+		return -EINVAL;
+	}
+
+	return 0;
+}
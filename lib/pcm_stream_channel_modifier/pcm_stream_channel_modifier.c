@@ -203,27 +203,19 @@ int pscm_two_channel_split(void const *const input, size_t input_size, uint8_t p
 	return 0;
 }
 
-int pscm_interleave(void const *const input, size_t input_size, uint8_t channel,
-		    uint8_t pcm_bit_depth, void *output, size_t output_size,
-		    uint8_t output_channels)
+/* Copy a 24-bit sample without a loop over the bytes */
+static inline void sample_24_copy(uint8_t *output, const uint8_t *input)
 {
-	if (input == NULL || output == NULL || input == output || input_size == 0 ||
-	    channel >= output_channels || pcm_bit_depth == 0 ||
-	    pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH || pcm_bit_depth % 8 || output_size == 0 ||
-	    output_channels == 0 || !IS_ALIGNED(input, 4) || !IS_ALIGNED(output, 4)) {
-		LOG_WRN("Invalid parameter(s) passed to interleaver");
-		return -EINVAL;
-	}
-
-	if (output_size < (input_size * output_channels)) {
-		LOG_WRN("Output buffer too small to interleave input into");
-		return -EINVAL;
-	}
+	output[0] = input[0];
+	output[1] = input[1];
+	output[2] = input[2];
+}
 
-	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+static void interleave_channel(void const *const input, size_t input_size, uint8_t channel,
+			       uint8_t bytes_per_sample, void *output, uint8_t output_channels)
+{
 	/*
-	 * Use types corresponding to pcm_bit_depth to make iterating over an array faster
-	 * when pcm_bit_depth is 16 or 32. Use uint8_t in 8/24 bits case.
+	 * Use types corresponding to pcm_bit_depth to make iterating over an array faster.
 	 */
 	if (bytes_per_sample == sizeof(uint16_t)) {
 		const uint16_t *input_16 = (const uint16_t *)input;
@@ -243,45 +235,35 @@ int pscm_interleave(void const *const input, size_t input_size, uint8_t channel,
 			*output_32 = *input_32++;
 			output_32 += output_channels;
 		}
+	} else if (bytes_per_sample == 3) {
+		const uint8_t *input_24 = (const uint8_t *)input;
+		uint8_t *output_24 = (uint8_t *)output + (3 * channel);
+		const uint8_t *input_24_end = input_24 + input_size;
+
+		while (input_24 < input_24_end) {
+			sample_24_copy(output_24, input_24);
+			input_24 += 3;
+			output_24 += 3 * output_channels;
+		}
 	} else {
 		const uint8_t *input_8 = (const uint8_t *)input;
-		uint8_t *output_8 = (uint8_t *)output + (bytes_per_sample * channel);
-		size_t step = bytes_per_sample * (output_channels - 1);
+		uint8_t *output_8 = (uint8_t *)output + channel;
+		const uint8_t *input_8_end = input_8 + input_size;
 
-		for (size_t i = 0; i < input_size; i += bytes_per_sample) {
-			for (uint8_t j = 0; j < bytes_per_sample; j++) {
-				*output_8++ = *input_8++;
-			}
-			output_8 += step;
+		while (input_8 < input_8_end) {
+			*output_8 = *input_8++;
+			output_8 += output_channels;
 		}
 	}
-
-	return 0;
 }
 
-int pscm_deinterleave(void const *const input, size_t input_size, uint8_t input_channels,
-		      uint8_t channel, uint8_t pcm_bit_depth, void *output, size_t output_size)
+static void deinterleave_channel(void const *const input, size_t bytes_to_copy,
+				 uint8_t input_channels, uint8_t channel, uint8_t bytes_per_sample,
+				 void *output)
 {
-	size_t bytes_to_copy;
-
-	if (input == NULL || output == NULL || input_size == 0 || channel >= input_channels ||
-	    pcm_bit_depth == 0 || pcm_bit_depth % 8 || output_size == 0 ||
-	    pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH || input_channels == 0 ||
-	    !IS_ALIGNED(input, 4) || !IS_ALIGNED(output, 4)) {
-		return -EINVAL;
-	}
-
-	if (output_size < (input_size / input_channels)) {
-		LOG_DBG("Output buffer too small to uninterleave input into");
-		return -EINVAL;
-	}
-
-	uint8_t bytes_per_sample = pcm_bit_depth / 8;
 	/*
-	 * Use types corresponding to pcm_bit_depth to make iterating over an array faster
-	 * when pcm_bit_depth is 16 or 32. Use uint8_t in 8/24 bits case.
+	 * Use types corresponding to pcm_bit_depth to make iterating over an array faster.
 	 */
-	bytes_to_copy = input_size / input_channels;
 	if (bytes_per_sample == sizeof(uint16_t)) {
 		uint16_t *output_16 = (uint16_t *)output;
 		const uint16_t *input_16 = (const uint16_t *)input + channel;
@@ -300,18 +282,197 @@ int pscm_deinterleave(void const *const input, size_t input_size, uint8_t input_
 			*output_32++ = *input_32;
 			input_32 += input_channels;
 		}
+	} else if (bytes_per_sample == 3) {
+		uint8_t *output_24 = (uint8_t *)output;
+		const uint8_t *input_24 = (const uint8_t *)input + (3 * channel);
+		uint8_t *output_24_end = output_24 + bytes_to_copy;
+
+		while (output_24 < output_24_end) {
+			sample_24_copy(output_24, input_24);
+			output_24 += 3;
+			input_24 += 3 * input_channels;
+		}
 	} else {
 		uint8_t *output_8 = (uint8_t *)output;
-		const uint8_t *input_8 = (const uint8_t *)input + (channel * bytes_per_sample);
-		size_t step = bytes_per_sample * (input_channels - 1);
+		const uint8_t *input_8 = (const uint8_t *)input + channel;
+		uint8_t *output_8_end = output_8 + bytes_to_copy;
 
-		for (size_t i = 0; i < bytes_to_copy; i += bytes_per_sample) {
-			for (uint8_t j = 0; j < bytes_per_sample; j++) {
-				*output_8++ = *input_8++;
-			}
-			input_8 += step;
+		while (output_8 < output_8_end) {
+			*output_8++ = *input_8;
+			input_8 += input_channels;
 		}
 	}
+}
+
+/*
+ * Interleave two frames of 16-bit stereo at a time. The halfwords are packed with shifts and
+ * masks, which the compiler turns into the PKHBT/PKHTB instructions on CPUs with the DSP
+ * extension.
+ */
+static size_t interleave_stereo_16(const uint32_t *input_left, const uint32_t *input_right,
+				   size_t input_size, uint32_t *output)
+{
+	size_t words = input_size / sizeof(uint32_t);
+
+	for (size_t i = 0; i < words; i++) {
+		uint32_t left = input_left[i];
+		uint32_t right = input_right[i];
+
+		*output++ = (left & 0x0000FFFF) | (right << 16);
+		*output++ = (left >> 16) | (right & 0xFFFF0000);
+	}
+
+	return words * sizeof(uint32_t);
+}
+
+static size_t deinterleave_stereo_16(const uint32_t *input, size_t bytes_to_copy,
+				     uint32_t *output_left, uint32_t *output_right)
+{
+	size_t words = bytes_to_copy / sizeof(uint32_t);
+
+	for (size_t i = 0; i < words; i++) {
+		uint32_t first = *input++;
+		uint32_t second = *input++;
+
+		output_left[i] = (first & 0x0000FFFF) | (second << 16);
+		output_right[i] = (first >> 16) | (second & 0xFFFF0000);
+	}
+
+	return words * sizeof(uint32_t);
+}
+
+int pscm_interleave(void const *const input, size_t input_size, uint8_t channel,
+		    uint8_t pcm_bit_depth, void *output, size_t output_size,
+		    uint8_t output_channels)
+{
+	if (input == NULL || output == NULL || input == output || input_size == 0 ||
+	    channel >= output_channels || pcm_bit_depth == 0 ||
+	    pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH || pcm_bit_depth % 8 || output_size == 0 ||
+	    output_channels == 0 || !IS_ALIGNED(input, 4) || !IS_ALIGNED(output, 4)) {
+		LOG_WRN("Invalid parameter(s) passed to interleaver");
+		return -EINVAL;
+	}
+
+	if (output_size < (input_size * output_channels)) {
+		LOG_WRN("Output buffer too small to interleave input into");
+		return -EINVAL;
+	}
+
+	interleave_channel(input, input_size, channel, pcm_bit_depth / 8, output, output_channels);
+
+	return 0;
+}
+
+int pscm_deinterleave(void const *const input, size_t input_size, uint8_t input_channels,
+		      uint8_t channel, uint8_t pcm_bit_depth, void *output, size_t output_size)
+{
+	if (input == NULL || output == NULL || input_size == 0 || channel >= input_channels ||
+	    pcm_bit_depth == 0 || pcm_bit_depth % 8 || output_size == 0 ||
+	    pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH || input_channels == 0 ||
+	    !IS_ALIGNED(input, 4) || !IS_ALIGNED(output, 4)) {
+		return -EINVAL;
+	}
+
+	if (output_size < (input_size / input_channels)) {
+		LOG_DBG("Output buffer too small to uninterleave input into");
+		return -EINVAL;
+	}
+
+	deinterleave_channel(input, input_size / input_channels, input_channels, channel,
+			     pcm_bit_depth / 8, output);
+
+	return 0;
+}
+
+int pscm_interleave_channels(void const *const inputs[], size_t input_size,
+			     uint8_t pcm_bit_depth, void *output, size_t output_size,
+			     uint8_t output_channels)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+	size_t offset = 0;
+
+	if (inputs == NULL || output == NULL || input_size == 0 || pcm_bit_depth == 0 ||
+	    pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH || pcm_bit_depth % 8 || output_size == 0 ||
+	    output_channels == 0 || input_size % bytes_per_sample || !IS_ALIGNED(output, 4)) {
+		LOG_WRN("Invalid parameter(s) passed to interleaver");
+		return -EINVAL;
+	}
+
+	for (uint8_t i = 0; i < output_channels; i++) {
+		if (inputs[i] == NULL || inputs[i] == output || !IS_ALIGNED(inputs[i], 4)) {
+			LOG_WRN("Invalid input buffer for channel %d", i);
+			return -EINVAL;
+		}
+	}
+
+	if (output_size < (input_size * output_channels)) {
+		LOG_WRN("Output buffer too small to interleave input into");
+		return -EINVAL;
+	}
+
+	if (bytes_per_sample == sizeof(uint16_t) && output_channels == 2 &&
+	    !IS_ENABLED(CONFIG_BIG_ENDIAN)) {
+		offset = interleave_stereo_16((const uint32_t *)inputs[0],
+					      (const uint32_t *)inputs[1], input_size,
+					      (uint32_t *)output);
+		if (offset == input_size) {
+			return 0;
+		}
+	}
+
+	/* Remaining samples are interleaved one channel at a time */
+	for (uint8_t i = 0; i < output_channels; i++) {
+		interleave_channel((const uint8_t *)inputs[i] + offset, input_size - offset, i,
+				   bytes_per_sample, (uint8_t *)output + (offset * output_channels),
+				   output_channels);
+	}
+
+	return 0;
+}
+
+int pscm_deinterleave_channels(void const *const input, size_t input_size,
+			       uint8_t input_channels, uint8_t pcm_bit_depth, void *const outputs[],
+			       size_t output_size)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+	size_t bytes_to_copy;
+	size_t offset = 0;
+
+	if (input == NULL || outputs == NULL || input_size == 0 || pcm_bit_depth == 0 ||
+	    pcm_bit_depth % 8 || output_size == 0 || pcm_bit_depth > PSCM_MAX_CARRIER_BIT_DEPTH ||
+	    input_channels == 0 || input_size % (bytes_per_sample * input_channels) ||
+	    !IS_ALIGNED(input, 4)) {
+		return -EINVAL;
+	}
+
+	for (uint8_t i = 0; i < input_channels; i++) {
+		if (outputs[i] == NULL || outputs[i] == input || !IS_ALIGNED(outputs[i], 4)) {
+			LOG_DBG("Invalid output buffer for channel %d", i);
+			return -EINVAL;
+		}
+	}
+
+	bytes_to_copy = input_size / input_channels;
+	if (output_size < bytes_to_copy) {
+		LOG_DBG("Output buffer too small to uninterleave input into");
+		return -EINVAL;
+	}
+
+	if (bytes_per_sample == sizeof(uint16_t) && input_channels == 2 &&
+	    !IS_ENABLED(CONFIG_BIG_ENDIAN)) {
+		offset = deinterleave_stereo_16((const uint32_t *)input, bytes_to_copy,
+						(uint32_t *)outputs[0], (uint32_t *)outputs[1]);
+		if (offset == bytes_to_copy) {
+			return 0;
+		}
+	}
+
+	/* Remaining samples are de-interleaved one channel at a time */
+	for (uint8_t i = 0; i < input_channels; i++) {
+		deinterleave_channel((const uint8_t *)input + (offset * input_channels),
+				     bytes_to_copy - offset, input_channels, i, bytes_per_sample,
+				     (uint8_t *)outputs[i] + offset);
+	}
 
 	return 0;
 }
@@ -6,6 +6,7 @@
 
 #include "sample_rate_converter.h"
 #include "sample_rate_converter_filter.h"
+#include "sample_rate_converter_polyphase.h"
 
 #include <errno.h>
 #include <stdbool.h>
@@ -102,6 +103,13 @@ static int sample_rate_converter_reconfigure(struct sample_rate_converter_ctx *c
 
 	__ASSERT(ctx != NULL, "Context cannot be NULL");
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	if (filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+		return sample_rate_converter_polyphase_init(ctx, sample_rate_input,
+							    sample_rate_output);
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 	ret = validate_sample_rates(sample_rate_input, sample_rate_output);
 	if (ret) {
 		LOG_ERR("Invalid sample rate given (%d)", ret);
@@ -247,6 +255,13 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 		}
 	}
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	if (ctx->filter_type == SAMPLE_RATE_FILTER_POLYPHASE) {
+		return sample_rate_converter_polyphase_process(ctx, input, samples_in, output,
+							       output_size, output_written);
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 	if ((ctx->conversion_ratio < 0) && (samples_in < abs(ctx->conversion_ratio))) {
 		LOG_ERR("Number of samples in can not be less than the conversion ratio (%d) when "
 			"downsampling",
@@ -393,3 +408,25 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 
 	return 0;
 }
+
+int sample_rate_converter_drift_set(struct sample_rate_converter_ctx *ctx, int32_t drift_ppm)
+{
+	if (ctx == NULL) {
+		LOG_ERR("Context cannot be NULL");
+		return -EINVAL;
+	}
+
+	if ((drift_ppm > SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX) ||
+	    (drift_ppm < -SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX)) {
+		LOG_ERR("Drift of %d ppm is out of range", drift_ppm);
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	sample_rate_converter_polyphase_drift_set(ctx, drift_ppm);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+}
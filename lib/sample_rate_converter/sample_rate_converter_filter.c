@@ -21,6 +21,152 @@ LOG_MODULE_REGISTER(sample_rate_converter_filter, CONFIG_SAMPLE_RATE_CONVERTER_L
  *   divisible by the conversio ratio (2 or 3).
  */
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+/**
+ * Kaiser windowed sinc filters (beta 7) split into 32 phases of 16 taps. Phase p holds the taps
+ * for an output sample p/32 input samples after the eighth tap. Each phase has a gain of
+ * exactly 1, so that a constant input passes through unchanged. The wide filter has its
+ * cut-off at 0.45 of the input rate and is used when the output rate is at least 0.9 of the
+ * input rate. The narrow filter has its cut-off at 0.30 of the input rate to suppress
+ * aliasing when downsampling further.
+ */
+static const q15_t filter_polyphase_wide[SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES]
+			      [SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS] = {
+	{48, -192, 511, -1046, 1755, -2495, 3063, 29480,
+	 3063, -2495, 1755, -1046, 511, -192, 48, 0},
+	{49, -191, 496, -990, 1603, -2135, 2145, 29445,
+	 4021, -2852, 1900, -1097, 523, -192, 47, -4},
+	{49, -187, 478, -928, 1443, -1773, 1270, 29325,
+	 5015, -3200, 2034, -1139, 530, -190, 45, -4},
+	{48, -183, 456, -861, 1278, -1412, 440, 29129,
+	 6042, -3538, 2157, -1174, 533, -186, 43, -4},
+	{47, -177, 432, -790, 1110, -1056, -341, 28853,
+	 7097, -3862, 2268, -1201, 532, -180, 39, -3},
+	{46, -170, 405, -716, 940, -706, -1073, 28502,
+	 8178, -4169, 2363, -1219, 526, -173, 36, -2},
+	{44, -162, 376, -639, 768, -365, -1752, 28077,
+	 9278, -4455, 2443, -1226, 514, -163, 31, -1},
+	{42, -152, 346, -560, 598, -36, -2378, 27575,
+	 10395, -4718, 2506, -1224, 498, -150, 26, 0},
+	{40, -143, 314, -480, 429, 280, -2949, 27007,
+	 11523, -4954, 2550, -1211, 477, -136, 20, 1},
+	{38, -132, 281, -400, 264, 581, -3464, 26369,
+	 12657, -5160, 2575, -1188, 450, -119, 13, 3},
+	{35, -121, 248, -320, 104, 864, -3924, 25671,
+	 13792, -5333, 2579, -1153, 418, -101, 5, 4},
+	{32, -110, 214, -241, -51, 1129, -4328, 24912,
+	 14923, -5471, 2562, -1107, 381, -80, -3, 6},
+	{30, -98, 181, -163, -199, 1374, -4676, 24092,
+	 16045, -5569, 2523, -1049, 338, -57, -12, 8},
+	{27, -87, 147, -88, -339, 1597, -4968, 23223,
+	 17154, -5626, 2461, -980, 290, -33, -21, 11},
+	{24, -75, 115, -16, -471, 1799, -5206, 22305,
+	 18243, -5639, 2375, -900, 238, -6, -31, 13},
+	{21, -64, 83, 54, -594, 1978, -5391, 21344,
+	 19307, -5605, 2266, -809, 181, 22, -41, 16},
+	{18, -52, 52, 119, -706, 2134, -5523, 20341,
+	 20343, -5523, 2134, -706, 119, 52, -52, 18},
+	{16, -41, 22, 181, -809, 2266, -5605, 19307,
+	 21344, -5391, 1978, -594, 54, 83, -64, 21},
+	{13, -31, -6, 238, -900, 2375, -5639, 18243,
+	 22305, -5206, 1799, -471, -16, 115, -75, 24},
+	{11, -21, -33, 290, -980, 2461, -5626, 17154,
+	 23223, -4968, 1597, -339, -88, 147, -87, 27},
+	{8, -12, -57, 338, -1049, 2523, -5569, 16045,
+	 24092, -4676, 1374, -199, -163, 181, -98, 30},
+	{6, -3, -80, 381, -1107, 2562, -5471, 14923,
+	 24912, -4328, 1129, -51, -241, 214, -110, 32},
+	{4, 5, -101, 418, -1153, 2579, -5333, 13792,
+	 25671, -3924, 864, 104, -320, 248, -121, 35},
+	{3, 13, -119, 450, -1188, 2575, -5160, 12657,
+	 26369, -3464, 581, 264, -400, 281, -132, 38},
+	{1, 20, -136, 477, -1211, 2550, -4954, 11523,
+	 27007, -2949, 280, 429, -480, 314, -143, 40},
+	{0, 26, -150, 498, -1224, 2506, -4718, 10395,
+	 27575, -2378, -36, 598, -560, 346, -152, 42},
+	{-1, 31, -163, 514, -1226, 2443, -4455, 9278,
+	 28077, -1752, -365, 768, -639, 376, -162, 44},
+	{-2, 36, -173, 526, -1219, 2363, -4169, 8178,
+	 28502, -1073, -706, 940, -716, 405, -170, 46},
+	{-3, 39, -180, 532, -1201, 2268, -3862, 7097,
+	 28853, -341, -1056, 1110, -790, 432, -177, 47},
+	{-4, 43, -186, 533, -1174, 2157, -3538, 6042,
+	 29129, 440, -1412, 1278, -861, 456, -183, 48},
+	{-4, 45, -190, 530, -1139, 2034, -3200, 5015,
+	 29325, 1270, -1773, 1443, -928, 478, -187, 49},
+	{-4, 47, -192, 523, -1097, 1900, -2852, 4021,
+	 29445, 2145, -2135, 1603, -990, 496, -191, 49},
+};
+
+static const q15_t filter_polyphase_narrow[SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES]
+			      [SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS] = {
+	{35, -192, 0, 1047, -1276, -2497, 9433, 19668,
+	 9433, -2497, -1276, 1047, 0, -192, 35, 0},
+	{36, -182, -29, 1042, -1147, -2636, 8926, 19654,
+	 9936, -2342, -1406, 1048, 31, -202, 34, 5},
+	{37, -172, -57, 1033, -1018, -2759, 8420, 19617,
+	 10438, -2170, -1535, 1045, 63, -212, 32, 6},
+	{37, -162, -83, 1020, -891, -2867, 7916, 19556,
+	 10938, -1982, -1664, 1037, 97, -221, 30, 7},
+	{37, -151, -108, 1003, -765, -2959, 7414, 19471,
+	 11433, -1778, -1792, 1025, 132, -229, 27, 8},
+	{37, -140, -130, 984, -641, -3036, 6916, 19355,
+	 11924, -1557, -1918, 1008, 169, -237, 24, 10},
+	{37, -130, -151, 961, -521, -3099, 6422, 19225,
+	 12407, -1320, -2042, 986, 206, -245, 21, 11},
+	{37, -119, -170, 936, -403, -3147, 5933, 19064,
+	 12884, -1067, -2163, 960, 245, -251, 17, 12},
+	{36, -109, -188, 907, -288, -3182, 5450, 18884,
+	 13352, -797, -2280, 928, 285, -257, 13, 14},
+	{35, -99, -203, 877, -177, -3203, 4975, 18680,
+	 13810, -511, -2393, 890, 325, -262, 9, 15},
+	{34, -89, -217, 844, -69, -3211, 4507, 18455,
+	 14258, -210, -2502, 848, 366, -266, 4, 16},
+	{33, -79, -230, 810, 34, -3207, 4049, 18207,
+	 14694, 107, -2605, 800, 408, -269, -2, 18},
+	{32, -70, -240, 774, 133, -3191, 3600, 17937,
+	 15118, 440, -2702, 747, 449, -271, -8, 20},
+	{30, -61, -249, 736, 227, -3164, 3162, 17649,
+	 15528, 788, -2792, 688, 491, -272, -14, 21},
+	{29, -52, -257, 697, 317, -3125, 2734, 17341,
+	 15923, 1150, -2876, 624, 533, -272, -21, 23},
+	{27, -44, -263, 657, 401, -3077, 2319, 17014,
+	 16303, 1526, -2951, 555, 575, -270, -28, 24},
+	{26, -36, -267, 616, 481, -3019, 1916, 16668,
+	 16666, 1916, -3019, 481, 616, -267, -36, 26},
+	{24, -28, -270, 575, 555, -2951, 1526, 16303,
+	 17014, 2319, -3077, 401, 657, -263, -44, 27},
+	{23, -21, -272, 533, 624, -2876, 1150, 15923,
+	 17341, 2734, -3125, 317, 697, -257, -52, 29},
+	{21, -14, -272, 491, 688, -2792, 788, 15528,
+	 17649, 3162, -3164, 227, 736, -249, -61, 30},
+	{20, -8, -271, 449, 747, -2702, 440, 15118,
+	 17937, 3600, -3191, 133, 774, -240, -70, 32},
+	{18, -2, -269, 408, 800, -2605, 107, 14694,
+	 18207, 4049, -3207, 34, 810, -230, -79, 33},
+	{16, 4, -266, 366, 848, -2502, -210, 14258,
+	 18455, 4507, -3211, -69, 844, -217, -89, 34},
+	{15, 9, -262, 325, 890, -2393, -511, 13810,
+	 18680, 4975, -3203, -177, 877, -203, -99, 35},
+	{14, 13, -257, 285, 928, -2280, -797, 13352,
+	 18884, 5450, -3182, -288, 907, -188, -109, 36},
+	{12, 17, -251, 245, 960, -2163, -1067, 12884,
+	 19064, 5933, -3147, -403, 936, -170, -119, 37},
+	{11, 21, -245, 206, 986, -2042, -1320, 12407,
+	 19225, 6422, -3099, -521, 961, -151, -130, 37},
+	{10, 24, -237, 169, 1008, -1918, -1557, 11924,
+	 19355, 6916, -3036, -641, 984, -130, -140, 37},
+	{8, 27, -229, 132, 1025, -1792, -1778, 11433,
+	 19471, 7414, -2959, -765, 1003, -108, -151, 37},
+	{7, 30, -221, 97, 1037, -1664, -1982, 10938,
+	 19556, 7916, -2867, -891, 1020, -83, -162, 37},
+	{6, 32, -212, 63, 1045, -1535, -2170, 10438,
+	 19617, 8420, -2759, -1018, 1033, -57, -172, 37},
+	{5, 34, -202, 31, 1048, -1406, -2342, 9936,
+	 19654, 8926, -2636, -1147, 1042, -29, -182, 36},
+};
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 #ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_TEST
 #ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
 static const q15_t filter_48khz_to_24khz_16bit_test[] = {0x3fff, 0x3fff};
@@ -301,3 +447,18 @@ int sample_rate_converter_filter_get(enum sample_rate_converter_filter filter_ty
 #endif /* CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16 */
 	return 0;
 }
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+int sample_rate_converter_polyphase_filter_get(uint32_t sample_rate_input,
+					       uint32_t sample_rate_output, const q15_t **filter_ptr)
+{
+	/* Compare in 64 bits as the rates are multiplied */
+	if ((uint64_t)sample_rate_output * 10 >= (uint64_t)sample_rate_input * 9) {
+		*filter_ptr = &filter_polyphase_wide[0][0];
+	} else {
+		*filter_ptr = &filter_polyphase_narrow[0][0];
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
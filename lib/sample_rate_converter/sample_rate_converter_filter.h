@@ -24,4 +24,19 @@ int sample_rate_converter_filter_get(enum sample_rate_converter_filter filter_ty
 				     int conversion_ratio, void const **filter_ptr,
 				     size_t *filter_size);
 
+/**
+ * @brief Get the pointer to the polyphase filter coefficients.
+ *
+ * @details The coefficients are stored as SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES rows of
+ *	    SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS coefficients.
+ *
+ * @param[in]	sample_rate_input	Sample rate of the input samples.
+ * @param[in]	sample_rate_output	Sample rate of the output samples.
+ * @param[out]	filter_ptr		Pointer to the filter coefficients.
+ *
+ * @retval	0	On success.
+ */
+int sample_rate_converter_polyphase_filter_get(uint32_t sample_rate_input,
+					       uint32_t sample_rate_output, const q15_t **filter_ptr);
+
 #endif /* _SAMPLE_RATE_CONVERTER_FILTER_H_ */
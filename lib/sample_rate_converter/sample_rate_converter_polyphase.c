@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "sample_rate_converter.h"
+#include "sample_rate_converter_filter.h"
+#include "sample_rate_converter_polyphase.h"
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <dsp/basic_math_functions.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(sample_rate_converter, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
+
+#define TAPS   SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+#define PHASES SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES
+
+/* The fraction of the input position selects a phase, and the next bits are used to
+ * interpolate linearly between that phase and the next.
+ */
+#define PHASE_BITS 5
+#define MU_BITS	   15
+
+BUILD_ASSERT(BIT(PHASE_BITS) == PHASES, "Number of phases must match the phase bits");
+
+/* Number of samples in the filter window before the input position. */
+#define WINDOW_OFFSET (TAPS / 2 - 1)
+
+/* Ratio between output and input sample rate must be within 0.6 and 8 */
+#define RATIO_MIN_NUM 6
+#define RATIO_MIN_DEN 10
+#define RATIO_MAX     8
+
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef q15_t sample_t;
+typedef q15_t coeff_t;
+
+/* The accumulator holds the exact products in 34.30 format */
+#define ACC_SHIFT  15
+#define SAMPLE_MIN INT16_MIN
+#define SAMPLE_MAX INT16_MAX
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef q31_t sample_t;
+typedef q31_t coeff_t;
+
+/* The coefficients are Q15 values promoted to Q31, and each product is shifted down by 14 before
+ * it is accumulated.
+ */
+#define ACC_SHIFT  17
+#define SAMPLE_MIN INT32_MIN
+#define SAMPLE_MAX INT32_MAX
+#endif
+
+static inline int64_t polyphase_dot(const sample_t *window, const coeff_t *coeffs)
+{
+	int64_t acc;
+
+#if CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_KERNEL_CMSIS_DSP
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	arm_dot_prod_q15(window, coeffs, TAPS, &acc);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	arm_dot_prod_q31(window, coeffs, TAPS, &acc);
+#endif
+#else
+	acc = 0;
+
+	/* Accumulate in the same way as the CMSIS DSP functions, so the output is identical */
+	for (size_t i = 0; i < TAPS; i++) {
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+		acc += (int32_t)window[i] * coeffs[i];
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+		acc += ((int64_t)window[i] * coeffs[i]) >> 14;
+#endif
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_KERNEL_CMSIS_DSP */
+
+	return acc;
+}
+
+static inline int32_t polyphase_round(int64_t acc)
+{
+	int64_t sample = (acc + ((int64_t)1 << (ACC_SHIFT - 1))) >> ACC_SHIFT;
+
+	return (int32_t)CLAMP(sample, SAMPLE_MIN, SAMPLE_MAX);
+}
+
+static inline coeff_t const *
+polyphase_phase_get(const struct sample_rate_converter_polyphase_ctx *poly, uint32_t phase)
+{
+	return &poly->filter[phase * TAPS];
+}
+
+/**
+ * @brief Calculate the output sample for a position in the input buffer.
+ *
+ * @details The sample is interpolated between the two phases closest to the position. For the
+ *	    last phase, the next phase is the first phase one input sample later.
+ */
+static sample_t polyphase_sample_get(const struct sample_rate_converter_polyphase_ctx *poly,
+				     uint64_t pos)
+{
+	const sample_t *window = &poly->buf[(pos >> 32) - WINDOW_OFFSET];
+	uint32_t frac = (uint32_t)pos;
+	uint32_t phase = frac >> (32 - PHASE_BITS);
+	int32_t mu = (frac >> (32 - PHASE_BITS - MU_BITS)) & (BIT(MU_BITS) - 1);
+	int32_t y0;
+	int32_t y1;
+
+	y0 = polyphase_round(polyphase_dot(window, polyphase_phase_get(poly, phase)));
+	if (mu == 0) {
+		return y0;
+	}
+
+	if (phase + 1 < PHASES) {
+		y1 = polyphase_round(polyphase_dot(window, polyphase_phase_get(poly, phase + 1)));
+	} else {
+		y1 = polyphase_round(polyphase_dot(window + 1, polyphase_phase_get(poly, 0)));
+	}
+
+	return y0 + (int32_t)(((int64_t)(y1 - y0) * mu) >> MU_BITS);
+}
+
+static void polyphase_step_update(struct sample_rate_converter_polyphase_ctx *poly)
+{
+	poly->step = poly->step_nominal +
+		     ((int64_t)poly->step_nominal * poly->drift_ppm) / 1000000;
+}
+
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_ctx *ctx,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output)
+{
+	struct sample_rate_converter_polyphase_ctx *poly = &ctx->polyphase;
+	const q15_t *filter;
+
+	if ((sample_rate_input == 0) ||
+	    ((uint64_t)sample_rate_output * RATIO_MIN_DEN <
+	     (uint64_t)sample_rate_input * RATIO_MIN_NUM) ||
+	    ((uint64_t)sample_rate_output > (uint64_t)sample_rate_input * RATIO_MAX)) {
+		LOG_ERR("Ratio between %d and %d not supported by the polyphase filter",
+			sample_rate_input, sample_rate_output);
+		return -EINVAL;
+	}
+
+	(void)sample_rate_converter_polyphase_filter_get(sample_rate_input, sample_rate_output,
+							 &filter);
+
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	poly->filter = filter;
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	for (size_t i = 0; i < ARRAY_SIZE(poly->filter); i++) {
+		poly->filter[i] = (q31_t)filter[i] * (1 << 16);
+	}
+#endif
+
+	poly->step_nominal = ((uint64_t)sample_rate_input << 32) / sample_rate_output;
+	polyphase_step_update(poly);
+
+	/* Start with zeros in the part of the window before the first sample */
+	memset(poly->buf, 0, WINDOW_OFFSET * sizeof(sample_t));
+	poly->samples_in_buf = WINDOW_OFFSET;
+	poly->pos = (uint64_t)WINDOW_OFFSET << 32;
+
+	ctx->sample_rate_input = sample_rate_input;
+	ctx->sample_rate_output = sample_rate_output;
+	ctx->conversion_ratio = 0;
+	ctx->filter_type = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	LOG_DBG("Polyphase conversion initialized. Input sample rate: %d, Output sample rate: %d",
+		sample_rate_input, sample_rate_output);
+
+	return 0;
+}
+
+void sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_ctx *ctx,
+					       int32_t drift_ppm)
+{
+	ctx->polyphase.drift_ppm = drift_ppm;
+	polyphase_step_update(&ctx->polyphase);
+}
+
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_ctx *ctx,
+					    void const *const input, size_t samples_in,
+					    void *const output, size_t output_size,
+					    size_t *output_written)
+{
+	struct sample_rate_converter_polyphase_ctx *poly = &ctx->polyphase;
+	sample_t *out = (sample_t *)output;
+	size_t samples_in_buf = poly->samples_in_buf + samples_in;
+	size_t samples_out = 0;
+	size_t consumed;
+	uint64_t end;
+
+	/* An output sample needs the input up to one sample after the window for the last phase */
+	end = (uint64_t)(samples_in_buf - (TAPS / 2 + 1)) << 32;
+	if ((samples_in_buf > TAPS / 2 + 1) && (poly->pos < end)) {
+		samples_out = (end - poly->pos + poly->step - 1) / poly->step;
+	}
+
+	if (samples_out * sizeof(sample_t) > output_size) {
+		LOG_ERR("Conversion process will produce more bytes than the output buffer can "
+			"hold");
+		return -EINVAL;
+	}
+
+	memcpy(&poly->buf[poly->samples_in_buf], input, samples_in * sizeof(sample_t));
+	poly->samples_in_buf = samples_in_buf;
+
+	for (size_t i = 0; i < samples_out; i++) {
+		out[i] = polyphase_sample_get(poly, poly->pos);
+		poly->pos += poly->step;
+	}
+
+	/* Keep the samples still needed in the window of the next output sample */
+	consumed = (poly->pos >> 32) - WINDOW_OFFSET;
+	poly->samples_in_buf -= consumed;
+	poly->pos -= (uint64_t)consumed << 32;
+	memmove(poly->buf, &poly->buf[consumed], poly->samples_in_buf * sizeof(sample_t));
+
+	*output_written = samples_out * sizeof(sample_t);
+
+	return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+#define _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+
+#include "sample_rate_converter.h"
+
+/**
+ * @brief Initialize the polyphase conversion for the given sample rates.
+ *
+ * @details The clock drift set in the context is kept.
+ *
+ * @param[in,out]	ctx			Pointer to the sample rate conversion context.
+ * @param[in]		sample_rate_input	Sample rate of the input samples.
+ * @param[in]		sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Ratio between the sample rates not supported.
+ */
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_ctx *ctx,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output);
+
+/**
+ * @brief Set the clock drift of the input and update the conversion step.
+ *
+ * @param[in,out]	ctx		Pointer to the sample rate conversion context.
+ * @param[in]		drift_ppm	Drift of the input clock in parts per million.
+ */
+void sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_ctx *ctx,
+					       int32_t drift_ppm);
+
+/**
+ * @brief Convert a block of samples with the polyphase filter.
+ *
+ * @param[in,out]	ctx		Pointer to the sample rate conversion context.
+ * @param[in]		input		Pointer to the input samples.
+ * @param[in]		samples_in	Number of input samples.
+ * @param[out]		output		Pointer to the output buffer.
+ * @param[in]		output_size	Size of the output buffer in bytes.
+ * @param[out]		output_written	Number of bytes written to the output buffer.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Output buffer too small for the samples produced.
+ */
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_ctx *ctx,
+					    void const *const input, size_t samples_in,
+					    void *const output, size_t output_size,
+					    size_t *output_written);
+
+#endif /* _SAMPLE_RATE_CONVERTER_POLYPHASE_H_ */
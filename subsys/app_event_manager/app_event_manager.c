@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
@@ -12,17 +13,61 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/reboot.h>
 
+#include "app_event_manager_slab.h"
+
 LOG_MODULE_REGISTER(app_event_manager, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES)
+#define EVENT_QUEUE_CNT	2
+#else
+#define EVENT_QUEUE_CNT	1
+#endif
+
+/* Without priority queues, high priority events use the normal queue. */
+#define EVENT_QUEUE_NORMAL	0
+#define EVENT_QUEUE_HIGH	(EVENT_QUEUE_CNT - 1)
+
+BUILD_ASSERT(APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY <
+	     BITS_PER_BYTE * sizeof(((struct event_type *)0)->flags));
+
+struct event_queue {
+	sys_slist_t events;
+	size_t len;
+};
+
 static void event_processor_fn(struct k_work *work);
 
 struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
 static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+static struct event_queue eventq[EVENT_QUEUE_CNT];
 static struct k_spinlock lock;
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ)
+static void high_prio_event_processor_fn(struct k_work *work);
+
+static K_WORK_DEFINE(high_prio_event_processor, high_prio_event_processor_fn);
+static K_THREAD_STACK_DEFINE(high_prio_workq_stack,
+			     CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ_STACK_SIZE);
+static struct k_work_q high_prio_workq;
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES)
+static size_t starvation_cnt;
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+struct dispatch_stats {
+	uint32_t event_cnt;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+	atomic_t dropped_cnt;
+};
+
+static struct dispatch_stats dispatch_stats[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+#endif
+
 static bool log_is_event_displayed(const struct event_type *et)
 {
 	size_t idx = et - _event_type_list_start;
@@ -116,7 +161,13 @@ static void log_event_init(void)
 
 void * __weak app_event_manager_alloc(size_t size)
 {
-	void *event = k_malloc(size);
+	void *event;
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB)) {
+		event = app_event_manager_slab_alloc(size);
+	} else {
+		event = k_malloc(size);
+	}
 
 	if (unlikely(!event)) {
 		LOG_ERR("Application Event Manager OOM error\n");
@@ -134,74 +185,217 @@ void * __weak app_event_manager_alloc(size_t size)
 
 void __weak app_event_manager_free(void *addr)
 {
-	k_free(addr);
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB)) {
+		app_event_manager_slab_free(addr);
+	} else {
+		k_free(addr);
+	}
 }
 
-static void event_processor_fn(struct k_work *work)
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+static void dispatch_stats_update(const struct event_type *et, uint32_t cycles)
+{
+	struct dispatch_stats *ds = &dispatch_stats[et - _event_type_list_start];
+
+	ds->event_cnt++;
+	ds->total_cycles += cycles;
+	ds->max_cycles = MAX(ds->max_cycles, cycles);
+}
+
+int app_event_manager_dispatch_stats_get(const struct event_type *et,
+					 struct app_event_manager_dispatch_stats *stats)
+{
+	if ((et < _event_type_list_start) || (et >= _event_type_list_end) || !stats) {
+		return -EINVAL;
+	}
+
+	const struct dispatch_stats *ds = &dispatch_stats[et - _event_type_list_start];
+
+	stats->event_cnt = ds->event_cnt;
+	stats->max_cycles = ds->max_cycles;
+	stats->total_cycles = ds->total_cycles;
+	stats->dropped_cnt = atomic_get(&ds->dropped_cnt);
+
+	return 0;
+}
+
+void app_event_manager_dispatch_stats_reset(void)
+{
+	memset(dispatch_stats, 0, sizeof(dispatch_stats));
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS */
+
+static void event_process(struct app_event_header *aeh)
+{
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	const struct event_type *et = aeh->type_id;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+	uint32_t start_cycles = k_cycle_get_32();
+#endif
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	log_event(aeh);
+
+	bool consumed = false;
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
+
+		__ASSERT_NO_MSG(es != NULL);
+
+		const struct event_listener *el = es->listener;
+
+		__ASSERT_NO_MSG(el != NULL);
+		__ASSERT_NO_MSG(el->notification != NULL);
+
+		log_event_progress(et, el);
+
+		consumed = el->notification(aeh);
+
+		if (consumed) {
+			log_event_consumed(et);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+	dispatch_stats_update(et, k_cycle_get_32() - start_cycles);
+#endif
+
+	app_event_manager_free(aeh);
+}
+
+static void event_queue_drain(struct event_queue *q)
 {
 	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
 	/* Make current event list local. */
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (sys_slist_is_empty(&eventq)) {
+	if (sys_slist_is_empty(&q->events)) {
 		k_spin_unlock(&lock, key);
 		return;
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	sys_slist_merge_slist(&events, &q->events);
+	q->len = 0;
 
 	k_spin_unlock(&lock, key);
 
 	/* Traverse the list of events. */
 	sys_snode_t *node;
 	while (NULL != (node = sys_slist_get(&events))) {
-		struct app_event_header *aeh = CONTAINER_OF(node,
-						       struct app_event_header,
-						       node);
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
+	}
+}
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES)
+static sys_snode_t *event_queue_get(struct event_queue *q)
+{
+	sys_snode_t *node = sys_slist_get(&q->events);
 
-		const struct event_type *et = aeh->type_id;
+	if (node) {
+		q->len--;
+	}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+	return node;
+}
 
-		log_event(aeh);
+/* Must be called under the lock. */
+static sys_snode_t *prioritized_event_get(void)
+{
+	struct event_queue *high = &eventq[EVENT_QUEUE_HIGH];
+	struct event_queue *normal = &eventq[EVENT_QUEUE_NORMAL];
 
-		bool consumed = false;
+	if (normal->len == 0) {
+		starvation_cnt = 0;
+		return event_queue_get(high);
+	}
 
-		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
-		     es++) {
+	if ((high->len > 0) &&
+	    ((CONFIG_APP_EVENT_MANAGER_STARVATION_LIMIT == 0) ||
+	     (starvation_cnt < CONFIG_APP_EVENT_MANAGER_STARVATION_LIMIT))) {
+		starvation_cnt++;
+		return event_queue_get(high);
+	}
 
-			__ASSERT_NO_MSG(es != NULL);
+	starvation_cnt = 0;
+	return event_queue_get(normal);
+}
 
-			const struct event_listener *el = es->listener;
+static void prioritized_events_process(void)
+{
+	/* Process at most the events that are already queued. Every event
+	 * submitted in the meantime resubmits the work, so other work items
+	 * are not blocked by an event storm.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	size_t budget = eventq[EVENT_QUEUE_HIGH].len + eventq[EVENT_QUEUE_NORMAL].len;
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+	k_spin_unlock(&lock, key);
 
-			log_event_progress(et, el);
+	while (budget-- > 0) {
+		key = k_spin_lock(&lock);
+		sys_snode_t *node = prioritized_event_get();
 
-			consumed = el->notification(aeh);
+		k_spin_unlock(&lock, key);
 
-			if (consumed) {
-				log_event_consumed(et);
-			}
+		if (!node) {
+			break;
 		}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+		event_process(CONTAINER_OF(node, struct app_event_header, node));
+	}
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES */
 
-		app_event_manager_free(aeh);
+static void event_processor_fn(struct k_work *work)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES) && \
+	!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ)
+	prioritized_events_process();
+#else
+	event_queue_drain(&eventq[EVENT_QUEUE_NORMAL]);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ)
+static void high_prio_event_processor_fn(struct k_work *work)
+{
+	event_queue_drain(&eventq[EVENT_QUEUE_HIGH]);
+}
+#endif
+
+static size_t event_queue_idx(const struct event_type *et)
+{
+	if (app_event_get_type_flag(et, APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY)) {
+		return EVENT_QUEUE_HIGH;
+	}
+
+	return EVENT_QUEUE_NORMAL;
+}
+
+/* Event without subscribers that is not logged has no observable effect. */
+static bool event_is_unobserved(const struct event_type *et)
+{
+	if (et->subs_start != et->subs_stop) {
+		return false;
 	}
+
+	return !IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SHOW_EVENTS) || !log_is_event_displayed(et);
 }
 
 void _event_submit(struct app_event_header *aeh)
@@ -209,6 +403,16 @@ void _event_submit(struct app_event_header *aeh)
 	__ASSERT_NO_MSG(aeh);
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DROP_UNSUBSCRIBED_EVENTS) &&
+	    event_is_unobserved(aeh->type_id)) {
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+		atomic_inc(&dispatch_stats[aeh->type_id - _event_type_list_start].dropped_cnt);
+#endif
+		app_event_manager_free(aeh);
+		return;
+	}
+
+	size_t q = event_queue_idx(aeh->type_id);
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
@@ -216,9 +420,16 @@ void _event_submit(struct app_event_header *aeh)
 			h->hook(aeh);
 		}
 	}
-	sys_slist_append(&eventq, &aeh->node);
+	sys_slist_append(&eventq[q].events, &aeh->node);
+	eventq[q].len++;
 	k_spin_unlock(&lock, key);
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ)
+	if (q == EVENT_QUEUE_HIGH) {
+		k_work_submit_to_queue(&high_prio_workq, &high_prio_event_processor);
+		return;
+	}
+#endif
 	k_work_submit(&event_processor);
 }
 
@@ -231,6 +442,18 @@ int app_event_manager_init(void)
 
 	log_event_init();
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ)
+	k_work_queue_start(&high_prio_workq, high_prio_workq_stack,
+			   K_THREAD_STACK_SIZEOF(high_prio_workq_stack),
+			   CONFIG_APP_EVENT_MANAGER_HIGH_PRIORITY_WORKQ_PRIORITY, NULL);
+	k_thread_name_set(&high_prio_workq.thread, "aem_high_prio");
+
+	/* High priority events submitted before the work queue was started
+	 * are already in their queue, but could not be scheduled.
+	 */
+	k_work_submit_to_queue(&high_prio_workq, &high_prio_event_processor);
+#endif
+
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
 			ret = h->hook();
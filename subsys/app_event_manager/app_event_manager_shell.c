@@ -148,6 +148,76 @@ static int disable_event_displaying(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+static int show_dispatch_stats(const struct shell *shell, size_t argc,
+			       char **argv)
+{
+	struct app_event_manager_dispatch_stats stats;
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event dispatch statistics:\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		int err = app_event_manager_dispatch_stats_get(et, &stats);
+
+		if (err) {
+			return err;
+		}
+
+		shell_fprintf(shell,
+			      SHELL_NORMAL,
+			      "%s:\tcnt %u\tavg %u cyc\tmax %u cyc\tdropped %u\n",
+			      et->name,
+			      stats.event_cnt,
+			      (stats.event_cnt > 0) ?
+				(uint32_t)(stats.total_cycles / stats.event_cnt) : 0,
+			      stats.max_cycles,
+			      stats.dropped_cnt);
+	}
+
+	return 0;
+}
+
+static int reset_dispatch_stats(const struct shell *shell, size_t argc,
+				char **argv)
+{
+	app_event_manager_dispatch_stats_reset();
+	return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB)
+static int show_alloc_stats(const struct shell *shell, size_t argc,
+			    char **argv)
+{
+	struct app_event_manager_slab_stats stats;
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event slab allocator:\n");
+
+	for (size_t i = 0; i < app_event_manager_slab_class_cnt(); i++) {
+		int err = app_event_manager_slab_stats_get(i, &stats);
+
+		if (err) {
+			return err;
+		}
+
+		shell_fprintf(shell,
+			      SHELL_NORMAL,
+			      "%zu:\tblock %zu B\tused %u/%u\tmax %u\tfallback %u\n",
+			      i,
+			      stats.block_size,
+			      stats.used_cnt,
+			      stats.block_cnt,
+			      stats.max_used_cnt,
+			      stats.fallback_cnt);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Oversized events: %u\n",
+		      app_event_manager_slab_oversize_cnt());
+
+	return 0;
+}
+#endif
+
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_listeners, NULL, "Show listeners",
@@ -155,6 +225,16 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)
+	SHELL_CMD_ARG(show_dispatch_stats, NULL, "Show event dispatch statistics",
+		      show_dispatch_stats, 0, 0),
+	SHELL_CMD_ARG(reset_dispatch_stats, NULL, "Reset event dispatch statistics",
+		      reset_dispatch_stats, 0, 0),
+#endif
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB)
+	SHELL_CMD_ARG(show_alloc_stats, NULL, "Show event allocator statistics",
+		      show_alloc_stats, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <app_event_manager.h>
+#include <zephyr/logging/log.h>
+
+#include "app_event_manager_slab.h"
+
+LOG_MODULE_DECLARE(app_event_manager, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
+
+#define SLAB_CLASS_CNT		CONFIG_APP_EVENT_MANAGER_SLAB_CLASS_COUNT
+#define SLAB_BLOCK_CNT		CONFIG_APP_EVENT_MANAGER_SLAB_BLOCK_COUNT
+#define SLAB_BLOCK_SIZE(idx)	(CONFIG_APP_EVENT_MANAGER_SLAB_MIN_BLOCK_SIZE << (idx))
+#define SLAB_BLOCK_SIZE_MAX	SLAB_BLOCK_SIZE(SLAB_CLASS_CNT - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_APP_EVENT_MANAGER_SLAB_MIN_BLOCK_SIZE),
+	     "Minimal slab block size must be a power of two");
+BUILD_ASSERT(CONFIG_APP_EVENT_MANAGER_SLAB_MIN_BLOCK_SIZE >= sizeof(void *),
+	     "Slab block must be able to hold a pointer");
+
+struct slab_class {
+	struct k_mem_slab slab;
+	atomic_t used;
+	atomic_t max_used;
+	atomic_t fallback_cnt;
+};
+
+#define SLAB_BUF_DEFINE(idx, _)							\
+	static uint8_t _CONCAT(slab_buf_, idx)[SLAB_BLOCK_SIZE(idx) * SLAB_BLOCK_CNT]	\
+		__aligned(sizeof(void *))
+
+#define SLAB_BUF_PTR(idx, _) _CONCAT(slab_buf_, idx)
+
+LISTIFY(SLAB_CLASS_CNT, SLAB_BUF_DEFINE, (;));
+
+static uint8_t *const slab_bufs[SLAB_CLASS_CNT] = {
+	LISTIFY(SLAB_CLASS_CNT, SLAB_BUF_PTR, (,))
+};
+
+static struct slab_class slab_classes[SLAB_CLASS_CNT];
+static atomic_t oversize_fallback_cnt;
+
+
+static size_t size_to_class(size_t size)
+{
+	size_t idx = 0;
+
+	while ((idx < SLAB_CLASS_CNT) && (size > SLAB_BLOCK_SIZE(idx))) {
+		idx++;
+	}
+
+	return idx;
+}
+
+static void max_used_update(struct slab_class *sc, atomic_val_t used)
+{
+	atomic_val_t max_used = atomic_get(&sc->max_used);
+
+	while (used > max_used) {
+		if (atomic_cas(&sc->max_used, max_used, used)) {
+			break;
+		}
+		max_used = atomic_get(&sc->max_used);
+	}
+}
+
+static void *heap_fallback(size_t size)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SLAB_HEAP_FALLBACK)) {
+		return NULL;
+	}
+
+	return k_malloc(size);
+}
+
+void *app_event_manager_slab_alloc(size_t size)
+{
+	size_t idx = size_to_class(size);
+
+	if (idx >= SLAB_CLASS_CNT) {
+		atomic_inc(&oversize_fallback_cnt);
+		return heap_fallback(size);
+	}
+
+	struct slab_class *sc = &slab_classes[idx];
+	void *event;
+
+	if (k_mem_slab_alloc(&sc->slab, &event, K_NO_WAIT)) {
+		atomic_inc(&sc->fallback_cnt);
+		return heap_fallback(size);
+	}
+
+	max_used_update(sc, atomic_inc(&sc->used) + 1);
+
+	return event;
+}
+
+void app_event_manager_slab_free(void *addr)
+{
+	for (size_t idx = 0; idx < SLAB_CLASS_CNT; idx++) {
+		const uint8_t *buf = slab_bufs[idx];
+
+		if (((const uint8_t *)addr >= buf) &&
+		    ((const uint8_t *)addr < buf + SLAB_BLOCK_SIZE(idx) * SLAB_BLOCK_CNT)) {
+			struct slab_class *sc = &slab_classes[idx];
+
+			atomic_dec(&sc->used);
+			k_mem_slab_free(&sc->slab, addr);
+			return;
+		}
+	}
+
+	k_free(addr);
+}
+
+int app_event_manager_slab_stats_get(size_t class_idx,
+				     struct app_event_manager_slab_stats *stats)
+{
+	if ((class_idx >= SLAB_CLASS_CNT) || !stats) {
+		return -EINVAL;
+	}
+
+	const struct slab_class *sc = &slab_classes[class_idx];
+
+	stats->block_size = SLAB_BLOCK_SIZE(class_idx);
+	stats->block_cnt = SLAB_BLOCK_CNT;
+	stats->used_cnt = atomic_get(&sc->used);
+	stats->max_used_cnt = atomic_get(&sc->max_used);
+	stats->fallback_cnt = atomic_get(&sc->fallback_cnt);
+
+	return 0;
+}
+
+size_t app_event_manager_slab_class_cnt(void)
+{
+	return SLAB_CLASS_CNT;
+}
+
+uint32_t app_event_manager_slab_oversize_cnt(void)
+{
+	return atomic_get(&oversize_fallback_cnt);
+}
+
+static void event_type_sizes_check(void)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROVIDE_EVENT_SIZE)
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		if (et->struct_size > SLAB_BLOCK_SIZE_MAX) {
+			LOG_WRN("Event %s (%u bytes) exceeds the largest slab block (%u bytes)",
+				et->name, et->struct_size, SLAB_BLOCK_SIZE_MAX);
+		}
+	}
+#endif
+}
+
+static int app_event_manager_slab_init(void)
+{
+	for (size_t idx = 0; idx < SLAB_CLASS_CNT; idx++) {
+		int err = k_mem_slab_init(&slab_classes[idx].slab, slab_bufs[idx],
+					  SLAB_BLOCK_SIZE(idx), SLAB_BLOCK_CNT);
+
+		if (err) {
+			return err;
+		}
+	}
+
+	event_type_sizes_check();
+
+	return 0;
+}
+
+SYS_INIT(app_event_manager_slab_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
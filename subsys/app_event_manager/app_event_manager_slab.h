@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Application Event Manager slab allocator private header.
+ *
+ * Although these functions are globally visible they must not be used directly.
+ */
+
+#ifndef _APP_EVENT_MANAGER_SLAB_H_
+#define _APP_EVENT_MANAGER_SLAB_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Allocate event memory from the smallest size class that fits the requested size.
+ * Falls back to the system heap if enabled and no slab block is available.
+ */
+void *app_event_manager_slab_alloc(size_t size);
+
+/* Free event memory allocated by app_event_manager_slab_alloc. */
+void app_event_manager_slab_free(void *addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _APP_EVENT_MANAGER_SLAB_H_ */
@@ -126,6 +126,12 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 		return false;
 	}
 
+	if (IS_ENABLED(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR) && parameters->thread.stack == NULL &&
+	    parameters->thread.stack_size == 0) {
+		/* The module has no thread and runs in a graph executor. */
+		return true;
+	}
+
 	if (parameters->thread.stack == NULL || parameters->thread.stack_size == 0) {
 		return false;
 	}
@@ -133,31 +139,78 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 	return true;
 }
 
+/**
+ * @brief Get the number of buffers in a data slab.
+ *
+ * @param data_slab  [in]  Pointer to the data slab.
+ *
+ * @return The number of buffers, free or in use.
+ */
+static uint32_t data_slab_buffers_num(struct k_mem_slab *data_slab)
+{
+	return k_mem_slab_num_free_get(data_slab) + k_mem_slab_num_used_get(data_slab);
+}
+
+/**
+ * @brief Claim a free reference count slot for an output audio data item.
+ *
+ * @param handle  [in/out]  The handle of the sending modules instance.
+ * @param count   [in]      Number of consumers of the audio data.
+ *
+ * @return Pointer to the reference count, NULL if all slots are in use.
+ */
+static atomic_t *buf_ref_cnt_claim(struct audio_module_handle *handle, atomic_val_t count)
+{
+	for (int i = 0; i < ARRAY_SIZE(handle->buf_ref_cnt); i++) {
+		if (atomic_cas(&handle->buf_ref_cnt[i], 0, count)) {
+			return &handle->buf_ref_cnt[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Release a reference to an output audio data item.
+ *
+ * @param handle   [in/out]  The handle of the sending modules instance.
+ * @param ref_cnt  [in/out]  Pointer to the reference count of the audio data.
+ * @param data     [in]      Pointer to the audio data memory.
+ */
+static void buf_ref_cnt_release(struct audio_module_handle *handle, atomic_t *ref_cnt,
+				void const *const data)
+{
+	if (atomic_dec(ref_cnt) == 1) {
+		LOG_DBG("Audio data has been consumed in module %s", handle->name);
+
+		/* Audio data has been consumed by all modules so now can free the data memory. */
+		k_mem_slab_free(handle->thread.data_slab, (void *)data);
+	}
+}
+
 /**
  * @brief General callback for releasing the data when inter-module data
  *        passing.
  *
+ * @note The audio data is always the one held in the consumer's message, so the
+ *       reference count is found from the message.
+ *
  * @param handle      [in/out]  The handle of the sending modules instance.
  * @param audio_data  [in]      Pointer to the audio data to release.
  */
 static void audio_data_release_cb(struct audio_module_handle_private *handle,
 				  struct audio_data const *const audio_data)
 {
-	int ret;
 	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct audio_module_message const *msg =
+		CONTAINER_OF(audio_data, struct audio_module_message, audio_data);
 
-	ret = k_sem_take(&hdl->sem, K_NO_WAIT);
-	if (ret) {
-		LOG_ERR("Failed to take semaphore for data release callback function");
+	if (msg->ref_cnt == NULL) {
+		LOG_ERR("No reference count for audio data from module %s", hdl->name);
 		return;
 	}
 
-	if (k_sem_count_get(&hdl->sem) == 0) {
-		LOG_DBG("Audio data has been consumed in module %s", hdl->name);
-
-		/* Audio data has been consumed by all modules so now can free the data memory. */
-		k_mem_slab_free(hdl->thread.data_slab, (void *)audio_data->data);
-	}
+	buf_ref_cnt_release(hdl, msg->ref_cnt, audio_data->data);
 }
 
 /**
@@ -168,12 +221,14 @@ static void audio_data_release_cb(struct audio_module_handle_private *handle,
  * @param audio_data           [in]      Pointer to the audio data to send to the module.
  * @param data_in_response_cb  [in]      A pointer to a callback to run when the buffer is
  *                                       fully consumed.
+ * @param ref_cnt              [in]      Pointer to the reference count of the audio data,
+ *                                       NULL if not shared.
  *
  * @return 0 if successful, error otherwise.
  */
 static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_handle *rx_handle,
 		   struct audio_data const *const audio_data,
-		   audio_module_response_cb data_in_response_cb)
+		   audio_module_response_cb data_in_response_cb, atomic_t *ref_cnt)
 {
 	int ret;
 	struct audio_module_message *data_msg_rx;
@@ -190,6 +245,7 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 		memcpy(&(data_msg_rx->audio_data), audio_data, sizeof(struct audio_data));
 		data_msg_rx->tx_handle = tx_handle;
 		data_msg_rx->response_cb = data_in_response_cb;
+		data_msg_rx->ref_cnt = ref_cnt;
 
 		ret = data_fifo_block_lock(rx_handle->thread.msg_rx, (void **)&data_msg_rx,
 					   sizeof(struct audio_module_message));
@@ -217,11 +273,12 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
  *
  * @param handle      [in/out]  The handle for this modules instance.
  * @param audio_data  [in]      A pointer to the audio data.
+ * @param ref_cnt     [in]      Pointer to the reference count of the audio data.
  *
  * @return 0 if successful, error otherwise.
  */
 static int tx_fifo_put(struct audio_module_handle *handle,
-		       struct audio_data const *const audio_data)
+		       struct audio_data const *const audio_data, atomic_t *ref_cnt)
 {
 	int ret;
 	struct audio_module_message *data_msg_tx;
@@ -238,6 +295,7 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 	memcpy(&data_msg_tx->audio_data, audio_data, sizeof(struct audio_data));
 	data_msg_tx->tx_handle = handle;
 	data_msg_tx->response_cb = audio_data_release_cb;
+	data_msg_tx->ref_cnt = ref_cnt;
 
 	/* Send audio data to modules output message queue. */
 	ret = data_fifo_block_lock(handle->thread.msg_tx, (void **)&data_msg_tx,
@@ -248,11 +306,6 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 
 		data_fifo_block_free(handle->thread.msg_tx, (void *)data_msg_tx);
 
-		ret = k_sem_take(&handle->sem, K_NO_WAIT);
-		if (ret) {
-			LOG_ERR("Failed to take semaphore for TX FIFO put");
-		}
-
 		return ret;
 	}
 
@@ -264,6 +317,11 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 /**
  * @brief Send the audio data item to all connected modules.
  *
+ * @note The audio data is shared with all the destinations without copying. Each destination
+ *       releases its reference when it has consumed the audio data, and the last one frees it.
+ *       Hence a module can have several audio data items in flight, and no mutex is taken
+ *       on this path.
+ *
  * @param handle      [in/out]  The handle for this modules instance.
  * @param audio_data  [in]      A pointer to the audio data.
  *
@@ -273,9 +331,26 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 				     struct audio_data const *const audio_data)
 {
 	int ret;
+	int ret_tx = 0;
 	struct audio_module_handle *handle_to;
+	struct audio_module_handle *dests[CONFIG_AUDIO_MODULE_FAN_OUT_MAX];
+	uint8_t dest_num = 0;
+	bool use_tx_queue;
+	atomic_t *ref_cnt;
+	k_spinlock_key_t key;
+
+	/* Take a snapshot of the destinations, so connections can change while sending. */
+	key = k_spin_lock(&handle->dest_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
+		dests[dest_num++] = handle_to;
+	}
+
+	use_tx_queue = handle->use_tx_queue && handle->thread.msg_tx;
+
+	k_spin_unlock(&handle->dest_lock, key);
 
-	if (handle->dest_count == 0) {
+	if (dest_num == 0 && !use_tx_queue) {
 		LOG_WRN("Nowhere to send the audio data from module %s so releasing it",
 			handle->name);
 
@@ -284,63 +359,46 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 		return 0;
 	}
 
-	/* We need to ensure that all receiving modules have got the audio data.
-	 * This is so the first receiver cannot free the audio data before all receivers
-	 * have all gotten the audio data.
-	 */
-	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
-	if (ret) {
-		LOG_ERR("Failed to take MUTEX lock in time");
-		return ret;
-	}
+	/* All references must be taken before the first receiver can release the audio data. */
+	ref_cnt = buf_ref_cnt_claim(handle, dest_num + (use_tx_queue ? 1 : 0));
+	if (ref_cnt == NULL) {
+		LOG_ERR("Too many audio data items in flight from module %s, dropping",
+			handle->name);
 
-	/* Here the semaphore is used as a count of the number of audio data items out in the
-	 * connected modules.
-	 */
-	ret = k_sem_init(&handle->sem, handle->dest_count, handle->dest_count);
-	if (ret) {
-		LOG_ERR("Failed to initiate semaphore");
-		return ret;
+		k_mem_slab_free(handle->thread.data_slab, (void *)audio_data->data);
+
+		return -ENOMEM;
 	}
 
 	/* Send to all internally connected modules. */
-	SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
-		ret = data_tx(handle, handle_to, audio_data, &audio_data_release_cb);
+	for (int i = 0; i < dest_num; i++) {
+		ret = data_tx(handle, dests[i], audio_data, &audio_data_release_cb, ref_cnt);
 		if (ret) {
 			LOG_ERR("Failed to send audio data to module %s from %s, ret %d",
-				handle_to->name, handle->name, ret);
+				dests[i]->name, handle->name, ret);
 
-			return ret;
+			buf_ref_cnt_release(handle, ref_cnt, audio_data->data);
+			ret_tx = ret;
 		}
 	}
 
-	ret = k_mutex_unlock(&handle->dest_mutex);
-	if (ret) {
-		LOG_ERR("Failed to release MUTEX");
-		return ret;
-	}
-
 	/* Send to this module's TX FIFO for extraction by an external
 	 * process with audio_module_rx().
 	 */
-	if (handle->use_tx_queue && handle->thread.msg_tx) {
-		ret = tx_fifo_put(handle, audio_data);
+	if (use_tx_queue) {
+		ret = tx_fifo_put(handle, audio_data, ref_cnt);
 		if (ret) {
 			LOG_ERR("Failed to send audio data on module %s TX message queue",
 				handle->name);
 
-			ret = k_sem_take(&handle->sem, K_NO_WAIT);
-			if (ret) {
-				LOG_ERR("Failed to take semaphore");
-			}
-
+			buf_ref_cnt_release(handle, ref_cnt, audio_data->data);
 			return ret;
 		}
 
 		LOG_DBG("Sent audio data to TX message queue for module %s", handle->name);
 	}
 
-	return 0;
+	return ret_tx;
 }
 
 /**
@@ -561,6 +619,17 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 		return -ECANCELED;
 	}
 
+	/* Each output audio data item in flight holds a data buffer and a reference count, so
+	 * there must be a reference count for every data buffer.
+	 */
+	if (parameters->thread.data_slab != NULL &&
+	    data_slab_buffers_num(parameters->thread.data_slab) >
+		    CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT) {
+		LOG_ERR("Data slab for module %s has more than %d buffers", name,
+			CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT);
+		return -EINVAL;
+	}
+
 	/* Clear handle to known state. */
 	memset(handle, 0, sizeof(struct audio_module_handle));
 
@@ -639,6 +708,14 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 	sys_slist_init(&handle->handle_dest_list);
 	k_mutex_init(&handle->dest_mutex);
 
+	if (handle->thread.stack == NULL) {
+		LOG_DBG("Module %s has no thread, it can only run in a graph", handle->name);
+
+		handle->state = AUDIO_MODULE_STATE_CONFIGURED;
+
+		return 0;
+	}
+
 	handle->thread_id = k_thread_create(
 		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
 		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
@@ -676,6 +753,13 @@ int audio_module_close(struct audio_module_handle *handle)
 		return -ECANCELED;
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	if (handle->graph != NULL) {
+		LOG_ERR("Module %s is in a graph, close the graph first", handle->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 	if (handle->description->functions->close != NULL) {
 		ret = handle->description->functions->close(
 			(struct audio_module_handle_private *)handle);
@@ -698,7 +782,9 @@ int audio_module_close(struct audio_module_handle *handle)
 	 *       Test the semaphore and wait for it to be zero.
 	 */
 
-	k_thread_abort(handle->thread_id);
+	if (handle->thread_id != NULL) {
+		k_thread_abort(handle->thread_id);
+	}
 
 	/* Ensure module handle data is fully cleared. */
 	memset(handle, 0, sizeof(struct audio_module_handle));
@@ -777,6 +863,7 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 {
 	int ret;
 	struct audio_module_handle *handle;
+	k_spinlock_key_t key;
 
 	if (handle_from == handle_to) {
 		LOG_ERR("Module handles identical");
@@ -821,6 +908,13 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 		}
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	if (handle_from->graph != NULL) {
+		LOG_ERR("Module %s is in a graph, close the graph first", handle_from->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 	ret = k_mutex_lock(&handle_from->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
@@ -832,7 +926,10 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 	 * with a call to audio_module_data_rx() with the same handle.
 	 */
 	if (connect_external) {
+		key = k_spin_lock(&handle_from->dest_lock);
 		handle_from->use_tx_queue = true;
+		handle_from->dest_count++;
+		k_spin_unlock(&handle_from->dest_lock, key);
 
 		LOG_DBG("Return the output of %s on it's TX FIFO", handle_from->name);
 	} else {
@@ -840,18 +937,28 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 			if (handle_to == handle) {
 				LOG_WRN("Already attached %s to %s", handle_to->name,
 					handle_from->name);
+				k_mutex_unlock(&handle_from->dest_mutex);
 				return -EALREADY;
 			}
 		}
 
+		if (sys_slist_len(&handle_from->handle_dest_list) >=
+		    CONFIG_AUDIO_MODULE_FAN_OUT_MAX) {
+			LOG_ERR("Module %s has reached the maximum of %d connections",
+				handle_from->name, CONFIG_AUDIO_MODULE_FAN_OUT_MAX);
+			k_mutex_unlock(&handle_from->dest_mutex);
+			return -ENOMEM;
+		}
+
+		key = k_spin_lock(&handle_from->dest_lock);
 		sys_slist_append(&handle_from->handle_dest_list, &handle_to->node);
+		handle_from->dest_count++;
+		k_spin_unlock(&handle_from->dest_lock, key);
 
 		LOG_DBG("Connected the output of %s to the input of %s", handle_from->name,
 			handle_to->name);
 	}
 
-	handle_from->dest_count++;
-
 	ret = k_mutex_unlock(&handle_from->dest_mutex);
 	if (ret) {
 		LOG_ERR("Failed to release MUTEX lock");
@@ -867,6 +974,7 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 			    struct audio_module_handle *handle_disconnect, bool disconnect_external)
 {
 	int ret;
+	k_spinlock_key_t key;
 
 	if (handle == handle_disconnect) {
 		LOG_ERR("Module handles identical");
@@ -912,6 +1020,13 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 		}
 	}
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	if (handle->graph != NULL) {
+		LOG_ERR("Module %s is in a graph, close the graph first", handle->name);
+		return -EBUSY;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
@@ -923,14 +1038,27 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 	 * it.
 	 */
 	if (disconnect_external) {
+		key = k_spin_lock(&handle->dest_lock);
 		handle->use_tx_queue = false;
+		handle->dest_count--;
+		k_spin_unlock(&handle->dest_lock, key);
 
 		LOG_DBG("Stop returning the output of %s on it's TX FIFO", handle->name);
 	} else {
-		if (!sys_slist_find_and_remove(&handle->handle_dest_list,
-					       &handle_disconnect->node)) {
+		bool found;
+
+		key = k_spin_lock(&handle->dest_lock);
+		found = sys_slist_find_and_remove(&handle->handle_dest_list,
+						  &handle_disconnect->node);
+		if (found) {
+			handle->dest_count--;
+		}
+		k_spin_unlock(&handle->dest_lock, key);
+
+		if (!found) {
 			LOG_ERR("Connection to module %s has not been found for module %s",
 				handle_disconnect->name, handle->name);
+			k_mutex_unlock(&handle->dest_mutex);
 			return -EALREADY;
 		}
 
@@ -938,8 +1066,6 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 			handle->name);
 	}
 
-	handle->dest_count--;
-
 	ret = k_mutex_unlock(&handle->dest_mutex);
 	if (ret) {
 		LOG_ERR("Failed to release MUTEX lock");
@@ -949,6 +1075,30 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 	return 0;
 }
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+/* Event posted to the executor while the source module of the graph is running. */
+#define GRAPH_EVENT_RUNNING BIT(0)
+
+/**
+ * @brief Let the executor of the graph run or wait, if the module is the source of a graph.
+ *
+ * @param handle   [in]  The handle to the module instance.
+ * @param running  [in]  Whether the module is running.
+ */
+static void graph_source_running_set(struct audio_module_handle *handle, bool running)
+{
+	if (handle->graph == NULL || handle->graph->modules[0] != handle) {
+		return;
+	}
+
+	if (running) {
+		k_event_post(&handle->graph->run_event, GRAPH_EVENT_RUNNING);
+	} else {
+		k_event_clear(&handle->graph->run_event, GRAPH_EVENT_RUNNING);
+	}
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 int audio_module_start(struct audio_module_handle *handle)
 {
 	int ret;
@@ -980,6 +1130,10 @@ int audio_module_start(struct audio_module_handle *handle)
 
 	handle->state = AUDIO_MODULE_STATE_RUNNING;
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	graph_source_running_set(handle, true);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 	return 0;
 }
 
@@ -1014,6 +1168,10 @@ int audio_module_stop(struct audio_module_handle *handle)
 
 	handle->state = AUDIO_MODULE_STATE_STOPPED;
 
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+	graph_source_running_set(handle, false);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
 	return 0;
 }
 
@@ -1047,7 +1205,7 @@ int audio_module_data_tx(struct audio_module_handle *handle,
 		return -EINVAL;
 	}
 
-	return data_tx((void *)NULL, handle, audio_data, response_cb);
+	return data_tx((void *)NULL, handle, audio_data, response_cb, NULL);
 }
 
 int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *audio_data,
@@ -1158,7 +1316,7 @@ int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 		return -EINVAL;
 	}
 
-	ret = data_tx(NULL, handle_rx, audio_data_tx, NULL);
+	ret = data_tx(NULL, handle_rx, audio_data_tx, NULL, NULL);
 	if (ret) {
 		LOG_ERR("Failed to send audio data to module %s, ret %d", handle_tx->name, ret);
 		return ret;
@@ -1254,3 +1412,374 @@ int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_ch
 
 	return 0;
 }
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+/**
+ * @brief Add a processing time to a histogram.
+ *
+ * @param graph   [in/out]  Pointer to the graph.
+ * @param hist    [in/out]  Pointer to the histogram.
+ * @param cycles  [in]      The processing time in cycles.
+ */
+static void graph_latency_add(struct audio_module_graph *graph,
+			      struct audio_module_latency_hist *hist, uint32_t cycles)
+{
+	uint32_t time_us = k_cyc_to_us_floor32(cycles);
+	uint32_t bin = 0;
+	k_spinlock_key_t key;
+
+	if (time_us > 0) {
+		bin = MIN(31 - __builtin_clz(time_us), CONFIG_AUDIO_MODULE_GRAPH_LATENCY_BINS - 1);
+	}
+
+	key = k_spin_lock(&graph->hist_lock);
+
+	hist->bins[bin]++;
+	hist->count++;
+	hist->max_us = MAX(hist->max_us, time_us);
+	hist->total_us += time_us;
+
+	k_spin_unlock(&graph->hist_lock, key);
+}
+
+/**
+ * @brief Run a module of the graph on the output of the module it is connected from.
+ *
+ * @param graph          [in/out]  Pointer to the graph.
+ * @param idx            [in]      Index of the module in the graph.
+ * @param audio_data_rx  [in]      Pointer to the input audio data, NULL for an input module.
+ */
+static void graph_module_process(struct audio_module_graph *graph, uint8_t idx,
+				 struct audio_data const *const audio_data_rx)
+{
+	int ret;
+	uint32_t start;
+	struct audio_module_handle *handle = graph->modules[idx];
+	struct audio_data *audio_data_tx = NULL;
+
+	if (!state_running(handle->state)) {
+		return;
+	}
+
+	if (has_input_type(handle->description->type)) {
+		audio_data_tx = &graph->out[idx];
+
+		ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&audio_data_tx->data,
+				       K_NO_WAIT);
+		if (ret) {
+			LOG_WRN("No free data buffer for module %s, ret %d", handle->name, ret);
+			audio_data_tx->data = NULL;
+			return;
+		}
+
+		audio_data_tx->data_size = handle->thread.data_size;
+	}
+
+	start = k_cycle_get_32();
+
+	ret = handle->description->functions->data_process(
+		(struct audio_module_handle_private *)handle, audio_data_rx, audio_data_tx);
+
+	graph_latency_add(graph, &graph->module_hist[idx], k_cycle_get_32() - start);
+
+	if (ret) {
+		LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
+
+		if (audio_data_tx != NULL) {
+			k_mem_slab_free(handle->thread.data_slab, audio_data_tx->data);
+			audio_data_tx->data = NULL;
+		}
+
+		return;
+	}
+
+	if (audio_data_tx == NULL || !handle->use_tx_queue || handle->thread.msg_tx == NULL) {
+		return;
+	}
+
+	/* The output is kept by the graph until the end of the block and by the external
+	 * receiver on the TX FIFO.
+	 */
+	graph->out_ref_cnt[idx] = buf_ref_cnt_claim(handle, 2);
+	if (graph->out_ref_cnt[idx] == NULL) {
+		LOG_WRN("Too many audio data items in flight from module %s", handle->name);
+		return;
+	}
+
+	ret = tx_fifo_put(handle, audio_data_tx, graph->out_ref_cnt[idx]);
+	if (ret) {
+		buf_ref_cnt_release(handle, graph->out_ref_cnt[idx], audio_data_tx->data);
+	}
+}
+
+/**
+ * @brief Release the input and all the outputs of the block processed by the graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ */
+static void graph_block_release(struct audio_module_graph *graph)
+{
+	void *data;
+	atomic_t *ref_cnt;
+	struct audio_module_handle *handle;
+	struct audio_module_message *msg_rx = graph->msg_rx;
+
+	for (int i = 0; i < graph->module_num; i++) {
+		handle = graph->modules[i];
+		data = graph->out[i].data;
+		ref_cnt = graph->out_ref_cnt[i];
+
+		if (data == NULL) {
+			continue;
+		}
+
+		/* Clear before releasing, so a graph closed at any point never frees twice. */
+		graph->out[i].data = NULL;
+		graph->out_ref_cnt[i] = NULL;
+
+		if (ref_cnt != NULL) {
+			buf_ref_cnt_release(handle, ref_cnt, data);
+		} else {
+			k_mem_slab_free(handle->thread.data_slab, data);
+		}
+	}
+
+	if (msg_rx != NULL) {
+		graph->msg_rx = NULL;
+
+		if (msg_rx->response_cb != NULL) {
+			msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
+					    &msg_rx->audio_data);
+		}
+
+		data_fifo_block_free(graph->modules[0]->thread.msg_rx, (void *)msg_rx);
+	}
+}
+
+/**
+ * @brief The executor thread, that processes each block through all the modules of the graph.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ */
+static void graph_thread(struct audio_module_graph *graph, void *p2, void *p3)
+{
+	int ret;
+	size_t size;
+	uint32_t start;
+	struct audio_module_handle *source = graph->modules[0];
+	struct audio_data const *audio_data_rx = NULL;
+
+	while (1) {
+		if (source->thread.msg_rx != NULL) {
+			ret = data_fifo_pointer_last_filled_get(
+				source->thread.msg_rx, (void **)&graph->msg_rx, &size, K_FOREVER);
+			__ASSERT(ret == 0, "Graph of %s error in getting last filled %d",
+				 source->name, ret);
+
+			audio_data_rx = &graph->msg_rx->audio_data;
+		} else {
+			/* An input module has nothing to wait on while it is not running. */
+			k_event_wait(&graph->run_event, GRAPH_EVENT_RUNNING, false, K_FOREVER);
+		}
+
+		/* An input module waits for its data in the processing, so the time through the
+		 * graph is counted from when the source has got a new audio data item.
+		 */
+		start = k_cycle_get_32();
+
+		graph_module_process(graph, 0, audio_data_rx);
+
+		if (audio_data_rx == NULL) {
+			start = k_cycle_get_32();
+		}
+
+		for (int i = 1; i < graph->module_num; i++) {
+			struct audio_data const *in = &graph->out[graph->parent[i]];
+
+			/* Nothing to do if the module this is connected from had no output. */
+			if (in->data == NULL) {
+				continue;
+			}
+
+			graph_module_process(graph, i, in);
+		}
+
+		graph_block_release(graph);
+
+		graph_latency_add(graph, &graph->graph_hist, k_cycle_get_32() - start);
+	}
+
+	CODE_UNREACHABLE;
+}
+
+int audio_module_graph_open(struct audio_module_graph *graph, struct audio_module_handle *source,
+			    k_thread_stack_t *stack, size_t stack_size, int priority)
+{
+	int ret;
+	struct audio_module_handle *handle;
+	struct audio_module_handle *handle_to;
+	k_spinlock_key_t key;
+
+	if (graph == NULL || source == NULL || stack == NULL || stack_size == 0) {
+		LOG_ERR("Invalid parameter for the graph open function");
+		return -EINVAL;
+	}
+
+	if (!state_not_undefined(source->state)) {
+		LOG_ERR("Module %s in an invalid state, %d, for a graph", source->name,
+			source->state);
+		return -ECANCELED;
+	}
+
+	if (has_output_type(source->description->type) && source->thread.msg_rx == NULL) {
+		LOG_ERR("Module %s has no RX FIFO to be a graph source", source->name);
+		return -EINVAL;
+	}
+
+	memset(graph, 0, sizeof(struct audio_module_graph));
+
+	graph->modules[0] = source;
+	graph->module_num = 1;
+
+	/* Each module is only connected from one other module, so visiting the connections in
+	 * breadth first order gives every module after the one it gets its input from.
+	 */
+	for (int i = 0; i < graph->module_num; i++) {
+		handle = graph->modules[i];
+
+		if (handle->thread_id != NULL) {
+			LOG_ERR("Module %s has its own thread", handle->name);
+			return -EINVAL;
+		}
+
+		if (handle->graph != NULL) {
+			LOG_ERR("Module %s is already in a graph", handle->name);
+			return -EBUSY;
+		}
+
+		if (has_input_type(handle->description->type) && handle->thread.data_slab == NULL) {
+			LOG_ERR("Module %s has no data slab", handle->name);
+			return -EINVAL;
+		}
+
+		key = k_spin_lock(&handle->dest_lock);
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
+			if (graph->module_num == CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX) {
+				k_spin_unlock(&handle->dest_lock, key);
+
+				LOG_ERR("More than %d modules in the graph",
+					CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX);
+				return -ENOMEM;
+			}
+
+			graph->modules[graph->module_num] = handle_to;
+			graph->parent[graph->module_num] = i;
+			graph->module_num++;
+		}
+
+		k_spin_unlock(&handle->dest_lock, key);
+	}
+
+	for (int i = 0; i < graph->module_num; i++) {
+		graph->modules[i]->graph = graph;
+	}
+
+	k_event_init(&graph->run_event);
+
+	if (state_running(source->state)) {
+		k_event_post(&graph->run_event, GRAPH_EVENT_RUNNING);
+	}
+
+	graph->thread_id = k_thread_create(&graph->thread_data, stack, stack_size,
+					   (k_thread_entry_t)graph_thread, (void *)graph, NULL,
+					   NULL, K_PRIO_PREEMPT(priority), 0, K_FOREVER);
+
+	ret = k_thread_name_set(graph->thread_id, source->name);
+	if (ret) {
+		LOG_WRN("Failed to name the graph thread, ret %d", ret);
+	}
+
+	k_thread_start(graph->thread_id);
+
+	LOG_DBG("Graph of %d modules from %s started", graph->module_num, source->name);
+
+	return 0;
+}
+
+int audio_module_graph_close(struct audio_module_graph *graph)
+{
+	if (graph == NULL || graph->thread_id == NULL) {
+		LOG_ERR("Graph is NULL or not open");
+		return -EINVAL;
+	}
+
+	k_thread_abort(graph->thread_id);
+	graph->thread_id = NULL;
+
+	k_event_clear(&graph->run_event, GRAPH_EVENT_RUNNING);
+
+	/* Return whatever was being processed when the executor was stopped. */
+	graph_block_release(graph);
+
+	for (int i = 0; i < graph->module_num; i++) {
+		graph->modules[i]->graph = NULL;
+	}
+
+	graph->module_num = 0;
+
+	return 0;
+}
+
+int audio_module_graph_latency_get(struct audio_module_graph *graph,
+				   struct audio_module_handle const *const handle,
+				   struct audio_module_latency_hist *hist)
+{
+	struct audio_module_latency_hist *src = NULL;
+	k_spinlock_key_t key;
+
+	if (graph == NULL || hist == NULL) {
+		LOG_ERR("Input parameter is NULL");
+		return -EINVAL;
+	}
+
+	if (handle == NULL) {
+		src = &graph->graph_hist;
+	} else {
+		for (int i = 0; i < graph->module_num; i++) {
+			if (graph->modules[i] == handle) {
+				src = &graph->module_hist[i];
+				break;
+			}
+		}
+	}
+
+	if (src == NULL) {
+		LOG_WRN("Module %s is not in the graph", handle->name);
+		return -ENOENT;
+	}
+
+	key = k_spin_lock(&graph->hist_lock);
+	memcpy(hist, src, sizeof(struct audio_module_latency_hist));
+	k_spin_unlock(&graph->hist_lock, key);
+
+	return 0;
+}
+
+int audio_module_graph_latency_reset(struct audio_module_graph *graph)
+{
+	k_spinlock_key_t key;
+
+	if (graph == NULL) {
+		LOG_ERR("Graph is NULL");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&graph->hist_lock);
+	memset(graph->module_hist, 0, sizeof(graph->module_hist));
+	memset(&graph->graph_hist, 0, sizeof(graph->graph_hist));
+	k_spin_unlock(&graph->hist_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
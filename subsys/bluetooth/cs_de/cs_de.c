@@ -12,6 +12,7 @@
 #include <zephyr/bluetooth/hci_types.h>
 #include <zephyr/logging/log.h>
 #include <dsp/transform_functions.h>
+#include <dsp/complex_math_functions.h>
 #include <dsp/fast_math_functions.h>
 #include <dsp/statistics_functions.h>
 #include <arm_const_structs.h>
@@ -32,7 +33,44 @@ LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
 #define NORMAL_PEAK_TO_NULL                                                                        \
 	((CONFIG_BT_CS_DE_NFFT_SIZE + CS_DE_NUM_CHANNELS - 1) / (CS_DE_NUM_CHANNELS))
 
+/* The peaks and nulls of the IFFT are searched on its power, the magnitude squared,
+ * so that the magnitude of each bin does not need a square root.
+ */
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+typedef float ifft_pow_t;
+
 static float m_iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+#else
+typedef uint32_t ifft_pow_t;
+
+#if defined(CONFIG_BT_CS_DE_IFFT_Q31)
+typedef q31_t ifft_sample_t;
+#define IFFT_SAMPLE_MAX INT32_MAX
+#else
+typedef q15_t ifft_sample_t;
+#define IFFT_SAMPLE_MAX INT16_MAX
+#endif
+
+BUILD_ASSERT(sizeof(ifft_sample_t) <= sizeof(float),
+	     "The IFFT must fit in the float buffer passed to cs_de_ifft()");
+
+/* The combined IQ values are kept in float for the phase slope estimate. */
+static float m_iq_scratch_mem[2 * CS_DE_NUM_CHANNELS];
+static ifft_sample_t m_ifft_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+
+static float ifft_fixed(const float iq_tones_comb[2 * CS_DE_NUM_CHANNELS],
+			ifft_sample_t samples[2 * CONFIG_BT_CS_DE_NFFT_SIZE]);
+#endif
+
+/* Compare ratios of powers, a * num > b * den, without overflow. */
+static inline bool pow_ratio_gt(ifft_pow_t a, uint32_t num, ifft_pow_t b, uint32_t den)
+{
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+	return a * num > b * den;
+#else
+	return (uint64_t)a * num > (uint64_t)b * den;
+#endif
+}
 
 static cs_de_quality_t set_best_estimate(cs_de_dist_estimates_t *p_estimates_public)
 {
@@ -90,7 +128,12 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
 
 		p_report->distance_estimates[ap].phase_slope = cs_de_phase_slope(m_iq_scratch_mem);
 
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
 		p_report->distance_estimates[ap].ifft = cs_de_ifft(m_iq_scratch_mem);
+#else
+		p_report->distance_estimates[ap].ifft =
+			ifft_fixed(m_iq_scratch_mem, m_ifft_scratch_mem);
+#endif
 
 		if (set_best_estimate(&p_report->distance_estimates[ap]) == CS_DE_QUALITY_OK) {
 			estimation_quality = CS_DE_QUALITY_OK;
@@ -136,18 +179,19 @@ float cs_de_phase_slope(float iq_tones_comb[CS_DE_NUM_CHANNELS * 2])
 }
 
 static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
-						   const float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+						   const ifft_pow_t ifft_pow[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
-	/* Peak interpolation */
-	float prompt = ifft_mag[peak_index];
+	/* Peak interpolation, on the magnitudes of the three bins around the peak */
+	float prompt = sqrtf(ifft_pow[peak_index]);
 
 	/* Find early and late magnitudes, if peak_index is at either first or last point in the
 	 * IFFT, wrap around since the IFFT is periodic.
 	 */
-	float early = (peak_index != 0) ? ifft_mag[peak_index - 1]
-					: ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE - 1];
-	float late = (peak_index != (CONFIG_BT_CS_DE_NFFT_SIZE - 1)) ? ifft_mag[peak_index + 1]
-								     : ifft_mag[0];
+	float early = sqrtf((peak_index != 0) ? ifft_pow[peak_index - 1]
+					      : ifft_pow[CONFIG_BT_CS_DE_NFFT_SIZE - 1]);
+	float late = sqrtf((peak_index != (CONFIG_BT_CS_DE_NFFT_SIZE - 1))
+				   ? ifft_pow[peak_index + 1]
+				   : ifft_pow[0]);
 	/* Avoid interpolation of early, prompt and late if left null compensation has taken place.
 	 */
 	float t_hat = (prompt >= early && prompt >= late)
@@ -164,7 +208,7 @@ static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
 }
 
 static int32_t calculate_ifft_find_left_null(int32_t peak_index,
-					     float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+					     const ifft_pow_t ifft_pow[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	int32_t left_null_index = peak_index;
 	bool found_left_null = false;
@@ -172,10 +216,13 @@ static int32_t calculate_ifft_find_left_null(int32_t peak_index,
 	while (!found_left_null) {
 		int32_t next_left_null_index =
 			left_null_index == 0 ? CONFIG_BT_CS_DE_NFFT_SIZE - 1 : left_null_index - 1;
-		/* This is a heuristic, probably non-optimal definition of a null. */
-		if ((ifft_mag[left_null_index] * 2 > ifft_mag[peak_index] ||
-		     ifft_mag[left_null_index] > 1.10f * ifft_mag[next_left_null_index]) &&
-		    ifft_mag[left_null_index] * 10 > ifft_mag[peak_index] &&
+		/* This is a heuristic, probably non-optimal definition of a null.
+		 * On magnitudes, it reads mag * 2 > peak or mag > 1.10 * next, and mag * 10 > peak.
+		 */
+		if ((pow_ratio_gt(ifft_pow[left_null_index], 4, ifft_pow[peak_index], 1) ||
+		     pow_ratio_gt(ifft_pow[left_null_index], 100,
+				  ifft_pow[next_left_null_index], 121)) &&
+		    pow_ratio_gt(ifft_pow[left_null_index], 100, ifft_pow[peak_index], 1) &&
 		    next_left_null_index != peak_index) {
 			left_null_index = next_left_null_index--;
 		} else {
@@ -192,11 +239,11 @@ static uint32_t calculate_distance_to_left_null(uint32_t peak_index, uint32_t le
 		       : (peak_index - left_null_index);
 }
 
-static int32_t calculate_left_null_compensation_of_peak(int32_t peak_index,
-							float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+static int32_t calculate_left_null_compensation_of_peak(
+	int32_t peak_index, const ifft_pow_t ifft_pow[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	int32_t compensated_peak_index = peak_index;
-	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_mag);
+	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_pow);
 	uint32_t peak_to_null_distance =
 		calculate_distance_to_left_null(peak_index, left_null_index);
 	if (peak_to_null_distance > NORMAL_PEAK_TO_NULL) {
@@ -213,9 +260,10 @@ static int32_t calculate_left_null_compensation_of_peak(int32_t peak_index,
 	return compensated_peak_index;
 }
 
-static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+static void calculate_ifft_pow(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
-	/* This function calculates the magnitude of the IFFT of the input IQ values.
+	/* This function calculates the power of the IFFT of the input IQ values.
 	 * Note that the result is written back to the input array.
 	 * Also note that the input array is a complex array of size CONFIG_BT_CS_DE_NFFT_SIZE
 	 * Odd indexes contain the real part and even indexes contain the imaginary part.
@@ -225,8 +273,10 @@ static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE
 	 *  1. Complex conjugate the input.
 	 *  2. Perform the FFT.
 	 *  3. Complex conjugate the output.
-	 * Since we are interested in the magnitude of the IFFT, we can skip step 3.
-	 * and directly calculate the magnitude of the output of step 2.
+	 * Since we are interested in the power of the IFFT, we can skip step 3.
+	 * and directly calculate the power of the output of step 2.
+	 * The 1/CONFIG_BT_CS_DE_NFFT_SIZE scaling of the IFFT is skipped too, because only
+	 * ratios of powers are used.
 	 */
 
 	/* Complex conjugate the input. */
@@ -245,46 +295,124 @@ static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE
 	#error
 	#endif
 
-	/* Compute the magnitude of complex values in
+	/* Compute the power of complex values in
 	 * iq_tones_comb[0:2*CONFIG_BT_CS_DE_NFFT_SIZE - 1]
-	 * and scale by 1/CONFIG_BT_CS_DE_NFFT_SIZE.
 	 * Store output in iq_tones_comb[0:CONFIG_BT_CS_DE_NFFT_SIZE - 1]
 	 */
+	arm_cmplx_mag_squared_f32(iq_tones_comb, iq_tones_comb, CONFIG_BT_CS_DE_NFFT_SIZE);
+}
+#else
+static void ifft_input_convert(const float iq_tones_comb[2 * CS_DE_NUM_CHANNELS],
+			       ifft_sample_t samples[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+{
+	/* Scale the combined IQ values to the full range of the fixed-point samples.
+	 * The samples may be stored over the input, each sample is written after its
+	 * input value is read.
+	 */
+	float max_abs = 0.0f;
+	float scale;
+
+	for (uint32_t i = 0; i < 2 * CS_DE_NUM_CHANNELS; i++) {
+		max_abs = fmaxf(max_abs, fabsf(iq_tones_comb[i]));
+	}
+
+	/* Keep a margin, so that rounding cannot overflow the samples. */
+	scale = (max_abs > 0.0f) ? (IFFT_SAMPLE_MAX * 0.99f) / max_abs : 0.0f;
+
+	for (uint32_t i = 0; i < 2 * CS_DE_NUM_CHANNELS; i++) {
+		samples[i] = (ifft_sample_t)lrintf(iq_tones_comb[i] * scale);
+	}
+
+	memset(&samples[2 * CS_DE_NUM_CHANNELS], 0,
+	       (2 * CONFIG_BT_CS_DE_NFFT_SIZE - 2 * CS_DE_NUM_CHANNELS) * sizeof(ifft_sample_t));
+}
+
+static void calculate_ifft_pow(ifft_sample_t samples[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+{
+	/* This function calculates the power of the IFFT of the samples.
+	 * Note that the result is written back to the samples, as ifft_pow_t values.
+	 *
+	 * The fixed-point transforms of CMSIS-DSP compute the inverse directly, and scale
+	 * the output down by CONFIG_BT_CS_DE_NFFT_SIZE to avoid overflow.
+	 */
+	ifft_pow_t *ifft_pow = (ifft_pow_t *)samples;
+
+#if defined(CONFIG_BT_CS_DE_IFFT_Q31)
+	#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
+		arm_cfft_q31(&arm_cfft_sR_q31_len512, samples, 1, 1);
+	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
+		arm_cfft_q31(&arm_cfft_sR_q31_len1024, samples, 1, 1);
+	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
+		arm_cfft_q31(&arm_cfft_sR_q31_len2048, samples, 1, 1);
+	#else
+	#error
+	#endif
+
+	/* The power of each bin, in 3.29 format, is never negative. */
+	arm_cmplx_mag_squared_q31(samples, (q31_t *)ifft_pow, CONFIG_BT_CS_DE_NFFT_SIZE);
+#else
+	#if CONFIG_BT_CS_DE_NFFT_SIZE == 512
+		arm_cfft_q15(&arm_cfft_sR_q15_len512, samples, 1, 1);
+	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 1024
+		arm_cfft_q15(&arm_cfft_sR_q15_len1024, samples, 1, 1);
+	#elif CONFIG_BT_CS_DE_NFFT_SIZE == 2048
+		arm_cfft_q15(&arm_cfft_sR_q15_len2048, samples, 1, 1);
+	#else
+	#error
+	#endif
+
+	/* The full 32-bit products are kept, as the q15 output of
+	 * arm_cmplx_mag_squared_q15() is too coarse to find the nulls.
+	 * Each power is stored over the sample pair it is computed from.
+	 */
 	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
-		float realIn = iq_tones_comb[2 * n] / CONFIG_BT_CS_DE_NFFT_SIZE;
-		float imagIn = iq_tones_comb[(2 * n) + 1] / CONFIG_BT_CS_DE_NFFT_SIZE;
+		int32_t re = samples[2 * n];
+		int32_t im = samples[(2 * n) + 1];
 
-		arm_sqrt_f32((realIn * realIn) + (imagIn * imagIn), &iq_tones_comb[n]);
+		ifft_pow[n] = (uint32_t)(re * re) + (uint32_t)(im * im);
 	}
+#endif
 }
+#endif /* CONFIG_BT_CS_DE_IFFT_FLOAT */
 
-static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static uint32_t find_ifft_peak_index(const ifft_pow_t ifft_pow[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
-	/* This function tries to find the peak index of the input IFFT magnitude.
+	/* This function tries to find the peak index of the input IFFT power.
 	 *
 	 * The function uses the following approach:
 	 *  1. Find the index of the strongest peak,
-	 *     corresponding to the maximum value in the IFFT magnitude.
+	 *     corresponding to the maximum value in the IFFT power.
 	 *  2. Search for strong peaks closer than the max peak.
 	 *  3. When applicable: Compensate peak based on left null location.
 	 */
-	uint32_t ifft_mag_max_index;
-	float ifft_mag_max;
-
-	arm_max_f32(ifft_mag, CONFIG_BT_CS_DE_NFFT_SIZE, &ifft_mag_max, &ifft_mag_max_index);
+	uint32_t ifft_pow_max_index = 0;
+	ifft_pow_t ifft_pow_max;
+
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+	arm_max_f32(ifft_pow, CONFIG_BT_CS_DE_NFFT_SIZE, &ifft_pow_max, &ifft_pow_max_index);
+#else
+	ifft_pow_max = ifft_pow[0];
+
+	for (uint32_t n = 1; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
+		if (ifft_pow[n] > ifft_pow_max) {
+			ifft_pow_max = ifft_pow[n];
+			ifft_pow_max_index = n;
+		}
+	}
+#endif
 
 	/* Search for strong peaks closer than the max value. */
 	uint32_t nw = CONFIG_BT_CS_DE_NFFT_SIZE - 2;
 	uint32_t nw_next = CONFIG_BT_CS_DE_NFFT_SIZE - 1;
-	uint32_t max_search_index = ifft_mag_max_index;
+	uint32_t max_search_index = ifft_pow_max_index;
 	bool short_path_found = false;
 	bool first_rise_found = false;
-	uint32_t shortest_path_idx = ifft_mag_max_index;
+	uint32_t shortest_path_idx = ifft_pow_max_index;
 
 	while (nw != max_search_index && !short_path_found) {
-		if (ifft_mag[nw_next] < ifft_mag[nw]) {
-			/* Peak found */
-			if (2.5f * ifft_mag[nw] > ifft_mag_max && first_rise_found) {
+		if (ifft_pow[nw_next] < ifft_pow[nw]) {
+			/* Peak found, with a magnitude of at least 1/2.5 of the max */
+			if (pow_ratio_gt(ifft_pow[nw], 25, ifft_pow_max, 4) && first_rise_found) {
 				/* New peak found */
 				shortest_path_idx = nw;
 				short_path_found = true;
@@ -300,29 +428,50 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 
 	if (compensated_peak_index < CONFIG_BT_CS_DE_NFFT_SIZE - 2) {
 		compensated_peak_index =
-			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_mag);
+			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_pow);
 	}
 
 	return compensated_peak_index;
 }
 
+#if !defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+static float ifft_fixed(const float iq_tones_comb[2 * CS_DE_NUM_CHANNELS],
+			ifft_sample_t samples[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+{
+	ifft_input_convert(iq_tones_comb, samples);
+	calculate_ifft_pow(samples);
+
+	/* The samples are overwritten with the IFFT power. */
+	const ifft_pow_t *ifft_pow = (const ifft_pow_t *)samples;
+
+	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_pow);
+
+	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_pow);
+}
+#endif
+
 float cs_de_ifft(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	/* This function calculates a distance estimate
-	 * based on the IFFT magnitude of the input IQ values
+	 * based on the IFFT power of the input IQ values
 	 *
 	 * To do this the function uses the following steps:
-	 *  1. Calculate the IFFT magnitude of the input IQ values.
-	 *  2. Find index of the peak in the IFFT magnitude which is believed
+	 *  1. Calculate the IFFT power of the input IQ values.
+	 *  2. Find index of the peak in the IFFT power which is believed
 	 *     to correspond to the path with the shortest propagattion time.
 	 *  3. Convert the peak index to a distance estimate.
 	 */
-	calculate_ifft_mag(iq_tones_comb);
+#if defined(CONFIG_BT_CS_DE_IFFT_FLOAT)
+	calculate_ifft_pow(iq_tones_comb);
 
-	/* The input IQ values are overwritten with the IFFT magnitude. */
-	float *ifft_mag = iq_tones_comb;
+	/* The input IQ values are overwritten with the IFFT power. */
+	float *ifft_pow = iq_tones_comb;
 
-	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_mag);
+	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_pow);
 
-	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_mag);
+	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_pow);
+#else
+	/* The fixed-point samples are stored in the input buffer. */
+	return ifft_fixed(iq_tones_comb, (ifft_sample_t *)iq_tones_comb);
+#endif
 }
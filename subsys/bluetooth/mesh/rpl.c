@@ -18,13 +18,109 @@ LOG_MODULE_REGISTER(bt_mesh_rpl);
 #include <mesh/rpl.h>
 #include <emds/emds.h>
 
+/* Open addressing index with linear probing, at most half full */
+#define INDEX_BITS (LOG2CEIL(CONFIG_BT_MESH_CRPL) + 1)
+#define INDEX_SIZE BIT(INDEX_BITS)
+#define INDEX_MASK (INDEX_SIZE - 1)
+
+BUILD_ASSERT(INDEX_BITS <= 16, "The index is hashed from 16-bit addresses");
+
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 
 EMDS_STATIC_ENTRY_DEFINE(rpl_store, CONFIG_BT_MESH_RPL_INDEX, replay_list, sizeof(replay_list));
 
+/* The used entries of the replay list are always at its start. The index maps
+ * source addresses to their entry, and is kept in RAM only. It is built from
+ * the replay list on first use, after EMDS has restored the list.
+ */
+static uint16_t rpl_index[INDEX_SIZE];
+static uint16_t rpl_count;
+static bool index_valid;
+
+static uint16_t index_hash(uint16_t src)
+{
+	/* Fibonacci hashing, taking the upper bits of the product */
+	return (uint16_t)(src * 40503U) >> (16 - INDEX_BITS);
+}
+
+/* Index slot holding the address, or the empty slot where it would be added */
+static uint16_t index_slot(uint16_t src)
+{
+	uint16_t slot = index_hash(src) & INDEX_MASK;
+
+	while (rpl_index[slot] && replay_list[rpl_index[slot] - 1].src != src) {
+		slot = (slot + 1) & INDEX_MASK;
+	}
+
+	return slot;
+}
+
+static void index_remove(uint16_t src)
+{
+	uint16_t hole = index_slot(src);
+	uint16_t slot = hole;
+
+	if (!rpl_index[hole]) {
+		return;
+	}
+
+	/* Move back the following entries of the probe sequence that can no longer
+	 * be reached across the hole.
+	 */
+	for (;;) {
+		uint16_t home;
+
+		slot = (slot + 1) & INDEX_MASK;
+		if (!rpl_index[slot]) {
+			break;
+		}
+
+		home = index_hash(replay_list[rpl_index[slot] - 1].src) & INDEX_MASK;
+		if (((slot - home) & INDEX_MASK) >= ((slot - hole) & INDEX_MASK)) {
+			rpl_index[hole] = rpl_index[slot];
+			hole = slot;
+		}
+	}
+
+	rpl_index[hole] = 0;
+}
+
+static void index_build(void)
+{
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+
+	for (rpl_count = 0; rpl_count < ARRAY_SIZE(replay_list); rpl_count++) {
+		if (!replay_list[rpl_count].src) {
+			break;
+		}
+
+		rpl_index[index_slot(replay_list[rpl_count].src)] = rpl_count + 1;
+	}
+
+	index_valid = true;
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
+	uint16_t entry = rpl - replay_list;
+
+	if (rpl->src != rx->ctx.addr) {
+		/* An entry handed out as empty may have been taken by another
+		 * address in the meantime.
+		 */
+		if (rpl->src) {
+			index_remove(rpl->src);
+		}
+
+		rpl->src = rx->ctx.addr;
+		rpl_index[index_slot(rpl->src)] = entry + 1;
+
+		if (entry >= rpl_count) {
+			rpl_count = entry + 1;
+		}
+	}
+
 	/* If this is the first message on the new IV index, we should reset it
 	 * to zero to avoid invalid combinations of IV index and seg.
 	 */
@@ -32,7 +128,6 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 }
@@ -45,7 +140,8 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match, bool bridge)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
+	uint16_t entry;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -57,11 +153,22 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	if (!index_valid) {
+		index_build();
+	}
+
+	entry = rpl_index[index_slot(rx->ctx.addr)];
+
+	/* Existing entry for given address */
+	if (entry) {
+		rpl = &replay_list[entry - 1];
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
+
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -71,25 +178,20 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			return false;
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+		return true;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* First empty entry */
+	if (rpl_count < ARRAY_SIZE(replay_list)) {
+		rpl = &replay_list[rpl_count];
 
-				return false;
-			} else {
-				return true;
-			}
+		if (match) {
+			*match = rpl;
+		} else {
+			bt_mesh_rpl_update(rpl, rx);
 		}
+
+		return false;
 	}
 
 	LOG_ERR("RPL is full!");
@@ -99,6 +201,9 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 void bt_mesh_rpl_clear(void)
 {
 	(void)memset(replay_list, 0, sizeof(replay_list));
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+	rpl_count = 0;
+	index_valid = true;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -130,6 +235,9 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	/* The remaining entries have moved */
+	index_build();
 }
 
 void bt_mesh_rpl_pending_store(uint16_t addr)
@@ -18,6 +18,9 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
 
+/* Number of slots of the hash index of an address array, at most half full. */
+#define ADDR_INDEX_SIZE(cnt) BIT(LOG2CEIL(MAX(cnt, 1)) + 1)
+
 /* Scan filter mutex. */
 K_MUTEX_DEFINE(scan_mutex);
 
@@ -89,6 +92,9 @@ struct bt_scan_addr_filter {
 	/* Addresses advertised by the peripherals. */
 	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
 
+	/* Hash index of the addresses. */
+	uint16_t index[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_ADDRESS_CNT)];
+
 	/* Address filter counter. */
 	uint8_t cnt;
 
@@ -194,6 +200,14 @@ struct bt_scan_filters {
 	 * matched to generate an event.
 	 */
 	bool all_mode;
+
+	/* Number of enabled filters, updated when the filters are
+	 * enabled or disabled.
+	 */
+	uint8_t enabled_cnt;
+
+	/* Indicates whether any filter on the advertising data is enabled. */
+	bool ad_enabled;
 };
 
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
@@ -211,6 +225,9 @@ struct conn_attempts_filter {
 	/* Array of the filtered devices. */
 	struct conn_attempts_device device[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
 
+	/* Hash index of the device addresses. */
+	uint16_t index[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN)];
+
 	/* The oldest device index. */
 	uint32_t oldest_idx;
 
@@ -225,6 +242,9 @@ struct conn_blocklist {
 	/* Array of the blocklist devices. */
 	bt_addr_le_t addr[CONFIG_BT_SCAN_BLOCKLIST_LEN];
 
+	/* Hash index of the blocklist devices. */
+	uint16_t index[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_BLOCKLIST_LEN)];
+
 	/* Blocklist device count. */
 	uint32_t count;
 };
@@ -263,6 +283,7 @@ static struct bt_scan {
 	 * the device as connectable if its address is in this cache.
 	 */
 	bt_addr_le_t connectable_cache[CONFIG_BT_SCAN_CONNECTABLE_CACHE_SIZE];
+	uint16_t connectable_cache_index[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_CONNECTABLE_CACHE_SIZE)];
 	uint8_t connectable_cache_idx;
 	uint8_t connectable_cache_count;
 
@@ -340,24 +361,123 @@ static void notify_connecting_error(struct bt_scan_device_info *device_info)
 }
 #endif /* CONFIG_BT_CENTRAL */
 
-#if CONFIG_BT_SCAN_BLOCKLIST
-static bool blocklist_device_check(const bt_addr_le_t *addr)
+/* Arrays holding addresses are indexed by open addressing hash tables with
+ * linear probing. A slot holds the array position of an address plus one,
+ * or zero if it is empty.
+ */
+struct addr_set {
+	/* Address of the first array element. */
+	const bt_addr_le_t *addr;
+
+	/* Distance between the addresses of consecutive elements. */
+	size_t stride;
+
+	/* Hash index, with a power of two number of slots. */
+	uint16_t *index;
+	size_t size;
+};
+
+#define ADDR_SET_INIT(_array, _member, _index)                                     \
+	{                                                                          \
+		.addr = &(_array)[0]_member,                                       \
+		.stride = sizeof((_array)[0]),                                     \
+		.index = (_index),                                                 \
+		.size = ARRAY_SIZE(_index),                                        \
+	}
+
+static const bt_addr_le_t *addr_set_get(const struct addr_set *set, size_t pos)
 {
-	bool blocklist_device = false;
+	return (const bt_addr_le_t *)((const uint8_t *)set->addr + pos * set->stride);
+}
 
-	k_mutex_lock(&scan_mutex, K_FOREVER);
+static size_t addr_hash(const struct addr_set *set, const bt_addr_le_t *addr)
+{
+	uint32_t h = sys_get_le32(&addr->a.val[0]) ^
+		     (sys_get_le16(&addr->a.val[4]) << 8) ^ addr->type;
 
-	for (size_t i = 0; i < bt_scan.blocklist.count; i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			blocklist_device = true;
+	/* Fibonacci hashing, the upper bits are used. */
+	return ((h * 0x9E3779B1U) >> 16) & (set->size - 1);
+}
 
-			break;
+/* Find the slot holding the address, or the empty slot where it belongs. */
+static size_t addr_set_slot(const struct addr_set *set, const bt_addr_le_t *addr)
+{
+	size_t slot = addr_hash(set, addr);
+
+	while (set->index[slot] &&
+	       !bt_addr_le_eq(addr_set_get(set, set->index[slot] - 1), addr)) {
+		slot = (slot + 1) & (set->size - 1);
+	}
+
+	return slot;
+}
+
+/* Returns the array position of the address, or a negative value. */
+static int addr_set_find(const struct addr_set *set, const bt_addr_le_t *addr)
+{
+	return (int)set->index[addr_set_slot(set, addr)] - 1;
+}
+
+/* Index the address stored at the given array position. */
+static void addr_set_add(const struct addr_set *set, size_t pos)
+{
+	set->index[addr_set_slot(set, addr_set_get(set, pos))] = pos + 1;
+}
+
+/* Remove the address stored at the given array position from the index,
+ * before the position is overwritten.
+ */
+static void addr_set_remove(const struct addr_set *set, size_t pos)
+{
+	size_t mask = set->size - 1;
+	size_t hole = addr_hash(set, addr_set_get(set, pos));
+	size_t slot;
+
+	while (set->index[hole] != pos + 1) {
+		if (!set->index[hole]) {
+			return;
 		}
+
+		hole = (hole + 1) & mask;
 	}
 
-	k_mutex_unlock(&scan_mutex);
+	/* Move back the following entries that can no longer be reached
+	 * across the hole.
+	 */
+	for (slot = (hole + 1) & mask; set->index[slot]; slot = (slot + 1) & mask) {
+		size_t home = addr_hash(set, addr_set_get(set, set->index[slot] - 1));
 
-	return blocklist_device;
+		if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+			set->index[hole] = set->index[slot];
+			hole = slot;
+		}
+	}
+
+	set->index[hole] = 0;
+}
+
+static const struct addr_set addr_filter_set =
+	ADDR_SET_INIT(bt_scan.scan_filters.addr.target_addr, ,
+		      bt_scan.scan_filters.addr.index);
+
+static const struct addr_set connectable_cache_set =
+	ADDR_SET_INIT(bt_scan.connectable_cache, , bt_scan.connectable_cache_index);
+
+#if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
+static const struct addr_set attempts_set =
+	ADDR_SET_INIT(bt_scan.attempts_filter.device, .addr,
+		      bt_scan.attempts_filter.index);
+#endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
+
+#if CONFIG_BT_SCAN_BLOCKLIST
+static const struct addr_set blocklist_set =
+	ADDR_SET_INIT(bt_scan.blocklist.addr, , bt_scan.blocklist.index);
+#endif /* CONFIG_BT_SCAN_BLOCKLIST */
+
+#if CONFIG_BT_SCAN_BLOCKLIST
+static bool blocklist_device_check(const bt_addr_le_t *addr)
+{
+	return addr_set_find(&blocklist_set, addr) >= 0;
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
@@ -366,8 +486,10 @@ static void attempts_filter_force_add(struct conn_attempts_filter *filter,
 				      const bt_addr_le_t *addr)
 {
 	/* Overwrite the oldest device */
+	addr_set_remove(&attempts_set, filter->oldest_idx);
 	filter->device[filter->oldest_idx].attempts = 0;
 	bt_addr_le_copy(&filter->device[filter->oldest_idx].addr, addr);
+	addr_set_add(&attempts_set, filter->oldest_idx);
 
 	if (filter->oldest_idx == (ARRAY_SIZE(filter->device) - 1)) {
 		filter->oldest_idx = 0;
@@ -388,14 +510,9 @@ static void scan_attempts_filter_device_add(const bt_addr_le_t *addr)
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if device is already in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			LOG_DBG("Device %s is already in the filter array",
-				addr_str);
-			goto out;
-		}
+	if (addr_set_find(&attempts_set, addr) >= 0) {
+		LOG_DBG("Device %s is already in the filter array", addr_str);
+		goto out;
 	}
 
 	if (filter->count >= ARRAY_SIZE(filter->device)) {
@@ -403,6 +520,7 @@ static void scan_attempts_filter_device_add(const bt_addr_le_t *addr)
 		attempts_filter_force_add(filter, addr);
 	} else {
 		bt_addr_le_copy(&filter->device[filter->count].addr, addr);
+		addr_set_add(&attempts_set, filter->count);
 		filter->count++;
 	}
 
@@ -414,19 +532,14 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 {
 	const bt_addr_le_t *addr = bt_conn_get_dst(conn);
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+	int pos;
 
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				device->attempts++;
-			}
-
-			break;
-		}
+	pos = addr_set_find(&attempts_set, addr);
+	if ((pos >= 0) &&
+	    (filter->device[pos].attempts < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT)) {
+		filter->device[pos].attempts++;
 	}
 
 	k_mutex_unlock(&scan_mutex);
@@ -435,50 +548,52 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
-	char addr_str[BT_ADDR_LE_STR_LEN];
-	bool attempts_exceeded = false;
-
-	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+	int pos = addr_set_find(&attempts_set, addr);
 
-	k_mutex_lock(&scan_mutex, K_FOREVER);
+	if ((pos < 0) ||
+	    (filter->device[pos].attempts < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT)) {
+		return false;
+	}
 
-	/* Check if the device is in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
+	if (IS_ENABLED(CONFIG_BT_SCAN_LOG_LEVEL_DBG)) {
+		char addr_str[BT_ADDR_LE_STR_LEN];
 
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				LOG_DBG("Connection attempts count for %s exceeded",
-					addr_str);
-				attempts_exceeded = true;
-			}
-
-			break;
-		}
+		bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+		LOG_DBG("Connection attempts count for %s exceeded", addr_str);
 	}
 
-	k_mutex_unlock(&scan_mutex);
-
-	return attempts_exceeded;
+	return true;
 }
 
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
 static bool scan_device_filter_check(const bt_addr_le_t *addr)
 {
+	bool allowed = true;
+
+	if (!IS_ENABLED(CONFIG_BT_SCAN_BLOCKLIST) &&
+	    !IS_ENABLED(CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER)) {
+		return true;
+	}
+
+	/* Both lists are checked under one lock. */
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
 #if CONFIG_BT_SCAN_BLOCKLIST
 	if (blocklist_device_check(addr)) {
-		return false;
+		allowed = false;
 	}
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
-	if (conn_attempts_exceeded(addr)) {
-		return false;
+	if (allowed && conn_attempts_exceeded(addr)) {
+		allowed = false;
 	}
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
-	return true;
+	k_mutex_unlock(&scan_mutex);
+
+	return allowed;
 }
 
 #if CONFIG_BT_CENTRAL
@@ -522,19 +637,15 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 			     struct bt_scan_control *control)
 {
-	const bt_addr_le_t *addr =
-			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	int pos = addr_set_find(&addr_filter_set, target_addr);
 
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
-			control->filter_status.addr.addr = &addr[i];
-
-			return true;
-		}
+	if (pos < 0) {
+		return false;
 	}
 
-	return false;
+	control->filter_status.addr.addr = &bt_scan.scan_filters.addr.target_addr[pos];
+
+	return true;
 }
 
 static bool is_addr_filter_enabled(void)
@@ -569,14 +680,13 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 	}
 
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr_filter[i]) == 0) {
-			return 0;
-		}
+	if (addr_set_find(&addr_filter_set, target_addr) >= 0) {
+		return 0;
 	}
 
 	/* Add target address to filter. */
 	bt_addr_le_copy(&addr_filter[counter], target_addr);
+	addr_set_add(&addr_filter_set, counter);
 
 	LOG_DBG("Filter set on address type %i",
 		addr_filter[counter].type);
@@ -777,6 +887,25 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
+static bool uuid_raw_eq(const uint8_t *data, uint8_t uuid_type,
+			const struct bt_scan_uuid *target_uuid)
+{
+	switch (uuid_type) {
+	case BT_UUID_TYPE_16:
+		return sys_get_le16(data) == target_uuid->uuid_data.uuid_16.val;
+
+	case BT_UUID_TYPE_32:
+		return sys_get_le32(data) == target_uuid->uuid_data.uuid_32.val;
+
+	case BT_UUID_TYPE_128:
+		return memcmp(data, target_uuid->uuid_data.uuid_128.val,
+			      BT_SCAN_UUID_128_SIZE) == 0;
+
+	default:
+		return false;
+	}
+}
+
 static bool find_uuid(const uint8_t *data,
 		      uint8_t data_len,
 		      uint8_t uuid_type,
@@ -801,9 +930,18 @@ static bool find_uuid(const uint8_t *data,
 		return false;
 	}
 
-	for (size_t i = 0; i < data_len; i += uuid_len) {
+	for (size_t i = 0; i + uuid_len <= data_len; i += uuid_len) {
 		struct bt_uuid_128 uuid;
 
+		/* UUIDs of the same size are compared in their advertised form. */
+		if (target_uuid->uuid->type == uuid_type) {
+			if (uuid_raw_eq(&data[i], uuid_type, target_uuid)) {
+				return true;
+			}
+
+			continue;
+		}
+
 		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
 			return false;
 		}
@@ -1242,6 +1380,7 @@ void bt_scan_filter_remove_all(void)
 	struct bt_scan_addr_filter *addr_filter =
 			&bt_scan.scan_filters.addr;
 	addr_filter->cnt = 0;
+	memset(addr_filter->index, 0, sizeof(addr_filter->index));
 
 	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
@@ -1258,6 +1397,24 @@ void bt_scan_filter_remove_all(void)
 	k_mutex_unlock(&scan_mutex);
 }
 
+static void enabled_filters_update(void)
+{
+	struct bt_scan_filters *filters = &bt_scan.scan_filters;
+
+	filters->ad_enabled = is_name_filter_enabled() ||
+			      is_short_name_filter_enabled() ||
+			      is_uuid_filter_enabled() ||
+			      is_appearance_filter_enabled() ||
+			      is_manufacturer_data_filter_enabled();
+
+	filters->enabled_cnt = is_addr_filter_enabled() +
+			       is_name_filter_enabled() +
+			       is_short_name_filter_enabled() +
+			       is_uuid_filter_enabled() +
+			       is_appearance_filter_enabled() +
+			       is_manufacturer_data_filter_enabled();
+}
+
 void bt_scan_filter_disable(void)
 {
 	/* Disable all filters. */
@@ -1267,6 +1424,8 @@ void bt_scan_filter_disable(void)
 	bt_scan.scan_filters.uuid.enabled = false;
 	bt_scan.scan_filters.appearance.enabled = false;
 	bt_scan.scan_filters.manufacturer_data.enabled = false;
+
+	enabled_filters_update();
 }
 
 int bt_scan_filter_enable(uint8_t mode, bool match_all)
@@ -1309,6 +1468,8 @@ int bt_scan_filter_enable(uint8_t mode, bool match_all)
 	/* Select the filter mode. */
 	filters->all_mode = match_all;
 
+	enabled_filters_update();
+
 	return 0;
 }
 
@@ -1392,35 +1553,6 @@ void bt_scan_update_init_conn_params(struct bt_le_conn_param *new_conn_param)
 	bt_scan.conn_param = *new_conn_param;
 }
 
-static void check_enabled_filters(struct bt_scan_control *control)
-{
-	control->filter_cnt = 0;
-
-	if (is_addr_filter_enabled()) {
-		control->filter_cnt++;
-	}
-
-	if (is_name_filter_enabled()) {
-		control->filter_cnt++;
-	}
-
-	if (is_short_name_filter_enabled()) {
-		control->filter_cnt++;
-	}
-
-	if (is_uuid_filter_enabled()) {
-		control->filter_cnt++;
-	}
-
-	if (is_appearance_filter_enabled()) {
-		control->filter_cnt++;
-	}
-
-	if (is_manufacturer_data_filter_enabled()) {
-		control->filter_cnt++;
-	}
-}
-
 static bool adv_data_found(struct bt_data *data, void *user_data)
 {
 	struct bt_scan_control *scan_control =
@@ -1507,7 +1639,17 @@ static void filter_state_check(struct bt_scan_control *control,
 
 static void connectable_cache_add(const bt_addr_le_t *addr)
 {
+	/* Connectable advertisers repeat their packets, keep one entry each. */
+	if (addr_set_find(&connectable_cache_set, addr) >= 0) {
+		return;
+	}
+
+	if (bt_scan.connectable_cache_count == CONFIG_BT_SCAN_CONNECTABLE_CACHE_SIZE) {
+		addr_set_remove(&connectable_cache_set, bt_scan.connectable_cache_idx);
+	}
+
 	bt_addr_le_copy(&bt_scan.connectable_cache[bt_scan.connectable_cache_idx], addr);
+	addr_set_add(&connectable_cache_set, bt_scan.connectable_cache_idx);
 	bt_scan.connectable_cache_idx =
 		(bt_scan.connectable_cache_idx + 1) % CONFIG_BT_SCAN_CONNECTABLE_CACHE_SIZE;
 	if (bt_scan.connectable_cache_count < CONFIG_BT_SCAN_CONNECTABLE_CACHE_SIZE) {
@@ -1517,12 +1659,7 @@ static void connectable_cache_add(const bt_addr_le_t *addr)
 
 static bool connectable_cache_contains(const bt_addr_le_t *addr)
 {
-	for (size_t i = 0; i < bt_scan.connectable_cache_count; i++) {
-		if (bt_addr_le_cmp(&bt_scan.connectable_cache[i], addr) == 0) {
-			return true;
-		}
-	}
-	return false;
+	return addr_set_find(&connectable_cache_set, addr) >= 0;
 }
 
 static void scan_recv(const struct bt_le_scan_recv_info *info,
@@ -1535,7 +1672,7 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 
 	scan_control.all_mode = bt_scan.scan_filters.all_mode;
 
-	check_enabled_filters(&scan_control);
+	scan_control.filter_cnt = bt_scan.scan_filters.enabled_cnt;
 
 	/* Check if device is connectable. */
 	scan_control.connectable = (info->adv_props & BT_GAP_ADV_PROP_CONNECTABLE) != 0;
@@ -1556,10 +1693,13 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 
 	/* Save advertising buffer state to transfer it
 	 * data to application if futher processing is needed.
+	 * All advertising data filters are checked in one pass.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (bt_scan.scan_filters.ad_enabled) {
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+	}
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
@@ -1633,13 +1773,10 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if the device is already on the blocklist. */
-	for (size_t i = 0; i < ARRAY_SIZE(bt_scan.blocklist.addr); i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			LOG_DBG("Device %s is already on the blocklist",
-				addr_str);
+	if (addr_set_find(&blocklist_set, addr) >= 0) {
+		LOG_DBG("Device %s is already on the blocklist", addr_str);
 
-			goto out;
-		}
+		goto out;
 	}
 
 	if (bt_scan.blocklist.count >= ARRAY_SIZE(bt_scan.blocklist.addr)) {
@@ -1648,6 +1785,7 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 	} else {
 		bt_addr_le_copy(&bt_scan.blocklist.addr[bt_scan.blocklist.count],
 				addr);
+		addr_set_add(&blocklist_set, bt_scan.blocklist.count);
 		bt_scan.blocklist.count++;
 		LOG_INF("Device %s added to the scanning blocklist", addr_str);
 	}
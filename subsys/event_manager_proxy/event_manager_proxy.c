@@ -16,6 +16,12 @@ LOG_MODULE_REGISTER(event_manager_proxy, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
 #define EMP_BIND_TIMEOUT K_MSEC(CONFIG_EVENT_MANAGER_PROXY_BIND_TIMEOUT_MS)
 
+#if IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)
+#define EMP_BATCH_FLUSH_TIMEOUT K_USEC(CONFIG_EVENT_MANAGER_PROXY_BATCH_FLUSH_TIMEOUT_US)
+#define EMP_BATCH_BUF_LEN \
+	DIV_ROUND_UP(CONFIG_EVENT_MANAGER_PROXY_BATCH_MAX_SIZE, sizeof(uint32_t))
+#endif
+
 /* Helpers - allow linker to get information about these structure sizes. */
 static struct event_type _emp_event_type_size_check
 	__used __attribute__((__section__("event_manager_proxy_event_type_size")));
@@ -51,14 +57,52 @@ struct emp_cmd_subscribe {
 	char name[];
 };
 
+/** @brief Features announced by the proxy in the start command. */
+enum emp_feature {
+	/** The proxy unpacks batched events. */
+	EMP_FEATURE_BATCH_RX = BIT(0),
+	/** The proxy batches events if the remote unpacks them. */
+	EMP_FEATURE_BATCH_TX = BIT(1),
+};
+
+/**
+ * @brief The command structure used to start.
+ *
+ * Earlier versions of the proxy send only the code and ignore the features of
+ * the received command. A remote that sends only the code has no features.
+ */
+struct emp_cmd_start {
+	enum emp_cmd_code code;
+	uint32_t features;
+};
+
+/**
+ * @brief The record of a single event in a batched frame.
+ *
+ * Records are placed one after another in the frame.
+ * Every record is padded to a multiple of 4 bytes.
+ */
+struct emp_batch_record {
+	uint32_t len;
+	uint32_t data[];
+};
+
 /** @brief Inter-core communication data. */
 struct emp_ipc_data {
 	struct ipc_ept ept;
 	struct ipc_ept_cfg ept_cfg;
 	bool used;
 	bool started;
+	bool remote_batching;
+	bool batch_to_remote;
 	struct k_event bound;
 	const struct event_type **event_type_map;
+#if IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)
+	struct k_mutex batch_mutex;
+	struct k_work_delayable batch_flush_work;
+	size_t batch_len;
+	uint32_t batch_buf[EMP_BATCH_BUF_LEN];
+#endif
 };
 
 
@@ -159,6 +203,34 @@ static void handle_remote_event(struct emp_ipc_data *ipc, const void *data, size
 	_event_submit(event);
 }
 
+static void handle_remote_batch(struct emp_ipc_data *ipc, const void *data, size_t len)
+{
+	const uint8_t *pos = data;
+
+	while (len > 0) {
+		const struct emp_batch_record *record = (const struct emp_batch_record *)pos;
+		size_t record_size;
+
+		if (len < sizeof(*record)) {
+			LOG_ERR("Truncated batch record: %zu", len);
+			__ASSERT_NO_MSG(false);
+			return;
+		}
+
+		record_size = sizeof(*record) + ROUND_UP(record->len, sizeof(uint32_t));
+		if ((record_size > len) || (record->len < sizeof(struct app_event_header))) {
+			LOG_ERR("Unexpected batch record size: %u", record->len);
+			__ASSERT_NO_MSG(false);
+			return;
+		}
+
+		handle_remote_event(ipc, record->data, record->len);
+
+		pos += record_size;
+		len -= record_size;
+	}
+}
+
 static void handle_remote_command_subscribe(struct emp_ipc_data *ipc, const void *data, size_t len)
 {
 	if (ipc->started) {
@@ -197,6 +269,12 @@ static void handle_remote_command_start(struct emp_ipc_data *ipc, const void *da
 		return;
 	}
 
+	const struct emp_cmd_start *cmd = data;
+	uint32_t features = (len >= sizeof(*cmd)) ? cmd->features : 0;
+
+	ipc->remote_batching = (features & EMP_FEATURE_BATCH_TX) != 0;
+	ipc->batch_to_remote = IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING) &&
+			       ((features & EMP_FEATURE_BATCH_RX) != 0);
 	ipc->started = true;
 
 	LOG_DBG("Event transmission on ipc %d started", ipc2idx(ipc));
@@ -256,7 +334,11 @@ static void handle_ipc_data_receive(const void *data, size_t len, void *priv)
 	__ASSERT_NO_MSG(!k_is_in_isr());
 
 	if (ipc->started && emp_started) {
-		handle_remote_event(ipc, data, len);
+		if (ipc->remote_batching) {
+			handle_remote_batch(ipc, data, len);
+		} else {
+			handle_remote_event(ipc, data, len);
+		}
 	} else {
 		handle_remote_command(ipc, data, len);
 	}
@@ -274,24 +356,12 @@ static void handle_ipc_endpoint_error(const char *message, void *priv)
 	__ASSERT_NO_MSG(false);
 }
 
-static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh)
+static int ipc_send(struct emp_ipc_data *ipc, const void *data, size_t len)
 {
-	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
 	int ret;
 
-	if (remote_ev == NULL) {
-		return 0;
-	}
-
-	size_t size = app_event_manager_event_size(eh);
-	uint32_t buffer[DIV_ROUND_UP(size, sizeof(uint32_t))];
-	struct app_event_header *remote_eh = (struct app_event_header *)buffer;
-
-	memcpy(buffer, eh, sizeof(buffer));
-	remote_eh->type_id = remote_ev;
-
 	for (size_t cnt = CONFIG_EVENT_MANAGER_PROXY_SEND_RETRIES + 1; cnt > 0; --cnt) {
-		ret = ipc_service_send(&ipc->ept, buffer, sizeof(buffer));
+		ret = ipc_service_send(&ipc->ept, data, len);
 		if (ret >= 0) {
 			break;
 		}
@@ -306,6 +376,119 @@ static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event
 	return ret;
 }
 
+#if IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)
+/* Must be called with the batch mutex locked. */
+static int batch_flush(struct emp_ipc_data *ipc)
+{
+	int ret = 0;
+
+	if (ipc->batch_len > 0) {
+		ret = ipc_send(ipc, ipc->batch_buf, ipc->batch_len);
+		ipc->batch_len = 0;
+	}
+
+	return ret;
+}
+
+static void batch_flush_work_fn(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct emp_ipc_data *ipc = CONTAINER_OF(dwork, struct emp_ipc_data, batch_flush_work);
+
+	k_mutex_lock(&ipc->batch_mutex, K_FOREVER);
+	(void)batch_flush(ipc);
+	k_mutex_unlock(&ipc->batch_mutex);
+}
+
+static void batch_record_fill(struct emp_batch_record *record, const struct app_event_header *eh,
+			      const struct event_type *remote_ev, size_t size)
+{
+	record->len = size;
+	memcpy(record->data, eh, size);
+	((struct app_event_header *)record->data)->type_id = remote_ev;
+}
+
+/* Must be called with the batch mutex locked. */
+static int batch_event_append(struct emp_ipc_data *ipc, const struct app_event_header *eh,
+			      const struct event_type *remote_ev, size_t size)
+{
+	size_t record_size = sizeof(struct emp_batch_record) + ROUND_UP(size, sizeof(uint32_t));
+
+	if (record_size > sizeof(ipc->batch_buf)) {
+		/* Event does not fit into a frame, send it in a dedicated one. */
+		uint32_t buffer[record_size / sizeof(uint32_t)];
+		int ret = batch_flush(ipc);
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		batch_record_fill((struct emp_batch_record *)buffer, eh, remote_ev, size);
+
+		return ipc_send(ipc, buffer, sizeof(buffer));
+	}
+
+	if (ipc->batch_len + record_size > sizeof(ipc->batch_buf)) {
+		int ret = batch_flush(ipc);
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	batch_record_fill((struct emp_batch_record *)((uint8_t *)ipc->batch_buf + ipc->batch_len),
+			  eh, remote_ev, size);
+	ipc->batch_len += record_size;
+
+	if (ipc->batch_len + sizeof(struct emp_batch_record) >= sizeof(ipc->batch_buf)) {
+		/* No space left for another record. */
+		return batch_flush(ipc);
+	}
+
+	/* Deadline is counted from the first event in the frame. */
+	(void)k_work_schedule(&ipc->batch_flush_work, EMP_BATCH_FLUSH_TIMEOUT);
+
+	return 0;
+}
+
+static int send_event_batched(struct emp_ipc_data *ipc, const struct app_event_header *eh,
+			      const struct event_type *remote_ev, size_t size)
+{
+	k_mutex_lock(&ipc->batch_mutex, K_FOREVER);
+
+	int ret = batch_event_append(ipc, eh, remote_ev, size);
+
+	k_mutex_unlock(&ipc->batch_mutex);
+
+	return ret;
+}
+#endif /* CONFIG_EVENT_MANAGER_PROXY_BATCHING */
+
+static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh)
+{
+	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
+
+	if (remote_ev == NULL) {
+		return 0;
+	}
+
+	size_t size = app_event_manager_event_size(eh);
+
+#if IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)
+	if (ipc->batch_to_remote) {
+		return send_event_batched(ipc, eh, remote_ev, size);
+	}
+#endif
+
+	uint32_t buffer[DIV_ROUND_UP(size, sizeof(uint32_t))];
+	struct app_event_header *remote_eh = (struct app_event_header *)buffer;
+
+	memcpy(buffer, eh, sizeof(buffer));
+	remote_eh->type_id = remote_ev;
+
+	return ipc_send(ipc, buffer, sizeof(buffer));
+}
+
 static void event_manager_proxy_on_event_process(const struct app_event_header *eh)
 {
 	int ret = 0;
@@ -336,6 +519,8 @@ static int add_ipc_instace(struct emp_ipc_data *ipc, const struct device *instan
 	}
 
 	ipc->started = false;
+	ipc->remote_batching = false;
+	ipc->batch_to_remote = false;
 	ipc->ept_cfg = (struct ipc_ept_cfg) {
 		.name = "event_manager_proxy",
 		.cb = {
@@ -356,6 +541,12 @@ static int add_ipc_instace(struct emp_ipc_data *ipc, const struct device *instan
 
 	k_event_init(&ipc->bound);
 
+#if IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)
+	k_mutex_init(&ipc->batch_mutex);
+	k_work_init_delayable(&ipc->batch_flush_work, batch_flush_work_fn);
+	ipc->batch_len = 0;
+#endif
+
 	ret = ipc_service_register_endpoint(instance, &ipc->ept, &ipc->ept_cfg);
 	if (ret) {
 		LOG_ERR("Error registering endpoint in ipc service (%d)", ret);
@@ -428,7 +619,12 @@ int event_manager_proxy_subscribe(const struct device *instance,
 
 static int send_start_command_to_remote(struct emp_ipc_data *ipc)
 {
-	const struct emp_cmd cmd = {.code = EMP_CMD_START};
+	const struct emp_cmd_start cmd = {
+		.code = EMP_CMD_START,
+		.features = EMP_FEATURE_BATCH_RX |
+			    (IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING) ?
+			     EMP_FEATURE_BATCH_TX : 0)
+	};
 
 	__ASSERT_NO_MSG(ipc);
 
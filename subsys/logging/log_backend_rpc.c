@@ -11,6 +11,7 @@
  */
 
 #include "log_rpc_group.h"
+#include "log_rpc_batch.h"
 #include "log_backend_rpc_history.h"
 
 #include <logging/log_rpc.h>
@@ -28,6 +29,8 @@
 #include <zephyr/logging/log_output.h>
 #include <zephyr/drivers/coredump.h>
 #include <zephyr/random/random.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/cbprintf.h>
 
 #include <string.h>
 
@@ -120,6 +123,17 @@ static K_THREAD_STACK_DEFINE(history_transfer_workq_stack,
 static struct k_work_q history_transfer_workq;
 #endif
 
+/* Bit set for each of the first log sources whose messages are not streamed */
+static ATOMIC_DEFINE(filtered_out_sources, CONFIG_LOG_BACKEND_RPC_SOURCE_FILTER_CACHE_SIZE);
+
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+static void batch_flush_task(struct k_work *work);
+static K_MUTEX_DEFINE(batch_mtx);
+static K_WORK_DELAYABLE_DEFINE(batch_flush_work, batch_flush_task);
+static uint8_t batch_buf[CONFIG_LOG_BACKEND_RPC_BATCH_SIZE];
+static struct nrf_rpc_cbor_ctx batch_ctx;
+#endif
+
 /*
  * Verify that Zephyr logging level can be used as the nRF RPC logging level without translation.
  */
@@ -481,6 +495,7 @@ static size_t format_message_to_buf(struct log_msg *msg, uint32_t flags, uint8_t
 	return output_ctx.total_len;
 }
 
+#ifndef CONFIG_LOG_BACKEND_RPC_BINARY
 static void stream_message(struct log_msg *msg)
 {
 	const uint32_t flags = common_output_flags | LOG_OUTPUT_FLAG_CRLF_NONE;
@@ -505,24 +520,35 @@ static void stream_message(struct log_msg *msg)
 
 	nrf_rpc_cbor_evt_no_err(&log_rpc_group, LOG_RPC_EVT_MSG, &ctx);
 }
+#endif
 
-static const char *log_msg_source_name_get(struct log_msg *msg)
+static bool log_msg_source_id_get(struct log_msg *msg, uint32_t *source_id)
 {
 	void *source;
-	uint32_t source_id;
 
 	if (log_msg_get_domain(msg) != Z_LOG_LOCAL_DOMAIN_ID) {
-		return NULL;
+		return false;
 	}
 
 	source = (void *)log_msg_get_source(msg);
 
 	if (source == NULL) {
-		return NULL;
+		return false;
 	}
 
-	source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? log_dynamic_source_id(source)
-							     : log_const_source_id(source);
+	*source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? log_dynamic_source_id(source)
+							      : log_const_source_id(source);
+
+	return true;
+}
+
+static const char *log_msg_source_name_get(struct log_msg *msg)
+{
+	uint32_t source_id;
+
+	if (!log_msg_source_id_get(msg, &source_id)) {
+		return NULL;
+	}
 
 	return TYPE_SECTION_START(log_const)[source_id].name;
 }
@@ -532,7 +558,7 @@ static bool starts_with(const char *str, const char *prefix)
 	return strncmp(str, prefix, strlen(prefix)) == 0;
 }
 
-static bool should_filter_out(struct log_msg *msg)
+static bool source_name_filtered_out(const char *source_name)
 {
 	/*
 	 * Drop messages coming from nRF RPC to avoid the log feedback loop:
@@ -542,24 +568,146 @@ static bool should_filter_out(struct log_msg *msg)
 	 * 4. more logs sent over nRF RPC
 	 * ...
 	 */
-	static const char *const filtered_out_sources[] = {
+	static const char *const filtered_out_prefixes[] = {
 		"nrf_rpc",
 		"NRF_RPC",
 	};
 
-	const char *source_name = log_msg_source_name_get(msg);
-
-	if (source_name != NULL) {
-		for (size_t i = 0; i < ARRAY_SIZE(filtered_out_sources); i++) {
-			if (starts_with(source_name, filtered_out_sources[i])) {
-				return true;
-			}
+	for (size_t i = 0; i < ARRAY_SIZE(filtered_out_prefixes); i++) {
+		if (starts_with(source_name, filtered_out_prefixes[i])) {
+			return true;
 		}
 	}
 
 	return false;
 }
 
+static void filter_cache_init(void)
+{
+	uint32_t count = MIN(log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID),
+			     CONFIG_LOG_BACKEND_RPC_SOURCE_FILTER_CACHE_SIZE);
+
+	for (uint32_t source_id = 0; source_id < count; source_id++) {
+		const char *source_name = TYPE_SECTION_START(log_const)[source_id].name;
+
+		atomic_set_bit_to(filtered_out_sources, source_id,
+				  source_name_filtered_out(source_name));
+	}
+}
+
+static bool should_filter_out(struct log_msg *msg)
+{
+	uint32_t source_id;
+
+	if (!log_msg_source_id_get(msg, &source_id)) {
+		return false;
+	}
+
+	if (source_id < CONFIG_LOG_BACKEND_RPC_SOURCE_FILTER_CACHE_SIZE) {
+		return atomic_test_bit(filtered_out_sources, source_id);
+	}
+
+	return source_name_filtered_out(TYPE_SECTION_START(log_const)[source_id].name);
+}
+
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+
+static void batch_reset(void)
+{
+	zcbor_new_encode_state(batch_ctx.zs, ARRAY_SIZE(batch_ctx.zs), batch_buf,
+			       sizeof(batch_buf), 0);
+}
+
+static size_t batch_length(void)
+{
+	return batch_ctx.zs[0].payload_mut - batch_buf;
+}
+
+/*
+ * Sends the batched messages as one event, terminated with null.
+ *
+ * Must be called with batch_mtx locked.
+ */
+static void batch_flush(void)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t length = batch_length();
+
+	if (length == 0) {
+		return;
+	}
+
+	NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx, length + 1);
+	memcpy(ctx.zs[0].payload_mut, batch_buf, length);
+	ctx.zs[0].payload_mut += length;
+	nrf_rpc_encode_null(&ctx);
+	nrf_rpc_cbor_evt_no_err(&log_rpc_group, LOG_RPC_EVT_MSG_BATCH, &ctx);
+
+	batch_reset();
+}
+
+static void batch_flush_task(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&batch_mtx, K_FOREVER);
+	batch_flush();
+	k_mutex_unlock(&batch_mtx);
+}
+
+static void batch_message(struct log_msg *msg)
+{
+	struct log_rpc_batch_record record;
+	struct nrf_rpc_cbor_ctx ctx;
+	uint16_t strl[4];
+	size_t package_len;
+	size_t data_len;
+	size_t length;
+	int rc;
+
+	record.level = log_msg_get_level(msg);
+	record.timestamp_us = log_output_timestamp_to_us(log_msg_get_timestamp(msg));
+	record.source = log_msg_source_name_get(msg);
+	record.source_size = (record.source != NULL) ? strlen(record.source) : 0;
+	record.package = log_msg_get_package(msg, &package_len);
+	record.package_size = package_len;
+	record.data = log_msg_get_data(msg, &data_len);
+	record.data_size = data_len;
+
+	rc = log_rpc_batch_record_size(&record, strl, ARRAY_SIZE(strl));
+
+	if (rc < 0) {
+		return;
+	}
+
+	length = rc;
+
+	k_mutex_lock(&batch_mtx, K_FOREVER);
+
+	if (batch_length() + length > sizeof(batch_buf)) {
+		batch_flush();
+	}
+
+	if (length > sizeof(batch_buf)) {
+		/* The message does not fit in an empty batch, so send it alone. */
+		NRF_RPC_CBOR_ALLOC(&log_rpc_group, ctx, length + 1);
+		log_rpc_batch_record_encode(&ctx, &record, strl, ARRAY_SIZE(strl));
+		nrf_rpc_encode_null(&ctx);
+		nrf_rpc_cbor_evt_no_err(&log_rpc_group, LOG_RPC_EVT_MSG_BATCH, &ctx);
+	} else {
+		if (batch_length() == 0) {
+			k_work_schedule(&batch_flush_work,
+					K_MSEC(CONFIG_LOG_BACKEND_RPC_BATCH_WINDOW_MS));
+		}
+
+		log_rpc_batch_record_encode(&batch_ctx, &record, strl, ARRAY_SIZE(strl));
+	}
+
+	k_mutex_unlock(&batch_mtx);
+}
+
+#endif /* CONFIG_LOG_BACKEND_RPC_BINARY */
+
 static void process(const struct log_backend *const backend, union log_msg_generic *msg_generic)
 {
 	struct log_msg *msg = &msg_generic->log;
@@ -578,7 +726,11 @@ static void process(const struct log_backend *const backend, union log_msg_gener
 		 * needed, because a log message can be generated with the level NONE, and such
 		 * a message should also be discarded if the configured maximum level is NONE.
 		 */
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+		batch_message(msg);
+#else
 		stream_message(msg);
+#endif
 	}
 
 #ifdef CONFIG_LOG_BACKEND_RPC_HISTORY
@@ -608,12 +760,32 @@ static void panic(struct log_backend const *const backend)
 	log_rpc_history_save_checksum();
 #endif
 	panic_mode = true;
+
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+	/*
+	 * Send the messages batched before the panic, because the flush work will not run.
+	 * The batch may be in the middle of an update if the panic interrupted the owner of
+	 * the mutex, so it is only sent if the mutex can be taken, and dropped otherwise.
+	 */
+	(void)k_work_cancel_delayable(&batch_flush_work);
+
+	if (!k_is_in_isr() && k_mutex_lock(&batch_mtx, K_NO_WAIT) == 0) {
+		batch_flush();
+		k_mutex_unlock(&batch_mtx);
+	}
+#endif
 }
 
 static void init(struct log_backend const *const backend)
 {
 	ARG_UNUSED(backend);
 
+	filter_cache_init();
+
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+	batch_reset();
+#endif
+
 #ifdef CONFIG_LOG_BACKEND_RPC_HISTORY
 	log_rpc_history_init();
 	k_work_queue_init(&history_transfer_workq);
@@ -672,6 +844,15 @@ static void log_rpc_set_stream_level_handler(const struct nrf_rpc_group *group,
 
 	stream_level = level;
 
+#ifdef CONFIG_LOG_BACKEND_RPC_BINARY
+	if (level == LOG_RPC_LEVEL_NONE) {
+		/* Do not hold back the messages batched before the streaming was stopped. */
+		k_mutex_lock(&batch_mtx, K_FOREVER);
+		batch_flush();
+		k_mutex_unlock(&batch_mtx);
+	}
+#endif
+
 	nrf_rpc_rsp_send_void(group);
 }
 
@@ -11,6 +11,7 @@
  */
 
 #include "log_rpc_group.h"
+#include "log_rpc_batch.h"
 
 #include <logging/log_rpc.h>
 #include <nrf_rpc/nrf_rpc_serialize.h>
@@ -19,8 +20,12 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/printk.h>
 #include <zephyr/sys/util.h>
 
+#include <string.h>
+
 LOG_MODULE_REGISTER(remote, LOG_LEVEL_DBG);
 
 static K_MUTEX_DEFINE(history_transfer_mtx);
@@ -28,6 +33,52 @@ static uint32_t history_transfer_id;
 static log_rpc_history_handler_t history_handler;
 static log_rpc_history_threshold_reached_handler_t history_threshold_reached_handler;
 
+static K_MUTEX_DEFINE(msg_format_mtx);
+static uint8_t msg_package[CONFIG_LOG_FORWARDER_RPC_MSG_BUFFER_SIZE]
+	__aligned(CBPRINTF_PACKAGE_ALIGNMENT);
+static char msg_text[CONFIG_LOG_FORWARDER_RPC_MSG_BUFFER_SIZE];
+
+static void forward_msg(enum log_rpc_level level, const char *message, size_t message_size)
+{
+	switch (level) {
+	case LOG_RPC_LEVEL_ERR:
+		LOG_ERR("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_WRN:
+		LOG_WRN("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_INF:
+		LOG_INF("%.*s", message_size, message);
+		break;
+	case LOG_RPC_LEVEL_DBG:
+		LOG_DBG("%.*s", message_size, message);
+		break;
+	default:
+		break;
+	}
+}
+
+static void forward_hexdump(enum log_rpc_level level, const char *message, const uint8_t *data,
+			    size_t data_size)
+{
+	switch (level) {
+	case LOG_RPC_LEVEL_ERR:
+		LOG_HEXDUMP_ERR(data, data_size, message);
+		break;
+	case LOG_RPC_LEVEL_WRN:
+		LOG_HEXDUMP_WRN(data, data_size, message);
+		break;
+	case LOG_RPC_LEVEL_INF:
+		LOG_HEXDUMP_INF(data, data_size, message);
+		break;
+	case LOG_RPC_LEVEL_DBG:
+		LOG_HEXDUMP_DBG(data, data_size, message);
+		break;
+	default:
+		break;
+	}
+}
+
 static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rpc_cbor_ctx *ctx,
 				void *handler_data)
 {
@@ -39,22 +90,7 @@ static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rp
 	message = nrf_rpc_decode_buffer_ptr_and_size(ctx, &message_size);
 
 	if (message) {
-		switch (level) {
-		case LOG_RPC_LEVEL_ERR:
-			LOG_ERR("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_WRN:
-			LOG_WRN("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_INF:
-			LOG_INF("%.*s", message_size, message);
-			break;
-		case LOG_RPC_LEVEL_DBG:
-			LOG_DBG("%.*s", message_size, message);
-			break;
-		default:
-			break;
-		}
+		forward_msg(level, message, message_size);
 	}
 
 	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, ctx)) {
@@ -66,6 +102,92 @@ static void log_rpc_msg_handler(const struct nrf_rpc_group *group, struct nrf_rp
 NRF_RPC_CBOR_EVT_DECODER(log_rpc_group, log_rpc_msg_handler, LOG_RPC_EVT_MSG, log_rpc_msg_handler,
 			 NULL);
 
+static int msg_text_out(int c, void *ctx)
+{
+	size_t *length = ctx;
+
+	/* Leave space for the null terminator */
+	if (*length < sizeof(msg_text) - 1) {
+		msg_text[(*length)++] = (char)c;
+	}
+
+	return c;
+}
+
+/*
+ * Formats the message in msg_package into msg_text, with the same layout as the text messages
+ * streamed by the backend: "[hh:mm:ss.ms,us] source: message".
+ */
+static size_t format_msg(uint64_t timestamp_us, const char *source, size_t source_size)
+{
+	uint64_t seconds = timestamp_us / USEC_PER_SEC;
+	uint32_t us = timestamp_us % USEC_PER_SEC;
+	size_t length;
+	int rc;
+
+	rc = snprintk(msg_text, sizeof(msg_text), "[%02u:%02u:%02u.%03u,%03u] ",
+		      (uint32_t)(seconds / 3600), (uint32_t)(seconds / 60 % 60),
+		      (uint32_t)(seconds % 60), us / USEC_PER_MSEC, us % USEC_PER_MSEC);
+	length = MIN(MAX(rc, 0), sizeof(msg_text) - 1);
+
+	if (source != NULL) {
+		rc = snprintk(msg_text + length, sizeof(msg_text) - length, "%.*s: ",
+			      (int)source_size, source);
+		length += MIN(MAX(rc, 0), sizeof(msg_text) - 1 - length);
+	}
+
+	cbpprintf(msg_text_out, &length, msg_package);
+	msg_text[length] = '\0';
+
+	return length;
+}
+
+static void log_rpc_msg_batch_handler(const struct nrf_rpc_group *group,
+				      struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
+{
+	struct log_rpc_batch_record record;
+	size_t length;
+
+	k_mutex_lock(&msg_format_mtx, K_FOREVER);
+
+	while (log_rpc_batch_record_decode(ctx, &record)) {
+		if (record.package == NULL) {
+			continue;
+		}
+
+		if (record.package_size > sizeof(msg_package)) {
+			LOG_WRN("Dropped a message of %zu bytes", record.package_size);
+			continue;
+		}
+
+		/* The package is formatted in place, so it must be aligned and writable. */
+		memcpy(msg_package, record.package, record.package_size);
+
+		if (!log_rpc_batch_package_is_valid(msg_package, record.package_size)) {
+			LOG_WRN("Dropped a malformed message");
+			continue;
+		}
+
+		length = format_msg(record.timestamp_us, record.source, record.source_size);
+
+		if (record.data != NULL) {
+			forward_hexdump(record.level, msg_text, record.data, record.data_size);
+		} else {
+			forward_msg(record.level, msg_text, length);
+		}
+	}
+
+	k_mutex_unlock(&msg_format_mtx);
+
+	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, ctx)) {
+		nrf_rpc_err(-EBADMSG, NRF_RPC_ERR_SRC_RECV, &log_rpc_group, LOG_RPC_EVT_MSG_BATCH,
+			    NRF_RPC_PACKET_TYPE_EVT);
+	}
+}
+
+NRF_RPC_CBOR_EVT_DECODER(log_rpc_group, log_rpc_msg_batch_handler, LOG_RPC_EVT_MSG_BATCH,
+			 log_rpc_msg_batch_handler, NULL);
+
 void log_rpc_set_stream_level(enum log_rpc_level level)
 {
 	struct nrf_rpc_cbor_ctx ctx;
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ *   This file implements the encoding of the log message records sent in batches by the
+ *   logging backend, and their decoding in the log forwarder.
+ *
+ */
+
+#include "log_rpc_batch.h"
+
+#include <nrf_rpc/nrf_rpc_serialize.h>
+
+#include <zephyr/sys/util.h>
+
+#include <string.h>
+
+int log_rpc_batch_record_size(const struct log_rpc_batch_record *record, uint16_t *strl,
+			      size_t strl_len)
+{
+	int copy_len;
+
+	/* Calculate the package size with the strings appended, and remember the string lengths */
+	copy_len = cbprintf_package_copy((void *)record->package, record->package_size, NULL, 0,
+					 LOG_RPC_BATCH_PACKAGE_FLAGS, strl, strl_len);
+
+	if (copy_len < 0) {
+		return copy_len;
+	}
+
+	return LOG_RPC_BATCH_RECORD_OVERHEAD + copy_len + record->data_size +
+	       ((record->source != NULL) ? record->source_size : 0);
+}
+
+void log_rpc_batch_record_encode(struct nrf_rpc_cbor_ctx *ctx,
+				 const struct log_rpc_batch_record *record, uint16_t *strl,
+				 size_t strl_len)
+{
+	int length;
+
+	nrf_rpc_encode_uint(ctx, record->level);
+	nrf_rpc_encode_uint64(ctx, record->timestamp_us);
+	nrf_rpc_encode_str(ctx, record->source, record->source_size);
+
+	if (zcbor_bstr_start_encode(ctx->zs)) {
+		length = cbprintf_package_copy((void *)record->package, record->package_size,
+					       ctx->zs[0].payload_mut,
+					       ctx->zs[0].payload_end - ctx->zs[0].payload_mut,
+					       LOG_RPC_BATCH_PACKAGE_FLAGS, strl, strl_len);
+		ctx->zs[0].payload_mut += MAX(length, 0);
+		zcbor_bstr_end_encode(ctx->zs, NULL);
+	}
+
+	if (record->data_size > 0) {
+		nrf_rpc_encode_buffer(ctx, record->data, record->data_size);
+	} else {
+		nrf_rpc_encode_null(ctx);
+	}
+}
+
+bool log_rpc_batch_record_decode(struct nrf_rpc_cbor_ctx *ctx,
+				 struct log_rpc_batch_record *record)
+{
+	/* A batch is a sequence of records terminated with null. */
+	if (!nrf_rpc_decode_valid(ctx) || nrf_rpc_decode_is_null(ctx)) {
+		return false;
+	}
+
+	record->source_size = 0;
+	record->package_size = 0;
+	record->data_size = 0;
+
+	record->level = nrf_rpc_decode_uint(ctx);
+	record->timestamp_us = nrf_rpc_decode_uint64(ctx);
+	record->source = nrf_rpc_decode_str_ptr_and_len(ctx, &record->source_size);
+	record->package = nrf_rpc_decode_buffer_ptr_and_size(ctx, &record->package_size);
+	record->data = nrf_rpc_decode_buffer_ptr_and_size(ctx, &record->data_size);
+
+	return nrf_rpc_decode_valid(ctx);
+}
+
+bool log_rpc_batch_package_is_valid(const uint8_t *package, size_t package_size)
+{
+	const union cbprintf_package_hdr *hdr = (const union cbprintf_package_hdr *)package;
+	const size_t fmt_offset = sizeof(union cbprintf_package_hdr);
+	size_t args_size;
+	size_t offset;
+	size_t str_offset;
+	bool fmt_appended = false;
+	const uint8_t *str_end;
+
+	if (package_size < sizeof(struct cbprintf_package_hdr_ext)) {
+		return false;
+	}
+
+	args_size = hdr->desc.len * sizeof(int);
+
+	if (args_size < sizeof(struct cbprintf_package_hdr_ext) || args_size > package_size) {
+		return false;
+	}
+
+	/* String locations refer to the memory of the remote, they must have been converted. */
+	if (hdr->desc.ro_str_cnt != 0 || hdr->desc.rw_str_cnt != 0) {
+		return false;
+	}
+
+	/* Each appended string is preceded by the index of the argument it replaces, in words. */
+	offset = args_size;
+
+	for (size_t i = 0; i < hdr->desc.str_cnt; i++) {
+		if (offset >= package_size) {
+			return false;
+		}
+
+		str_offset = package[offset++] * sizeof(int);
+
+		if (str_offset < fmt_offset || str_offset + sizeof(char *) > args_size) {
+			return false;
+		}
+
+		str_end = memchr(&package[offset], '\0', package_size - offset);
+
+		if (str_end == NULL) {
+			return false;
+		}
+
+		fmt_appended |= (str_offset == fmt_offset);
+		offset = str_end - package + 1;
+	}
+
+	/* Otherwise, the format string would be read from the remote memory. */
+	return fmt_appended;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LOG_RPC_BATCH_H_
+#define LOG_RPC_BATCH_H_
+
+#include <logging/log_rpc.h>
+
+#include <nrf_rpc_cbor.h>
+
+#include <zephyr/sys/cbprintf.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Upper bound of the encoded size of a batch record, not counting the source name, the package
+ * and the hexdump data: the level, the timestamp and three string headers.
+ */
+#define LOG_RPC_BATCH_RECORD_OVERHEAD 32
+
+/* Append all strings to the package so that the forwarder does not need to access this image */
+#define LOG_RPC_BATCH_PACKAGE_FLAGS                                                                \
+	(CBPRINTF_PACKAGE_CONVERT_RO_STR | CBPRINTF_PACKAGE_CONVERT_RW_STR)
+
+/* Log message record, as sent in the LOG_RPC_EVT_MSG_BATCH event. */
+struct log_rpc_batch_record {
+	enum log_rpc_level level;
+	uint64_t timestamp_us;
+	const char *source;
+	size_t source_size;
+	const uint8_t *package;
+	size_t package_size;
+	const uint8_t *data;
+	size_t data_size;
+};
+
+/*
+ * Returns the upper bound of the encoded size of the record, or a negative error code if
+ * the package cannot be converted. The lengths of the package strings are stored in strl.
+ */
+int log_rpc_batch_record_size(const struct log_rpc_batch_record *record, uint16_t *strl,
+			      size_t strl_len);
+
+/*
+ * Encodes the record, with the strings appended to the package. The string lengths must come
+ * from log_rpc_batch_record_size().
+ */
+void log_rpc_batch_record_encode(struct nrf_rpc_cbor_ctx *ctx,
+				 const struct log_rpc_batch_record *record, uint16_t *strl,
+				 size_t strl_len);
+
+/*
+ * Decodes the next record of a batch. Returns false at the null terminating the batch or when
+ * the decoding fails. The record points into the decoded buffer.
+ */
+bool log_rpc_batch_record_decode(struct nrf_rpc_cbor_ctx *ctx,
+				 struct log_rpc_batch_record *record);
+
+/*
+ * Checks that the package received from the remote can be formatted with cbpprintf() without
+ * accessing memory outside of it: the header is consistent with the size, the package does not
+ * refer to strings in the remote memory, and all appended strings are within the package.
+ */
+bool log_rpc_batch_package_is_valid(const uint8_t *package, size_t package_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_RPC_BATCH_H_ */
@@ -30,6 +30,7 @@ NRF_RPC_GROUP_DEFINE(log_rpc_group, "log", &log_rpc_tr, NULL, NULL, NULL);
 enum log_rpc_evt_forwarder {
 	LOG_RPC_EVT_MSG = 0,
 	LOG_RPC_EVT_HISTORY_THRESHOLD_REACHED = 1,
+	LOG_RPC_EVT_MSG_BATCH = 2,
 };
 
 enum log_rpc_cmd_forwarder {
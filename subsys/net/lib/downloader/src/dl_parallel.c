@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <net/downloader.h>
+#include <net/downloader_parallel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(downloader, CONFIG_DOWNLOADER_LOG_LEVEL);
+
+/* Events about the whole download, they come from no single instance */
+static int evt_send(struct downloader_parallel *pd, enum downloader_evt_id id, int error)
+{
+	const struct downloader_evt evt = {
+		.id = id,
+		.dl = NULL,
+		.error = error,
+	};
+
+	return pd->cfg.callback(&evt);
+}
+
+/* Must be called with the mutex held */
+static int conn_start(struct downloader_parallel *pd, struct downloader_parallel_conn *conn,
+		      size_t start)
+{
+	int err;
+	struct downloader_host_cfg host_cfg = pd->host_cfg;
+
+	conn->start = start;
+	conn->end = start + pd->cfg.segment_size;
+	if (pd->file_size) {
+		conn->end = MIN(conn->end, pd->file_size);
+	}
+
+	host_cfg.range_end = conn->end;
+
+	/* Keep the connection for the next segment. The file size is not known before the
+	 * first response, so the first connection is always kept.
+	 */
+	if (!pd->file_size || conn->end < pd->file_size) {
+		host_cfg.keep_connection = true;
+	}
+
+	LOG_DBG("Connection %d: bytes %u-%u", (int)(conn - pd->conn), start, conn->end - 1);
+
+	err = downloader_get(&conn->dl, &host_cfg, pd->url, start);
+	if (err) {
+		LOG_ERR("Failed to start connection %d, err %d", (int)(conn - pd->conn), err);
+		return err;
+	}
+
+	pd->next = conn->end;
+	conn->active = true;
+	pd->active++;
+
+	return 0;
+}
+
+/* Must be called with the mutex held */
+static void conn_release(struct downloader_parallel *pd, struct downloader_parallel_conn *conn)
+{
+	if (!conn->active) {
+		return;
+	}
+
+	conn->active = false;
+	pd->active--;
+}
+
+/* Must be called with the mutex held */
+static void stop_all(struct downloader_parallel *pd)
+{
+	pd->stopping = true;
+	k_condvar_broadcast(&pd->delivered_cond);
+
+	for (size_t i = 0; i < pd->cfg.connections; i++) {
+		if (pd->conn[i].active) {
+			/* A connection that has just completed its segment is not downloading,
+			 * it is released when its done event is handled.
+			 */
+			(void)downloader_cancel(&pd->conn[i].dl);
+		}
+	}
+}
+
+/* Must be called with the mutex held */
+static void finish_check(struct downloader_parallel *pd)
+{
+	if (pd->active || !pd->running) {
+		return;
+	}
+
+	pd->running = false;
+
+	if (!pd->stopping && pd->delivered == pd->file_size) {
+		LOG_INF("Parallel download complete");
+		(void)evt_send(pd, DOWNLOADER_EVT_DONE, 0);
+	} else {
+		(void)evt_send(pd, DOWNLOADER_EVT_STOPPED, 0);
+	}
+}
+
+/* Must be called with the mutex held */
+static void conns_start(struct downloader_parallel *pd)
+{
+	int err;
+
+	for (size_t i = 0; i < pd->cfg.connections && pd->next < pd->file_size; i++) {
+		if (pd->conn[i].active) {
+			continue;
+		}
+
+		err = conn_start(pd, &pd->conn[i], pd->next);
+		if (err) {
+			(void)evt_send(pd, DOWNLOADER_EVT_ERROR, err);
+			stop_all(pd);
+			return;
+		}
+	}
+}
+
+static int fragment_handle(struct downloader_parallel *pd, struct downloader_parallel_conn *conn,
+			   const struct downloader_evt *event)
+{
+	int ret;
+	/* The progress of the downloader includes the fragment */
+	size_t offset = event->dl->progress - event->fragment.len;
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+
+	if (!pd->file_size && event->dl->file_size) {
+		/* The first response gives the file size, start the other connections */
+		pd->file_size = event->dl->file_size;
+		conn->end = MIN(conn->end, pd->file_size);
+		pd->next = conn->end;
+		conns_start(pd);
+	}
+
+	/* Hand the data over in order. The connection is not read while it waits, which
+	 * throttles the server through the socket receive window.
+	 */
+	while (pd->delivered != offset && !pd->stopping) {
+		k_condvar_wait(&pd->delivered_cond, &pd->mutex, K_FOREVER);
+	}
+
+	if (pd->stopping) {
+		k_mutex_unlock(&pd->mutex);
+		return 1;
+	}
+
+	ret = pd->cfg.callback(event);
+	if (ret) {
+		stop_all(pd);
+	} else {
+		pd->delivered += event->fragment.len;
+		k_condvar_broadcast(&pd->delivered_cond);
+	}
+
+	k_mutex_unlock(&pd->mutex);
+
+	return ret;
+}
+
+static int error_handle(struct downloader_parallel *pd, const struct downloader_evt *event)
+{
+	int ret = 1;
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+
+	if (pd->stopping) {
+		goto out;
+	}
+
+	ret = pd->cfg.callback(event);
+
+	/* The connection reconnects and resumes its segment on ECONNRESET if the application
+	 * allows it. On any other error the whole download is stopped.
+	 */
+	if (event->error != -ECONNRESET) {
+		ret = 1;
+	}
+
+	if (ret) {
+		stop_all(pd);
+	}
+
+out:
+	k_mutex_unlock(&pd->mutex);
+
+	return ret;
+}
+
+static void done_handle(struct downloader_parallel *pd, struct downloader_parallel_conn *conn)
+{
+	int err;
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+
+	if (!conn->active) {
+		goto out;
+	}
+
+	conn_release(pd, conn);
+
+	if (!pd->stopping && pd->next < pd->file_size) {
+		/* Reuse the connection for the next segment */
+		err = conn_start(pd, conn, pd->next);
+		if (err) {
+			(void)evt_send(pd, DOWNLOADER_EVT_ERROR, err);
+			stop_all(pd);
+		}
+	}
+
+	finish_check(pd);
+
+out:
+	k_mutex_unlock(&pd->mutex);
+}
+
+static int conn_callback(const struct downloader_evt *event)
+{
+	struct downloader_parallel_conn *conn =
+		CONTAINER_OF(event->dl, struct downloader_parallel_conn, dl);
+	struct downloader_parallel *pd = conn->pd;
+
+	switch (event->id) {
+	case DOWNLOADER_EVT_FRAGMENT:
+		return fragment_handle(pd, conn, event);
+	case DOWNLOADER_EVT_ERROR:
+		return error_handle(pd, event);
+	case DOWNLOADER_EVT_DONE:
+		done_handle(pd, conn);
+		break;
+	case DOWNLOADER_EVT_STOPPED:
+		k_mutex_lock(&pd->mutex, K_FOREVER);
+		conn_release(pd, conn);
+		finish_check(pd);
+		k_mutex_unlock(&pd->mutex);
+		break;
+	case DOWNLOADER_EVT_DEINITIALIZED:
+		break;
+	}
+
+	return 0;
+}
+
+int downloader_parallel_init(struct downloader_parallel *pd,
+			     const struct downloader_parallel_cfg *cfg)
+{
+	int err;
+
+	if (!pd || !cfg || !cfg->callback ||
+	    cfg->connections > CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS) {
+		return -EINVAL;
+	}
+
+	memset(pd, 0, sizeof(*pd));
+	pd->cfg = *cfg;
+	k_mutex_init(&pd->mutex);
+	k_condvar_init(&pd->delivered_cond);
+
+	if (pd->cfg.connections == 0) {
+		pd->cfg.connections = CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS;
+	}
+
+	if (pd->cfg.segment_size == 0) {
+		pd->cfg.segment_size = CONFIG_DOWNLOADER_PARALLEL_SEGMENT_SIZE;
+	}
+
+	for (size_t i = 0; i < pd->cfg.connections; i++) {
+		struct downloader_parallel_conn *conn = &pd->conn[i];
+		struct downloader_cfg dl_cfg = {
+			.callback = conn_callback,
+			.buf = conn->buf,
+			.buf_size = sizeof(conn->buf),
+		};
+
+		conn->pd = pd;
+
+		err = downloader_init(&conn->dl, &dl_cfg);
+		if (err) {
+			LOG_ERR("Failed to initialize connection %d, err %d", (int)i, err);
+			while (i--) {
+				(void)downloader_deinit(&pd->conn[i].dl);
+			}
+			pd->cfg.callback = NULL;
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+int downloader_parallel_deinit(struct downloader_parallel *pd)
+{
+	if (!pd) {
+		return -EINVAL;
+	}
+
+	if (!pd->cfg.callback) {
+		return -EPERM;
+	}
+
+	/* Release the connections waiting for their turn to hand over data */
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+	pd->stopping = true;
+	k_condvar_broadcast(&pd->delivered_cond);
+	k_mutex_unlock(&pd->mutex);
+
+	/* The connection threads need the mutex to finish, so it is not held here */
+	for (size_t i = 0; i < pd->cfg.connections; i++) {
+		(void)downloader_deinit(&pd->conn[i].dl);
+	}
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+	if (pd->running) {
+		pd->running = false;
+		(void)evt_send(pd, DOWNLOADER_EVT_STOPPED, 0);
+	}
+	(void)evt_send(pd, DOWNLOADER_EVT_DEINITIALIZED, 0);
+	pd->cfg.callback = NULL;
+	k_mutex_unlock(&pd->mutex);
+
+	return 0;
+}
+
+int downloader_parallel_get(struct downloader_parallel *pd,
+			    const struct downloader_host_cfg *host_cfg, const char *url,
+			    size_t from)
+{
+	int err;
+
+	if (!pd || !host_cfg || !url || host_cfg->range_end) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+
+	if (!pd->cfg.callback || pd->running) {
+		k_mutex_unlock(&pd->mutex);
+		return -EPERM;
+	}
+
+	pd->host_cfg = *host_cfg;
+	pd->url = url;
+	pd->file_size = 0;
+	pd->next = from;
+	pd->delivered = from;
+	pd->active = 0;
+	pd->stopping = false;
+
+	/* The other connections are started when the file size is known */
+	err = conn_start(pd, &pd->conn[0], from);
+	if (err == 0) {
+		pd->running = true;
+	}
+
+	k_mutex_unlock(&pd->mutex);
+
+	return err;
+}
+
+int downloader_parallel_cancel(struct downloader_parallel *pd)
+{
+	if (!pd) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+
+	if (!pd->running) {
+		k_mutex_unlock(&pd->mutex);
+		return -EPERM;
+	}
+
+	stop_all(pd);
+
+	k_mutex_unlock(&pd->mutex);
+
+	return 0;
+}
+
+int downloader_parallel_file_size_get(struct downloader_parallel *pd, size_t *size)
+{
+	if (!pd || !size) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+	*size = pd->file_size;
+	k_mutex_unlock(&pd->mutex);
+
+	return 0;
+}
+
+int downloader_parallel_downloaded_size_get(struct downloader_parallel *pd, size_t *size)
+{
+	if (!pd || !size) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&pd->mutex, K_FOREVER);
+	*size = pd->delivered;
+	k_mutex_unlock(&pd->mutex);
+
+	return 0;
+}
@@ -153,6 +153,51 @@ static int reconnect(struct downloader *dl)
 	return  transport_connect(dl);
 }
 
+/* FNV-1a hash of the security tag list. The list of the kept connection may be out of scope
+ * when the next download starts, so only its hash is kept.
+ */
+static uint32_t sec_tag_hash(const struct downloader_host_cfg *host_cfg)
+{
+	uint32_t hash = 2166136261U;
+	const uint8_t *p = (const uint8_t *)host_cfg->sec_tag_list;
+
+	if (!p) {
+		return 0;
+	}
+
+	for (size_t i = 0; i < host_cfg->sec_tag_count * sizeof(host_cfg->sec_tag_list[0]); i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Whether the connection of the previous download can be used with the new configuration */
+static bool host_cfg_match(const struct downloader *dl, const struct downloader_host_cfg *cfg)
+{
+	const struct downloader_host_cfg *cur = &dl->host_cfg;
+
+	return cur->sec_tag_count == cfg->sec_tag_count && cur->pdn_id == cfg->pdn_id &&
+	       cur->family == cfg->family && cur->set_native_tls == cfg->set_native_tls &&
+	       cur->cid == cfg->cid && cur->auth_cb == cfg->auth_cb &&
+	       cur->proxy_uri == cfg->proxy_uri && cur->if_name == cfg->if_name &&
+	       dl->sec_tag_hash == sec_tag_hash(cfg);
+}
+
+static void idle_close(struct downloader *dl)
+{
+	k_mutex_lock(&dl->mutex, K_FOREVER);
+
+	/* A download may have been started just as the timeout expired */
+	if (is_state(dl, DOWNLOADER_CONNECTED)) {
+		LOG_DBG("Closing idle connection");
+		transport_close(dl);
+		state_set(dl, DOWNLOADER_CONNECTED, DOWNLOADER_IDLE);
+	}
+
+	k_mutex_unlock(&dl->mutex);
+}
+
 static void restart_and_suspend(struct downloader *dl)
 {
 	if (!is_state(dl, DOWNLOADER_DOWNLOADING)) {
@@ -175,9 +220,10 @@ static void restart_and_suspend(struct downloader *dl)
 	state_set(dl, DOWNLOADER_DOWNLOADING, DOWNLOADER_CONNECTED);
 }
 
-static int data_evt_send(const struct downloader *dl, void *data, size_t len)
+static int data_evt_send(struct downloader *dl, void *data, size_t len)
 {
 	const struct downloader_evt evt = {.id = DOWNLOADER_EVT_FRAGMENT,
+					   .dl = dl,
 					   .fragment = {
 						   .buf = data,
 						   .len = len,
@@ -186,10 +232,11 @@ static int data_evt_send(const struct downloader *dl, void *data, size_t len)
 	return dl->cfg.callback(&evt);
 }
 
-static int download_complete_evt_send(const struct downloader *dl)
+static int download_complete_evt_send(struct downloader *dl)
 {
 	const struct downloader_evt evt = {
 		.id = DOWNLOADER_EVT_DONE,
+		.dl = dl,
 	};
 
 	return dl->cfg.callback(&evt);
@@ -199,25 +246,27 @@ static int stopped_evt_send(struct downloader *dl)
 {
 	const struct downloader_evt evt = {
 		.id = DOWNLOADER_EVT_STOPPED,
+		.dl = dl,
 	};
 
 	return dl->cfg.callback(&evt);
 }
 
-static int error_evt_send(const struct downloader *dl, int error)
+static int error_evt_send(struct downloader *dl, int error)
 {
 	/* Error will be sent as negative. */
 	__ASSERT_NO_MSG(error < 0);
 
-	const struct downloader_evt evt = {.id = DOWNLOADER_EVT_ERROR, .error = error};
+	const struct downloader_evt evt = {.id = DOWNLOADER_EVT_ERROR, .dl = dl, .error = error};
 
 	return dl->cfg.callback(&evt);
 }
 
-static int deinit_evt_send(const struct downloader *dl)
+static int deinit_evt_send(struct downloader *dl)
 {
 	const struct downloader_evt evt = {
 		.id = DOWNLOADER_EVT_DEINITIALIZED,
+		.dl = dl,
 	};
 
 	return dl->cfg.callback(&evt);
@@ -279,7 +328,14 @@ void download_thread(void *cli, void *a, void *b)
 
 		if (is_state(dl, DOWNLOADER_CONNECTED)) {
 			/* Client connected, wait for action */
-			k_sem_take(&dl->event_sem, K_FOREVER);
+			rc = k_sem_take(&dl->event_sem,
+					CONFIG_DOWNLOADER_KEEP_CONNECTION_IDLE_TIMEOUT ?
+					K_SECONDS(CONFIG_DOWNLOADER_KEEP_CONNECTION_IDLE_TIMEOUT) :
+					K_FOREVER);
+			if (rc == -EAGAIN) {
+				idle_close(dl);
+				continue;
+			}
 		}
 
 		if (is_state(dl, DOWNLOADER_DOWNLOADING)) {
@@ -422,6 +478,13 @@ static int downloader_start(struct downloader *dl, const struct downloader_host_
 		return -EPERM;
 	}
 
+	if (dl_host_cfg->range_end && dl_host_cfg->range_end <= from) {
+		LOG_ERR("Range end %u must be after the start offset %u", dl_host_cfg->range_end,
+			from);
+		k_mutex_unlock(&dl->mutex);
+		return -EINVAL;
+	}
+
 	/* Check if we are already connected to the correct host */
 	if (is_state(dl, DOWNLOADER_CONNECTED)) {
 		char hostname[CONFIG_DOWNLOADER_MAX_HOSTNAME_SIZE];
@@ -432,7 +495,8 @@ static int downloader_start(struct downloader *dl, const struct downloader_host_
 			k_mutex_unlock(&dl->mutex);
 			return -EINVAL;
 		}
-		if (strncmp(hostname, dl->hostname, sizeof(hostname)) == 0) {
+		if (strncmp(hostname, dl->hostname, sizeof(hostname)) == 0 &&
+		    host_cfg_match(dl, dl_host_cfg)) {
 			host_connected = true;
 		}
 	}
@@ -454,6 +518,7 @@ static int downloader_start(struct downloader *dl, const struct downloader_host_
 	}
 
 	dl->host_cfg = *dl_host_cfg;
+	dl->sec_tag_hash = sec_tag_hash(dl_host_cfg);
 	dl->file_size = 0;
 	dl->progress = from;
 	dl->buf_offset = 0;
@@ -498,11 +563,13 @@ static int downloader_start(struct downloader *dl, const struct downloader_host_
 	};
 
 	if (is_state(dl, DOWNLOADER_CONNECTED)) {
-		if (host_connected) {
+		if (host_connected && dl->transport == transport_connected &&
+		    (!dl->transport->reuse || dl->transport->reuse(dl, url))) {
+			LOG_DBG("Reusing connection to %s", dl->hostname);
 			state_set(dl, DOWNLOADER_CONNECTED, DOWNLOADER_DOWNLOADING);
 			goto out;
 		} else if (transport_connected) {
-			/* We are connected to the wrong host */
+			/* We are connected to the wrong host, or the connection can't be reused */
 			LOG_DBG("Closing connection to connect different host or protocol");
 			transport_connected->close(dl);
 			transport_connected->deinit(dl);
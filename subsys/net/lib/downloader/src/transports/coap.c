@@ -383,6 +383,11 @@ static int dl_coap_init(struct downloader *dl, struct downloader_host_cfg *dl_ho
 
 	coap = (struct transport_params_coap *)dl->transport_internal;
 
+	if (dl_host_cfg->range_end) {
+		LOG_ERR("Range end is not supported by the CoAP transport");
+		return -EPROTONOSUPPORT;
+	}
+
 	/* Reset coap internal struct except config. */
 	struct downloader_transport_coap_cfg tmp_cfg = coap->cfg;
 	bool cfg_set = coap->cfg_set;
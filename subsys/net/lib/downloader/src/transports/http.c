@@ -168,8 +168,17 @@ static int http_get_request_send(struct downloader *dl)
 		}
 	}
 
-	if (dl->host_cfg.range_override) {
-		off = dl->progress + dl->host_cfg.range_override - 1;
+	if (dl->host_cfg.range_override || dl->host_cfg.range_end) {
+		if (dl->host_cfg.range_override) {
+			off = dl->progress + dl->host_cfg.range_override - 1;
+		} else {
+			off = dl->host_cfg.range_end - 1;
+		}
+
+		if (dl->host_cfg.range_end) {
+			/* Don't request bytes past the end of the range */
+			off = MIN(off, dl->host_cfg.range_end - 1);
+		}
 
 		if (dl->file_size) {
 			/* Don't request bytes past the end of file */
@@ -180,7 +189,7 @@ static int http_get_request_send(struct downloader *dl)
 			       dl->hostname, dl->progress, off);
 		http->ranged = true;
 		http->ranged_progress = 0;
-		LOG_DBG("Range request up to %d bytes", dl->host_cfg.range_override);
+		LOG_DBG("Range request up to %d bytes", off - dl->progress + 1);
 		goto send;
 	} else if (dl->progress) {
 		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_OFFSET, dl->file,
@@ -606,6 +615,48 @@ static int dl_http_close(struct downloader *dl)
 	return -EBADF;
 }
 
+static bool dl_http_reuse(struct downloader *dl, const char *url)
+{
+	int proto;
+	uint16_t port;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	if (http->connection_close) {
+		LOG_DBG("Peer has closed the connection");
+		return false;
+	}
+
+	proto = http->sock.proto;
+	port = http->sock.port;
+
+	if (parse_protocol(dl, url) || http->sock.proto != proto || http->sock.port != port) {
+		return false;
+	}
+
+	/* Reset the state of the previous download, the request is sent on the next download
+	 * call.
+	 */
+	memset(&http->header, 0, sizeof(http->header));
+	http->ranged = false;
+	http->ranged_progress = 0;
+	http->redirects = 0;
+	http->new_data_req = true;
+
+	return true;
+}
+
+/* Offset after the last byte to download */
+static size_t http_download_end(const struct downloader *dl)
+{
+	if (dl->host_cfg.range_end) {
+		return MIN(dl->host_cfg.range_end, dl->file_size);
+	}
+
+	return dl->file_size;
+}
+
 static int dl_http_download(struct downloader *dl)
 {
 	int ret, recv_len, data_len, expected_len;
@@ -660,7 +711,12 @@ static int dl_http_download(struct downloader *dl)
 		return data_len;
 	}
 
-	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, dl->file_size - dl->progress);
+	if (!http->header.has_end) {
+		/* Wait for the rest of the header, the file size may not be known yet */
+		return recv_len > 0 ? 0 : -ECONNRESET;
+	}
+
+	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, http_download_end(dl) - dl->progress);
 
 	if (data_len < expected_len) {
 		/* Wait for more data after the HTTP headers,
@@ -674,7 +730,7 @@ static int dl_http_download(struct downloader *dl)
 	if (data_len) {
 		dl_transport_evt_data(dl, dl->cfg.buf, data_len);
 	}
-	if (http->ranged) {
+	if (http->ranged && dl->host_cfg.range_override) {
 		http->ranged_progress += data_len;
 		if (http->ranged_progress < dl->host_cfg.range_override) {
 			/* Ranged query: read until a full fragment is received */
@@ -683,8 +739,8 @@ static int dl_http_download(struct downloader *dl)
 			http->new_data_req = true;
 		}
 	}
-	if (dl->progress == dl->file_size) {
-		/* A full file has been received */
+	if (dl->progress == http_download_end(dl)) {
+		/* A full file or range has been received */
 		dl->complete = true;
 		http->new_data_req = true;
 	}
@@ -704,6 +760,7 @@ static const struct dl_transport dl_transport_http = {
 	.connect = dl_http_connect,
 	.close = dl_http_close,
 	.download = dl_http_download,
+	.reuse = dl_http_reuse,
 };
 
 DL_TRANSPORT(http, &dl_transport_http);
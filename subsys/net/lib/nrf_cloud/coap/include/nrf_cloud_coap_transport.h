@@ -34,6 +34,10 @@ struct nrf_cloud_coap_client {
 };
 
 #define NRF_CLOUD_COAP_PROXY_RSC "proxy"
+#define COAP_D2C_RSC "msg/d2c"
+#define COAP_D2C_BULK_RSC COAP_D2C_RSC "/bulk"
+#define COAP_D2C_RAW_RSC COAP_D2C_RSC "/raw"
+#define COAP_D2C_BIN_RSC COAP_D2C_RSC "/bin"
 
 /**
  * @defgroup nrf_cloud_coap_transport nRF CoAP API
@@ -272,6 +276,12 @@ int nrf_cloud_coap_bin_log_send(const uint8_t * const buf, size_t buf_len, bool
 void nrf_cloud_coap_get_user_options(struct coap_client_option *options, size_t *num_options,
 				     const char *resource, const char *user_data);
 
+/**@brief Send the messages stored by the batch uploader, now that the device is connected.
+ *
+ * Only available when CONFIG_NRF_CLOUD_COAP_BATCH is enabled.
+ */
+void nrf_cloud_coap_batch_connected(void);
+
 /** @} */
 
 #ifdef __cplusplus
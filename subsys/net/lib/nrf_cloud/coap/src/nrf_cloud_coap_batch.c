@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/sys/byteorder.h>
+#include <date_time.h>
+#if defined(CONFIG_NRF_CLOUD_COAP_BATCH_FLUSH_ON_RRC_CONNECTED)
+#include <modem/lte_lc.h>
+#endif
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_coap.h>
+#include <net/nrf_cloud_codec.h>
+#include "nrf_cloud_coap_transport.h"
+#include "coap_codec.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(nrf_cloud_coap_batch, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
+
+/* Each stored message is prefixed with its length */
+#define REC_HDR_SIZE 2
+/* Size of the JSON array holding count messages of len bytes in total, with brackets and commas */
+#define ARRAY_LEN(len, count) ((len) + (count) + 1)
+#define PAYLOAD_MAX MIN(CONFIG_NRF_CLOUD_COAP_BATCH_PAYLOAD_MAX, CONFIG_COAP_CLIENT_BLOCK_SIZE)
+
+/* Encoded messages waiting to be sent, oldest first */
+static uint8_t records[CONFIG_NRF_CLOUD_COAP_BATCH_BUF_SIZE];
+static size_t records_len;
+static size_t records_count;
+/* The first messages, which are being sent and must not be dropped */
+static size_t sending_len;
+static size_t sending_count;
+static K_MUTEX_DEFINE(records_mut);
+
+/* Serializes the flushes, which share the payload buffer */
+static K_MUTEX_DEFINE(flush_mut);
+static uint8_t payload[PAYLOAD_MAX];
+
+static struct k_work_q batch_work_q;
+static K_THREAD_STACK_DEFINE(batch_stack, CONFIG_NRF_CLOUD_COAP_BATCH_STACK_SIZE);
+
+static void flush_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_fn);
+
+static int64_t get_ts(const int64_t ts_ms)
+{
+	int64_t ts = ts_ms;
+	int err;
+
+	if (ts != NRF_CLOUD_NO_TIMESTAMP) {
+		return ts;
+	}
+
+	/* The message is sent later, so it is timestamped when it is added */
+	err = date_time_now(&ts);
+	if (err) {
+		LOG_ERR("Error getting time: %d", err);
+		ts = 0;
+	}
+	return ts;
+}
+
+static size_t record_len(const size_t offset)
+{
+	return sys_get_le16(&records[offset]);
+}
+
+/* Size of the JSON array of the messages that are not being sent */
+static size_t unsent_array_len(void)
+{
+	size_t count = records_count - sending_count;
+
+	return ARRAY_LEN((records_len - sending_len) - count * REC_HDR_SIZE, count);
+}
+
+/* Drop the oldest message that is not being sent */
+static int record_drop(void)
+{
+	size_t len;
+
+	if (records_len == sending_len) {
+		return -ENOMEM;
+	}
+
+	len = REC_HDR_SIZE + record_len(sending_len);
+	memmove(&records[sending_len], &records[sending_len + len],
+		records_len - sending_len - len);
+	records_len -= len;
+	records_count--;
+
+	return 0;
+}
+
+static int record_add(const uint8_t *const msg, const size_t len)
+{
+	int err = 0;
+	bool first;
+
+	if (ARRAY_LEN(len, 1) > PAYLOAD_MAX || REC_HDR_SIZE + len > sizeof(records)) {
+		LOG_ERR("Message of %zu bytes does not fit in a batch", len);
+		return -E2BIG;
+	}
+
+	k_mutex_lock(&records_mut, K_FOREVER);
+
+	while (records_len + REC_HDR_SIZE + len > sizeof(records)) {
+		err = record_drop();
+		if (err) {
+			LOG_ERR("No room for the message");
+			goto unlock;
+		}
+		LOG_WRN("Buffer full, dropped the oldest message");
+	}
+
+	first = !records_count;
+	sys_put_le16(len, &records[records_len]);
+	memcpy(&records[records_len + REC_HDR_SIZE], msg, len);
+	records_len += REC_HDR_SIZE + len;
+	records_count++;
+
+	if (unsent_array_len() >= PAYLOAD_MAX) {
+		/* A batch is full */
+		k_work_reschedule_for_queue(&batch_work_q, &flush_work, K_NO_WAIT);
+	} else if (first) {
+		k_work_schedule_for_queue(&batch_work_q, &flush_work,
+					  K_SECONDS(CONFIG_NRF_CLOUD_COAP_BATCH_MAX_AGE_S));
+	}
+
+unlock:
+	k_mutex_unlock(&records_mut);
+	return err;
+}
+
+/* Copy the oldest messages that fit in one payload into a JSON array. Returns its length. */
+static size_t batch_build(void)
+{
+	size_t offset = 0;
+	size_t end = 1;
+	size_t count = 0;
+
+	k_mutex_lock(&records_mut, K_FOREVER);
+
+	while (offset < records_len) {
+		size_t msg_len = record_len(offset);
+
+		/* Room for the message and the comma or closing bracket after it */
+		if (end + msg_len + 1 > sizeof(payload)) {
+			break;
+		}
+
+		memcpy(&payload[end], &records[offset + REC_HDR_SIZE], msg_len);
+		end += msg_len;
+		payload[end++] = ',';
+		offset += REC_HDR_SIZE + msg_len;
+		count++;
+	}
+
+	sending_len = offset;
+	sending_count = count;
+
+	k_mutex_unlock(&records_mut);
+
+	if (!count) {
+		return 0;
+	}
+
+	payload[0] = '[';
+	payload[end - 1] = ']';
+
+	return end;
+}
+
+static void batch_done(const bool sent)
+{
+	k_mutex_lock(&records_mut, K_FOREVER);
+
+	if (sent) {
+		memmove(records, &records[sending_len], records_len - sending_len);
+		records_len -= sending_len;
+		records_count -= sending_count;
+	}
+
+	sending_len = 0;
+	sending_count = 0;
+
+	k_mutex_unlock(&records_mut);
+}
+
+static void result_code_cb(const struct coap_client_response_data *data, void *user)
+{
+	*(int *)user = data->result_code;
+}
+
+static int batch_send(const uint8_t *const buf, const size_t len)
+{
+	int result = 0;
+	int err;
+
+	/* The bulk resource only accepts JSON, see nrf_cloud_coap_obj_send() */
+	err = nrf_cloud_coap_post(COAP_D2C_BULK_RSC, NULL, buf, len,
+				  COAP_CONTENT_FORMAT_APP_JSON, true, result_code_cb, &result);
+	if (err < 0) {
+		LOG_ERR("Failed to send POST request: %d", err);
+		return err;
+	}
+
+	if (result < 0) {
+		LOG_ERR("Send failed: %d", result);
+		return result;
+	} else if (result >= COAP_RESPONSE_CODE_BAD_REQUEST) {
+		LOG_RESULT_CODE_ERR("Error from server:", result);
+		return result;
+	}
+
+	return 0;
+}
+
+int nrf_cloud_coap_batch_flush(void)
+{
+	int err = 0;
+	size_t len;
+
+	k_mutex_lock(&flush_mut, K_FOREVER);
+
+	while (true) {
+		if (!nrf_cloud_coap_is_connected()) {
+			err = -EACCES;
+			break;
+		}
+
+		len = batch_build();
+		if (!len) {
+			break;
+		}
+
+		LOG_DBG("Sending %zu messages in %zu bytes", sending_count, len);
+
+		err = batch_send(payload, len);
+
+		/* A batch the server rejected would be rejected again, so it is dropped */
+		batch_done(!err || (err >= COAP_RESPONSE_CODE_BAD_REQUEST &&
+				    err < COAP_RESPONSE_CODE_INTERNAL_ERROR));
+		if (err) {
+			break;
+		}
+	}
+
+	k_mutex_lock(&records_mut, K_FOREVER);
+	if (records_count) {
+		/* Try again later, or when connected */
+		k_work_schedule_for_queue(&batch_work_q, &flush_work,
+					  K_SECONDS(CONFIG_NRF_CLOUD_COAP_BATCH_MAX_AGE_S));
+	} else {
+		(void)k_work_cancel_delayable(&flush_work);
+	}
+	k_mutex_unlock(&records_mut);
+
+	k_mutex_unlock(&flush_mut);
+
+	return err;
+}
+
+static void flush_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)nrf_cloud_coap_batch_flush();
+}
+
+void nrf_cloud_coap_batch_connected(void)
+{
+	k_mutex_lock(&records_mut, K_FOREVER);
+	if (records_count) {
+		k_work_reschedule_for_queue(&batch_work_q, &flush_work, K_NO_WAIT);
+	}
+	k_mutex_unlock(&records_mut);
+}
+
+/* Encode the message and store it. The object is freed. */
+static int record_obj_add(struct nrf_cloud_obj *const obj)
+{
+	int err;
+
+	err = nrf_cloud_obj_cloud_encode(obj);
+	if (err) {
+		LOG_ERR("Unable to encode data: %d", err);
+		goto cleanup;
+	}
+
+	err = record_add(obj->encoded_data.ptr, obj->encoded_data.len);
+	(void)nrf_cloud_obj_cloud_encoded_free(obj);
+
+cleanup:
+	(void)nrf_cloud_obj_free(obj);
+	return err;
+}
+
+int nrf_cloud_coap_batch_sensor_add(const char *app_id, double value, int64_t ts_ms)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	int err;
+
+	if (!app_id) {
+		return -EINVAL;
+	}
+
+	err = nrf_cloud_obj_msg_init(&obj, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	err = err ? err : nrf_cloud_obj_num_add(&obj, NRF_CLOUD_JSON_DATA_KEY, value, false);
+	err = err ? err : nrf_cloud_obj_ts_add(&obj, get_ts(ts_ms));
+	if (err) {
+		LOG_ERR("Unable to encode sensor data: %d", err);
+		(void)nrf_cloud_obj_free(&obj);
+		return err;
+	}
+
+	return record_obj_add(&obj);
+}
+
+int nrf_cloud_coap_batch_message_add(const char *app_id, const char *message, int64_t ts_ms)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	int err;
+
+	if (!app_id || !message) {
+		return -EINVAL;
+	}
+
+	err = nrf_cloud_obj_msg_init(&obj, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	err = err ? err : nrf_cloud_obj_str_add(&obj, NRF_CLOUD_JSON_DATA_KEY, message, false);
+	err = err ? err : nrf_cloud_obj_ts_add(&obj, get_ts(ts_ms));
+	if (err) {
+		LOG_ERR("Unable to encode message: %d", err);
+		(void)nrf_cloud_obj_free(&obj);
+		return err;
+	}
+
+	return record_obj_add(&obj);
+}
+
+int nrf_cloud_coap_batch_location_add(const struct nrf_cloud_gnss_data *const gnss)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	struct nrf_cloud_gnss_data data;
+	int err;
+
+	if (!gnss) {
+		return -EINVAL;
+	}
+
+	if (gnss->type != NRF_CLOUD_GNSS_TYPE_PVT) {
+		LOG_ERR("Only PVT format is supported");
+		return -ENOTSUP;
+	}
+
+	data = *gnss;
+	data.ts_ms = get_ts(gnss->ts_ms);
+
+	err = nrf_cloud_obj_gnss_msg_create(&obj, &data);
+	if (err) {
+		LOG_ERR("Unable to encode GNSS PVT data: %d", err);
+		(void)nrf_cloud_obj_free(&obj);
+		return err;
+	}
+
+	return record_obj_add(&obj);
+}
+
+#if defined(CONFIG_NRF_CLOUD_COAP_BATCH_FLUSH_ON_RRC_CONNECTED)
+static void lte_handler(const struct lte_lc_evt *const evt)
+{
+	if (evt->type == LTE_LC_EVT_RRC_UPDATE && evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED) {
+		/* The radio is already on, so sending now costs no extra wake-up */
+		nrf_cloud_coap_batch_connected();
+	}
+}
+#endif
+
+static int batch_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "nrf_cloud_coap_batch",
+	};
+
+	k_work_queue_init(&batch_work_q);
+	k_work_queue_start(&batch_work_q, batch_stack, K_THREAD_STACK_SIZEOF(batch_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+#if defined(CONFIG_NRF_CLOUD_COAP_BATCH_FLUSH_ON_RRC_CONNECTED)
+	lte_lc_register_handler(lte_handler);
+#endif
+
+	return 0;
+}
+
+SYS_INIT(batch_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -60,16 +60,19 @@ struct cc_xfer_data {
 	coap_client_response_cb_t cb;
 	void *user_data;
 	int result_code;
-	struct k_sem *sem;
+	/* Given when the transfer has ended */
+	struct k_sem sem;
 	atomic_t used;
 };
 
-/* Semaphore to be used with internal coap_client requests */
-static K_SEM_DEFINE(cb_sem, 0, 1);
-/* Semaphore to be used when doing authorization with an external coap_client */
-static K_SEM_DEFINE(ext_cc_sem, 0, 1);
-/* Mutex to be used when using the internal coap_client */
+/* Mutex to be used when using the internal coap_client. With an NSTART larger than 1,
+ * requests hold it only while they are sent, not while they wait for the response.
+ */
 static K_MUTEX_DEFINE(internal_transfer_mut);
+/* Held while a response is handled, so that the transfer data is not released meanwhile */
+static K_MUTEX_DEFINE(xfer_ctx_mut);
+/* Limits the number of outstanding requests of the internal coap_client */
+static K_SEM_DEFINE(nstart_sem, CONFIG_NRF_CLOUD_COAP_NSTART, CONFIG_NRF_CLOUD_COAP_NSTART);
 
 static struct nrf_cloud_coap_client internal_cc = {0};
 
@@ -138,14 +141,15 @@ static struct cc_xfer_data *xfer_ctx_take(void)
 static void xfer_ctx_release(struct cc_xfer_data *ctx)
 {
 	if (ctx) {
+		k_mutex_lock(&xfer_ctx_mut, K_FOREVER);
 		atomic_clear_bit(&ctx->used, 0);
+		k_mutex_unlock(&xfer_ctx_mut);
 	}
 }
 
 static struct cc_xfer_data *xfer_data_init(struct nrf_cloud_coap_client *cc,
 					   coap_client_response_cb_t cb,
-					   void *user,
-					   struct k_sem *sem)
+					   void *user)
 {
 	struct cc_xfer_data *xfer = xfer_ctx_take();
 
@@ -157,7 +161,7 @@ static struct cc_xfer_data *xfer_data_init(struct nrf_cloud_coap_client *cc,
 	xfer->cb = cb;
 	xfer->user_data = user;
 	xfer->result_code = -ECANCELED;
-	xfer->sem = sem;
+	k_sem_init(&xfer->sem, 0, 1);
 	return xfer;
 }
 
@@ -388,6 +392,10 @@ int nrf_cloud_coap_connect(const char * const app_ver)
 		goto exit;
 	}
 
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_COAP_BATCH)) {
+		nrf_cloud_coap_batch_connected();
+	}
+
 	/* On initial connect, set the control section in the shadow */
 	update_control_section();
 
@@ -426,6 +434,10 @@ int nrf_cloud_coap_resume(void)
 	err = nrf_cloud_coap_transport_resume(&internal_cc);
 	k_mutex_unlock(&internal_transfer_mut);
 
+	if (!err && IS_ENABLED(CONFIG_NRF_CLOUD_COAP_BATCH)) {
+		nrf_cloud_coap_batch_connected();
+	}
+
 	return err;
 }
 
@@ -481,52 +493,59 @@ static void client_callback(const struct coap_client_response_data *data, void *
 		LOG_ERR("Unexpected response: %*s", data->payload_len, data->payload);
 	}
 	/* Sanitize the xfer struct to ensure callback is valid, in case transfer
-	 * was cancelled or timed out.
+	 * was cancelled or timed out. The transfer data is checked and signaled
+	 * under the mutex, so it cannot be released and taken by a new transfer
+	 * in between. The request is cancelled before its transfer data is released,
+	 * so no callback of an ended request starts afterwards.
 	 */
-	if (atomic_test_bit(&xfer->used, 0)) {
-		xfer->result_code = data->result_code;
-		if (xfer->cb) {
-			LOG_DBG("Calling user's callback %p", xfer->cb);
-			xfer->cb(data, xfer->user_data);
-		}
+	k_mutex_lock(&xfer_ctx_mut, K_FOREVER);
+	if (!atomic_test_bit(&xfer->used, 0)) {
+		k_mutex_unlock(&xfer_ctx_mut);
+		return;
+	}
+
+	xfer->result_code = data->result_code;
+	if (xfer->cb) {
+		LOG_DBG("Calling user's callback %p", xfer->cb);
+		xfer->cb(data, xfer->user_data);
 	}
 	if (data->last_block || (data->result_code >= COAP_RESPONSE_CODE_BAD_REQUEST)) {
 		LOG_DBG("End of client transfer");
-		if (xfer->sem) {
-			k_sem_give(xfer->sem);
-		}
+		k_sem_give(&xfer->sem);
 	}
+	k_mutex_unlock(&xfer_ctx_mut);
 }
 
 
 BUILD_ASSERT((NRF_CLOUD_COAP_NUM_INTERNAL_OPTIONS + CONFIG_NRF_CLOUD_COAP_MAX_USER_OPTIONS) <=
 		CONFIG_COAP_CLIENT_MAX_EXTRA_OPTIONS);
-static int client_transfer(enum coap_method method,
+static int client_transfer(struct nrf_cloud_coap_client *const nrfc_cc,
+			   enum coap_method method,
 			   const char *resource, const char *query,
 			   const uint8_t *buf, size_t buf_len,
 			   enum coap_content_format fmt_out,
 			   enum coap_content_format fmt_in,
 			   bool response_expected,
 			   bool reliable,
-			   struct cc_xfer_data *xfer)
+			   coap_client_response_cb_t cb, void *user)
 {
-	if (xfer == NULL) {
-		return -ENOBUFS;
-	}
 	__ASSERT_NO_MSG(resource != NULL);
 
 	int err = 0;
 	int retry;
+	const bool internal = is_internal(nrfc_cc);
+	bool locked = false;
+	bool slot = false;
+	struct cc_xfer_data *xfer = NULL;
 	struct coap_client_request request = {
 		.method = method,
 		.confirmable = reliable,
 		.fmt = fmt_out,
 		.payload = (uint8_t *)buf,
 		.len = buf_len,
-		.cb = client_callback,
-		.user_data = xfer
+		.cb = client_callback
 	};
-	struct coap_client *const cc = &xfer->nrfc_cc->cc;
+	struct coap_client *const cc = &nrfc_cc->cc;
 
 	size_t num_internal_options = 0;
 	if (response_expected) {
@@ -541,7 +560,7 @@ static int client_transfer(enum coap_method method,
 	size_t num_user_options = CONFIG_NRF_CLOUD_COAP_MAX_USER_OPTIONS;
 #if (CONFIG_NRF_CLOUD_COAP_MAX_USER_OPTIONS > 0)
 	nrf_cloud_coap_get_user_options(&request.options[num_internal_options], &num_user_options,
-		resource, xfer->user_data);
+		resource, user);
 #endif
 	const size_t total_options = num_internal_options + num_user_options;
 
@@ -566,10 +585,28 @@ static int client_transfer(enum coap_method method,
 		response_expected ? fmt_name(fmt_in) : "none");
 #endif /* CONFIG_NRF_CLOUD_COAP_LOG_LEVEL_DBG */
 
+	if (internal) {
+		/* Send one request at a time, and let up to NSTART requests wait for
+		 * their responses. The coap_client matches the responses by token.
+		 * With an NSTART of 1, the mutex is held until the response is received.
+		 */
+		k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+		locked = true;
+		k_sem_take(&nstart_sem, K_FOREVER);
+		slot = true;
+	}
+
+	/* Taken after the NSTART slot so that waiting requests do not exhaust the pool */
+	xfer = xfer_data_init(nrfc_cc, cb, user);
+	if (xfer == NULL) {
+		err = -ENOBUFS;
+		goto transfer_end;
+	}
+	request.user_data = xfer;
+
 	retry = 0;
-	k_sem_reset(xfer->sem);
-	while ((xfer->nrfc_cc->sock >= 0) &&
-	       (err = coap_client_req(cc, xfer->nrfc_cc->sock, NULL, &request, NULL)) == -EAGAIN) {
+	while ((nrfc_cc->sock >= 0) &&
+	       (err = coap_client_req(cc, nrfc_cc->sock, NULL, &request, NULL)) == -EAGAIN) {
 		if (!nrf_cloud_coap_is_connected()) {
 			err = -EACCES;
 			break;
@@ -590,7 +627,7 @@ static int client_transfer(enum coap_method method,
 		LOG_ERR("Error sending CoAP request: %d", err);
 	} else {
 
-		if (xfer->nrfc_cc->sock < 0) {
+		if (nrfc_cc->sock < 0) {
 			LOG_ERR("Socket closed during CoAP request");
 			err = -ESHUTDOWN;
 			goto transfer_end;
@@ -599,10 +636,17 @@ static int client_transfer(enum coap_method method,
 		if (buf_len) {
 			LOG_HEXDUMP_DBG(buf, MIN(64, buf_len), "Sent");
 		}
+
+		if (locked && (CONFIG_NRF_CLOUD_COAP_NSTART > 1)) {
+			/* Let other requests be sent while waiting for the response */
+			k_mutex_unlock(&internal_transfer_mut);
+			locked = false;
+		}
+
 		/* Wait for coap_client to exhaust retries when reliable transfer selected,
 		 * otherwise wait a finite time because response might never come.
 		 */
-		err = k_sem_take(xfer->sem, reliable ? K_FOREVER : K_SECONDS(NON_RESP_WAIT_S));
+		err = k_sem_take(&xfer->sem, reliable ? K_FOREVER : K_SECONDS(NON_RESP_WAIT_S));
 		if (!err) {
 			LOG_DBG("Got callback");
 		} else {
@@ -620,8 +664,19 @@ static int client_transfer(enum coap_method method,
 	}
 
 transfer_end:
-	xfer_ctx_release(xfer);
-	coap_client_cancel_request(cc, &request);
+	if (locked) {
+		k_mutex_unlock(&internal_transfer_mut);
+	}
+	/* Cancel before releasing, so that a late response cannot end a new transfer
+	 * using the same transfer data.
+	 */
+	if (xfer) {
+		coap_client_cancel_request(cc, &request);
+		xfer_ctx_release(xfer);
+	}
+	if (slot) {
+		k_sem_give(&nstart_sem);
+	}
 	if (err == -ETIMEDOUT && IS_ENABLED(CONFIG_NRF_CLOUD_COAP_DISCONNECT_ON_FAILED_REQUEST)) {
 		nrf_cloud_coap_disconnect();
 	}
@@ -634,16 +689,8 @@ int nrf_cloud_coap_get(const char *resource, const char *query,
 		       enum coap_content_format fmt_in, bool reliable,
 		       coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_GET, resource, query,
-			      buf, len, fmt_out, fmt_in, true, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_GET, resource, query,
+			       buf, len, fmt_out, fmt_in, true, reliable, cb, user);
 }
 
 int nrf_cloud_coap_post(const char *resource, const char *query,
@@ -651,16 +698,8 @@ int nrf_cloud_coap_post(const char *resource, const char *query,
 			enum coap_content_format fmt, bool reliable,
 			coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_POST, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_POST, resource, query,
+			       buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_put(const char *resource, const char *query,
@@ -668,16 +707,8 @@ int nrf_cloud_coap_put(const char *resource, const char *query,
 		       enum coap_content_format fmt, bool reliable,
 		       coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_PUT, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_PUT, resource, query,
+			       buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_delete(const char *resource, const char *query,
@@ -685,16 +716,8 @@ int nrf_cloud_coap_delete(const char *resource, const char *query,
 			  enum coap_content_format fmt, bool reliable,
 			  coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_DELETE, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_DELETE, resource, query,
+			       buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_fetch(const char *resource, const char *query,
@@ -703,16 +726,8 @@ int nrf_cloud_coap_fetch(const char *resource, const char *query,
 			 enum coap_content_format fmt_in, bool reliable,
 			 coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_FETCH, resource, query,
-			      buf, len, fmt_out, fmt_in, true, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_FETCH, resource, query,
+			       buf, len, fmt_out, fmt_in, true, reliable, cb, user);
 }
 
 int nrf_cloud_coap_patch(const char *resource, const char *query,
@@ -720,16 +735,8 @@ int nrf_cloud_coap_patch(const char *resource, const char *query,
 			 enum coap_content_format fmt, bool reliable,
 			 coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_PATCH, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return client_transfer(&internal_cc, COAP_METHOD_PATCH, resource, query,
+			       buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 static void auth_cb(const struct coap_client_response_data *data, void *user_data)
@@ -747,13 +754,10 @@ static int nrf_cloud_coap_auth_post(struct nrf_cloud_coap_client *const client,
 			     const uint8_t *jwt, size_t jwt_len)
 {
 	/* Use the nrf_cloud_coap_client as the user data so the auth flag can be set */
-	void *xfer = xfer_data_init(client, auth_cb, client,
-				    is_internal(client) ? &cb_sem : &ext_cc_sem);
-
-	return client_transfer(COAP_METHOD_POST, NRF_CLOUD_COAP_AUTH_RSC,
+	return client_transfer(client, COAP_METHOD_POST, NRF_CLOUD_COAP_AUTH_RSC,
 			       ver_string, jwt, jwt_len,
 			       COAP_CONTENT_FORMAT_TEXT_PLAIN, COAP_CONTENT_FORMAT_TEXT_PLAIN,
-			       false, true, xfer);
+			       false, true, auth_cb, client);
 }
 
 int nrf_cloud_coap_disconnect(void)
@@ -28,6 +28,7 @@
 #include "nrf_cloud_agnss_schema_v1.h"
 #include "nrf_cloud_fota.h"
 #include "nrf_cloud_transport.h"
+#include "nrf_cloud_json_writer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -242,6 +243,36 @@ int nrf_cloud_obj_location_request_payload_add(struct nrf_cloud_obj *const obj,
 int nrf_cloud_wifi_req_json_encode(struct wifi_scan_info const *const wifi,
 				   cJSON *const req_obj_out);
 
+/** @brief Write the cellular positioning request member to the JSON writer.
+ * Same output as @ref nrf_cloud_cell_pos_req_json_encode, without cJSON.
+ *
+ * @retval 0 Success.
+ * @retval -ENODATA No current cell and no GCI cells, nothing was written.
+ */
+int nrf_cloud_cell_pos_req_json_write(struct nrf_cloud_json_writer *const w,
+				      struct lte_lc_cells_info const *const inf);
+
+/** @brief Write the Wi-Fi positioning request member to the JSON writer.
+ * Same output as @ref nrf_cloud_wifi_req_json_encode, without cJSON.
+ *
+ * @retval 0 Success.
+ * @retval -ENODATA Access point (non-local) count less than NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN,
+ *                  nothing was written.
+ */
+int nrf_cloud_wifi_req_json_write(struct nrf_cloud_json_writer *const w,
+				  struct wifi_scan_info const *const wifi);
+
+/** @brief Write a complete location request message to the JSON writer.
+ * Same output as @ref nrf_cloud_obj_location_request_create_timestamped, without cJSON.
+ * A timestamp of zero is not included. Warnings about excluded data are only logged when
+ * the writer is counting, so that they are logged once when the message is sized first.
+ */
+int nrf_cloud_location_req_json_write(struct nrf_cloud_json_writer *const w,
+				      struct lte_lc_cells_info const *const cells_inf,
+				      struct wifi_scan_info const *const wifi_inf,
+				      struct nrf_cloud_location_config const *const config,
+				      const int64_t timestamp);
+
 /** @brief Get the required information from the modem for a single-cell location request. */
 int nrf_cloud_get_single_cell_modem_info(struct lte_lc_cell *const cell_inf);
 
@@ -280,6 +311,9 @@ int get_bool_from_obj(const cJSON *const obj, const char *const key, bool *bool_
 /** @brief Send the cJSON object to nRF Cloud on the d2c topic */
 int json_send_to_cloud(cJSON *const request);
 
+/** @brief Send the JSON string to nRF Cloud on the d2c topic */
+int json_str_send_to_cloud(const char *const request, const size_t len);
+
 /** @brief Create a cJSON object containing the specified appId and messageType.
  * If successful, user is responsible for calling @ref cJSON_Delete to free
  * the cJSON object's memory.
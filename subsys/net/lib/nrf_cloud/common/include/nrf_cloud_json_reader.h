@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_READER_H__
+#define NRF_CLOUD_JSON_READER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Maximum nesting depth of objects and arrays. */
+#define NRF_CLOUD_JSON_READER_DEPTH_MAX 16
+
+/** @brief Type of a JSON token. */
+enum nrf_cloud_json_tok_type {
+	NRF_CLOUD_JSON_TOK_OBJECT,
+	NRF_CLOUD_JSON_TOK_ARRAY,
+	NRF_CLOUD_JSON_TOK_STRING,
+	/** Number, true, false or null */
+	NRF_CLOUD_JSON_TOK_PRIMITIVE,
+};
+
+/** @brief JSON token, a slice of the parsed text.
+ *
+ * Tokens are stored in document order. An object is followed by its keys, each key followed
+ * by its value. An array is followed by its values.
+ */
+struct nrf_cloud_json_tok {
+	/** Offset of the first character. For strings, the character after the opening quote. */
+	uint16_t start;
+	/** Offset after the last character. For strings, the offset of the closing quote. */
+	uint16_t end;
+	/** Number of members of an object, or number of values of an array. */
+	uint16_t size;
+	/** Token type, @ref nrf_cloud_json_tok_type. */
+	uint8_t type;
+};
+
+/** @brief Split JSON text into tokens, without copying or allocating.
+ *
+ * The text does not need to be null-terminated. The tokens refer to the text, which must be
+ * kept while the tokens are used.
+ *
+ * @retval Number of tokens on success.
+ * @retval -EBADMSG The text is not valid JSON.
+ * @retval -E2BIG The text has more than @p toks_max tokens, is nested too deeply or is too long.
+ */
+int nrf_cloud_json_tokenize(const char *const js, const size_t len,
+			    struct nrf_cloud_json_tok *const toks, const size_t toks_max);
+
+/** @brief Get the index of the token after the given token and all the tokens it contains. */
+int nrf_cloud_json_tok_next(const struct nrf_cloud_json_tok *const toks, const int count,
+			    const int idx);
+
+/** @brief Get the value of a member of an object.
+ *
+ * @retval Index of the value token on success.
+ * @retval -EINVAL The token is not an object.
+ * @retval -ENOENT The member was not found.
+ */
+int nrf_cloud_json_tok_obj_get(const char *const js, const struct nrf_cloud_json_tok *const toks,
+			       const int count, const int obj, const char *const key);
+
+/** @brief Get a value of an array.
+ *
+ * @retval Index of the value token on success.
+ * @retval -EINVAL The token is not an array.
+ * @retval -ENOENT The index is out of range.
+ */
+int nrf_cloud_json_tok_array_get(const struct nrf_cloud_json_tok *const toks, const int count,
+				 const int array, const int index);
+
+/** @brief Check if a token is a string equal to the given string. */
+bool nrf_cloud_json_tok_str_eq(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			       const char *const str);
+
+/** @brief Copy the unescaped value of a string token and null-terminate it.
+ *
+ * @retval Length of the string on success.
+ * @retval -EINVAL The token is not a string.
+ * @retval -ENOBUFS The string and the null-terminator do not fit in the buffer.
+ */
+int nrf_cloud_json_tok_str_copy(const char *const js, const struct nrf_cloud_json_tok *const tok,
+				char *const buf, const size_t size);
+
+/** @brief Get the value of a number token.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL The token is not a number.
+ * @retval -ERANGE The number is out of the range of a double.
+ */
+int nrf_cloud_json_tok_num(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			   double *const out);
+
+/** @brief Get the value of a number token as an integer, saturated like cJSON does.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL The token is not a number.
+ * @retval -ERANGE The number is out of the range of a double.
+ */
+int nrf_cloud_json_tok_int(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			   int *const out);
+
+/** @brief Check if a token is null. */
+bool nrf_cloud_json_tok_is_null(const char *const js, const struct nrf_cloud_json_tok *const tok);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_READER_H__ */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_WRITER_H__
+#define NRF_CLOUD_JSON_WRITER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Maximum nesting depth of objects and arrays. */
+#define NRF_CLOUD_JSON_WRITER_DEPTH_MAX 32
+
+/** @brief Output handler of the JSON writer.
+ *
+ * Called with the buffered output when the buffer is full, and when the writer is finished.
+ *
+ * @return 0 on success, otherwise a negative error code that is returned by
+ *         @ref nrf_cloud_json_writer_finish.
+ */
+typedef int (*nrf_cloud_json_writer_flush_t)(const char *buf, size_t len, void *ctx);
+
+/** @brief Streaming JSON writer.
+ *
+ * Serializes JSON into a caller provided buffer without allocating memory.
+ * The output is the same as the unformatted output of cJSON.
+ *
+ * Errors are sticky: after the first error the following calls do nothing, and the error is
+ * returned by @ref nrf_cloud_json_writer_finish. This lets encoders write a whole message and
+ * check for errors once.
+ *
+ * Members are internal to the writer.
+ */
+struct nrf_cloud_json_writer {
+	char *buf;
+	size_t size;
+	size_t len;
+	size_t total;
+	nrf_cloud_json_writer_flush_t flush;
+	void *ctx;
+	int err;
+	/* Bit per nesting level, set when the object or array has a member */
+	uint32_t has_member;
+	uint8_t depth;
+};
+
+/** @brief Initialize the JSON writer.
+ *
+ * - With a buffer and no flush handler, the output is written to the buffer and
+ *   null-terminated. @c -ENOMEM is returned if it does not fit.
+ * - With a buffer and a flush handler, the buffer is flushed to the handler when it is full,
+ *   for instance to send the output to a socket in chunks.
+ * - Without a buffer, the output is only counted. This gives the length of the output.
+ */
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size, nrf_cloud_json_writer_flush_t flush,
+				void *const ctx);
+
+/** @brief Finish writing, flushing and null-terminating the output.
+ *
+ * @return Length of the output, not including the null-terminator, on success.
+ *         Negative error code of the first error otherwise.
+ */
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *const w);
+
+/** @brief Check if the writer only counts the length of the output.
+ *
+ * Encoders that are run twice, first to size a buffer and then to fill it, can use this to
+ * log their warnings only once.
+ */
+bool nrf_cloud_json_writer_is_counting(const struct nrf_cloud_json_writer *const w);
+
+/** @brief Start an object. The key is NULL at the top level and inside arrays. */
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current object. */
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Start an array. The key is NULL at the top level and inside arrays. */
+void nrf_cloud_json_array_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current array. */
+void nrf_cloud_json_array_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Add a null-terminated string. */
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val);
+
+/** @brief Add a string of the given length. */
+void nrf_cloud_json_strn_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const char *const val, const size_t len);
+
+/** @brief Add an integer. */
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const int64_t val);
+
+/** @brief Add a number, formatted the same way as cJSON does. */
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val);
+
+/** @brief Add a boolean. */
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_WRITER_H__ */
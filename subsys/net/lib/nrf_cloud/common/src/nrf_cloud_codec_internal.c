@@ -7,6 +7,8 @@
 #include "nrf_cloud_codec_internal.h"
 #include "nrf_cloud_bootloader_version.h"
 #include "nrf_cloud_mem.h"
+#include "nrf_cloud_json_writer.h"
+#include "nrf_cloud_json_reader.h"
 #include <net/nrf_cloud_codec.h>
 #include <net/nrf_cloud_location.h>
 #include <stdbool.h>
@@ -1434,6 +1436,153 @@ clean_up:
 	return ret;
 }
 
+static void fota_job_decode_error_clean(struct nrf_cloud_fota_job_info *const job_info)
+{
+	/* On error, leave the job ID so that the job can be cancelled */
+	nrf_cloud_free(job_info->host);
+	job_info->host = NULL;
+	nrf_cloud_free(job_info->path);
+	job_info->path = NULL;
+	job_info->type = NRF_CLOUD_FOTA_TYPE__INVALID;
+}
+
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+static char *tok_strdup(const char *const js, const struct nrf_cloud_json_tok *const toks,
+			const int tok)
+{
+	char *dest;
+	size_t size;
+
+	if ((tok < 0) || (toks[tok].type != NRF_CLOUD_JSON_TOK_STRING)) {
+		return NULL;
+	}
+
+	/* The unescaped string is never longer than the escaped one */
+	size = toks[tok].end - toks[tok].start + 1;
+	dest = nrf_cloud_calloc(size, 1);
+	if (dest && (nrf_cloud_json_tok_str_copy(js, &toks[tok], dest, size) < 0)) {
+		nrf_cloud_free(dest);
+		dest = NULL;
+	}
+
+	return dest;
+}
+
+static int tok_array_int_get(const char *const js, const struct nrf_cloud_json_tok *const toks,
+			     const int count, const int array, const int index, int *number_out)
+{
+	int tok = nrf_cloud_json_tok_array_get(toks, count, array, index);
+
+	if (tok < 0) {
+		return -EINVAL;
+	}
+
+	return nrf_cloud_json_tok_int(js, &toks[tok], number_out);
+}
+
+/* Same as the cJSON decoding below, reading the fields from the input buffer.
+ * Only the strings that are kept in the job info are allocated.
+ */
+static int fota_job_decode_in_place(struct nrf_cloud_fota_job_info *const job_info,
+				    bt_addr_t *const ble_id,
+				    const struct nrf_cloud_data *const input)
+{
+	struct nrf_cloud_json_tok toks[CONFIG_NRF_CLOUD_JSON_DECODE_TOKENS_MAX];
+	const char *js = input->ptr;
+	const size_t len = strnlen(js, input->len);
+	int err = -ENOMSG;
+	size_t job_id_len;
+	int offset = !ble_id ? 1 : 0;
+	int count;
+
+	count = nrf_cloud_json_tokenize(js, len, toks, ARRAY_SIZE(toks));
+	if (count == -E2BIG) {
+		return count;
+	}
+
+	if ((count < 0) || (toks[0].type != NRF_CLOUD_JSON_TOK_ARRAY)) {
+		LOG_ERR("Invalid JSON array");
+		err = -EINVAL;
+		goto cleanup;
+	}
+
+	LOG_DBG("JSON array: %.*s", (int)len, js);
+
+	memset(job_info, 0, sizeof(*job_info));
+
+	/* Get the job ID separately, it may be needed to reject an invalid job */
+	job_info->id = tok_strdup(js, toks,
+				  nrf_cloud_json_tok_array_get(toks, count, 0,
+							       RCV_ITEM_IDX_JOB_ID - offset));
+	if (job_info->id == NULL) {
+		LOG_ERR("FOTA job ID not found");
+		goto cleanup;
+	}
+
+	/* Check that the job ID is a valid size */
+	job_id_len = strlen(job_info->id);
+	if (job_id_len > (NRF_CLOUD_FOTA_JOB_ID_SIZE - 1)) {
+		LOG_ERR("Job ID length: %d, exceeds allowed length: %d", job_id_len,
+			NRF_CLOUD_FOTA_JOB_ID_SIZE - 1);
+		goto cleanup;
+	}
+
+#if CONFIG_NRF_CLOUD_FOTA_BLE_DEVICES
+	if (ble_id) {
+		char ble_str[BT_ADDR_STR_LEN];
+		int tok = nrf_cloud_json_tok_array_get(toks, count, 0, RCV_ITEM_IDX_BLE_ID);
+		int ret = (tok < 0) ? tok :
+			  nrf_cloud_json_tok_str_copy(js, &toks[tok], ble_str, sizeof(ble_str));
+
+		if ((ret == -ENOBUFS) || ((ret >= 0) && bt_addr_from_str(ble_str, ble_id))) {
+			err = -EADDRNOTAVAIL;
+			LOG_ERR("Invalid BLE ID: %.*s", toks[tok].end - toks[tok].start,
+				&js[toks[tok].start]);
+			goto cleanup;
+		} else if (ret < 0) {
+			LOG_ERR("Failed to get BLE ID from job");
+			goto cleanup;
+		}
+	}
+#endif
+
+	/* Get and allocate host and path strings */
+	job_info->host = tok_strdup(js, toks,
+				    nrf_cloud_json_tok_array_get(toks, count, 0,
+								 RCV_ITEM_IDX_FILE_HOST - offset));
+	job_info->path = tok_strdup(js, toks,
+				    nrf_cloud_json_tok_array_get(toks, count, 0,
+								 RCV_ITEM_IDX_FILE_PATH - offset));
+
+	/* Get type and file size */
+	if ((job_info->host == NULL) || (job_info->path == NULL) ||
+	    tok_array_int_get(js, toks, count, 0, RCV_ITEM_IDX_FW_TYPE - offset,
+			      (int *)&job_info->type) ||
+	    tok_array_int_get(js, toks, count, 0, RCV_ITEM_IDX_FILE_SIZE - offset,
+			      &job_info->file_size)) {
+		LOG_ERR("Error parsing job info");
+		goto cleanup;
+	}
+
+	/* Check that the FOTA type is valid */
+	if (job_info->type < NRF_CLOUD_FOTA_TYPE__FIRST ||
+	    job_info->type >= NRF_CLOUD_FOTA_TYPE__INVALID) {
+		LOG_ERR("Invalid FOTA type: %d", job_info->type);
+		goto cleanup;
+	}
+
+	/* Success */
+	err = 0;
+
+cleanup:
+	if (err) {
+		fota_job_decode_error_clean(job_info);
+	}
+
+	return err;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE */
+
 int nrf_cloud_fota_job_decode(struct nrf_cloud_fota_job_info *const job_info,
 			      bt_addr_t *const ble_id, const struct nrf_cloud_data *const input)
 {
@@ -1441,6 +1590,16 @@ int nrf_cloud_fota_job_decode(struct nrf_cloud_fota_job_info *const job_info,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+	int ret = fota_job_decode_in_place(job_info, ble_id, input);
+
+	if (ret != -E2BIG) {
+		return ret;
+	}
+
+	LOG_DBG("FOTA job has too many JSON tokens, decoding with cJSON");
+#endif
+
 	int err = -ENOMSG;
 	size_t job_id_len;
 	int offset = !ble_id ? 1 : 0;
@@ -1524,12 +1683,7 @@ cleanup:
 	}
 
 	if (err) {
-		/* On error, leave the job ID so that the job can be cancelled */
-		nrf_cloud_free(job_info->host);
-		job_info->host = NULL;
-		nrf_cloud_free(job_info->path);
-		job_info->path = NULL;
-		job_info->type = NRF_CLOUD_FOTA_TYPE__INVALID;
+		fota_job_decode_error_clean(job_info);
 	}
 
 	return err;
@@ -2239,6 +2393,285 @@ cleanup:
 	return err;
 }
 
+/* Members of a cell, the neighbor cells of the current cell are added after them */
+static void lte_inf_json_write(struct nrf_cloud_json_writer *const w,
+			       struct lte_lc_cell const *const inf)
+{
+	/* Required parameters for the API call */
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_ECI, inf->id);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MCC, inf->mcc);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_MNC, inf->mnc);
+	nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TAC, inf->tac);
+
+	/* Optional parameters for the API call */
+	if (inf->earfcn != NRF_CLOUD_LOCATION_CELL_OMIT_EARFCN) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, inf->earfcn);
+	}
+
+	if (inf->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+				       RSRP_IDX_TO_DBM(inf->rsrp));
+	}
+
+	if (inf->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+		nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRQ,
+				       RSRQ_IDX_TO_DB(inf->rsrq));
+	}
+
+	if (inf->timing_advance != NRF_CLOUD_LOCATION_CELL_OMIT_TIME_ADV) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_T_ADV,
+				       MIN(inf->timing_advance,
+					   NRF_CLOUD_LOCATION_CELL_TIME_ADV_MAX));
+	}
+}
+
+static void ncells_json_write(struct nrf_cloud_json_writer *const w, const uint8_t ncells_count,
+			      const struct lte_lc_ncell *const neighbor_cells)
+{
+	if (!ncells_count || !neighbor_cells) {
+		return;
+	}
+
+	nrf_cloud_json_array_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_NBORS);
+
+	for (uint8_t i = 0; i < ncells_count; ++i) {
+		const struct lte_lc_ncell *ncell = neighbor_cells + i;
+
+		nrf_cloud_json_obj_start(w, NULL);
+
+		/* Required parameters for the API call */
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_EARFCN, ncell->earfcn);
+		nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_PCI, ncell->phys_cell_id);
+
+		/* Optional parameters for the API call */
+		if (ncell->rsrp != NRF_CLOUD_LOCATION_CELL_OMIT_RSRP) {
+			nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRP,
+					       RSRP_IDX_TO_DBM(ncell->rsrp));
+		}
+		if (ncell->rsrq != NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ) {
+			nrf_cloud_json_num_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_RSRQ,
+					       RSRQ_IDX_TO_DB(ncell->rsrq));
+		}
+		if (ncell->time_diff != LTE_LC_CELL_TIME_DIFF_INVALID) {
+			nrf_cloud_json_int_add(w, NRF_CLOUD_CELL_POS_JSON_KEY_TDIFF,
+					       ncell->time_diff);
+		}
+
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_array_end(w);
+}
+
+static bool cell_pos_req_has_data(struct lte_lc_cells_info const *const inf)
+{
+	return (inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) ||
+	       (inf->gci_cells_count && inf->gci_cells);
+}
+
+int nrf_cloud_cell_pos_req_json_write(struct nrf_cloud_json_writer *const w,
+				      struct lte_lc_cells_info const *const inf)
+{
+	if (!w || !inf) {
+		return -EINVAL;
+	}
+
+	if (!cell_pos_req_has_data(inf)) {
+		return -ENODATA;
+	}
+
+	nrf_cloud_json_array_start(w, NRF_CLOUD_CELL_POS_JSON_KEY_LTE);
+
+	/* Add the current cell to the array; if using a GCI search type, sometimes
+	 * there is no current cell.
+	 */
+	if (inf->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) {
+		nrf_cloud_json_obj_start(w, NULL);
+		lte_inf_json_write(w, &inf->current_cell);
+		ncells_json_write(w, inf->ncells_count, inf->neighbor_cells);
+		nrf_cloud_json_obj_end(w);
+	}
+
+	for (uint8_t i = 0; inf->gci_cells && (i < inf->gci_cells_count); ++i) {
+		nrf_cloud_json_obj_start(w, NULL);
+		lte_inf_json_write(w, inf->gci_cells + i);
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_array_end(w);
+
+	return w->err;
+}
+
+static int wifi_ap_count(struct wifi_scan_info const *const wifi)
+{
+	int cnt = 0;
+
+	for (uint8_t i = 0; i < wifi->cnt; ++i) {
+		if (!is_local_mac(wifi->ap_info[i].mac)) {
+			++cnt;
+		}
+	}
+
+	return cnt;
+}
+
+int nrf_cloud_wifi_req_json_write(struct nrf_cloud_json_writer *const w,
+				  struct wifi_scan_info const *const wifi)
+{
+	if (!w || !wifi || !wifi->ap_info || !wifi->cnt) {
+		return -EINVAL;
+	}
+
+	const bool add_all = IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_ALL);
+	const bool add_rssi =
+		(add_all || IS_ENABLED(CONFIG_NRF_CLOUD_WIFI_LOCATION_ENCODE_OPT_MAC_RSSI));
+
+	/* Nothing can be taken back once written, so check the count first */
+	if (wifi_ap_count(wifi) < NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN) {
+		return -ENODATA;
+	}
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI);
+	nrf_cloud_json_array_start(w, NRF_CLOUD_LOCATION_JSON_KEY_APS);
+
+	for (uint8_t cnt = 0; cnt < wifi->cnt; ++cnt) {
+		char mac_str[WIFI_MAC_ADDR_STR_LEN + 1];
+		struct wifi_scan_result const *const ap = (wifi->ap_info + cnt);
+
+		if (is_local_mac(ap->mac)) {
+			continue;
+		}
+
+		nrf_cloud_json_obj_start(w, NULL);
+
+		/* MAC address is the only required parameter for the API call */
+		(void)snprintk(mac_str, sizeof(mac_str), WIFI_MAC_ADDR_TEMPLATE, ap->mac[0],
+			       ap->mac[1], ap->mac[2], ap->mac[3], ap->mac[4], ap->mac[5]);
+		nrf_cloud_json_str_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_MAC, mac_str);
+
+		/* Optional parameters for the API call */
+		if (add_rssi && (ap->rssi != NRF_CLOUD_LOCATION_WIFI_OMIT_RSSI)) {
+			nrf_cloud_json_int_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_RSSI, ap->rssi);
+		}
+
+		if (add_all) {
+			size_t ssid_len = 0;
+
+			if ((ap->ssid_length > 0) && (ap->ssid_length <= WIFI_SSID_MAX_LEN)) {
+				ssid_len = strnlen((const char *)ap->ssid, ap->ssid_length);
+			}
+
+			if (ssid_len) {
+				nrf_cloud_json_strn_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_SSID,
+							(const char *)ap->ssid, ssid_len);
+			}
+
+			if (ap->channel != NRF_CLOUD_LOCATION_WIFI_OMIT_CHAN) {
+				nrf_cloud_json_int_add(w, NRF_CLOUD_LOCATION_JSON_KEY_WIFI_CH,
+						       ap->channel);
+			}
+		}
+
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_array_end(w);
+	nrf_cloud_json_obj_end(w);
+
+	return w->err;
+}
+
+int nrf_cloud_location_req_json_write(struct nrf_cloud_json_writer *const w,
+				      struct lte_lc_cells_info const *const cells_inf,
+				      struct wifi_scan_info const *const wifi_inf,
+				      struct nrf_cloud_location_config const *const config,
+				      const int64_t timestamp)
+{
+	if (!w || (!cells_inf && !wifi_inf)) {
+		return -EINVAL;
+	}
+	if (!cells_inf && (wifi_inf->cnt < NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN)) {
+		return -EDOM;
+	}
+	if (wifi_inf && (!wifi_inf->ap_info || !wifi_inf->cnt)) {
+		return -EINVAL;
+	}
+
+	/* Decide what goes in the request the same way as
+	 * nrf_cloud_obj_location_request_payload_add() before writing anything.
+	 */
+	bool add_cells = cells_inf && cell_pos_req_has_data(cells_inf);
+	bool add_wifi = wifi_inf &&
+			(wifi_ap_count(wifi_inf) >= NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN);
+	/* The message is sized before it is written, only warn in the sizing pass */
+	bool warn = nrf_cloud_json_writer_is_counting(w);
+
+	if (cells_inf && !add_cells) {
+		if (!wifi_inf) {
+			LOG_ERR("Failed to add cell info to location request, error: %d", -ENODATA);
+			return -ENODATA;
+		}
+		if (warn) {
+			LOG_WRN("No GCI cells, excluding cellular data from request");
+		}
+	}
+
+	if (wifi_inf && !add_wifi) {
+		if (!add_cells) {
+			LOG_WRN("At least %d APs (with a non-local MAC address) are required",
+				NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN);
+			LOG_ERR("Wi-Fi request not created");
+			return -ENODATA;
+		}
+		if (warn) {
+			LOG_WRN("At least %d APs (with a non-local MAC address) are required",
+				NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN);
+			LOG_WRN("Excluding Wi-Fi data, request is cellular only");
+		}
+	}
+
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, NRF_CLOUD_JSON_APPID_VAL_LOCATION);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+
+	if (config && ((config->do_reply != NRF_CLOUD_LOCATION_DOREPLY_DEFAULT) ||
+		       (config->hi_conf != NRF_CLOUD_LOCATION_HICONF_DEFAULT) ||
+		       (config->fallback != NRF_CLOUD_LOCATION_FALLBACK_DEFAULT))) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_LOCATION_JSON_KEY_CONFIG);
+		if (config->do_reply != NRF_CLOUD_LOCATION_DOREPLY_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_DOREPLY,
+						config->do_reply);
+		}
+		if (config->hi_conf != NRF_CLOUD_LOCATION_HICONF_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_HICONF,
+						config->hi_conf);
+		}
+		if (config->fallback != NRF_CLOUD_LOCATION_FALLBACK_DEFAULT) {
+			nrf_cloud_json_bool_add(w, NRF_CLOUD_LOCATION_JSON_KEY_FALLBACK,
+						config->fallback);
+		}
+		nrf_cloud_json_obj_end(w);
+	}
+
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_DATA_KEY);
+	if (add_cells) {
+		(void)nrf_cloud_cell_pos_req_json_write(w, cells_inf);
+	}
+	if (add_wifi) {
+		(void)nrf_cloud_wifi_req_json_write(w, wifi_inf);
+	}
+	nrf_cloud_json_obj_end(w);
+
+	if (timestamp) {
+		nrf_cloud_json_int_add(w, NRF_CLOUD_MSG_TIMESTAMP_KEY, timestamp);
+	}
+
+	nrf_cloud_json_obj_end(w);
+
+	return w->err;
+}
+
 static bool json_item_string_exists(const cJSON *const obj, const char *const key,
 				    const char *const val)
 {
@@ -2428,6 +2861,230 @@ clean_up:
 	return ret;
 }
 
+static void location_result_error_set(struct nrf_cloud_location_result *const result)
+{
+	/* Clear data on error */
+	result->lat = 0.0;
+	result->lon = 0.0;
+	result->unc = 0;
+	result->type = LOCATION_TYPE__INVALID;
+
+	/* Set to unknown error if an error code was not found */
+	if (result->err == NRF_CLOUD_ERROR_NONE) {
+		result->err = NRF_CLOUD_ERROR_UNKNOWN;
+	}
+}
+
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+static bool tok_item_string_exists(const char *const js, const struct nrf_cloud_json_tok *toks,
+				   const int count, const int obj, const char *const key,
+				   const char *const val)
+{
+	int tok = nrf_cloud_json_tok_obj_get(js, toks, count, obj, key);
+
+	if (tok < 0) {
+		return false;
+	}
+
+	if (!val) {
+		return nrf_cloud_json_tok_is_null(js, &toks[tok]);
+	}
+
+	return nrf_cloud_json_tok_str_eq(js, &toks[tok], val);
+}
+
+static void parse_location_anchors_in_place(const char *const js,
+					    const struct nrf_cloud_json_tok *toks,
+					    const int count, const int loc,
+					    struct nrf_cloud_location_result *const location_out)
+{
+	size_t buf_idx = 0;
+	bool buf_exists = location_out->anchor_buf_sz && location_out->anchor_buf;
+	int anchors;
+
+	/* Init anchor output */
+	sys_slist_init(&location_out->anchor_list);
+	if (buf_exists) {
+		location_out->anchor_buf[0] = '\0';
+	}
+
+	/* Anchor info is provided in an array of objects */
+	anchors = nrf_cloud_json_tok_obj_get(js, toks, count, loc,
+					     NRF_CLOUD_LOCATION_JSON_KEY_ANCHORS);
+	location_out->anchor_cnt =
+		((anchors >= 0) && (toks[anchors].type == NRF_CLOUD_JSON_TOK_ARRAY)) ?
+		toks[anchors].size : 0;
+
+	for (int idx = 0; idx < location_out->anchor_cnt; ++idx) {
+		struct nrf_cloud_anchor_list_node *node;
+		int anc = nrf_cloud_json_tok_array_get(toks, count, anchors, idx);
+		int mac = nrf_cloud_json_tok_obj_get(js, toks, count, anc,
+						     NRF_CLOUD_LOCATION_JSON_KEY_ANC_MAC);
+		int name = nrf_cloud_json_tok_obj_get(js, toks, count, anc,
+						      NRF_CLOUD_LOCATION_JSON_KEY_ANC_NAME);
+		size_t space;
+		int name_len;
+
+		if ((mac >= 0) && (toks[mac].type == NRF_CLOUD_JSON_TOK_STRING)) {
+			LOG_DBG("Wi-Fi anchor MAC: %.*s", toks[mac].end - toks[mac].start,
+				&js[toks[mac].start]);
+		}
+
+		if ((name >= 0) && (toks[name].type == NRF_CLOUD_JSON_TOK_STRING)) {
+			LOG_DBG("Wi-Fi anchor name: %.*s", toks[name].end - toks[name].start,
+				&js[toks[name].start]);
+		} else {
+			continue;
+		}
+
+		if (!buf_exists) {
+			/* No anchor buffer provided */
+			continue;
+		}
+
+		/* Copy the anchor name directly into the node, if it fits in the buffer */
+		node = (struct nrf_cloud_anchor_list_node *)&location_out->anchor_buf[buf_idx];
+		space = location_out->anchor_buf_sz - buf_idx;
+		name_len = (space > sizeof(*node)) ?
+			   nrf_cloud_json_tok_str_copy(js, &toks[name], node->name,
+						       space - sizeof(*node)) :
+			   -ENOBUFS;
+		if (name_len < 0) {
+			LOG_WRN("Anchor does not fit in provided buffer");
+			continue;
+		}
+
+		node->node.next = NULL;
+		/* Update the buffer index */
+		buf_idx += sizeof(*node) + name_len + 1;
+		/* Add node to list */
+		sys_slist_append(&location_out->anchor_list, &node->node);
+	}
+}
+
+static int parse_location_in_place(const char *const js, const struct nrf_cloud_json_tok *toks,
+				   const int count, const int loc,
+				   struct nrf_cloud_location_result *const location_out)
+{
+	int lat = nrf_cloud_json_tok_obj_get(js, toks, count, loc, NRF_CLOUD_LOCATION_JSON_KEY_LAT);
+	int lon = nrf_cloud_json_tok_obj_get(js, toks, count, loc, NRF_CLOUD_LOCATION_JSON_KEY_LON);
+	int unc = nrf_cloud_json_tok_obj_get(js, toks, count, loc,
+					     NRF_CLOUD_LOCATION_JSON_KEY_UNCERT);
+	int type = nrf_cloud_json_tok_obj_get(js, toks, count, loc, NRF_CLOUD_JSON_FULFILL_KEY);
+	bool anchor = false;
+	int unc_val;
+
+	if ((lat < 0) || (lon < 0) || (unc < 0) ||
+	    nrf_cloud_json_tok_num(js, &toks[lat], &location_out->lat) ||
+	    nrf_cloud_json_tok_num(js, &toks[lon], &location_out->lon) ||
+	    nrf_cloud_json_tok_int(js, &toks[unc], &unc_val)) {
+		return -EBADMSG;
+	}
+
+	location_out->unc = (uint32_t)unc_val;
+
+	location_out->type = LOCATION_TYPE__INVALID;
+
+	if ((type >= 0) && (toks[type].type == NRF_CLOUD_JSON_TOK_STRING)) {
+		if (nrf_cloud_json_tok_str_eq(js, &toks[type], NRF_CLOUD_LOCATION_TYPE_VAL_MCELL)) {
+			location_out->type = LOCATION_TYPE_MULTI_CELL;
+		} else if (nrf_cloud_json_tok_str_eq(js, &toks[type],
+						     NRF_CLOUD_LOCATION_TYPE_VAL_SCELL)) {
+			location_out->type = LOCATION_TYPE_SINGLE_CELL;
+		} else if (nrf_cloud_json_tok_str_eq(js, &toks[type],
+						     NRF_CLOUD_LOCATION_TYPE_VAL_WIFI)) {
+			location_out->type = LOCATION_TYPE_WIFI;
+		} else if (nrf_cloud_json_tok_str_eq(js, &toks[type],
+						     NRF_CLOUD_LOCATION_TYPE_VAL_ANCHOR)) {
+			location_out->type = LOCATION_TYPE_WIFI;
+			anchor = true;
+		} else {
+			LOG_WRN("Unhandled location type: %.*s", toks[type].end - toks[type].start,
+				&js[toks[type].start]);
+		}
+	} else {
+		LOG_WRN("Location type not found in message");
+	}
+
+	if (anchor && IS_ENABLED(CONFIG_NRF_CLOUD_LOCATION_PARSE_ANCHORS)) {
+		parse_location_anchors_in_place(js, toks, count, loc, location_out);
+	}
+
+	return 0;
+}
+
+/* Same as the cJSON decoding below, reading the fields from the input buffer without
+ * allocating memory.
+ */
+static int location_response_decode_in_place(const char *const buf,
+					     struct nrf_cloud_location_result *result)
+{
+	struct nrf_cloud_json_tok toks[CONFIG_NRF_CLOUD_JSON_DECODE_TOKENS_MAX];
+	double num;
+	int count;
+	int data;
+	int tok;
+	int ret;
+
+	count = nrf_cloud_json_tokenize(buf, strlen(buf), toks, ARRAY_SIZE(toks));
+	if (count == -E2BIG) {
+		return count;
+	}
+
+	if (count < 0) {
+		LOG_DBG("No JSON found for location");
+		return 1;
+	}
+
+	result->err = NRF_CLOUD_ERROR_NONE;
+
+	/* Check for nRF Cloud MQTT message; valid appId and msgType */
+	if (!tok_item_string_exists(buf, toks, count, 0, NRF_CLOUD_JSON_MSG_TYPE_KEY,
+				    NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA) ||
+	    !tok_item_string_exists(buf, toks, count, 0, NRF_CLOUD_JSON_APPID_KEY,
+				    NRF_CLOUD_JSON_APPID_VAL_LOCATION)) {
+		/* Not a location data message */
+		return 1;
+	}
+
+	tok = nrf_cloud_json_tok_obj_get(buf, toks, count, 0, NRF_CLOUD_MSG_TIMESTAMP_KEY);
+	result->timestamp = ((tok >= 0) && !nrf_cloud_json_tok_num(buf, &toks[tok], &num)) ?
+			    (int64_t)num : 0;
+
+	/* MQTT payload format found, parse the data */
+	data = nrf_cloud_json_tok_obj_get(buf, toks, count, 0, NRF_CLOUD_JSON_DATA_KEY);
+	if (data >= 0) {
+		ret = parse_location_in_place(buf, toks, count, data, result);
+		if (ret) {
+			LOG_ERR("Failed to parse location data");
+		}
+		/* A message with "data" should not also contain an error code */
+	} else {
+		/* Check for error code */
+		tok = nrf_cloud_json_tok_obj_get(buf, toks, count, 0, NRF_CLOUD_JSON_ERR_KEY);
+		if (tok < 0) {
+			/* No data or error was found */
+			LOG_ERR("Expected data not found in location message");
+			ret = -EBADMSG;
+		} else if (nrf_cloud_json_tok_num(buf, &toks[tok], &num)) {
+			LOG_WRN("Invalid JSON data type for error value");
+			LOG_ERR("Expected data not found in location message");
+			ret = -EBADMSG;
+		} else {
+			result->err = (enum nrf_cloud_error)num;
+			/* Indicate that an nRF Cloud error code was found */
+			ret = -EFAULT;
+		}
+	}
+
+	if (ret < 0) {
+		location_result_error_set(result);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE */
+
 int nrf_cloud_location_response_decode(const char *const buf,
 				       struct nrf_cloud_location_result *result)
 {
@@ -2439,6 +3096,15 @@ int nrf_cloud_location_response_decode(const char *const buf,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+	ret = location_response_decode_in_place(buf, result);
+	if (ret != -E2BIG) {
+		return ret;
+	}
+
+	LOG_DBG("Location response has too many JSON tokens, decoding with cJSON");
+#endif
+
 	loc_obj = cJSON_Parse(buf);
 	if (!loc_obj) {
 		LOG_DBG("No JSON found for location");
@@ -2485,16 +3151,7 @@ cleanup:
 	cJSON_Delete(loc_obj);
 
 	if (ret < 0) {
-		/* Clear data on error */
-		result->lat = 0.0;
-		result->lon = 0.0;
-		result->unc = 0;
-		result->type = LOCATION_TYPE__INVALID;
-
-		/* Set to unknown error if an error code was not found */
-		if (result->err == NRF_CLOUD_ERROR_NONE) {
-			result->err = NRF_CLOUD_ERROR_UNKNOWN;
-		}
+		location_result_error_set(result);
 	}
 
 	return ret;
@@ -2913,6 +3570,60 @@ int nrf_cloud_agnss_type_array_get(const struct nrf_modem_gnss_agnss_data_frame
 #endif /* CONFIG_NRF_CLOUD_AGNSS || CONFIG_NRF_CLOUD_PGPS */
 
 #if defined(CONFIG_NRF_CLOUD_PGPS)
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+/* Same as the cJSON decoding below, copying the host and path from the response directly to
+ * the result.
+ */
+static int pgps_response_decode_in_place(const char *const response,
+					 struct nrf_cloud_pgps_result *const result)
+{
+	struct nrf_cloud_json_tok toks[CONFIG_NRF_CLOUD_JSON_DECODE_TOKENS_MAX];
+	int count;
+	int host;
+	int path;
+	int err;
+
+	count = nrf_cloud_json_tokenize(response, strlen(response), toks, ARRAY_SIZE(toks));
+	if (count == -E2BIG) {
+		return count;
+	}
+
+	if (count < 0) {
+		LOG_ERR("P-GPS response does not contain valid JSON");
+		return -EBADMSG;
+	}
+
+	/* MQTT response is an array */
+	if (toks[0].type != NRF_CLOUD_JSON_TOK_ARRAY) {
+		LOG_ERR("Invalid P-GPS response format");
+		return -EPROTO;
+	}
+
+	host = nrf_cloud_json_tok_array_get(toks, count, 0, NRF_CLOUD_PGPS_RCV_ARRAY_IDX_HOST);
+	path = nrf_cloud_json_tok_array_get(toks, count, 0, NRF_CLOUD_PGPS_RCV_ARRAY_IDX_PATH);
+	if ((host < 0) || (path < 0) || (toks[host].type != NRF_CLOUD_JSON_TOK_STRING) ||
+	    (toks[path].type != NRF_CLOUD_JSON_TOK_STRING)) {
+		LOG_ERR("Invalid P-GPS array response format");
+		return -EPROTO;
+	}
+
+	err = nrf_cloud_json_tok_str_copy(response, &toks[host], result->host, result->host_sz);
+	if (err >= 0) {
+		err = nrf_cloud_json_tok_str_copy(response, &toks[path], result->path,
+						  result->path_sz);
+	}
+
+	if (err < 0) {
+		return (err == -ENOBUFS) ? -ENOBUFS : -EPROTO;
+	}
+
+	LOG_DBG("host: %s", result->host);
+	LOG_DBG("path: %s", result->path);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE */
+
 int nrf_cloud_pgps_response_decode(const char *const response,
 				   struct nrf_cloud_pgps_result *const result)
 {
@@ -2921,6 +3632,16 @@ int nrf_cloud_pgps_response_decode(const char *const response,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_NRF_CLOUD_JSON_DECODE_IN_PLACE)
+	int ret = pgps_response_decode_in_place(response, result);
+
+	if (ret != -E2BIG) {
+		return ret;
+	}
+
+	LOG_DBG("P-GPS response has too many JSON tokens, decoding with cJSON");
+#endif
+
 	char *host_ptr = NULL;
 	char *path_ptr = NULL;
 	int err = 0;
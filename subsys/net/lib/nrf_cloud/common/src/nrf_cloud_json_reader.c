@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "nrf_cloud_json_reader.h"
+
+enum expect {
+	EXPECT_VALUE,
+	EXPECT_KEY,
+	EXPECT_COLON,
+	/* Comma or end of the current object or array */
+	EXPECT_NEXT,
+	/* Only whitespace after the top level value */
+	EXPECT_END,
+};
+
+struct tokenizer {
+	struct nrf_cloud_json_tok *toks;
+	size_t toks_max;
+	size_t count;
+	/* Indexes of the open objects and arrays */
+	uint16_t stack[NRF_CLOUD_JSON_READER_DEPTH_MAX];
+	uint8_t depth;
+};
+
+static struct nrf_cloud_json_tok *parent_get(struct tokenizer *const t)
+{
+	return t->depth ? &t->toks[t->stack[t->depth - 1]] : NULL;
+}
+
+static int tok_add(struct tokenizer *const t, const enum nrf_cloud_json_tok_type type,
+		   const size_t start, const size_t end, const bool key)
+{
+	struct nrf_cloud_json_tok *parent = parent_get(t);
+
+	if (t->count == t->toks_max) {
+		return -E2BIG;
+	}
+
+	/* Objects count their keys, arrays their values */
+	if (parent && (key || parent->type == NRF_CLOUD_JSON_TOK_ARRAY)) {
+		parent->size++;
+	}
+
+	t->toks[t->count] = (struct nrf_cloud_json_tok){
+		.start = start,
+		.end = end,
+		.type = type,
+	};
+
+	return t->count++;
+}
+
+/* Find the end of the string starting after the opening quote at pos */
+static int string_end(const char *const js, const size_t len, size_t pos)
+{
+	for (; pos < len; pos++) {
+		const unsigned char c = js[pos];
+
+		if (c == '"') {
+			return pos;
+		}
+
+		if (c < ' ') {
+			return -EBADMSG;
+		}
+
+		if (c != '\\') {
+			continue;
+		}
+
+		if (++pos == len) {
+			return -EBADMSG;
+		}
+
+		switch (js[pos]) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			break;
+		case 'u':
+			for (int i = 0; i < 4; i++) {
+				if (++pos == len || !isxdigit((unsigned char)js[pos])) {
+					return -EBADMSG;
+				}
+			}
+			break;
+		default:
+			return -EBADMSG;
+		}
+	}
+
+	return -EBADMSG;
+}
+
+static bool is_primitive_char(const char c)
+{
+	return isalnum((unsigned char)c) || c == '-' || c == '+' || c == '.';
+}
+
+static bool is_literal_valid(const char *const js, const size_t start, const size_t end)
+{
+	static const char *const literals[] = {"true", "false", "null"};
+
+	if (js[start] == '-' || isdigit((unsigned char)js[start])) {
+		/* Numbers are validated when they are read */
+		return true;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(literals); i++) {
+		if ((end - start) == strlen(literals[i]) &&
+		    !memcmp(&js[start], literals[i], end - start)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int nrf_cloud_json_tokenize(const char *const js, const size_t len,
+			    struct nrf_cloud_json_tok *const toks, const size_t toks_max)
+{
+	struct tokenizer t = {.toks = toks, .toks_max = toks_max};
+	enum expect expect = EXPECT_VALUE;
+	/* An empty object or array can be closed */
+	bool can_close = false;
+	int ret;
+
+	if (!js || !toks) {
+		return -EINVAL;
+	}
+
+	if (len > UINT16_MAX) {
+		return -E2BIG;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		const char c = js[i];
+		struct nrf_cloud_json_tok *parent = parent_get(&t);
+		bool close = false;
+
+		if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+			continue;
+		}
+
+		switch (expect) {
+		case EXPECT_COLON:
+			if (c != ':') {
+				return -EBADMSG;
+			}
+			expect = EXPECT_VALUE;
+			continue;
+		case EXPECT_NEXT:
+			if (c == ',') {
+				expect = (parent->type == NRF_CLOUD_JSON_TOK_OBJECT) ? EXPECT_KEY :
+										      EXPECT_VALUE;
+				can_close = false;
+				continue;
+			}
+			close = true;
+			break;
+		case EXPECT_KEY:
+			if (c == '}' && can_close) {
+				close = true;
+				break;
+			}
+
+			if (c != '"') {
+				return -EBADMSG;
+			}
+
+			ret = string_end(js, len, i + 1);
+			if (ret < 0) {
+				return ret;
+			}
+
+			ret = tok_add(&t, NRF_CLOUD_JSON_TOK_STRING, i + 1, ret, true);
+			if (ret < 0) {
+				return ret;
+			}
+
+			i = toks[ret].end;
+			expect = EXPECT_COLON;
+			continue;
+		case EXPECT_VALUE:
+			if (c == ']' && can_close) {
+				close = true;
+				break;
+			}
+
+			if (c == '{' || c == '[') {
+				if (t.depth == NRF_CLOUD_JSON_READER_DEPTH_MAX) {
+					return -E2BIG;
+				}
+
+				ret = tok_add(&t, (c == '{') ? NRF_CLOUD_JSON_TOK_OBJECT :
+							       NRF_CLOUD_JSON_TOK_ARRAY,
+					      i, 0, false);
+				if (ret < 0) {
+					return ret;
+				}
+
+				t.stack[t.depth++] = ret;
+				expect = (c == '{') ? EXPECT_KEY : EXPECT_VALUE;
+				can_close = true;
+				continue;
+			}
+
+			if (c == '"') {
+				ret = string_end(js, len, i + 1);
+				if (ret < 0) {
+					return ret;
+				}
+
+				ret = tok_add(&t, NRF_CLOUD_JSON_TOK_STRING, i + 1, ret, false);
+				if (ret < 0) {
+					return ret;
+				}
+
+				i = toks[ret].end;
+			} else if (c == '-' || isdigit((unsigned char)c) || c == 't' || c == 'f' ||
+				   c == 'n') {
+				size_t end = i + 1;
+
+				while (end < len && is_primitive_char(js[end])) {
+					end++;
+				}
+
+				if (!is_literal_valid(js, i, end)) {
+					return -EBADMSG;
+				}
+
+				ret = tok_add(&t, NRF_CLOUD_JSON_TOK_PRIMITIVE, i, end, false);
+				if (ret < 0) {
+					return ret;
+				}
+
+				i = end - 1;
+			} else {
+				return -EBADMSG;
+			}
+
+			expect = t.depth ? EXPECT_NEXT : EXPECT_END;
+			continue;
+		case EXPECT_END:
+			return -EBADMSG;
+		}
+
+		if (!close || !parent) {
+			return -EBADMSG;
+		}
+
+		if ((c == '}' && parent->type != NRF_CLOUD_JSON_TOK_OBJECT) ||
+		    (c == ']' && parent->type != NRF_CLOUD_JSON_TOK_ARRAY) ||
+		    (c != '}' && c != ']')) {
+			return -EBADMSG;
+		}
+
+		parent->end = i + 1;
+		t.depth--;
+		can_close = false;
+		expect = t.depth ? EXPECT_NEXT : EXPECT_END;
+	}
+
+	if (expect != EXPECT_END) {
+		return -EBADMSG;
+	}
+
+	return t.count;
+}
+
+int nrf_cloud_json_tok_next(const struct nrf_cloud_json_tok *const toks, const int count,
+			    const int idx)
+{
+	int i = idx;
+	int remaining = 1;
+
+	while (remaining && i < count) {
+		const struct nrf_cloud_json_tok *tok = &toks[i++];
+
+		remaining--;
+
+		if (tok->type == NRF_CLOUD_JSON_TOK_OBJECT) {
+			remaining += 2 * tok->size;
+		} else if (tok->type == NRF_CLOUD_JSON_TOK_ARRAY) {
+			remaining += tok->size;
+		}
+	}
+
+	return i;
+}
+
+int nrf_cloud_json_tok_obj_get(const char *const js, const struct nrf_cloud_json_tok *const toks,
+			       const int count, const int obj, const char *const key)
+{
+	int i;
+
+	if (obj < 0 || obj >= count || toks[obj].type != NRF_CLOUD_JSON_TOK_OBJECT) {
+		return -EINVAL;
+	}
+
+	i = obj + 1;
+
+	for (int member = 0; member < toks[obj].size && (i + 1) < count; member++) {
+		if (nrf_cloud_json_tok_str_eq(js, &toks[i], key)) {
+			return i + 1;
+		}
+
+		i = nrf_cloud_json_tok_next(toks, count, i + 1);
+	}
+
+	return -ENOENT;
+}
+
+int nrf_cloud_json_tok_array_get(const struct nrf_cloud_json_tok *const toks, const int count,
+				 const int array, const int index)
+{
+	int i;
+
+	if (array < 0 || array >= count || toks[array].type != NRF_CLOUD_JSON_TOK_ARRAY) {
+		return -EINVAL;
+	}
+
+	if (index < 0 || index >= toks[array].size) {
+		return -ENOENT;
+	}
+
+	i = array + 1;
+
+	for (int n = 0; n < index; n++) {
+		i = nrf_cloud_json_tok_next(toks, count, i);
+	}
+
+	return i;
+}
+
+static int hex4(const char *const s)
+{
+	char hex[5];
+
+	memcpy(hex, s, 4);
+	hex[4] = '\0';
+
+	return (int)strtol(hex, NULL, 16);
+}
+
+/* Decode one character of a string at pos into UTF-8, the same way as cJSON.
+ * Returns the number of bytes written to out, or a negative error code.
+ */
+static int char_decode(const char *const js, size_t *const pos, const size_t end,
+		       uint8_t out[4])
+{
+	uint32_t cp;
+
+	if (js[*pos] != '\\') {
+		out[0] = js[(*pos)++];
+		return 1;
+	}
+
+	(*pos)++;
+
+	switch (js[(*pos)++]) {
+	case 'b':
+		out[0] = '\b';
+		return 1;
+	case 'f':
+		out[0] = '\f';
+		return 1;
+	case 'n':
+		out[0] = '\n';
+		return 1;
+	case 'r':
+		out[0] = '\r';
+		return 1;
+	case 't':
+		out[0] = '\t';
+		return 1;
+	case 'u':
+		break;
+	default:
+		/* Quote, backslash and slash */
+		out[0] = js[*pos - 1];
+		return 1;
+	}
+
+	cp = hex4(&js[*pos]);
+	*pos += 4;
+
+	if (cp >= 0xDC00 && cp <= 0xDFFF) {
+		/* Low surrogate without a high surrogate */
+		return -EBADMSG;
+	}
+
+	if (cp >= 0xD800 && cp <= 0xDBFF) {
+		uint32_t low;
+
+		if ((*pos + 6) > end || js[*pos] != '\\' || js[*pos + 1] != 'u') {
+			return -EBADMSG;
+		}
+
+		low = hex4(&js[*pos + 2]);
+		if (low < 0xDC00 || low > 0xDFFF) {
+			return -EBADMSG;
+		}
+
+		*pos += 6;
+		cp = 0x10000 + (((cp & 0x3FF) << 10) | (low & 0x3FF));
+	}
+
+	if (cp < 0x80) {
+		out[0] = cp;
+		return 1;
+	} else if (cp < 0x800) {
+		out[0] = 0xC0 | (cp >> 6);
+		out[1] = 0x80 | (cp & 0x3F);
+		return 2;
+	} else if (cp < 0x10000) {
+		out[0] = 0xE0 | (cp >> 12);
+		out[1] = 0x80 | ((cp >> 6) & 0x3F);
+		out[2] = 0x80 | (cp & 0x3F);
+		return 3;
+	}
+
+	out[0] = 0xF0 | (cp >> 18);
+	out[1] = 0x80 | ((cp >> 12) & 0x3F);
+	out[2] = 0x80 | ((cp >> 6) & 0x3F);
+	out[3] = 0x80 | (cp & 0x3F);
+	return 4;
+}
+
+bool nrf_cloud_json_tok_str_eq(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			       const char *const str)
+{
+	const size_t str_len = strlen(str);
+	const size_t tok_len = tok->end - tok->start;
+	size_t pos = tok->start;
+	size_t matched = 0;
+
+	if (tok->type != NRF_CLOUD_JSON_TOK_STRING) {
+		return false;
+	}
+
+	if (!memchr(&js[tok->start], '\\', tok_len)) {
+		/* Nothing to unescape */
+		return (tok_len == str_len) && !memcmp(&js[tok->start], str, str_len);
+	}
+
+	while (pos < tok->end) {
+		uint8_t dec[4];
+		int n = char_decode(js, &pos, tok->end, dec);
+
+		if (n < 0 || (matched + n) > str_len || memcmp(&str[matched], dec, n)) {
+			return false;
+		}
+
+		matched += n;
+	}
+
+	return matched == str_len;
+}
+
+int nrf_cloud_json_tok_str_copy(const char *const js, const struct nrf_cloud_json_tok *const tok,
+				char *const buf, const size_t size)
+{
+	size_t pos = tok->start;
+	size_t len = 0;
+
+	if (tok->type != NRF_CLOUD_JSON_TOK_STRING) {
+		return -EINVAL;
+	}
+
+	while (pos < tok->end) {
+		uint8_t dec[4];
+		int n = char_decode(js, &pos, tok->end, dec);
+
+		if (n < 0) {
+			return n;
+		}
+
+		if ((len + n) >= size) {
+			return -ENOBUFS;
+		}
+
+		memcpy(&buf[len], dec, n);
+		len += n;
+	}
+
+	if (!size) {
+		return -ENOBUFS;
+	}
+
+	buf[len] = '\0';
+
+	return len;
+}
+
+/* Skip the digits starting at pos, returns the position after them */
+static size_t digits_skip(const char *const num, size_t pos)
+{
+	while (isdigit((unsigned char)num[pos])) {
+		pos++;
+	}
+
+	return pos;
+}
+
+/* Check that the null-terminated string is a JSON number. strtod() also accepts hexadecimal
+ * numbers, infinity and NaN, leading zeros and a missing integer or fraction part.
+ */
+static bool number_is_valid(const char *const num)
+{
+	size_t pos = (num[0] == '-') ? 1 : 0;
+	size_t end;
+
+	if (num[pos] == '0') {
+		pos++;
+	} else if (num[pos] >= '1' && num[pos] <= '9') {
+		pos = digits_skip(num, pos);
+	} else {
+		return false;
+	}
+
+	if (num[pos] == '.') {
+		end = digits_skip(num, pos + 1);
+		if (end == pos + 1) {
+			return false;
+		}
+		pos = end;
+	}
+
+	if (num[pos] == 'e' || num[pos] == 'E') {
+		pos++;
+		if (num[pos] == '+' || num[pos] == '-') {
+			pos++;
+		}
+
+		end = digits_skip(num, pos);
+		if (end == pos) {
+			return false;
+		}
+		pos = end;
+	}
+
+	return num[pos] == '\0';
+}
+
+int nrf_cloud_json_tok_num(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			   double *const out)
+{
+	const size_t len = tok->end - tok->start;
+	char num[32];
+	char *end;
+	double val;
+
+	if (tok->type != NRF_CLOUD_JSON_TOK_PRIMITIVE || len >= sizeof(num)) {
+		return -EINVAL;
+	}
+
+	memcpy(num, &js[tok->start], len);
+	num[len] = '\0';
+
+	if (!number_is_valid(num)) {
+		return -EINVAL;
+	}
+
+	val = strtod(num, &end);
+	if (end != &num[len]) {
+		return -EINVAL;
+	}
+
+	/* A number too large for a double */
+	if (!isfinite(val)) {
+		return -ERANGE;
+	}
+
+	*out = val;
+
+	return 0;
+}
+
+int nrf_cloud_json_tok_int(const char *const js, const struct nrf_cloud_json_tok *const tok,
+			   int *const out)
+{
+	double num;
+	int err = nrf_cloud_json_tok_num(js, tok, &num);
+
+	if (err) {
+		return err;
+	}
+
+	if (num >= INT_MAX) {
+		*out = INT_MAX;
+	} else if (num <= (double)INT_MIN) {
+		*out = INT_MIN;
+	} else {
+		*out = (int)num;
+	}
+
+	return 0;
+}
+
+bool nrf_cloud_json_tok_is_null(const char *const js, const struct nrf_cloud_json_tok *const tok)
+{
+	return (tok->type == NRF_CLOUD_JSON_TOK_PRIMITIVE) && ((tok->end - tok->start) == 4) &&
+	       !memcmp(&js[tok->start], "null", 4);
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "nrf_cloud_json_writer.h"
+
+static void put(struct nrf_cloud_json_writer *const w, const char *data, size_t len)
+{
+	if (w->err) {
+		return;
+	}
+
+	w->total += len;
+
+	if (!w->buf) {
+		/* Only counting */
+		return;
+	}
+
+	while (len) {
+		/* Keep room for the null-terminator */
+		size_t space = w->size - w->len - 1;
+		size_t chunk = MIN(len, space);
+
+		memcpy(w->buf + w->len, data, chunk);
+		w->len += chunk;
+		data += chunk;
+		len -= chunk;
+
+		if (!len) {
+			break;
+		}
+
+		if (!w->flush) {
+			w->err = -ENOMEM;
+			return;
+		}
+
+		w->err = w->flush(w->buf, w->len, w->ctx);
+		if (w->err) {
+			return;
+		}
+
+		w->len = 0;
+	}
+}
+
+static void put_char(struct nrf_cloud_json_writer *const w, const char c)
+{
+	put(w, &c, 1);
+}
+
+/* Same escaping as cJSON */
+static void put_string(struct nrf_cloud_json_writer *const w, const char *const str,
+		       const size_t len)
+{
+	size_t run = 0;
+
+	put_char(w, '"');
+
+	for (size_t i = 0; i < len; i++) {
+		const unsigned char c = str[i];
+		char esc[7];
+
+		if (c >= ' ' && c != '"' && c != '\\') {
+			run++;
+			continue;
+		}
+
+		/* Write the characters that don't need escaping in one go */
+		put(w, str + i - run, run);
+		run = 0;
+
+		switch (c) {
+		case '"':
+		case '\\':
+			esc[0] = '\\';
+			esc[1] = c;
+			put(w, esc, 2);
+			break;
+		case '\b':
+			put(w, "\\b", 2);
+			break;
+		case '\f':
+			put(w, "\\f", 2);
+			break;
+		case '\n':
+			put(w, "\\n", 2);
+			break;
+		case '\r':
+			put(w, "\\r", 2);
+			break;
+		case '\t':
+			put(w, "\\t", 2);
+			break;
+		default:
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			put(w, esc, 6);
+			break;
+		}
+	}
+
+	put(w, str + len - run, run);
+	put_char(w, '"');
+}
+
+/* Separator and key of a new member of the current object or array */
+static void member_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	if (w->err) {
+		return;
+	}
+
+	if (w->depth) {
+		const uint32_t bit = BIT(w->depth - 1);
+
+		if (w->has_member & bit) {
+			put_char(w, ',');
+		}
+
+		w->has_member |= bit;
+	}
+
+	if (key) {
+		put_string(w, key, strlen(key));
+		put_char(w, ':');
+	}
+}
+
+static void container_start(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char open)
+{
+	member_start(w, key);
+
+	if (w->err) {
+		return;
+	}
+
+	if (w->depth == NRF_CLOUD_JSON_WRITER_DEPTH_MAX) {
+		w->err = -E2BIG;
+		return;
+	}
+
+	w->depth++;
+	w->has_member &= ~BIT(w->depth - 1);
+	put_char(w, open);
+}
+
+static void container_end(struct nrf_cloud_json_writer *const w, const char close)
+{
+	if (w->err) {
+		return;
+	}
+
+	if (!w->depth) {
+		w->err = -EINVAL;
+		return;
+	}
+
+	w->depth--;
+	put_char(w, close);
+}
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size, nrf_cloud_json_writer_flush_t flush,
+				void *const ctx)
+{
+	memset(w, 0, sizeof(*w));
+
+	/* The buffer holds at least one character and the null-terminator */
+	if (buf && size > 1) {
+		w->buf = buf;
+		w->size = size;
+		w->flush = flush;
+		w->ctx = ctx;
+	} else if (buf || flush) {
+		w->err = -EINVAL;
+	}
+}
+
+bool nrf_cloud_json_writer_is_counting(const struct nrf_cloud_json_writer *const w)
+{
+	return !w->buf && !w->err;
+}
+
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *const w)
+{
+	if (!w->err && w->depth) {
+		/* Unterminated object or array */
+		w->err = -EINVAL;
+	}
+
+	if (w->err) {
+		return w->err;
+	}
+
+	if (w->buf) {
+		w->buf[w->len] = '\0';
+
+		if (w->flush && w->len) {
+			w->err = w->flush(w->buf, w->len, w->ctx);
+			if (w->err) {
+				return w->err;
+			}
+
+			w->len = 0;
+		}
+	}
+
+	return (int)w->total;
+}
+
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, '{');
+}
+
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, '}');
+}
+
+void nrf_cloud_json_array_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, '[');
+}
+
+void nrf_cloud_json_array_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, ']');
+}
+
+void nrf_cloud_json_strn_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const char *const val, const size_t len)
+{
+	if (!val && !w->err) {
+		w->err = -EINVAL;
+	}
+
+	member_start(w, key);
+	put_string(w, val, len);
+}
+
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val)
+{
+	nrf_cloud_json_strn_add(w, key, val, val ? strlen(val) : 0);
+}
+
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val)
+{
+	char num[26];
+	int len;
+
+	member_start(w, key);
+
+	if (w->err) {
+		return;
+	}
+
+	/* cJSON prints integers that fit in an int without decimals, and other numbers with
+	 * the shortest precision that reads back the same value.
+	 */
+	if (isnan(val) || isinf(val)) {
+		len = snprintf(num, sizeof(num), "null");
+	} else if (val >= INT32_MIN && val <= INT32_MAX && val == (int32_t)val) {
+		len = snprintf(num, sizeof(num), "%d", (int)val);
+	} else {
+		len = snprintf(num, sizeof(num), "%1.15g", val);
+		if (strtod(num, NULL) != val) {
+			len = snprintf(num, sizeof(num), "%1.17g", val);
+		}
+	}
+
+	put(w, num, len);
+}
+
+void nrf_cloud_json_int_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const int64_t val)
+{
+	char num[12];
+	int len;
+
+	if (val < INT32_MIN || val > INT32_MAX) {
+		/* Large values are printed as numbers by cJSON, such as timestamps */
+		nrf_cloud_json_num_add(w, key, (double)val);
+		return;
+	}
+
+	member_start(w, key);
+
+	len = snprintf(num, sizeof(num), "%d", (int)val);
+	put(w, num, len);
+}
+
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val)
+{
+	member_start(w, key);
+
+	if (val) {
+		put(w, "true", 4);
+	} else {
+		put(w, "false", 5);
+	}
+}
@@ -495,7 +495,11 @@ int npgps_download_start(const char *host, const char *file, int sec_tag, uint8_
 				 .sec_tag_list = NULL,
 				 .pdn_id = pdn_id,
 				 .range_override = fragment_size,
-				 .family = family},
+				 .family = family,
+				 /* Prediction sets are fetched from the same host one after
+				  * another, reuse the connection instead of a new TLS handshake.
+				  */
+				 .keep_connection = true},
 		.dl = &dl,
 	};
 
@@ -270,9 +270,25 @@ int json_send_to_cloud(cJSON *const request)
 		return -ENOMEM;
 	}
 
-	struct nct_dc_data msg = {.data.ptr = msg_string, .data.len = strlen(msg_string)};
+	err = json_str_send_to_cloud(msg_string, strlen(msg_string));
 
-	LOG_DBG("Created request: %s (size: %u)", (char *)msg.data.ptr, msg.data.len);
+	nrf_cloud_free(msg_string);
+
+	return err;
+}
+
+int json_str_send_to_cloud(const char *const request, const size_t len)
+{
+	__ASSERT_NO_MSG(request != NULL);
+
+	if (nfsm_get_current_state() != STATE_DC_CONNECTED) {
+		return -EACCES;
+	}
+
+	int err;
+	struct nct_dc_data msg = {.data.ptr = request, .data.len = len};
+
+	LOG_DBG("Created request: %s (size: %zu)", request, len);
 
 	err = nct_dc_send(&msg);
 	if (err) {
@@ -281,8 +297,6 @@ int json_send_to_cloud(cJSON *const request)
 		LOG_DBG("Request sent to cloud");
 	}
 
-	nrf_cloud_free(msg_string);
-
 	return err;
 }
 
@@ -13,6 +13,8 @@
 #include "nrf_cloud_fsm.h"
 #include "nrf_cloud_codec_internal.h"
 #include "nrf_cloud_transport.h"
+#include "nrf_cloud_mem.h"
+#include "nrf_cloud_json_writer.h"
 
 int nrf_cloud_location_request(const struct lte_lc_cells_info *const cells_inf,
 			       const struct wifi_scan_info *const wifi_inf,
@@ -23,19 +25,41 @@ int nrf_cloud_location_request(const struct lte_lc_cells_info *const cells_inf,
 		return -EACCES;
 	}
 
-	int err = 0;
+	int err;
+	int len;
+	char *msg;
+	struct nrf_cloud_json_writer w;
 
-	NRF_CLOUD_OBJ_JSON_DEFINE(location_req_obj);
+	/* Write the request directly instead of building a cJSON tree: a first pass counts the
+	 * length, so the message needs a single allocation.
+	 */
+	nrf_cloud_json_writer_init(&w, NULL, 0, NULL, NULL);
+	err = nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config, 0);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (err || len < 0) {
+		return err ? err : len;
+	}
 
-	err = nrf_cloud_obj_location_request_create(&location_req_obj, cells_inf, wifi_inf, config);
-	if (!err) {
-		if (!config || (config->do_reply)) {
-			nfsm_set_location_response_cb(cb);
-		}
+	msg = nrf_cloud_malloc(len + 1);
+	if (!msg) {
+		return -ENOMEM;
+	}
 
-		err = json_send_to_cloud(location_req_obj.json);
+	nrf_cloud_json_writer_init(&w, msg, len + 1, NULL, NULL);
+	(void)nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config, 0);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (len < 0) {
+		err = len;
+		goto cleanup;
 	}
 
-	(void)nrf_cloud_obj_free(&location_req_obj);
+	if (!config || (config->do_reply)) {
+		nfsm_set_location_response_cb(cb);
+	}
+
+	err = json_str_send_to_cloud(msg, len);
+
+cleanup:
+	nrf_cloud_free(msg);
 	return err;
 }
@@ -9,6 +9,8 @@
 #include <nrf_rpc/nrf_rpc_uart.h>
 #include <nrf_rpc_errno.h>
 
+#include <string.h>
+
 #include <zephyr/drivers/uart.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
@@ -19,6 +21,27 @@ LOG_MODULE_REGISTER(nrf_rpc_uart, CONFIG_NRF_RPC_TR_LOG_LEVEL);
 
 #define CRC_SIZE sizeof(uint16_t)
 
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+#define WINDOW_SIZE CONFIG_NRF_RPC_UART_WINDOW_SIZE
+/* The sequence number of a frame is 7 bits, the MSB of its first byte is the sync flag. */
+#define SEQ_MASK 0x7fu
+#define SEQ_SYNC 0x80u
+#define RX_TIMEOUT_US 100
+#if defined(CONFIG_NRF_RPC_UART_RELIABLE)
+#define ACK_TIME_MS CONFIG_NRF_RPC_UART_ACK_WAITING_TIME
+#define TX_ATTEMPTS CONFIG_NRF_RPC_UART_TX_ATTEMPTS
+#else
+/* No frame waits for an acknowledgment. */
+#define ACK_TIME_MS 0
+#define TX_ATTEMPTS 1
+#endif
+/* Time before a UART transfer that failed to start is tried again. */
+#define TX_RETRY_MS 10
+/* Slot of a TX item that is not a frame of the TX window. */
+#define TX_SLOT_ACK -1
+#define TX_SLOT_RESET -2
+#endif
+
 enum {
 	HDLC_CHAR_ESCAPE = 0x7d,
 	HDLC_CHAR_DELIMITER = 0x7e,
@@ -52,8 +75,48 @@ struct hdlc_decode_ctx {
 	uint16_t len;
 	/* The capacity of the buffer to store a decoded packet. */
 	uint16_t capacity;
+	/* CRC of the decoded bytes, except for the last two, which may be the CRC field. */
+	uint16_t crc;
+	/* The number of bytes covered by the CRC, including the skipped ones. */
+	uint16_t crc_len;
+	/* The number of bytes at the start of the packet that the CRC does not cover. */
+	uint16_t crc_skip;
+};
+
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+/* Packet in the TX window, until it is sent, or acknowledged in the reliable mode. */
+struct tx_frame {
+	const uint8_t *data;
+	uint16_t len;
+	/* CRC of the packet, the sequence number is added to it when the frame is encoded. */
+	uint16_t crc;
+	/* Time by which the frame must be acknowledged. */
+	int64_t deadline;
+	uint8_t attempts;
+	/* Waiting to be sent, or sent again. */
+	bool queued;
+	/* Acknowledged, or dropped. The frame is released when all previous ones are done. */
+	bool done;
+	/* Tells the receiver to skip the frames before this one. */
+	bool sync;
 };
 
+/* Frame being encoded in the TX buffer, which may take several UART transfers. */
+struct tx_item {
+	uint8_t head[2];
+	uint8_t tail[CRC_SIZE];
+	uint8_t head_len;
+	uint8_t tail_len;
+	const uint8_t *body;
+	uint16_t body_len;
+	/* Position in the unencoded bytes. */
+	uint16_t pos;
+	/* Slot of the frame in the TX window, or TX_SLOT_ACK or TX_SLOT_RESET. */
+	int8_t slot;
+	bool active;
+};
+#endif
+
 struct nrf_rpc_uart {
 	const struct device *uart;
 	nrf_rpc_tr_receive_handler_t receive_callback;
@@ -78,6 +141,42 @@ struct nrf_rpc_uart {
 	struct hdlc_decode_ctx rx_pkt_ctx;
 	uint8_t rx_pkt[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
 
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+	/* TX window, protecting the state shared with the UART and timer callbacks */
+	struct k_spinlock tx_spinlock;
+	struct tx_frame tx_frames[WINDOW_SIZE];
+	struct k_sem tx_slots;
+	uint8_t tx_head;
+	uint8_t tx_head_seq;
+	uint8_t tx_count;
+	bool tx_synced;
+	/* The peer has not acknowledged the reset yet, the frames wait */
+	bool tx_reset;
+	bool tx_reset_queued;
+	int64_t tx_reset_deadline;
+	bool tx_busy;
+	/* The transfer of the TX buffer failed to start, it is tried again by the timer */
+	bool tx_failed;
+	size_t tx_len;
+	struct tx_item tx_item;
+	uint8_t tx_buf[CONFIG_NRF_RPC_UART_TX_BUF_SIZE];
+	/* Sequence numbers to acknowledge */
+	uint32_t tx_acks[(SEQ_MASK + 1) / 32];
+	/* Reset of the peer to acknowledge */
+	bool tx_reset_ack;
+	uint8_t tx_reset_ack_seq;
+	struct k_timer tx_timer;
+
+	uint8_t rx_dma_buf[2][CONFIG_NRF_RPC_UART_RX_BUF_SIZE];
+	uint8_t rx_dma_next;
+
+	/* RX window, holding the packets received ahead of the next expected one */
+	uint8_t *rx_frames[WINDOW_SIZE];
+	uint16_t rx_frame_len[WINDOW_SIZE];
+	uint8_t rx_head;
+	uint8_t rx_head_seq;
+	bool rx_synced;
+#else
 	/* Ack waiting semaphore */
 	struct k_sem ack_sem;
 	uint16_t ack_payload;
@@ -86,6 +185,7 @@ struct nrf_rpc_uart {
 
 	/* TX lock */
 	struct k_mutex tx_lock;
+#endif
 };
 
 static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt, ...)
@@ -102,6 +202,7 @@ static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt,
 	}
 }
 
+#if !defined(CONFIG_NRF_RPC_UART_ASYNC)
 static void send_byte(const struct device *dev, uint8_t byte);
 
 static void ack_rx(struct nrf_rpc_uart *uart_tr)
@@ -189,19 +290,26 @@ static bool crc_compare(uint16_t rx_crc, uint16_t calc_crc)
 
 	return rx_crc == calc_crc;
 }
+#endif /* !CONFIG_NRF_RPC_UART_ASYNC */
+
+static void hdlc_frame_start(struct hdlc_decode_ctx *ctx)
+{
+	ctx->len = 0;
+	ctx->crc = 0xffff;
+	ctx->crc_len = ctx->crc_skip;
+	ctx->state = HDLC_STATE_FRAME;
+}
 
 static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t in)
 {
 	switch (ctx->state) {
 	case HDLC_STATE_UNSYNC:
 		if (in == HDLC_CHAR_DELIMITER) {
-			ctx->len = 0;
-			ctx->state = HDLC_STATE_FRAME;
+			hdlc_frame_start(ctx);
 		}
 		return;
 	case HDLC_STATE_FRAME_FOUND:
-		ctx->len = 0;
-		ctx->state = HDLC_STATE_FRAME;
+		hdlc_frame_start(ctx);
 		__fallthrough;
 	case HDLC_STATE_FRAME:
 		if (in == HDLC_CHAR_DELIMITER) {
@@ -229,20 +337,145 @@ static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t
 	out[ctx->len++] = in;
 }
 
+/* Returns a word with the MSB set in the first byte equal to the value, checking the bytes of
+ * the word at the same time. The bytes after the first match may be flagged by mistake.
+ */
+static inline uint32_t hdlc_word_match(uint32_t word, uint8_t value)
+{
+	word ^= 0x01010101u * value;
+
+	return (word - 0x01010101u) & ~word & 0x80808080u;
+}
+
+/* Returns the position of the first delimiter, or escape byte if escape is set, in the input,
+ * or len if there is none.
+ */
+static size_t hdlc_find(const uint8_t *in, size_t len, bool escape)
+{
+	size_t i = 0;
+
+	for (; i + sizeof(uint32_t) <= len; i += sizeof(uint32_t)) {
+		uint32_t word = sys_le32_to_cpu(UNALIGNED_GET((const uint32_t *)(in + i)));
+		uint32_t match = hdlc_word_match(word, HDLC_CHAR_DELIMITER);
+
+		if (escape) {
+			match |= hdlc_word_match(word, HDLC_CHAR_ESCAPE);
+		}
+
+		if (match != 0) {
+			return i + (find_lsb_set(match) - 1) / 8;
+		}
+	}
+
+	for (; i < len; i++) {
+		if (in[i] == HDLC_CHAR_DELIMITER || (escape && in[i] == HDLC_CHAR_ESCAPE)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Add the bytes decoded since the last update to the CRC, keeping the last two out of it. */
+static void hdlc_crc_update(struct hdlc_decode_ctx *ctx, const uint8_t *out)
+{
+	if (ctx->len > ctx->crc_len + CRC_SIZE) {
+		ctx->crc = crc16_ccitt(ctx->crc, out + ctx->crc_len,
+				       ctx->len - CRC_SIZE - ctx->crc_len);
+		ctx->crc_len = ctx->len - CRC_SIZE;
+	}
+}
+
+/* Decode the input until the end of a frame, with the same result as hdlc_decode_byte() for
+ * each byte. The bytes between the special octets are copied, or skipped outside of a frame,
+ * in bulk. Returns the number of bytes consumed.
+ */
+static size_t hdlc_decode(struct hdlc_decode_ctx *ctx, uint8_t *out, const uint8_t *in,
+			  size_t len)
+{
+	size_t i = 0;
+	size_t run;
+
+	while (i < len) {
+		if (ctx->state == HDLC_STATE_UNSYNC) {
+			i += hdlc_find(in + i, len - i, false);
+		} else if (ctx->state == HDLC_STATE_FRAME) {
+			run = hdlc_find(in + i, len - i, true);
+
+			if (run > ctx->capacity - ctx->len) {
+				/* Ignore too long frame */
+				ctx->state = HDLC_STATE_UNSYNC;
+				i += run;
+				continue;
+			}
+
+			memcpy(out + ctx->len, in + i, run);
+			ctx->len += run;
+			i += run;
+			hdlc_crc_update(ctx, out);
+		}
+
+		if (i == len) {
+			break;
+		}
+
+		hdlc_decode_byte(ctx, out, in[i++]);
+
+		if (ctx->state == HDLC_STATE_FRAME_FOUND) {
+			break;
+		}
+	}
+
+	hdlc_crc_update(ctx, out);
+
+	return i;
+}
+
+#if !defined(CONFIG_NRF_RPC_UART_ASYNC)
+static void rx_packet(struct nrf_rpc_uart *uart_tr)
+{
+	uint16_t crc_received = 0;
+	uint16_t crc_calculated = 0;
+
+	uart_tr->rx_pkt_ctx.len -= CRC_SIZE;
+	crc_received = sys_get_le16(uart_tr->rx_pkt + uart_tr->rx_pkt_ctx.len);
+	crc_calculated = uart_tr->rx_pkt_ctx.crc;
+
+	log_hexdump_dbg(uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len, ">>> RX packet %04x",
+			crc_received);
+
+	if (!crc_compare(crc_received, crc_calculated)) {
+		LOG_ERR("Invalid packet CRC: calculated %04x but received %04x", crc_calculated,
+			crc_received);
+		return;
+	}
+
+	ack_tx(uart_tr, crc_received);
+
+	if (rx_flip_check(uart_tr, crc_received)) {
+		LOG_WRN("Duplicate packet %04x", crc_received);
+	} else {
+		uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_pkt,
+					  uart_tr->rx_pkt_ctx.len, uart_tr->receive_ctx);
+	}
+}
+#else
+static void ack_rx(struct nrf_rpc_uart *uart_tr);
+static void rx_packet(struct nrf_rpc_uart *uart_tr);
+#endif /* !CONFIG_NRF_RPC_UART_ASYNC */
+
 static void work_handler(struct k_work *work)
 {
 	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(work, struct nrf_rpc_uart, rx_work);
 	uint8_t *data;
 	size_t len;
 	int ret;
-	uint16_t crc_received = 0;
-	uint16_t crc_calculated = 0;
 
 	while (!ring_buf_is_empty(&uart_tr->rx_ringbuf)) {
 		len = ring_buf_get_claim(&uart_tr->rx_ringbuf, &data,
 					 CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE);
-		for (size_t i = 0; i < len; i++) {
-			hdlc_decode_byte(&uart_tr->rx_pkt_ctx, uart_tr->rx_pkt, data[i]);
+		for (size_t i = 0; i < len;) {
+			i += hdlc_decode(&uart_tr->rx_pkt_ctx, uart_tr->rx_pkt, data + i, len - i);
 
 			if (uart_tr->rx_pkt_ctx.state != HDLC_STATE_FRAME_FOUND) {
 				continue;
@@ -253,29 +486,7 @@ static void work_handler(struct k_work *work)
 				continue;
 			}
 
-			uart_tr->rx_pkt_ctx.len -= CRC_SIZE;
-			crc_received = sys_get_le16(uart_tr->rx_pkt + uart_tr->rx_pkt_ctx.len);
-			crc_calculated =
-				crc16_ccitt(0xffff, uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len);
-
-			log_hexdump_dbg(uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len,
-					">>> RX packet %04x", crc_received);
-
-			if (!crc_compare(crc_received, crc_calculated)) {
-				LOG_ERR("Invalid packet CRC: calculated %04x but received %04x",
-					crc_calculated, crc_received);
-				continue;
-			}
-
-			ack_tx(uart_tr, crc_received);
-
-			if (rx_flip_check(uart_tr, crc_received)) {
-				LOG_WRN("Duplicate packet %04x", crc_received);
-			} else {
-				uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_pkt,
-							  uart_tr->rx_pkt_ctx.len,
-							  uart_tr->receive_ctx);
-			}
+			rx_packet(uart_tr);
 		}
 
 		ret = ring_buf_get_finish(&uart_tr->rx_ringbuf, len);
@@ -287,8 +498,8 @@ static void work_handler(struct k_work *work)
 
 static void decode_ack(struct nrf_rpc_uart *inst, const uint8_t *in, size_t len)
 {
-	for (size_t i = 0; i < len; i++) {
-		hdlc_decode_byte(&inst->rx_ack_ctx, inst->rx_ack, in[i]);
+	for (size_t i = 0; i < len;) {
+		i += hdlc_decode(&inst->rx_ack_ctx, inst->rx_ack, in + i, len - i);
 
 		if (inst->rx_ack_ctx.state == HDLC_STATE_FRAME_FOUND) {
 			ack_rx(inst);
@@ -296,6 +507,7 @@ static void decode_ack(struct nrf_rpc_uart *inst, const uint8_t *in, size_t len)
 	}
 }
 
+#if !defined(CONFIG_NRF_RPC_UART_ASYNC)
 static void serial_cb(const struct device *uart, void *user_data)
 {
 	struct nrf_rpc_uart *uart_tr = user_data;
@@ -331,6 +543,12 @@ static void serial_cb(const struct device *uart, void *user_data)
 		k_work_submit_to_queue(&uart_tr->rx_workq, &uart_tr->rx_work);
 	}
 }
+#else
+static void async_cb(const struct device *dev, struct uart_event *evt, void *user_data);
+static void tx_timer_expiry(struct k_timer *timer);
+static void rx_enable(struct nrf_rpc_uart *uart_tr);
+static void tx_start(struct nrf_rpc_uart *uart_tr, k_spinlock_key_t key);
+#endif /* !CONFIG_NRF_RPC_UART_ASYNC */
 
 static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t receive_cb,
 		void *context)
@@ -357,6 +575,29 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		return -NRF_ENOENT;
 	}
 
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+	/* configure DMA transfers and callback to send and receive data */
+	int ret = uart_callback_set(uart_tr->uart, async_cb, uart_tr);
+
+	if (ret < 0) {
+		if (ret == -ENOTSUP || ret == -ENOSYS) {
+			LOG_ERR("UART device does not support asynchronous API\n");
+		} else {
+			LOG_ERR("Error setting UART callback: %d\n", ret);
+		}
+		return 0;
+	}
+
+	k_sem_init(&uart_tr->tx_slots, WINDOW_SIZE, WINDOW_SIZE);
+	k_timer_init(&uart_tr->tx_timer, tx_timer_expiry, NULL);
+	/* A reliable transport first sends a reset, which tells the peer to drop what it kept
+	 * from before the restart and to expect the next frame at the current sequence number.
+	 * The frames wait until the peer acknowledges it.
+	 */
+	uart_tr->tx_synced = true;
+	uart_tr->tx_reset = IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE);
+	uart_tr->tx_reset_queued = uart_tr->tx_reset;
+#else
 	/* configure interrupt and callback to receive data */
 	int ret = uart_irq_callback_user_data_set(uart_tr->uart, serial_cb, uart_tr);
 
@@ -379,6 +620,7 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		uart_tr->flips.tx_flip = FLIP_ZERO;
 		uart_tr->flips.rx_flip_any = 1;
 	}
+#endif /* CONFIG_NRF_RPC_UART_ASYNC */
 
 	k_work_queue_init(&uart_tr->rx_workq);
 	k_work_queue_start(&uart_tr->rx_workq, uart_tr->rx_workq_stack,
@@ -390,14 +632,24 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 
 	uart_tr->rx_pkt_ctx.state = HDLC_STATE_UNSYNC;
 	uart_tr->rx_pkt_ctx.capacity = sizeof(uart_tr->rx_pkt);
+	/* The CRC covers the sequence number of a reliable asynchronous frame last. */
+	uart_tr->rx_pkt_ctx.crc_skip = IS_ENABLED(CONFIG_NRF_RPC_UART_ASYNC) &&
+				       IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE);
 	uart_tr->rx_ack_ctx.state = HDLC_STATE_UNSYNC;
 	uart_tr->rx_ack_ctx.capacity = sizeof(uart_tr->rx_ack);
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+	rx_enable(uart_tr);
+	/* Send the reset. */
+	tx_start(uart_tr, k_spin_lock(&uart_tr->tx_spinlock));
+#else
 	uart_irq_rx_enable(uart_tr->uart);
+#endif
 	nrf_rpc_uart_initialized_hook(uart_tr->uart);
 
 	return 0;
 }
 
+#if !defined(CONFIG_NRF_RPC_UART_ASYNC)
 static void send_byte(const struct device *dev, uint8_t byte)
 {
 	if (byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE) {
@@ -463,6 +715,594 @@ static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t
 
 	return acked ? 0 : -EPROTO;
 }
+#endif /* !CONFIG_NRF_RPC_UART_ASYNC */
+
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+static uint8_t tx_item_byte(const struct tx_item *item, uint16_t pos)
+{
+	if (pos < item->head_len) {
+		return item->head[pos];
+	}
+
+	pos -= item->head_len;
+
+	if (pos < item->body_len) {
+		return item->body[pos];
+	}
+
+	return item->tail[pos - item->body_len];
+}
+
+static bool tx_item_next(struct nrf_rpc_uart *uart_tr)
+{
+	struct tx_item *item = &uart_tr->tx_item;
+
+	/* Acknowledgments go first, so that the peer can move its window. */
+	if (uart_tr->tx_reset_ack) {
+		uint8_t seq = uart_tr->tx_reset_ack_seq | SEQ_SYNC;
+
+		uart_tr->tx_reset_ack = false;
+		LOG_DBG("<<< TX reset ack %u", seq & SEQ_MASK);
+
+		*item = (struct tx_item){
+			.head = {seq, (uint8_t)~seq},
+			.head_len = 2,
+			.slot = TX_SLOT_ACK,
+			.active = true,
+		};
+		return true;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(uart_tr->tx_acks); i++) {
+		if (uart_tr->tx_acks[i] != 0) {
+			uint8_t bit = find_lsb_set(uart_tr->tx_acks[i]) - 1;
+			uint8_t seq = i * 32 + bit;
+
+			uart_tr->tx_acks[i] &= ~BIT(bit);
+			LOG_DBG("<<< TX ack %u", seq);
+
+			*item = (struct tx_item){
+				.head = {seq, (uint8_t)~seq},
+				.head_len = 2,
+				.slot = TX_SLOT_ACK,
+				.active = true,
+			};
+			return true;
+		}
+	}
+
+	/* The reset is a frame with the sync flag and no packet. */
+	if (uart_tr->tx_reset) {
+		if (!uart_tr->tx_reset_queued) {
+			return false;
+		}
+
+		*item = (struct tx_item){
+			.head = {uart_tr->tx_head_seq | SEQ_SYNC},
+			.head_len = 1,
+			.tail_len = CRC_SIZE,
+			.slot = TX_SLOT_RESET,
+			.active = true,
+		};
+		sys_put_le16(crc16_ccitt(0xffff, item->head, 1), item->tail);
+		return true;
+	}
+
+	for (uint8_t i = 0; i < uart_tr->tx_count; i++) {
+		uint8_t slot = (uart_tr->tx_head + i) % WINDOW_SIZE;
+		struct tx_frame *frame = &uart_tr->tx_frames[slot];
+
+		if (frame->queued) {
+			*item = (struct tx_item){
+				.body = frame->data,
+				.body_len = frame->len,
+				.tail_len = CRC_SIZE,
+				.slot = slot,
+				.active = true,
+			};
+
+			if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
+				uint8_t seq = (uart_tr->tx_head_seq + i) & SEQ_MASK;
+
+				frame->sync |= !uart_tr->tx_synced;
+				item->head[0] = seq | (frame->sync ? SEQ_SYNC : 0);
+				item->head_len = 1;
+				/* The CRC covers the sequence number after the packet. */
+				sys_put_le16(crc16_ccitt(frame->crc, item->head, 1), item->tail);
+			} else {
+				sys_put_le16(frame->crc, item->tail);
+			}
+
+			return true;
+		}
+
+		/* Until the peer acknowledges the first frame, the others wait. */
+		if (!uart_tr->tx_synced) {
+			break;
+		}
+	}
+
+	return false;
+}
+
+static void tx_release(struct nrf_rpc_uart *uart_tr)
+{
+	while (uart_tr->tx_count > 0) {
+		struct tx_frame *frame = &uart_tr->tx_frames[uart_tr->tx_head];
+
+		if (!frame->done ||
+		    (uart_tr->tx_item.active && uart_tr->tx_item.slot == uart_tr->tx_head)) {
+			break;
+		}
+
+		k_free((void *)frame->data);
+		frame->data = NULL;
+
+		uart_tr->tx_head = (uart_tr->tx_head + 1) % WINDOW_SIZE;
+		uart_tr->tx_head_seq = (uart_tr->tx_head_seq + 1) & SEQ_MASK;
+		uart_tr->tx_count--;
+		k_sem_give(&uart_tr->tx_slots);
+	}
+}
+
+static void tx_item_done(struct nrf_rpc_uart *uart_tr)
+{
+	struct tx_item *item = &uart_tr->tx_item;
+	struct tx_frame *frame;
+
+	item->active = false;
+
+	if (item->slot == TX_SLOT_RESET) {
+		uart_tr->tx_reset_queued = false;
+		uart_tr->tx_reset_deadline = k_uptime_get() + ACK_TIME_MS;
+
+		if (k_timer_remaining_get(&uart_tr->tx_timer) == 0) {
+			k_timer_start(&uart_tr->tx_timer, K_MSEC(ACK_TIME_MS), K_NO_WAIT);
+		}
+		return;
+	}
+
+	if (item->slot < 0) {
+		return;
+	}
+
+	frame = &uart_tr->tx_frames[item->slot];
+	frame->queued = false;
+
+	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
+		frame->done = true;
+	} else if (!frame->done) {
+		frame->attempts++;
+		frame->deadline = k_uptime_get() + ACK_TIME_MS;
+
+		if (k_timer_remaining_get(&uart_tr->tx_timer) == 0) {
+			k_timer_start(&uart_tr->tx_timer, K_MSEC(ACK_TIME_MS), K_NO_WAIT);
+		}
+	}
+
+	tx_release(uart_tr);
+}
+
+static size_t tx_encode(struct nrf_rpc_uart *uart_tr)
+{
+	struct tx_item *item = &uart_tr->tx_item;
+	uint8_t *buf = uart_tr->tx_buf;
+	size_t size = sizeof(uart_tr->tx_buf);
+	size_t len = 0;
+
+	while (len < size) {
+		if (!item->active) {
+			if (!tx_item_next(uart_tr)) {
+				break;
+			}
+
+			buf[len++] = HDLC_CHAR_DELIMITER;
+			continue;
+		}
+
+		if (item->pos == item->head_len + item->body_len + item->tail_len) {
+			buf[len++] = HDLC_CHAR_DELIMITER;
+			tx_item_done(uart_tr);
+			continue;
+		}
+
+		uint8_t byte = tx_item_byte(item, item->pos);
+
+		if (byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE) {
+			/* Do not split the escape sequence between transfers. */
+			if (len + 2 > size) {
+				break;
+			}
+
+			buf[len++] = HDLC_CHAR_ESCAPE;
+			byte ^= 0x20;
+		}
+
+		buf[len++] = byte;
+		item->pos++;
+	}
+
+	return len;
+}
+
+/* Start sending the pending frames, if the UART is idle. Releases the TX lock. */
+static void tx_start(struct nrf_rpc_uart *uart_tr, k_spinlock_key_t key)
+{
+	size_t len = 0;
+	uint32_t remaining;
+	int err;
+
+	if (!uart_tr->tx_busy) {
+		uart_tr->tx_len = tx_encode(uart_tr);
+		uart_tr->tx_busy = (uart_tr->tx_len > 0);
+		len = uart_tr->tx_len;
+	} else if (uart_tr->tx_failed) {
+		uart_tr->tx_failed = false;
+		len = uart_tr->tx_len;
+	}
+
+	k_spin_unlock(&uart_tr->tx_spinlock, key);
+
+	if (len == 0) {
+		return;
+	}
+
+	err = uart_tx(uart_tr->uart, uart_tr->tx_buf, len, SYS_FOREVER_US);
+	if (err) {
+		/* The acknowledgments and the unreliable frames in the TX buffer are not kept
+		 * anywhere else, so the buffer stays as it is until the transfer starts.
+		 */
+		LOG_ERR("Failed to start UART TX: %d", err);
+
+		key = k_spin_lock(&uart_tr->tx_spinlock);
+		uart_tr->tx_failed = true;
+		remaining = k_timer_remaining_get(&uart_tr->tx_timer);
+
+		if (remaining == 0 || remaining > TX_RETRY_MS) {
+			k_timer_start(&uart_tr->tx_timer, K_MSEC(TX_RETRY_MS), K_NO_WAIT);
+		}
+
+		k_spin_unlock(&uart_tr->tx_spinlock, key);
+	}
+}
+
+static void ack_queue(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	k_spinlock_key_t key = k_spin_lock(&uart_tr->tx_spinlock);
+
+	uart_tr->tx_acks[seq / 32] |= BIT(seq % 32);
+	tx_start(uart_tr, key);
+}
+
+static void ack_rx(struct nrf_rpc_uart *uart_tr)
+{
+	k_spinlock_key_t key;
+	uint8_t seq = uart_tr->rx_ack[0];
+	uint8_t i;
+
+	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE) || uart_tr->rx_ack_ctx.len != CRC_SIZE ||
+	    uart_tr->rx_ack[1] != (uint8_t)~seq) {
+		log_hexdump_dbg(uart_tr->rx_ack, uart_tr->rx_ack_ctx.len, ">>> RX invalid frame");
+		return;
+	}
+
+	key = k_spin_lock(&uart_tr->tx_spinlock);
+
+	if (seq & SEQ_SYNC) {
+		seq &= SEQ_MASK;
+		LOG_DBG(">>> RX reset ack %u", seq);
+
+		if (uart_tr->tx_reset && seq == uart_tr->tx_head_seq) {
+			uart_tr->tx_reset = false;
+		}
+
+		tx_start(uart_tr, key);
+		return;
+	}
+
+	LOG_DBG(">>> RX ack %u", seq);
+
+	i = (seq - uart_tr->tx_head_seq) & SEQ_MASK;
+	if (i < uart_tr->tx_count) {
+		struct tx_frame *frame = &uart_tr->tx_frames[(uart_tr->tx_head + i) % WINDOW_SIZE];
+
+		frame->done = true;
+		frame->queued = false;
+		uart_tr->tx_synced = true;
+		tx_release(uart_tr);
+	} else {
+		LOG_DBG("Ack %u outside of the window", seq);
+	}
+
+	tx_start(uart_tr, key);
+}
+
+static void tx_timer_expiry(struct k_timer *timer)
+{
+	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(timer, struct nrf_rpc_uart, tx_timer);
+	k_spinlock_key_t key = k_spin_lock(&uart_tr->tx_spinlock);
+	int64_t now = k_uptime_get();
+	int64_t next = INT64_MAX;
+
+	if (uart_tr->tx_reset && !uart_tr->tx_reset_queued) {
+		if (uart_tr->tx_reset_deadline > now) {
+			next = uart_tr->tx_reset_deadline;
+		} else {
+			/* The peer may not be running yet, keep trying. */
+			LOG_DBG("Reset not acknowledged");
+			uart_tr->tx_reset_queued = true;
+		}
+	}
+
+	/* Send again only the frames whose acknowledgment is late. */
+	for (uint8_t i = 0; i < uart_tr->tx_count; i++) {
+		struct tx_frame *frame = &uart_tr->tx_frames[(uart_tr->tx_head + i) % WINDOW_SIZE];
+
+		if (frame->done || frame->queued) {
+			continue;
+		}
+
+		if (frame->deadline > now) {
+			next = MIN(next, frame->deadline);
+		} else if (frame->attempts < TX_ATTEMPTS) {
+			LOG_WRN("Ack timeout for frame %u", (uart_tr->tx_head_seq + i) & SEQ_MASK);
+			frame->queued = true;
+		} else {
+			LOG_ERR("Frame %u not acknowledged, dropping it",
+				(uart_tr->tx_head_seq + i) & SEQ_MASK);
+			frame->done = true;
+			/* The next frame tells the peer to stop waiting for this one. */
+			uart_tr->tx_synced = false;
+		}
+	}
+
+	tx_release(uart_tr);
+
+	if (!uart_tr->tx_synced && uart_tr->tx_count > 0) {
+		struct tx_frame *head = &uart_tr->tx_frames[uart_tr->tx_head];
+
+		head->queued = !head->done;
+	}
+
+	if (next != INT64_MAX) {
+		k_timer_start(timer, K_MSEC(next - now), K_NO_WAIT);
+	}
+
+	tx_start(uart_tr, key);
+}
+
+static void rx_deliver(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t len)
+{
+	uart_tr->receive_callback(uart_tr->transport, data, len, uart_tr->receive_ctx);
+}
+
+/* Move the RX window by count frames, delivering the stored packets in order. */
+static void rx_window_move(struct nrf_rpc_uart *uart_tr, uint8_t count)
+{
+	for (uint8_t i = 0; i < count; i++) {
+		uint8_t *data = uart_tr->rx_frames[uart_tr->rx_head];
+
+		if (data != NULL) {
+			uart_tr->rx_frames[uart_tr->rx_head] = NULL;
+			rx_deliver(uart_tr, data, uart_tr->rx_frame_len[uart_tr->rx_head]);
+			k_free(data);
+		}
+
+		uart_tr->rx_head = (uart_tr->rx_head + 1) % WINDOW_SIZE;
+		uart_tr->rx_head_seq = (uart_tr->rx_head_seq + 1) & SEQ_MASK;
+	}
+}
+
+/* The peer has restarted, the packets kept from before are dropped. */
+static void rx_reset(struct nrf_rpc_uart *uart_tr, uint8_t seq)
+{
+	k_spinlock_key_t key;
+
+	LOG_DBG(">>> RX reset %u", seq);
+
+	for (uint8_t i = 0; i < WINDOW_SIZE; i++) {
+		k_free(uart_tr->rx_frames[i]);
+		uart_tr->rx_frames[i] = NULL;
+	}
+
+	uart_tr->rx_head_seq = seq;
+	uart_tr->rx_synced = true;
+
+	/* The reset is sent again until it is acknowledged, but only before any frame after it.
+	 * A repeated one finds nothing to drop.
+	 */
+	key = k_spin_lock(&uart_tr->tx_spinlock);
+	uart_tr->tx_reset_ack = true;
+	uart_tr->tx_reset_ack_seq = seq;
+	tx_start(uart_tr, key);
+}
+
+static void rx_window_put(struct nrf_rpc_uart *uart_tr, uint8_t seq_byte, const uint8_t *data,
+			  size_t len)
+{
+	uint8_t seq = seq_byte & SEQ_MASK;
+	uint8_t ahead = (seq - uart_tr->rx_head_seq) & SEQ_MASK;
+	uint8_t slot;
+
+	/* A restart of the peer comes with a reset, so even a frame with the sync flag that is
+	 * behind the window has been delivered already, and the acknowledgment was lost.
+	 */
+	if (uart_tr->rx_synced && ahead > SEQ_MASK - WINDOW_SIZE) {
+		LOG_WRN("Duplicate frame %u", seq);
+		ack_queue(uart_tr, seq);
+		return;
+	}
+
+	if (!uart_tr->rx_synced || (seq_byte & SEQ_SYNC)) {
+		/* This side has restarted, or the peer has given up on the frames before this one.
+		 */
+		rx_window_move(uart_tr, MIN(ahead, WINDOW_SIZE));
+		uart_tr->rx_head_seq = seq;
+		uart_tr->rx_synced = true;
+		ahead = 0;
+	} else if (ahead >= WINDOW_SIZE) {
+		LOG_WRN("Frame %u outside of the window", seq);
+		return;
+	}
+
+	slot = (uart_tr->rx_head + ahead) % WINDOW_SIZE;
+
+	if (ahead > 0) {
+		/* Keep the packet until the missing ones before it are sent again. */
+		if (uart_tr->rx_frames[slot] == NULL) {
+			uint8_t *copy = k_malloc(len);
+
+			if (copy == NULL) {
+				LOG_WRN("No memory to keep frame %u", seq);
+				return;
+			}
+
+			memcpy(copy, data, len);
+			uart_tr->rx_frames[slot] = copy;
+			uart_tr->rx_frame_len[slot] = len;
+		}
+
+		ack_queue(uart_tr, seq);
+		return;
+	}
+
+	ack_queue(uart_tr, seq);
+
+	if (uart_tr->rx_frames[slot] != NULL) {
+		k_free(uart_tr->rx_frames[slot]);
+		uart_tr->rx_frames[slot] = NULL;
+	}
+
+	rx_deliver(uart_tr, data, len);
+	rx_window_move(uart_tr, 1);
+
+	while (uart_tr->rx_frames[uart_tr->rx_head] != NULL) {
+		rx_window_move(uart_tr, 1);
+	}
+}
+
+static void rx_packet(struct nrf_rpc_uart *uart_tr)
+{
+	uint8_t *pkt = uart_tr->rx_pkt;
+	size_t len = uart_tr->rx_pkt_ctx.len - CRC_SIZE;
+	uint16_t crc_received = sys_get_le16(pkt + len);
+	uint16_t crc_calculated;
+
+	if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
+		/* A frame without a packet is a reset, with the sync flag set. */
+		if (len < 1 || (len == 1 && !(pkt[0] & SEQ_SYNC))) {
+			log_hexdump_dbg(pkt, len, ">>> RX invalid frame");
+			return;
+		}
+
+		/* The first byte is the sequence number, covered by the CRC after the packet. */
+		crc_calculated = crc16_ccitt(uart_tr->rx_pkt_ctx.crc, pkt, 1);
+	} else {
+		crc_calculated = uart_tr->rx_pkt_ctx.crc;
+	}
+
+	log_hexdump_dbg(pkt, len, ">>> RX packet %04x", crc_received);
+
+	if (crc_received != crc_calculated) {
+		LOG_ERR("Invalid packet CRC: calculated %04x but received %04x", crc_calculated,
+			crc_received);
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE) && len == 1) {
+		rx_reset(uart_tr, pkt[0] & SEQ_MASK);
+	} else if (IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE)) {
+		rx_window_put(uart_tr, pkt[0], pkt + 1, len - 1);
+	} else {
+		rx_deliver(uart_tr, pkt, len);
+	}
+}
+
+static void rx_enable(struct nrf_rpc_uart *uart_tr)
+{
+	int err = uart_rx_enable(uart_tr->uart, uart_tr->rx_dma_buf[uart_tr->rx_dma_next],
+				 sizeof(uart_tr->rx_dma_buf[0]), RX_TIMEOUT_US);
+
+	if (err) {
+		LOG_ERR("Failed to enable UART RX: %d", err);
+		return;
+	}
+
+	uart_tr->rx_dma_next ^= 1;
+}
+
+static void async_cb(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	struct nrf_rpc_uart *uart_tr = user_data;
+	k_spinlock_key_t key;
+	const uint8_t *rx_data;
+	uint32_t rx_len;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		key = k_spin_lock(&uart_tr->tx_spinlock);
+		uart_tr->tx_busy = false;
+		tx_start(uart_tr, key);
+		break;
+	case UART_RX_RDY:
+		rx_data = evt->data.rx.buf + evt->data.rx.offset;
+		decode_ack(uart_tr, rx_data, evt->data.rx.len);
+
+		rx_len = ring_buf_put(&uart_tr->rx_ringbuf, rx_data, evt->data.rx.len);
+		if (rx_len < evt->data.rx.len) {
+			LOG_WRN("RX ring buffer full");
+		}
+
+		k_work_submit_to_queue(&uart_tr->rx_workq, &uart_tr->rx_work);
+		break;
+	case UART_RX_BUF_REQUEST:
+		if (uart_rx_buf_rsp(dev, uart_tr->rx_dma_buf[uart_tr->rx_dma_next],
+				    sizeof(uart_tr->rx_dma_buf[0])) == 0) {
+			uart_tr->rx_dma_next ^= 1;
+		}
+		break;
+	case UART_RX_DISABLED:
+		rx_enable(uart_tr);
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("UART RX stopped: %d", evt->data.rx_stop.reason);
+		break;
+	default:
+		break;
+	}
+}
+
+static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
+{
+	struct nrf_rpc_uart *uart_tr = transport->ctx;
+	uint16_t crc_val = crc16_ccitt(0xffff, data, length);
+	struct tx_frame *frame;
+	k_spinlock_key_t key;
+
+	log_hexdump_dbg(data, length, "<<< TX packet %04x", crc_val);
+
+	/* Wait for room in the window. The packet is sent, and freed once it is acknowledged,
+	 * in the background.
+	 */
+	k_sem_take(&uart_tr->tx_slots, K_FOREVER);
+
+	key = k_spin_lock(&uart_tr->tx_spinlock);
+
+	frame = &uart_tr->tx_frames[(uart_tr->tx_head + uart_tr->tx_count) % WINDOW_SIZE];
+	*frame = (struct tx_frame){
+		.data = data,
+		.len = length,
+		.crc = crc_val,
+		.queued = true,
+	};
+	uart_tr->tx_count++;
+
+	tx_start(uart_tr, key);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_RPC_UART_ASYNC */
 
 static void *tx_buf_alloc(const struct nrf_rpc_tr *transport, size_t *size)
 {
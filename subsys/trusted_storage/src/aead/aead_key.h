@@ -14,4 +14,16 @@
 
 psa_status_t trusted_storage_get_key(psa_storage_uid_t uid, uint8_t *key_buf, size_t key_length);
 
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE
+/* Gets the key from the cache, or derives it and adds it to the cache */
+psa_status_t trusted_storage_get_key_cached(psa_storage_uid_t uid, uint8_t *key_buf,
+					    size_t key_length);
+#else
+static inline psa_status_t trusted_storage_get_key_cached(psa_storage_uid_t uid,
+							  uint8_t *key_buf, size_t key_length)
+{
+	return trusted_storage_get_key(uid, key_buf, key_length);
+}
+#endif
+
 #endif /* __TRUSTED_STORAGE_AUTH_CRYPT_KEY_H_ */
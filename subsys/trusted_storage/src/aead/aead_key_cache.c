@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <mbedtls/platform_util.h>
+
+#include "aead_key.h"
+
+/*
+ * Cache of the derived AEAD keys
+ *
+ * Deriving a key takes a hash or a key derivation for each access to an object. The keys of
+ * the recently used UIDs are kept in RAM for a short time, after which they are wiped.
+ * The timeout is not extended on use, so that no key stays in RAM longer than the timeout.
+ */
+
+#define CACHE_SIZE    CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_SIZE
+#define CACHE_TIMEOUT CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_TIMEOUT_MS
+
+struct key_cache_entry {
+	psa_storage_uid_t uid;
+	int64_t expiry;
+	bool valid;
+	uint8_t key[AEAD_KEY_SIZE];
+};
+
+static struct key_cache_entry cache[CACHE_SIZE];
+static K_MUTEX_DEFINE(cache_mutex);
+
+static void cache_expire(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(cache_expire_work, cache_expire);
+
+/* Wipes the expired keys and schedules the next expiry, the mutex must be held */
+static void cache_purge(void)
+{
+	int64_t now = k_uptime_get();
+	int64_t next = INT64_MAX;
+
+	for (size_t i = 0; i < CACHE_SIZE; i++) {
+		if (!cache[i].valid) {
+			continue;
+		}
+
+		if (cache[i].expiry <= now) {
+			mbedtls_platform_zeroize(&cache[i], sizeof(cache[i]));
+		} else {
+			next = MIN(next, cache[i].expiry);
+		}
+	}
+
+	if (next != INT64_MAX) {
+		k_work_reschedule(&cache_expire_work, K_MSEC(next - now));
+	}
+}
+
+static void cache_expire(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	cache_purge();
+	k_mutex_unlock(&cache_mutex);
+}
+
+psa_status_t trusted_storage_get_key_cached(psa_storage_uid_t uid, uint8_t *key_buf,
+					    size_t key_length)
+{
+	psa_status_t status;
+	struct key_cache_entry *entry = &cache[0];
+
+	if (key_length < AEAD_KEY_SIZE) {
+		return PSA_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	cache_purge();
+
+	for (size_t i = 0; i < CACHE_SIZE; i++) {
+		if (cache[i].valid && cache[i].uid == uid) {
+			memcpy(key_buf, cache[i].key, AEAD_KEY_SIZE);
+			k_mutex_unlock(&cache_mutex);
+			return PSA_SUCCESS;
+		}
+
+		/* Use a free entry, or replace the one that expires first */
+		if (entry->valid && (!cache[i].valid || cache[i].expiry < entry->expiry)) {
+			entry = &cache[i];
+		}
+	}
+
+	status = trusted_storage_get_key(uid, key_buf, key_length);
+	if (status == PSA_SUCCESS) {
+		entry->uid = uid;
+		entry->expiry = k_uptime_get() + CACHE_TIMEOUT;
+		entry->valid = true;
+		memcpy(entry->key, key_buf, AEAD_KEY_SIZE);
+		cache_purge();
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return status;
+}
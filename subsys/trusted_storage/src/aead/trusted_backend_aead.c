@@ -47,53 +47,112 @@ typedef struct stored_object {
 	uint8_t data[AEAD_MAX_BUF_SIZE];
 } stored_object;
 
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+/*
+ * Chunked object format
+ *
+ * The data is split into chunks that are encrypted separately, with the chunk number as
+ * additional data. The index, which is the header and the nonces of all chunks, is
+ * authenticated with a tag of its own, so that a chunk cannot be replaced with an older one.
+ *
+ * Layout:
+ * - chunked_object_header
+ * - Nonce of each chunk
+ * - Index nonce and tag
+ * - Each chunk followed by its tag
+ */
+
+#define CHUNK_SIZE CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE
+#define CHUNKS_MAX DIV_ROUND_UP(STORAGE_MAX_ASSET_SIZE, CHUNK_SIZE)
+
+/* Set in the stored create flags of the objects in the chunked format */
+#define STORED_FLAG_CHUNKED BIT(31)
+
+#define NONCE_OFFSET(chunk)  (sizeof(chunked_object_header) + (chunk) * AEAD_NONCE_SIZE)
+#define INDEX_OFFSET(chunks) NONCE_OFFSET(chunks)
+#define CHUNK_OFFSET(chunks, chunk)                                                               \
+	(INDEX_OFFSET(chunks) + AEAD_NONCE_SIZE + AEAD_TAG_SIZE +                                 \
+	 (chunk) * (CHUNK_SIZE + AEAD_TAG_SIZE))
+#define CHUNKED_OBJECT_MAX_SIZE                                                                   \
+	(CHUNK_OFFSET(CHUNKS_MAX, 0) + STORAGE_MAX_ASSET_SIZE + CHUNKS_MAX * AEAD_TAG_SIZE)
+
+typedef struct chunked_object_header {
+	stored_object_header header;
+	size_t capacity;
+} chunked_object_header;
+
+typedef union chunked_object {
+	chunked_object_header header;
+	stored_object legacy;
+	uint8_t raw[CHUNKED_OBJECT_MAX_SIZE];
+} chunked_object;
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
+
 psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
 			      struct psa_storage_info_t *p_info)
 {
 	psa_status_t status;
 	size_t out_length;
-	stored_object_header header;
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	chunked_object_header chunked_header;
+	stored_object_header *header = &chunked_header.header;
+	size_t header_size = sizeof(chunked_header);
+#else
+	stored_object_header stored_header;
+	stored_object_header *header = &stored_header;
+	size_t header_size = sizeof(stored_header);
+#endif
 
 	if (p_info == NULL || uid == INVALID_UID) {
 		return PSA_ERROR_INVALID_ARGUMENT;
 	}
 
 	/* Get size & flags */
-	status = storage_get_object(uid, prefix, (void *)&header, sizeof(header), &out_length);
+	status = storage_get_object(uid, prefix, (void *)header, header_size, &out_length);
 	if (status != PSA_SUCCESS) {
 		return status;
 	}
 
-	p_info->capacity = header.data_size;
-	p_info->size = header.data_size;
-	p_info->flags = header.create_flags;
+	p_info->capacity = header->data_size;
+	p_info->size = header->data_size;
+	p_info->flags = header->create_flags;
+
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	if ((header->create_flags & STORED_FLAG_CHUNKED) != 0) {
+		p_info->capacity = chunked_header.capacity;
+		p_info->flags &= ~STORED_FLAG_CHUNKED;
+	}
+#endif
 
 	return PSA_SUCCESS;
 }
 
-psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t data_offset,
-			 size_t data_length, void *p_data, size_t *p_data_length)
+/* Decrypts the data of the stored object in place */
+static psa_status_t legacy_decrypt(const uint8_t *key_buf, stored_object *object_data,
+				   size_t object_length, size_t *data_length)
+{
+	if (object_length < offsetof(stored_object, data)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	return trusted_storage_aead_decrypt(
+		key_buf, AEAD_KEY_SIZE, object_data->nonce, AEAD_NONCE_SIZE,
+		(void *)&object_data->header, sizeof(object_data->header), object_data->data,
+		object_length - offsetof(stored_object, data), object_data->data,
+		STORAGE_MAX_ASSET_SIZE, data_length);
+}
+
+static psa_status_t legacy_get(const psa_storage_uid_t uid, const char *prefix,
+			       size_t data_offset, size_t data_length, void *p_data,
+			       size_t *p_data_length)
 {
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	uint8_t key_buf[AEAD_KEY_SIZE + 1];
 	size_t out_length;
 	stored_object object_data;
 
-	if ((p_data == NULL && data_length != 0) || p_data_length == NULL || uid == INVALID_UID) {
-		return PSA_ERROR_INVALID_ARGUMENT;
-	}
-
-	if (data_length == 0) {
-		*p_data_length = 0;
-		return PSA_SUCCESS;
-	}
-
-	if ((data_offset + data_length) > STORAGE_MAX_ASSET_SIZE) {
-		return PSA_ERROR_INVALID_ARGUMENT;
-	}
-
 	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
 	if (status != PSA_SUCCESS) {
 		return status;
 	}
@@ -102,15 +161,10 @@ psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t
 	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
 				    &out_length);
 	if (status != PSA_SUCCESS) {
-		return status;
+		goto clean_up;
 	}
 
-	status = trusted_storage_aead_decrypt(
-		key_buf, AEAD_KEY_SIZE, object_data.nonce, AEAD_NONCE_SIZE,
-		(void *)&object_data.header, sizeof(object_data.header), object_data.data,
-		out_length - offsetof(stored_object, data), object_data.data,
-		STORAGE_MAX_ASSET_SIZE, &out_length);
-
+	status = legacy_decrypt(key_buf, &object_data, out_length, &out_length);
 	if (status != PSA_SUCCESS) {
 		goto clean_up;
 	}
@@ -138,13 +192,343 @@ clean_up:
 	return status;
 }
 
+#ifndef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+static psa_status_t legacy_set(const psa_storage_uid_t uid, const char *prefix,
+			       const uint8_t *key_buf, size_t data_length, const void *p_data,
+			       psa_storage_create_flags_t create_flags)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	size_t out_length = 0;
+	stored_object object_data;
+
+	/* Get new nonce at each set */
+	status = trusted_storage_get_nonce(object_data.nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	object_data.header.create_flags = create_flags;
+	object_data.header.data_size = data_length;
+
+	status = trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, object_data.nonce,
+					      AEAD_NONCE_SIZE, (void *)&object_data.header,
+					      sizeof(object_data.header), p_data, data_length,
+					      object_data.data, AEAD_MAX_BUF_SIZE, &out_length);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	/* Write data */
+	status = storage_set_object(uid, prefix, &object_data,
+				    offsetof(stored_object, data) + out_length);
+
+cleanup:
+	mbedtls_platform_zeroize(&object_data, sizeof(object_data));
+
+	return status;
+}
+
+#endif /* !CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
+
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+
+static size_t chunk_count(size_t capacity)
+{
+	return DIV_ROUND_UP(capacity, CHUNK_SIZE);
+}
+
+static size_t chunk_length(size_t capacity, size_t chunk)
+{
+	return MIN(CHUNK_SIZE, capacity - chunk * CHUNK_SIZE);
+}
+
+static size_t chunked_object_size(size_t capacity)
+{
+	size_t chunks = chunk_count(capacity);
+
+	return CHUNK_OFFSET(chunks, 0) + capacity + chunks * AEAD_TAG_SIZE;
+}
+
+static psa_status_t chunk_encrypt(const uint8_t *key_buf, chunked_object *object, size_t chunk,
+				  const uint8_t *data)
+{
+	psa_status_t status;
+	size_t capacity = object->header.capacity;
+	size_t chunks = chunk_count(capacity);
+	uint8_t *nonce = object->raw + NONCE_OFFSET(chunk);
+	uint32_t chunk_number = chunk;
+	size_t out_length;
+
+	status = trusted_storage_get_nonce(nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, nonce, AEAD_NONCE_SIZE,
+					    &chunk_number, sizeof(chunk_number), data,
+					    chunk_length(capacity, chunk),
+					    object->raw + CHUNK_OFFSET(chunks, chunk),
+					    CHUNK_SIZE + AEAD_TAG_SIZE, &out_length);
+}
+
+static psa_status_t chunk_decrypt(const uint8_t *key_buf, const chunked_object *object,
+				  size_t chunk, uint8_t *data)
+{
+	size_t capacity = object->header.capacity;
+	size_t chunks = chunk_count(capacity);
+	uint32_t chunk_number = chunk;
+	size_t out_length;
+
+	return trusted_storage_aead_decrypt(key_buf, AEAD_KEY_SIZE, object->raw + NONCE_OFFSET(chunk),
+					    AEAD_NONCE_SIZE, &chunk_number, sizeof(chunk_number),
+					    object->raw + CHUNK_OFFSET(chunks, chunk),
+					    chunk_length(capacity, chunk) + AEAD_TAG_SIZE, data,
+					    CHUNK_SIZE, &out_length);
+}
+
+/* Authenticates the header and the chunk nonces with a new index tag */
+static psa_status_t index_seal(const uint8_t *key_buf, chunked_object *object)
+{
+	psa_status_t status;
+	size_t index_size = INDEX_OFFSET(chunk_count(object->header.capacity));
+	uint8_t *nonce = object->raw + index_size;
+	size_t out_length;
+
+	status = trusted_storage_get_nonce(nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* Nothing is encrypted, the output is only the tag */
+	return trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, nonce, AEAD_NONCE_SIZE,
+					    object->raw, index_size, object->raw, 0,
+					    nonce + AEAD_NONCE_SIZE, AEAD_TAG_SIZE, &out_length);
+}
+
+static psa_status_t index_verify(const uint8_t *key_buf, chunked_object *object)
+{
+	size_t index_size = INDEX_OFFSET(chunk_count(object->header.capacity));
+	const uint8_t *nonce = object->raw + index_size;
+	size_t out_length;
+
+	return trusted_storage_aead_decrypt(key_buf, AEAD_KEY_SIZE, nonce, AEAD_NONCE_SIZE,
+					    object->raw, index_size, nonce + AEAD_NONCE_SIZE,
+					    AEAD_TAG_SIZE, object->raw, 0, &out_length);
+}
+
+/* Checks that the object read from storage is complete up to the given chunk */
+static psa_status_t chunked_check(const chunked_object *object, size_t object_length,
+				  size_t chunk)
+{
+	size_t capacity = object->header.capacity;
+	size_t chunks = chunk_count(capacity);
+	size_t end;
+
+	if (object_length < sizeof(chunked_object_header) || capacity > STORAGE_MAX_ASSET_SIZE ||
+	    object->header.header.data_size > capacity) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if (chunks == 0) {
+		end = CHUNK_OFFSET(0, 0);
+	} else {
+		chunk = MIN(chunk, chunks - 1);
+		end = CHUNK_OFFSET(chunks, chunk) + chunk_length(capacity, chunk) + AEAD_TAG_SIZE;
+	}
+
+	return object_length < end ? PSA_ERROR_DATA_CORRUPT : PSA_SUCCESS;
+}
+
+/*
+ * Encrypts all chunks of a new object into the given buffer, data is NULL to fill them with
+ * zeros. The data may be stored at the end of the buffer, as each chunk is copied before it
+ * is encrypted, and the encrypted chunks never reach the data of the next ones.
+ */
+static psa_status_t chunked_set(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, chunked_object *object, size_t capacity,
+				size_t data_length, const uint8_t *p_data,
+				psa_storage_create_flags_t create_flags)
+{
+	psa_status_t status = PSA_SUCCESS;
+	uint8_t chunk_data[CHUNK_SIZE] = {0};
+
+	object->header.header.create_flags = create_flags | STORED_FLAG_CHUNKED;
+	object->header.header.data_size = data_length;
+	object->header.capacity = capacity;
+
+	for (size_t chunk = 0; chunk < chunk_count(capacity) && status == PSA_SUCCESS; chunk++) {
+		if (p_data != NULL) {
+			memcpy(chunk_data, p_data + chunk * CHUNK_SIZE,
+			       chunk_length(capacity, chunk));
+		}
+
+		status = chunk_encrypt(key_buf, object, chunk, chunk_data);
+	}
+
+	if (status == PSA_SUCCESS) {
+		status = index_seal(key_buf, object);
+	}
+
+	if (status == PSA_SUCCESS) {
+		status = storage_set_object(uid, prefix, object->raw, chunked_object_size(capacity));
+	}
+
+	mbedtls_platform_zeroize(chunk_data, sizeof(chunk_data));
+
+	return status;
+}
+
+static psa_status_t chunked_get(const psa_storage_uid_t uid, const char *prefix,
+				size_t data_offset, size_t data_length, uint8_t *p_data,
+				size_t *p_data_length)
+{
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t chunk_data[CHUNK_SIZE];
+	size_t first = data_offset / CHUNK_SIZE;
+	size_t last = (data_offset + data_length - 1) / CHUNK_SIZE;
+	size_t out_length;
+	size_t copied = 0;
+	chunked_object object;
+
+	/* Read up to the end of the last requested chunk, for any number of chunks in the index */
+	status = storage_get_object(uid, prefix, object.raw,
+				    MIN(sizeof(object), CHUNK_OFFSET(CHUNKS_MAX, last + 1)),
+				    &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length >= sizeof(stored_object_header) &&
+	    (object.header.header.create_flags & STORED_FLAG_CHUNKED) == 0) {
+		return legacy_get(uid, prefix, data_offset, data_length, p_data, p_data_length);
+	}
+
+	status = chunked_check(&object, out_length, last);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (data_offset > object.header.header.data_size) {
+		*p_data_length = 0;
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	data_length = MIN(data_length, object.header.header.data_size - data_offset);
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = index_verify(key_buf, &object);
+
+	/* Only decrypt the chunks that contain the requested data */
+	for (size_t chunk = first; copied < data_length && status == PSA_SUCCESS; chunk++) {
+		size_t chunk_offset = (chunk == first) ? data_offset % CHUNK_SIZE : 0;
+		size_t length = MIN(CHUNK_SIZE - chunk_offset, data_length - copied);
+
+		status = chunk_decrypt(key_buf, &object, chunk, chunk_data);
+		if (status == PSA_SUCCESS) {
+			memcpy(p_data + copied, chunk_data + chunk_offset, length);
+			copied += length;
+		}
+	}
+
+	if (status == PSA_SUCCESS) {
+		*p_data_length = data_length;
+	}
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(chunk_data, sizeof(chunk_data));
+
+	return status;
+}
+
+static psa_status_t chunked_set_extended(const psa_storage_uid_t uid, const char *prefix,
+					 const uint8_t *key_buf, chunked_object *object,
+					 size_t data_offset, size_t data_length,
+					 const uint8_t *p_data)
+{
+	psa_status_t status = PSA_SUCCESS;
+	uint8_t chunk_data[CHUNK_SIZE];
+	size_t first = data_offset / CHUNK_SIZE;
+	size_t end = data_offset + data_length;
+	size_t written = 0;
+
+	status = index_verify(key_buf, object);
+
+	/* Only encrypt the chunks that contain the written data */
+	for (size_t chunk = first; written < data_length && status == PSA_SUCCESS; chunk++) {
+		size_t chunk_offset = (chunk == first) ? data_offset % CHUNK_SIZE : 0;
+		size_t length = MIN(CHUNK_SIZE - chunk_offset, data_length - written);
+
+		if (length == chunk_length(object->header.capacity, chunk)) {
+			status = chunk_encrypt(key_buf, object, chunk, p_data + written);
+		} else {
+			status = chunk_decrypt(key_buf, object, chunk, chunk_data);
+			if (status == PSA_SUCCESS) {
+				memcpy(chunk_data + chunk_offset, p_data + written, length);
+				status = chunk_encrypt(key_buf, object, chunk, chunk_data);
+			}
+		}
+
+		written += length;
+	}
+
+	mbedtls_platform_zeroize(chunk_data, sizeof(chunk_data));
+
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	object->header.header.data_size = MAX(object->header.header.data_size, end);
+
+	status = index_seal(key_buf, object);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return storage_set_object(uid, prefix, object->raw,
+				  chunked_object_size(object->header.capacity));
+}
+
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
+
+psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t data_offset,
+			 size_t data_length, void *p_data, size_t *p_data_length)
+{
+	if ((p_data == NULL && data_length != 0) || p_data_length == NULL || uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (data_length == 0) {
+		*p_data_length = 0;
+		return PSA_SUCCESS;
+	}
+
+	if ((data_offset + data_length) > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	return chunked_get(uid, prefix, data_offset, data_length, p_data, p_data_length);
+#else
+	return legacy_get(uid, prefix, data_offset, data_length, p_data, p_data_length);
+#endif
+}
+
 psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t data_length,
 			 const void *p_data, psa_storage_create_flags_t create_flags)
 {
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	uint8_t key_buf[AEAD_KEY_SIZE + 1];
 	size_t out_length = 0;
-	stored_object object_data;
+	stored_object_header header;
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	chunked_object object;
+#endif
 
 	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
 		return PSA_ERROR_INVALID_ARGUMENT;
@@ -159,62 +543,42 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 	}
 
 	/* Get flags */
-	status = storage_get_object(uid, prefix, (void *)&object_data.header,
-				    sizeof(object_data.header), &out_length);
+	status = storage_get_object(uid, prefix, (void *)&header, sizeof(header), &out_length);
 
 	if (status != PSA_SUCCESS && status != PSA_ERROR_DOES_NOT_EXIST) {
 		return status;
 	}
 
 	/* Do not allow to write new values if WRITE_ONCE flag is set */
-	if (status == PSA_SUCCESS &&
-	    (object_data.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+	if (status == PSA_SUCCESS && (header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
 		return PSA_ERROR_NOT_PERMITTED;
 	}
 
 	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
 	if (status != PSA_SUCCESS) {
 		goto cleanup_objects;
 	}
 
-	/* Get new nonce at each set */
-	status = trusted_storage_get_nonce(object_data.nonce, AEAD_NONCE_SIZE);
-	if (status != PSA_SUCCESS) {
-		goto cleanup_objects;
-	}
-
-	object_data.header.create_flags = create_flags;
-	object_data.header.data_size = data_length;
-
-	status = trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, object_data.nonce,
-					      AEAD_NONCE_SIZE, (void *)&object_data.header,
-					      sizeof(object_data.header), p_data, data_length,
-					      object_data.data, AEAD_MAX_BUF_SIZE, &out_length);
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	status = chunked_set(uid, prefix, key_buf, &object, data_length, data_length, p_data,
+			     create_flags);
+	mbedtls_platform_zeroize(&object, sizeof(object));
+#else
+	status = legacy_set(uid, prefix, key_buf, data_length, p_data, create_flags);
+#endif
 
 	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
 
-	if (status != PSA_SUCCESS) {
-		goto cleanup;
-	}
-
-	/* Write data */
-	status = storage_set_object(uid, prefix, &object_data,
-				    offsetof(stored_object, data) + out_length);
-	if (status != PSA_SUCCESS) {
-		goto cleanup_objects;
+	if (status == PSA_SUCCESS) {
+		return status;
 	}
 
-	goto cleanup;
-
 cleanup_objects:
 	/* Remove object if an error occurs */
 	LOG_DBG("trusted_set cleanup. status %d", status);
 	storage_remove_object(uid, prefix);
 
-cleanup:
-	mbedtls_platform_zeroize(&object_data, sizeof(object_data));
-
 	return status;
 }
 
@@ -243,25 +607,148 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
 
 uint32_t trusted_get_support(void)
 {
-	return 0;
+	return IS_ENABLED(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+		       ? PSA_STORAGE_SUPPORT_SET_EXTENDED
+		       : 0;
 }
 
-psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
 			    psa_storage_create_flags_t create_flags)
 {
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	size_t out_length;
+	stored_object_header header;
+	chunked_object object;
 
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (capacity > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	status = storage_get_object(uid, prefix, (void *)&header, sizeof(header), &out_length);
+	if (status == PSA_SUCCESS) {
+		return PSA_ERROR_ALREADY_EXISTS;
+	}
+
+	if (status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = chunked_set(uid, prefix, key_buf, &object, capacity, 0, NULL, create_flags);
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(&object, sizeof(object));
+
+	return status;
+#else
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(capacity);
 	ARG_UNUSED(create_flags);
 	return PSA_ERROR_NOT_SUPPORTED;
+#endif
 }
 
-psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
-				  size_t data_length, const void *p_data)
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				  size_t data_offset, size_t data_length, const void *p_data)
 {
+#ifdef CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t *data;
+	size_t out_length;
+	chunked_object object;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = storage_get_object(uid, prefix, object.raw, sizeof(object), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length < sizeof(stored_object_header)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if ((object.header.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key_cached(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if ((object.header.header.create_flags & STORED_FLAG_CHUNKED) == 0) {
+		/*
+		 * Objects in the previous format are converted, with their size as capacity.
+		 * The object is decrypted in place, and its data is moved to the end of the
+		 * buffer, from where it is encrypted into the chunked format.
+		 */
+		psa_storage_create_flags_t create_flags = object.legacy.header.create_flags;
+
+		status = legacy_decrypt(key_buf, &object.legacy, out_length, &out_length);
+
+		if (status == PSA_SUCCESS && data_offset + data_length > out_length) {
+			status = PSA_ERROR_INVALID_ARGUMENT;
+		}
+
+		if (status == PSA_SUCCESS && data_length > 0) {
+			data = object.raw + sizeof(object) - out_length;
+			memmove(data, object.legacy.data, out_length);
+			memcpy(data + data_offset, p_data, data_length);
+			status = chunked_set(uid, prefix, key_buf, &object, out_length, out_length,
+					     data, create_flags);
+		}
+
+		goto cleanup;
+	}
+
+	status = chunked_check(&object, out_length, CHUNKS_MAX);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	if (data_offset > object.header.header.data_size ||
+	    data_offset + data_length > object.header.capacity) {
+		status = PSA_ERROR_INVALID_ARGUMENT;
+		goto cleanup;
+	}
+
+	if (data_length > 0) {
+		status = chunked_set_extended(uid, prefix, key_buf, &object, data_offset,
+					      data_length, p_data);
+	}
+
+cleanup:
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(&object, sizeof(object));
+
+	return status;
+#else
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(data_offset);
 	ARG_UNUSED(data_length);
 	ARG_UNUSED(p_data);
 	return PSA_ERROR_NOT_SUPPORTED;
+#endif
 }
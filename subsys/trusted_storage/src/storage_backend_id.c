@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+#include <zephyr/fs/zms.h>
+#else
+#include <zephyr/fs/nvs.h>
+#endif
+
+#include "storage_backend.h"
+
+LOG_MODULE_REGISTER(internal_trusted_storage_id, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
+
+/*
+ * Storage of the objects in ZMS or NVS entries, addressed by ID
+ *
+ * The UID and the prefix are hashed to a slot with a CRC, which does not depend on the
+ * configuration, so that the objects are found again after an update. Each slot has two IDs, one
+ * for a tag that holds the UID and the prefix of the object stored in the slot, and one for the
+ * object. Slots are probed linearly from the hashed one until the tag matches, or until a slot
+ * that was never used is found. A removed object leaves a tag with the invalid UID behind, unless
+ * the next slot was never used, so that the objects stored after it can still be found.
+ */
+
+/* Kconfig only allows storage_partition when the settings do not store their file system there */
+#if FIXED_PARTITION_EXISTS(trusted_storage_partition)
+#define STORAGE_PARTITION trusted_storage_partition
+#else
+#define STORAGE_PARTITION storage_partition
+#endif
+
+#define STORAGE_PARTITION_DEVICE FIXED_PARTITION_DEVICE(STORAGE_PARTITION)
+#define STORAGE_PARTITION_OFFSET FIXED_PARTITION_OFFSET(STORAGE_PARTITION)
+#define STORAGE_PARTITION_SIZE	 FIXED_PARTITION_SIZE(STORAGE_PARTITION)
+
+/* Two IDs for each slot, the last ID is reserved by ZMS */
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+#define SLOT_COUNT 0x7fffffffU
+#else
+#define SLOT_COUNT 0x7fffU
+#endif
+
+#define TAG_ID(slot)  ((slot) * 2)
+#define DATA_ID(slot) ((slot) * 2 + 1)
+
+/* Marks the tag of a removed object, so it cannot be the UID of an object */
+#define INVALID_UID 0U
+
+#define PREFIX_MAX_LEN 16
+
+/* Only the characters of the prefix are stored */
+struct slot_tag {
+	psa_storage_uid_t uid;
+	char prefix[PREFIX_MAX_LEN];
+} __packed;
+
+#define TAG_SIZE(prefix_len) (offsetof(struct slot_tag, prefix) + (prefix_len))
+
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+static struct zms_fs fs;
+#else
+static struct nvs_fs fs;
+#endif
+
+static K_MUTEX_DEFINE(storage_mutex);
+static bool mounted;
+
+static int id_fs_mount(void)
+{
+	struct flash_pages_info info;
+	int ret;
+
+	fs.flash_device = STORAGE_PARTITION_DEVICE;
+	if (!device_is_ready(fs.flash_device)) {
+		return -ENODEV;
+	}
+
+	fs.offset = STORAGE_PARTITION_OFFSET;
+
+	ret = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (ret) {
+		return ret;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = STORAGE_PARTITION_SIZE / info.size;
+
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+	return zms_mount(&fs);
+#else
+	return nvs_mount(&fs);
+#endif
+}
+
+/* Returns the number of bytes read, which is at most len */
+static ssize_t id_fs_read(uint32_t id, void *data, size_t len)
+{
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+	ssize_t ret = zms_read(&fs, id, data, len);
+#else
+	/* NVS returns the length of the entry, even if it is longer than the buffer */
+	ssize_t ret = nvs_read(&fs, id, data, len);
+#endif
+
+	return ret < 0 ? ret : MIN(ret, len);
+}
+
+static int id_fs_write(uint32_t id, const void *data, size_t len)
+{
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+	ssize_t ret = zms_write(&fs, id, data, len);
+#else
+	ssize_t ret = nvs_write(&fs, id, data, len);
+#endif
+
+	/* 0 is returned when the entry already has the same content */
+	return ret < 0 ? ret : 0;
+}
+
+static int id_fs_delete(uint32_t id)
+{
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+	return zms_delete(&fs, id);
+#else
+	return nvs_delete(&fs, id);
+#endif
+}
+
+static psa_status_t error_to_psa_error(int errorno)
+{
+	switch (errorno) {
+	case 0:
+		return PSA_SUCCESS;
+	case -ENOSPC:
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	case -ENOENT:
+		return PSA_ERROR_DOES_NOT_EXIST;
+	case -EINVAL:
+		return PSA_ERROR_INVALID_ARGUMENT;
+	default:
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+}
+
+static uint32_t slot_hash(const struct slot_tag *tag, size_t tag_size)
+{
+	return crc32_ieee((const uint8_t *)tag, tag_size) % SLOT_COUNT;
+}
+
+/*
+ * Finds the slot of the object, or the slot to store it in. Returns 0 if the object is found,
+ * -ENOENT if not, in which case the slot is the first one that can be used for it.
+ */
+static int slot_find(const struct slot_tag *tag, size_t tag_size, uint32_t *slot)
+{
+	struct slot_tag stored;
+	bool free_found = false;
+	uint32_t current = slot_hash(tag, tag_size);
+	ssize_t ret;
+
+	for (uint32_t i = 0; i < SLOT_COUNT; i++) {
+		ret = id_fs_read(TAG_ID(current), &stored, sizeof(stored));
+
+		if (ret == -ENOENT) {
+			/* Never used, the object is not stored after it */
+			if (!free_found) {
+				*slot = current;
+			}
+
+			return -ENOENT;
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		if ((size_t)ret == tag_size && stored.uid == tag->uid &&
+		    memcmp(stored.prefix, tag->prefix, tag_size - TAG_SIZE(0)) == 0) {
+			*slot = current;
+			return 0;
+		}
+
+		/* Removed, can be used if the object is not found further on */
+		if (!free_found && ((size_t)ret < TAG_SIZE(0) || stored.uid == INVALID_UID)) {
+			free_found = true;
+			*slot = current;
+		}
+
+		current = (current + 1) % SLOT_COUNT;
+	}
+
+	return free_found ? -ENOENT : -ENOSPC;
+}
+
+/* Fills the tag of the object, locks the storage and mounts it on first use */
+static int storage_lock(const psa_storage_uid_t uid, const char *prefix, struct slot_tag *tag,
+			size_t *tag_size)
+{
+	size_t prefix_len = strlen(prefix);
+	int ret;
+
+	if (prefix_len > sizeof(tag->prefix)) {
+		return -EINVAL;
+	}
+
+	tag->uid = uid;
+	memcpy(tag->prefix, prefix, prefix_len);
+	*tag_size = TAG_SIZE(prefix_len);
+
+	k_mutex_lock(&storage_mutex, K_FOREVER);
+
+	if (!mounted) {
+		ret = id_fs_mount();
+		if (ret) {
+			LOG_ERR("Failed to mount the storage: %d", ret);
+			k_mutex_unlock(&storage_mutex);
+			return ret;
+		}
+
+		mounted = true;
+	}
+
+	return 0;
+}
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	struct slot_tag tag;
+	size_t tag_size;
+	uint32_t slot;
+	ssize_t ret;
+
+	if (uid == INVALID_UID || object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_lock(uid, prefix, &tag, &tag_size);
+	if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	ret = slot_find(&tag, tag_size, &slot);
+	if (ret == 0) {
+		ret = id_fs_read(DATA_ID(slot), object_data, object_size);
+	}
+
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Get object %s/%llx (max_size: %zd), ret: %d", prefix, (unsigned long long)uid,
+		object_size, (int)ret);
+
+	if (ret < 0) {
+		return error_to_psa_error(ret);
+	}
+
+	*object_length = ret;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	struct slot_tag tag;
+	size_t tag_size;
+	uint32_t slot;
+	int ret;
+
+	if (uid == INVALID_UID || object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_lock(uid, prefix, &tag, &tag_size);
+	if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	ret = slot_find(&tag, tag_size, &slot);
+	if (ret == 0 || ret == -ENOENT) {
+		/* The tag is written last, a slot with data but without a tag is not in use */
+		bool found = (ret == 0);
+
+		ret = id_fs_write(DATA_ID(slot), object_data, object_size);
+		if (ret == 0 && !found) {
+			ret = id_fs_write(TAG_ID(slot), &tag, tag_size);
+		}
+	}
+
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Set object %s/%llx. Size: %zd, ret: %d", prefix, (unsigned long long)uid,
+		object_size, ret);
+
+	return error_to_psa_error(ret);
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	struct slot_tag tag;
+	struct slot_tag next;
+	size_t tag_size;
+	uint32_t slot;
+	int ret;
+
+	if (uid == INVALID_UID || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	ret = storage_lock(uid, prefix, &tag, &tag_size);
+	if (ret) {
+		return error_to_psa_error(ret);
+	}
+
+	ret = slot_find(&tag, tag_size, &slot);
+	if (ret == 0) {
+		if (id_fs_read(TAG_ID((slot + 1) % SLOT_COUNT), &next, sizeof(next)) == -ENOENT) {
+			ret = id_fs_delete(TAG_ID(slot));
+		} else {
+			tag.uid = INVALID_UID;
+			ret = id_fs_write(TAG_ID(slot), &tag, tag_size);
+		}
+	}
+
+	if (ret == 0) {
+		ret = id_fs_delete(DATA_ID(slot));
+	}
+
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Remove object %s/%llx, ret %d", prefix, (unsigned long long)uid, ret);
+
+	return error_to_psa_error(ret);
+}
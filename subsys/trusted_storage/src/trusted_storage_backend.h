@@ -23,10 +23,10 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix);
 
 uint32_t trusted_get_support(void);
 
-psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
 			   psa_storage_create_flags_t create_flags);
 
-psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
-				 size_t data_length, const void *p_data);
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				 size_t data_offset, size_t data_length, const void *p_data);
 
 #endif /* __TRUSTED_STORAGE_BACKEND_H_*/
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <app_event_manager.h>
+
+#define ROUND_CNT		20
+#define STORM_EVENT_CNT		200
+#define HIGH_EVENT_INTERVAL	20
+#define HIGH_EVENT_CNT		(STORM_EVENT_CNT / HIGH_EVENT_INTERVAL)
+
+struct storm_event {
+	struct app_event_header header;
+
+	uint32_t timestamp;
+};
+
+APP_EVENT_TYPE_DECLARE(storm_event);
+APP_EVENT_TYPE_DEFINE(storm_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+struct urgent_event {
+	struct app_event_header header;
+
+	uint32_t timestamp;
+};
+
+APP_EVENT_TYPE_DECLARE(urgent_event);
+APP_EVENT_TYPE_DEFINE(urgent_event, NULL, NULL,
+		      APP_EVENT_FLAGS_CREATE(APP_EVENT_TYPE_FLAGS_HIGH_PRIORITY));
+
+struct latency_stats {
+	uint64_t sum;
+	uint32_t max;
+	uint32_t cnt;
+};
+
+static struct latency_stats storm_stats;
+static struct latency_stats urgent_stats;
+static atomic_t handled_cnt;
+static K_SEM_DEFINE(round_done_sem, 0, 1);
+
+
+static void latency_update(struct latency_stats *stats, uint32_t timestamp)
+{
+	uint32_t latency = k_cycle_get_32() - timestamp;
+
+	stats->sum += latency;
+	stats->max = MAX(stats->max, latency);
+	stats->cnt++;
+}
+
+static void latency_print(const char *name, const struct latency_stats *stats)
+{
+	uint32_t avg = stats->sum / stats->cnt;
+
+	TC_PRINT("%s: %u events, avg %u cycles (%u us), max %u cycles (%u us)\n",
+		 name, stats->cnt, avg, k_cyc_to_us_floor32(avg),
+		 stats->max, k_cyc_to_us_floor32(stats->max));
+}
+
+static void storm_submit(void)
+{
+	/* Queue the whole storm before the event processor gets a chance to run. */
+	k_sched_lock();
+
+	for (size_t i = 0; i < STORM_EVENT_CNT; i++) {
+		struct storm_event *se = new_storm_event();
+
+		se->timestamp = k_cycle_get_32();
+		APP_EVENT_SUBMIT(se);
+
+		if ((i % HIGH_EVENT_INTERVAL) == 0) {
+			struct urgent_event *ue = new_urgent_event();
+
+			ue->timestamp = k_cycle_get_32();
+			APP_EVENT_SUBMIT(ue);
+		}
+	}
+
+	k_sched_unlock();
+}
+
+static void *bench_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	return NULL;
+}
+
+ZTEST(app_event_manager_latency, test_event_storm)
+{
+	memset(&storm_stats, 0, sizeof(storm_stats));
+	memset(&urgent_stats, 0, sizeof(urgent_stats));
+
+	for (size_t i = 0; i < ROUND_CNT; i++) {
+		atomic_set(&handled_cnt, 0);
+		storm_submit();
+		zassert_ok(k_sem_take(&round_done_sem, K_SECONDS(10)), "Events not handled");
+	}
+
+	latency_print("normal priority", &storm_stats);
+	latency_print("high priority", &urgent_stats);
+
+	zassert_equal(storm_stats.cnt, ROUND_CNT * STORM_EVENT_CNT);
+	zassert_equal(urgent_stats.cnt, ROUND_CNT * HIGH_EVENT_CNT);
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PRIORITY_QUEUES)) {
+		zassert_true((urgent_stats.sum / urgent_stats.cnt) <
+			     (storm_stats.sum / storm_stats.cnt),
+			     "High priority events not prioritized");
+	}
+}
+
+ZTEST_SUITE(app_event_manager_latency, NULL, bench_setup, NULL, NULL, NULL);
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_storm_event(aeh)) {
+		latency_update(&storm_stats, cast_storm_event(aeh)->timestamp);
+	} else if (is_urgent_event(aeh)) {
+		latency_update(&urgent_stats, cast_urgent_event(aeh)->timestamp);
+	} else {
+		zassert_unreachable("Wrong event type received");
+	}
+
+	if (atomic_inc(&handled_cnt) + 1 == (STORM_EVENT_CNT + HIGH_EVENT_CNT)) {
+		k_sem_give(&round_done_sem);
+	}
+
+	return false;
+}
+
+APP_EVENT_LISTENER(bench, app_event_handler);
+APP_EVENT_SUBSCRIBE(bench, storm_event);
+APP_EVENT_SUBSCRIBE(bench, urgent_event);
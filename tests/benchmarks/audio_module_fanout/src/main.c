@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <data_fifo.h>
+
+#include "audio_module/audio_module.h"
+
+#define FAN_OUT_MAX		4
+#define BLOCK_CNT		1000
+#define BLOCK_SIZE		192
+/* The sinks report a block before its release callback has run, so leave some margin. A slab
+ * must not have more blocks than a module can have in flight.
+ */
+#define SLAB_MARGIN		2
+#define BLOCKS_IN_FLIGHT	MIN(4, CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT - SLAB_MARGIN)
+#define SLAB_BLOCK_CNT		(BLOCKS_IN_FLIGHT + SLAB_MARGIN)
+#define MSG_QUEUE_SIZE		(BLOCKS_IN_FLIGHT + 1)
+#define MSG_SIZE		(sizeof(struct audio_module_message))
+#define THREAD_STACK_SIZE	1024
+#define THREAD_PRIORITY		4
+#define ROUND_TIMEOUT		K_SECONDS(10)
+
+BUILD_ASSERT(FAN_OUT_MAX <= CONFIG_AUDIO_MODULE_FAN_OUT_MAX);
+BUILD_ASSERT(BLOCKS_IN_FLIGHT > 0);
+
+#define MSG_FIFO_DEFINE(i, prefix)	DATA_FIFO_DEFINE(prefix##i, MSG_QUEUE_SIZE, MSG_SIZE)
+#define MSG_FIFO_PTR(i, prefix)		&prefix##i
+#define DATA_SLAB_DEFINE(i, prefix)	\
+	K_MEM_SLAB_DEFINE_STATIC(prefix##i, BLOCK_SIZE, SLAB_BLOCK_CNT, 4)
+#define DATA_SLAB_PTR(i, prefix)	&prefix##i
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+/* All the modules run on the graph executor, so they have no thread of their own. */
+#define MODULE_STACK(stack)	NULL
+#define MODULE_STACK_SIZE	0
+
+K_THREAD_STACK_DEFINE(graph_stack, THREAD_STACK_SIZE);
+static struct audio_module_graph graph;
+#else
+#define MODULE_STACK(stack)	(stack)
+#define MODULE_STACK_SIZE	THREAD_STACK_SIZE
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
+K_THREAD_STACK_DEFINE(producer_stack, THREAD_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(pass_stack, FAN_OUT_MAX, THREAD_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(sink_stack, FAN_OUT_MAX, THREAD_STACK_SIZE);
+
+K_MEM_SLAB_DEFINE_STATIC(producer_slab, BLOCK_SIZE, SLAB_BLOCK_CNT, 4);
+LISTIFY(FAN_OUT_MAX, DATA_SLAB_DEFINE, (;), pass_slab);
+LISTIFY(FAN_OUT_MAX, MSG_FIFO_DEFINE, (;), pass_fifo_rx);
+LISTIFY(FAN_OUT_MAX, MSG_FIFO_DEFINE, (;), sink_fifo_rx);
+
+static struct k_mem_slab *pass_slabs[] = {LISTIFY(FAN_OUT_MAX, DATA_SLAB_PTR, (,), pass_slab)};
+static struct data_fifo *pass_fifos_rx[] = {LISTIFY(FAN_OUT_MAX, MSG_FIFO_PTR, (,), pass_fifo_rx)};
+static struct data_fifo *sink_fifos_rx[] = {LISTIFY(FAN_OUT_MAX, MSG_FIFO_PTR, (,), sink_fifo_rx)};
+
+static struct audio_module_handle producer;
+static struct audio_module_handle pass[FAN_OUT_MAX];
+static struct audio_module_handle sink[FAN_OUT_MAX];
+
+/* The modules have no state or configuration, so these are shared by all. */
+struct bench_context {
+	uint32_t unused;
+};
+
+struct bench_configuration {
+	uint32_t unused;
+};
+
+static struct bench_context bench_context;
+static const struct bench_configuration bench_configuration;
+
+static K_SEM_DEFINE(credit_sem, 0, BLOCKS_IN_FLIGHT);
+static K_SEM_DEFINE(sink_done_sem, 0, K_SEM_MAX_LIMIT);
+static uint32_t seq_num;
+
+static int bench_configuration_set(struct audio_module_handle_private *handle,
+				   struct audio_module_configuration const *const configuration)
+{
+	return 0;
+}
+
+static int bench_configuration_get(struct audio_module_handle_private const *const handle,
+				   struct audio_module_configuration *configuration)
+{
+	return 0;
+}
+
+static int producer_data_process(struct audio_module_handle_private *handle,
+				 struct audio_data const *const audio_data_rx,
+				 struct audio_data *audio_data_tx)
+{
+	/* Behave like a hardware source, a new block is only produced when there is room. */
+	k_sem_take(&credit_sem, K_FOREVER);
+
+	memset(audio_data_tx->data, (uint8_t)seq_num, audio_data_tx->data_size);
+	audio_data_tx->meta.ref_ts_us = seq_num++;
+
+	return 0;
+}
+
+static int pass_data_process(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data_rx,
+			     struct audio_data *audio_data_tx)
+{
+	memcpy(audio_data_tx->data, audio_data_rx->data, audio_data_rx->data_size);
+	audio_data_tx->data_size = audio_data_rx->data_size;
+	audio_data_tx->meta = audio_data_rx->meta;
+
+	return 0;
+}
+
+static int sink_data_process(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data_rx,
+			     struct audio_data *audio_data_tx)
+{
+	k_sem_give(&sink_done_sem);
+
+	return 0;
+}
+
+static const struct audio_module_functions producer_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = producer_data_process,
+};
+
+static const struct audio_module_functions pass_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = pass_data_process,
+};
+
+static const struct audio_module_functions sink_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = sink_data_process,
+};
+
+static struct audio_module_description producer_description = {
+	.name = "Producer",
+	.type = AUDIO_MODULE_TYPE_INPUT,
+	.functions = &producer_functions,
+};
+
+static struct audio_module_description pass_description = {
+	.name = "Pass-through",
+	.type = AUDIO_MODULE_TYPE_IN_OUT,
+	.functions = &pass_functions,
+};
+
+static struct audio_module_description sink_description = {
+	.name = "Sink",
+	.type = AUDIO_MODULE_TYPE_OUTPUT,
+	.functions = &sink_functions,
+};
+
+static void module_open_start(struct audio_module_description *description,
+			      k_thread_stack_t *stack, struct data_fifo *msg_rx,
+			      struct k_mem_slab *data_slab, const char *name,
+			      struct audio_module_handle *handle)
+{
+	int ret;
+	struct audio_module_parameters parameters = {
+		.description = description,
+		.thread = {
+			.stack = MODULE_STACK(stack),
+			.stack_size = MODULE_STACK_SIZE,
+			.priority = THREAD_PRIORITY,
+			.msg_rx = msg_rx,
+			.msg_tx = NULL,
+			.data_slab = data_slab,
+			.data_size = data_slab != NULL ? BLOCK_SIZE : 0,
+		},
+	};
+
+	ret = audio_module_open(&parameters,
+				(struct audio_module_configuration const *)&bench_configuration, name,
+				(struct audio_module_context *)&bench_context, handle);
+	zassert_equal(ret, 0, "Failed to open module %s: ret %d", name, ret);
+
+	ret = audio_module_start(handle);
+	zassert_equal(ret, 0, "Failed to start module %s: ret %d", name, ret);
+}
+
+static void fan_out_round(int fan_out)
+{
+	int ret;
+	uint32_t start;
+	uint32_t cycles;
+	uint32_t credits = BLOCKS_IN_FLIGHT;
+
+	k_sem_reset(&sink_done_sem);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < BLOCKS_IN_FLIGHT; i++) {
+		k_sem_give(&credit_sem);
+	}
+
+	/* A block is complete when all the sinks have got it, then the producer may send the
+	 * next one.
+	 */
+	for (int i = 0; i < BLOCK_CNT * fan_out; i++) {
+		ret = k_sem_take(&sink_done_sem, ROUND_TIMEOUT);
+		zassert_equal(ret, 0, "Timed out after %d of %d blocks", i / fan_out, BLOCK_CNT);
+
+		if (((i + 1) % fan_out) == 0 && credits < BLOCK_CNT) {
+			k_sem_give(&credit_sem);
+			credits++;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	if (cycles == 0) {
+		TC_PRINT("1->%d: %d blocks, no cycles elapsed on this platform\n", fan_out,
+			 BLOCK_CNT);
+		return;
+	}
+
+	TC_PRINT("1->%d: %d blocks in %u cycles, %u cycles/block, %llu blocks/s\n", fan_out,
+		 BLOCK_CNT, cycles, cycles / BLOCK_CNT,
+		 ((uint64_t)BLOCK_CNT * sys_clock_hw_cycles_per_sec()) / cycles);
+}
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+static void graph_latency_print(int fan_out)
+{
+	int ret;
+	struct audio_module_latency_hist hist;
+
+	ret = audio_module_graph_latency_get(&graph, NULL, &hist);
+	zassert_equal(ret, 0, "Failed to get the graph latency: ret %d", ret);
+
+	TC_PRINT("1->%d: graph avg %llu us, max %u us, histogram (2^n us):", fan_out,
+		 hist.count ? hist.total_us / hist.count : 0, hist.max_us);
+
+	for (int i = 0; i < ARRAY_SIZE(hist.bins); i++) {
+		TC_PRINT(" %u", hist.bins[i]);
+	}
+
+	TC_PRINT("\n");
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
+ZTEST(audio_module_fanout, test_fan_out_throughput)
+{
+	int ret;
+	int fan_out = 0;
+	char name[CONFIG_AUDIO_MODULE_NAME_SIZE];
+
+	for (int i = 0; i < FAN_OUT_MAX; i++) {
+		snprintf(name, sizeof(name), "Sink %d", i);
+		module_open_start(&sink_description, sink_stack[i], sink_fifos_rx[i], NULL, name,
+				  &sink[i]);
+
+		snprintf(name, sizeof(name), "Pass %d", i);
+		module_open_start(&pass_description, pass_stack[i], pass_fifos_rx[i],
+				  pass_slabs[i], name, &pass[i]);
+
+		ret = audio_module_connect(&pass[i], &sink[i], false);
+		zassert_equal(ret, 0, "Failed to connect %s: ret %d", name, ret);
+	}
+
+	module_open_start(&producer_description, producer_stack, NULL, &producer_slab,
+			  "Producer", &producer);
+
+	TC_PRINT("%d blocks of %d bytes, %d in flight\n", BLOCK_CNT, BLOCK_SIZE,
+		 BLOCKS_IN_FLIGHT);
+
+	/* The graph grows while running, which exercises connecting under load as well. */
+	for (int n = 1; n <= FAN_OUT_MAX; n *= 2) {
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+		/* The connections of a graph can only change while it is closed. */
+		if (fan_out > 0) {
+			ret = audio_module_graph_close(&graph);
+			zassert_equal(ret, 0, "Failed to close the graph: ret %d", ret);
+		}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+
+		while (fan_out < n) {
+			ret = audio_module_connect(&producer, &pass[fan_out], false);
+			zassert_equal(ret, 0, "Failed to connect pass-through %d: ret %d",
+				      fan_out, ret);
+			fan_out++;
+		}
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+		ret = audio_module_graph_open(&graph, &producer, graph_stack,
+					      K_THREAD_STACK_SIZEOF(graph_stack), THREAD_PRIORITY);
+		zassert_equal(ret, 0, "Failed to open the graph: ret %d", ret);
+
+		fan_out_round(fan_out);
+		graph_latency_print(fan_out);
+#else
+		fan_out_round(fan_out);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
+	}
+}
+
+ZTEST_SUITE(audio_module_fanout, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include <mesh/net.h>
+#include <mesh/rpl.h>
+
+#define CHECKS 4096
+
+/* Copy of the replay list lookup before it was indexed, for comparison */
+static struct bt_mesh_rpl linear_list[CONFIG_BT_MESH_CRPL];
+
+static bool linear_check(struct bt_mesh_net_rx *rx)
+{
+	for (int i = 0; i < ARRAY_SIZE(linear_list); i++) {
+		struct bt_mesh_rpl *rpl = &linear_list[i];
+
+		if (!rpl->src) {
+			rpl->src = rx->ctx.addr;
+			rpl->seq = rx->seq;
+			return false;
+		}
+
+		if (rpl->src == rx->ctx.addr) {
+			if (rpl->seq < rx->seq) {
+				rpl->seq = rx->seq;
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	return true;
+}
+
+static bool indexed_check(struct bt_mesh_net_rx *rx)
+{
+	return bt_mesh_rpl_check(rx, NULL, false);
+}
+
+/* Spread the unicast addresses, as in a provisioned network */
+static uint16_t node_addr(uint32_t node)
+{
+	return 1 + (node * 37) % 0x7ffe;
+}
+
+/* Fill the list with the nodes, then report the cycles per check of messages
+ * from random nodes, first new ones and then replayed ones.
+ */
+static void bench(const char *name, bool (*check)(struct bt_mesh_net_rx *rx), uint32_t nodes)
+{
+	struct bt_mesh_net_rx rx = {
+		.local_match = 1,
+		.net_if = BT_MESH_NET_IF_ADV,
+	};
+	uint32_t fresh = 0;
+	uint32_t replay = 0;
+	uint32_t start;
+
+	bt_mesh_rpl_clear();
+	memset(linear_list, 0, sizeof(linear_list));
+
+	for (uint32_t i = 0; i < nodes; i++) {
+		rx.ctx.addr = node_addr(i);
+		rx.seq = 1;
+		zassert_false(check(&rx), "message from new node %u rejected", i);
+	}
+
+	for (uint32_t i = 0; i < CHECKS; i++) {
+		rx.ctx.addr = node_addr(sys_rand32_get() % nodes);
+		rx.seq = 2 + i;
+
+		start = k_cycle_get_32();
+		zassert_false(check(&rx));
+		fresh += k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		zassert_true(check(&rx));
+		replay += k_cycle_get_32() - start;
+	}
+
+	TC_PRINT("%-8s %5u nodes: %6u cycles/check new, %6u cycles/check replayed\n", name,
+		 nodes, fresh / CHECKS, replay / CHECKS);
+}
+
+ZTEST(suite_bt_mesh_rpl, test_check)
+{
+	TC_PRINT("Replay list of %d entries, %d checks, %u cycles/s\n", CONFIG_BT_MESH_CRPL,
+		 CHECKS, sys_clock_hw_cycles_per_sec());
+
+	for (uint32_t nodes = 8; nodes < CONFIG_BT_MESH_CRPL; nodes *= 4) {
+		bench("linear", linear_check, nodes);
+		bench("indexed", indexed_check, nodes);
+	}
+
+	bench("linear", linear_check, CONFIG_BT_MESH_CRPL);
+	bench("indexed", indexed_check, CONFIG_BT_MESH_CRPL);
+}
+
+ZTEST_SUITE(suite_bt_mesh_rpl, NULL, NULL, NULL, NULL, NULL);
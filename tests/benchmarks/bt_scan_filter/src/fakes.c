@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Replacements for the parts of the Bluetooth host that the scan library uses.
+ * The registered callbacks are kept, so that the benchmark can feed reports
+ * and connection events to the library.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+
+#include "fakes.h"
+
+struct bt_le_scan_cb *fake_scan_cb;
+struct bt_conn_cb *fake_conn_cb;
+
+int bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	fake_scan_cb = cb;
+
+	return 0;
+}
+
+int bt_conn_cb_register(struct bt_conn_cb *cb)
+{
+	fake_conn_cb = cb;
+
+	return 0;
+}
+
+int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+/* The benchmark passes the peer address as the connection object. */
+const bt_addr_le_t *bt_conn_get_dst(const struct bt_conn *conn)
+{
+	return (const bt_addr_le_t *)conn;
+}
+
+void bt_data_parse(struct net_buf_simple *ad,
+		   bool (*func)(struct bt_data *data, void *user_data),
+		   void *user_data)
+{
+	while (ad->len > 1) {
+		struct bt_data data;
+		uint8_t len;
+
+		len = net_buf_simple_pull_u8(ad);
+		if ((len == 0) || (len > ad->len)) {
+			return;
+		}
+
+		data.type = net_buf_simple_pull_u8(ad);
+		data.data_len = len - 1;
+		data.data = ad->data;
+
+		if (!func(&data, user_data)) {
+			return;
+		}
+
+		net_buf_simple_pull(ad, len - 1);
+	}
+}
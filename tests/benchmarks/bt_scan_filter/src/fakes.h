@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FAKES_H_
+#define FAKES_H_
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+
+/* Callbacks registered by the scan library. */
+extern struct bt_le_scan_cb *fake_scan_cb;
+extern struct bt_conn_cb *fake_conn_cb;
+
+#endif /* FAKES_H_ */
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+
+#include "fakes.h"
+
+/* Reports come from more advertisers than the lists hold. */
+#define ADVERTISERS	(4 * LIST_SIZE)
+#define REPORTS		20000
+#define AD_SIZE		31
+
+/* The advertisers are split into address filter, blocklist, exceeded connection
+ * attempts and unknown devices.
+ */
+#define BLOCKED_FIRST	LIST_SIZE
+#define ATTEMPTS_FIRST	(2 * LIST_SIZE)
+
+static bt_addr_le_t advertisers[ADVERTISERS];
+static uint8_t ad_data[ADVERTISERS][AD_SIZE];
+static uint8_t ad_len[ADVERTISERS];
+static uint32_t matches;
+static uint32_t no_matches;
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	matches++;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_matches++;
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+/* Flags, a complete name, a list of 16-bit UUIDs and manufacturer data. */
+static void ad_build(uint32_t i)
+{
+	uint8_t *p = ad_data[i];
+	int len;
+
+	*p++ = 2;
+	*p++ = BT_DATA_FLAGS;
+	*p++ = BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR;
+
+	len = snprintf(p + 2, 9, "bench-%u", i % 8);
+	*p++ = len + 1;
+	*p++ = BT_DATA_NAME_COMPLETE;
+	p += len;
+
+	*p++ = 7;
+	*p++ = BT_DATA_UUID16_ALL;
+	sys_put_le16(BT_UUID_BAS_VAL, p);
+	sys_put_le16(BT_UUID_DIS_VAL, p + 2);
+	sys_put_le16((i % 3) ? BT_UUID_HTS_VAL : BT_UUID_HRS_VAL, p + 4);
+	p += 6;
+
+	*p++ = 5;
+	*p++ = BT_DATA_MANUFACTURER_DATA;
+	sys_put_le16((i % 5) ? 0xffff : 0x0059, p);
+	sys_put_le16(i, p + 2);
+	p += 4;
+
+	ad_len[i] = p - ad_data[i];
+}
+
+static void *suite_setup(void)
+{
+	static const struct bt_uuid_16 hrs = BT_UUID_INIT_16(BT_UUID_HRS_VAL);
+	static const uint8_t company[] = {0x59, 0x00};
+	const struct bt_scan_manufacturer_data manufacturer_data = {
+		.data = (uint8_t *)company,
+		.data_len = sizeof(company),
+	};
+	int err;
+
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb);
+
+	for (uint32_t i = 0; i < ADVERTISERS; i++) {
+		advertisers[i].type = BT_ADDR_LE_RANDOM;
+		sys_rand_get(advertisers[i].a.val, sizeof(advertisers[i].a.val));
+		BT_ADDR_SET_STATIC(&advertisers[i].a);
+		ad_build(i);
+	}
+
+	for (uint32_t i = 0; i < LIST_SIZE; i++) {
+		err = bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &advertisers[i]);
+		zassert_ok(err, "address filter add failed: %d", err);
+
+		err = bt_scan_blocklist_device_add(&advertisers[BLOCKED_FIRST + i]);
+		zassert_ok(err, "blocklist add failed: %d", err);
+
+		/* Two failed connections exceed the attempts count. */
+		fake_conn_cb->connected((struct bt_conn *)&advertisers[ATTEMPTS_FIRST + i],
+					BT_HCI_ERR_CONN_FAIL_TO_ESTAB);
+		fake_conn_cb->connected((struct bt_conn *)&advertisers[ATTEMPTS_FIRST + i],
+					BT_HCI_ERR_CONN_FAIL_TO_ESTAB);
+	}
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "bench-1"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "bench-5"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs.uuid));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA,
+				      &manufacturer_data));
+
+	return NULL;
+}
+
+/* Feed reports from random advertisers, every other one a scan response, and
+ * report the cycles spent in the library per report.
+ */
+static void bench(const char *name)
+{
+	uint32_t blocked = 0;
+	uint64_t cycles = 0;
+
+	matches = 0;
+	no_matches = 0;
+
+	for (uint32_t r = 0; r < REPORTS; r++) {
+		uint32_t i = sys_rand32_get() % ADVERTISERS;
+		struct bt_le_scan_recv_info info = {
+			.addr = &advertisers[i],
+			.adv_type = (r & 1) ? BT_GAP_ADV_TYPE_SCAN_RSP : BT_GAP_ADV_TYPE_ADV_IND,
+			.adv_props = (r & 1) ? (BT_GAP_ADV_PROP_SCANNABLE |
+						BT_GAP_ADV_PROP_SCAN_RESPONSE) :
+					       (BT_GAP_ADV_PROP_CONNECTABLE |
+						BT_GAP_ADV_PROP_SCANNABLE),
+		};
+		struct net_buf_simple ad;
+		uint32_t start;
+
+		net_buf_simple_init_with_data(&ad, ad_data[i], ad_len[i]);
+
+		if ((i >= BLOCKED_FIRST) && (i < ATTEMPTS_FIRST + LIST_SIZE)) {
+			blocked++;
+		}
+
+		start = k_cycle_get_32();
+		fake_scan_cb->recv(&info, &ad);
+		cycles += k_cycle_get_32() - start;
+	}
+
+	zassert_equal(matches + no_matches, REPORTS - blocked,
+		      "%u matches and %u no matches for %u reports, %u blocked",
+		      matches, no_matches, REPORTS, blocked);
+
+	TC_PRINT("%-24s lists of %3d: %6u cycles/report, %u matches\n", name, LIST_SIZE,
+		 (uint32_t)(cycles / REPORTS), matches);
+}
+
+ZTEST(suite_bt_scan_filter, test_address_filter)
+{
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+	bench("address");
+}
+
+ZTEST(suite_bt_scan_filter, test_ad_filters)
+{
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+	bench("name, UUID, manufacturer");
+}
+
+ZTEST(suite_bt_scan_filter, test_all_filters)
+{
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER | BT_SCAN_NAME_FILTER |
+					 BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+	bench("all");
+}
+
+ZTEST_SUITE(suite_bt_scan_filter, NULL, suite_setup, NULL, NULL, NULL);
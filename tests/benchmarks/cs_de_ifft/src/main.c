@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Replays a fixed set of Channel Sounding reports through cs_de_calc() and reports the error
+ * of the IFFT distance estimates and the cycles spent. Each test variant builds the library
+ * with one IFFT arithmetic, the float variant is the reference for the fixed-point ones.
+ */
+
+#include <math.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <bluetooth/cs_de.h>
+
+#define PI			3.14159265358979f
+#define SPEED_OF_LIGHT_M_PER_S	299792458.0f
+#define CHANNEL_SPACING_HZ	1e6f
+#define AMPLITUDE		100.0f
+#define REPORTS			100
+
+/* Error allowed above the float reference figures, and invalid estimates allowed above them */
+#if defined(CONFIG_BT_CS_DE_IFFT_Q31)
+#define ARITHMETIC "q31"
+#define IDEAL_TOLERANCE_M 0.01f
+#define MEAN_MARGIN_M	  0.01f
+#define MAX_MARGIN_M	  0.05f
+#define INVALID_MARGIN	  1
+#elif defined(CONFIG_BT_CS_DE_IFFT_Q15)
+#define ARITHMETIC "q15"
+#define IDEAL_TOLERANCE_M 0.05f
+#define MEAN_MARGIN_M	  0.03f
+#define MAX_MARGIN_M	  0.1f
+#define INVALID_MARGIN	  2
+#else
+#define ARITHMETIC "float"
+#define IDEAL_TOLERANCE_M 0.01f
+#define MEAN_MARGIN_M	  0.01f
+#define MAX_MARGIN_M	  0.05f
+#define INVALID_MARGIN	  1
+#endif
+
+/* Mean and max error of the float variant, rounded up, and its invalid estimates */
+#if CONFIG_BT_CS_DE_NFFT_SIZE == 2048
+#define MULTIPATH_REF_MEAN_M 0.12f
+#define MULTIPATH_REF_MAX_M  0.73f
+#else
+#define MULTIPATH_REF_MEAN_M 0.11f
+#define MULTIPATH_REF_MAX_M  0.52f
+#endif
+#define NOISY_REF_MEAN_M     0.08f
+#define NOISY_REF_MAX_M	     0.49f
+#define REF_INVALID	     1
+
+/* Channel between the devices: the direct path and one reflection */
+struct channel {
+	float distance;
+	float reflection_distance;
+	float reflection_amplitude;
+	float noise;
+};
+
+struct result {
+	float error_sum;
+	float error_max;
+	uint32_t invalid;
+	uint32_t cycles;
+};
+
+static cs_de_report_t report;
+static uint32_t rand_state;
+
+static float rand_uniform(void)
+{
+	/* xorshift32, so that every build replays the same reports */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return (rand_state >> 8) / 16777216.0f;
+}
+
+static float rand_gauss(void)
+{
+	float u = rand_uniform() + 1e-7f;
+	float v = rand_uniform();
+
+	return sqrtf(-2.0f * logf(u)) * cosf(2.0f * PI * v);
+}
+
+/* Fill in the IQ values that the two devices measure over the channel. Each device sees the
+ * channel response with its own random phase offset, which cancels out when combined.
+ */
+static void report_generate(const struct channel *ch)
+{
+	cs_de_iq_tones_t *iq = &report.iq_tones[0];
+
+	for (int i = 0; i < CS_DE_NUM_CHANNELS; i++) {
+		float f = 2.0f * PI * CHANNEL_SPACING_HZ * i / SPEED_OF_LIGHT_M_PER_S;
+		float re = cosf(-f * ch->distance) +
+			   ch->reflection_amplitude * cosf(-f * ch->reflection_distance);
+		float im = sinf(-f * ch->distance) +
+			   ch->reflection_amplitude * sinf(-f * ch->reflection_distance);
+		float phase = 2.0f * PI * rand_uniform();
+		float c = cosf(phase);
+		float s = sinf(phase);
+
+		iq->i_local[i] = AMPLITUDE * (re * c - im * s) + ch->noise * rand_gauss();
+		iq->q_local[i] = AMPLITUDE * (re * s + im * c) + ch->noise * rand_gauss();
+		iq->i_remote[i] = AMPLITUDE * (re * c + im * s) + ch->noise * rand_gauss();
+		iq->q_remote[i] = AMPLITUDE * (im * c - re * s) + ch->noise * rand_gauss();
+	}
+
+	report.n_ap = 1;
+	report.tone_quality[0] = CS_DE_TONE_QUALITY_OK;
+	report.rtt_accumulated_half_ns = 0;
+	report.rtt_count = 0;
+}
+
+static void estimate(const struct channel *ch, struct result *res)
+{
+	uint32_t start;
+	float error;
+
+	report_generate(ch);
+
+	start = k_cycle_get_32();
+	(void)cs_de_calc(&report);
+	res->cycles += k_cycle_get_32() - start;
+
+	if (isnan(report.distance_estimates[0].ifft)) {
+		res->invalid++;
+		return;
+	}
+
+	error = fabsf(report.distance_estimates[0].ifft - ch->distance);
+	res->error_sum += error;
+	res->error_max = MAX(res->error_max, error);
+}
+
+static float result_mean(const struct result *res)
+{
+	return res->error_sum / MAX(REPORTS - res->invalid, 1);
+}
+
+static void result_print(const char *name, const struct result *res)
+{
+	TC_PRINT("%-6s %-10s NFFT %4d: mean error %6.3f m, max error %6.3f m, %3u invalid, "
+		 "%8u cycles/report\n",
+		 ARITHMETIC, name, CONFIG_BT_CS_DE_NFFT_SIZE, (double)result_mean(res),
+		 (double)res->error_max, res->invalid, res->cycles / REPORTS);
+}
+
+/* Check the result against the float reference, with the margins of the arithmetic */
+static void result_check(const struct result *res, float ref_mean, float ref_max)
+{
+	zassert_true(res->invalid <= REF_INVALID + INVALID_MARGIN, "%u invalid estimates",
+		     res->invalid);
+	zassert_true(result_mean(res) <= ref_mean + MEAN_MARGIN_M, "mean error %f m, reference %f m",
+		     (double)result_mean(res), (double)ref_mean);
+	zassert_true(res->error_max <= ref_max + MAX_MARGIN_M, "max error %f m, reference %f m",
+		     (double)res->error_max, (double)ref_max);
+}
+
+ZTEST(suite_cs_de_ifft, test_ideal)
+{
+	struct result res = {0};
+
+	rand_state = 1;
+
+	for (int i = 0; i < REPORTS; i++) {
+		struct channel ch = {
+			.distance = 0.25f + 0.74f * i,
+		};
+
+		estimate(&ch, &res);
+	}
+
+	result_print("ideal", &res);
+
+	zassert_equal(res.invalid, 0, "%u invalid estimates", res.invalid);
+	zassert_true(res.error_max < IDEAL_TOLERANCE_M, "max error %f m",
+		     (double)res.error_max);
+}
+
+ZTEST(suite_cs_de_ifft, test_multipath)
+{
+	struct result res = {0};
+
+	rand_state = 2;
+
+	for (int i = 0; i < REPORTS; i++) {
+		struct channel ch = {
+			.distance = 40.0f * rand_uniform(),
+		};
+
+		ch.reflection_distance = ch.distance + 2.0f + 15.0f * rand_uniform();
+		ch.reflection_amplitude = 0.9f * rand_uniform();
+
+		estimate(&ch, &res);
+	}
+
+	result_print("multipath", &res);
+	result_check(&res, MULTIPATH_REF_MEAN_M, MULTIPATH_REF_MAX_M);
+}
+
+ZTEST(suite_cs_de_ifft, test_noisy)
+{
+	struct result res = {0};
+
+	rand_state = 3;
+
+	for (int i = 0; i < REPORTS; i++) {
+		struct channel ch = {
+			.distance = 40.0f * rand_uniform(),
+			.noise = 0.2f * AMPLITUDE * rand_uniform(),
+		};
+
+		ch.reflection_distance = ch.distance + 2.0f + 15.0f * rand_uniform();
+		ch.reflection_amplitude = 0.5f * rand_uniform();
+
+		estimate(&ch, &res);
+	}
+
+	result_print("noisy", &res);
+	result_check(&res, NOISY_REF_MEAN_M, NOISY_REF_MAX_M);
+}
+
+static void *suite_setup(void)
+{
+	TC_PRINT("%d reports per test, %u cycles/s\n", REPORTS, sys_clock_hw_cycles_per_sec());
+
+	return NULL;
+}
+
+ZTEST_SUITE(suite_cs_de_ifft, NULL, suite_setup, NULL, NULL, NULL);
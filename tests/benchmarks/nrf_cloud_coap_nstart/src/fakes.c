@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Replacements for the parts of the nRF Cloud library that the CoAP transport uses.
+ * The transport connects to the echo server on the loopback interface with plain UDP.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_coap.h>
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_dns.h"
+#include "nrf_cloud_mem.h"
+#include "nrfc_dtls.h"
+
+int nrf_cloud_connect_host(const char *host_name, uint16_t port, struct zsock_addrinfo *hints,
+			   nrf_cloud_connect_host_cb connect_cb)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+	};
+	int sock;
+
+	ARG_UNUSED(host_name);
+	ARG_UNUSED(hints);
+	ARG_UNUSED(connect_cb);
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr))) {
+		zsock_close(sock);
+		return -errno;
+	}
+
+	return sock;
+}
+
+int nrfc_dtls_setup(int sock)
+{
+	return 0;
+}
+
+bool nrfc_dtls_cid_is_active(int sock)
+{
+	return false;
+}
+
+int nrfc_dtls_session_save(int sock)
+{
+	return -ENOTSUP;
+}
+
+int nrfc_dtls_session_load(int sock)
+{
+	return -ENOTSUP;
+}
+
+bool nrfc_keepopen_is_supported(void)
+{
+	return false;
+}
+
+int nrf_cloud_jwt_generate(uint32_t time_valid_s, char * const jwt_buf, size_t jwt_buf_sz)
+{
+	strncpy(jwt_buf, "header.payload.signature", jwt_buf_sz - 1);
+	jwt_buf[jwt_buf_sz - 1] = '\0';
+
+	return 0;
+}
+
+int nrf_cloud_print_details(void)
+{
+	return 0;
+}
+
+void *nrf_cloud_malloc(size_t size)
+{
+	return k_malloc(size);
+}
+
+void nrf_cloud_free(void *memory)
+{
+	k_free(memory);
+}
+
+int nrf_cloud_codec_init(struct nrf_cloud_os_mem_hooks *hooks)
+{
+	return 0;
+}
+
+void nrf_cloud_device_control_get(struct nrf_cloud_ctrl_data *const ctrl)
+{
+	memset(ctrl, 0, sizeof(*ctrl));
+}
+
+int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *const data,
+					     bool accept, struct nrf_cloud_data *const output)
+{
+	/* The control section is not part of the benchmark */
+	return -ENOTSUP;
+}
+
+int nrf_cloud_enabled_info_sections_json_encode(cJSON *const obj, const char *const app_ver)
+{
+	return -ENODEV;
+}
+
+int nrf_cloud_modem_info_json_encode(const struct nrf_cloud_modem_info *const mod_inf,
+				     cJSON *const mod_inf_obj)
+{
+	return -ENOTSUP;
+}
+
+int nrf_cloud_obj_init(struct nrf_cloud_obj *const obj)
+{
+	return -ENOTSUP;
+}
+
+int nrf_cloud_obj_free(struct nrf_cloud_obj *const obj)
+{
+	return 0;
+}
+
+int nrf_cloud_obj_cloud_encode(struct nrf_cloud_obj *const obj)
+{
+	return -ENOTSUP;
+}
+
+int nrf_cloud_obj_cloud_encoded_free(struct nrf_cloud_obj *const obj)
+{
+	return 0;
+}
+
+int nrf_cloud_coap_shadow_state_update(const char * const shadow_json)
+{
+	return -ENOTSUP;
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_client.h>
+#include <net/nrf_cloud_coap.h>
+#include "nrf_cloud_coap_transport.h"
+
+#define THREADS		4
+#define POSTS		25
+#define GETS		5
+/* Delay of each response, standing in for the round trip time to the cloud */
+#define RTT_MS		20
+#define BLOB_SIZE	1024
+#define BLOCK_SZX	2
+#define BLOCK_SIZE	(1 << (BLOCK_SZX + 4))
+#define MSG_SIZE	256
+#define PENDING_MAX	8
+#define STACK_SIZE	2048
+
+/* Response waiting for its delay to pass */
+struct pending {
+	bool used;
+	int64_t due;
+	struct sockaddr_in addr;
+	uint16_t len;
+	uint8_t buf[MSG_SIZE];
+};
+
+struct blob_result {
+	size_t len;
+	int result_code;
+};
+
+static int server_sock = -1;
+static struct pending pending[PENDING_MAX];
+static uint8_t blob[BLOB_SIZE];
+static atomic_t failures;
+
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, THREADS, STACK_SIZE);
+static struct k_thread client_threads[THREADS];
+
+static bool uri_path_is(const struct coap_packet *req, const char *path)
+{
+	struct coap_option opt;
+
+	if (coap_find_options(req, COAP_OPTION_URI_PATH, &opt, 1) != 1) {
+		return false;
+	}
+
+	return opt.len == strlen(path) && !memcmp(opt.value, path, opt.len);
+}
+
+/* Piggyback the response on the ACK. The authorization is accepted, "blob" is served
+ * in blocks and anything else is echoed back.
+ */
+static int response_build(const struct coap_packet *req, uint8_t *buf)
+{
+	struct coap_packet rsp;
+	uint8_t token[COAP_TOKEN_MAX_LEN];
+	uint8_t tkl = coap_header_get_token(req, token);
+	const uint8_t *payload;
+	uint16_t payload_len;
+	uint8_t code = COAP_RESPONSE_CODE_CONTENT;
+	int err;
+
+	if (coap_header_get_type(req) != COAP_TYPE_CON) {
+		return -ENOTSUP;
+	}
+
+	if (uri_path_is(req, "auth")) {
+		code = COAP_RESPONSE_CODE_CREATED;
+	}
+
+	err = coap_packet_init(&rsp, buf, MSG_SIZE, COAP_VERSION_1, COAP_TYPE_ACK, tkl, token,
+			       code, coap_header_get_id(req));
+	if (err) {
+		return err;
+	}
+
+	if (uri_path_is(req, "blob")) {
+		int block2 = coap_get_option_int(req, COAP_OPTION_BLOCK2);
+		size_t num = block2 > 0 ? block2 >> 4 : 0;
+		size_t offset = num * BLOCK_SIZE;
+		bool more = offset + BLOCK_SIZE < BLOB_SIZE;
+
+		if (offset >= BLOB_SIZE) {
+			return -EINVAL;
+		}
+
+		err = coap_append_option_int(&rsp, COAP_OPTION_BLOCK2,
+					     (num << 4) | (more ? 0x8 : 0) | BLOCK_SZX);
+		payload = blob + offset;
+		payload_len = MIN(BLOCK_SIZE, BLOB_SIZE - offset);
+	} else if (code == COAP_RESPONSE_CODE_CONTENT) {
+		payload = coap_packet_get_payload(req, &payload_len);
+	} else {
+		payload_len = 0;
+	}
+
+	if (!err && payload_len) {
+		err = coap_packet_append_payload_marker(&rsp);
+		if (!err) {
+			err = coap_packet_append_payload(&rsp, payload, payload_len);
+		}
+	}
+
+	return err ? err : rsp.offset;
+}
+
+static void request_receive(int64_t now)
+{
+	static uint8_t rx[MSG_SIZE];
+	struct coap_option options[16];
+	struct coap_packet req;
+	struct pending *slot = NULL;
+	struct sockaddr_in addr;
+	socklen_t addr_len = sizeof(addr);
+	int len;
+
+	len = zsock_recvfrom(server_sock, rx, sizeof(rx), 0, (struct sockaddr *)&addr, &addr_len);
+	if (len <= 0 || coap_packet_parse(&req, rx, len, options, ARRAY_SIZE(options))) {
+		return;
+	}
+
+	for (int i = 0; i < PENDING_MAX; i++) {
+		if (!pending[i].used) {
+			slot = &pending[i];
+			break;
+		}
+	}
+
+	if (!slot) {
+		/* Dropped, the client retransmits */
+		return;
+	}
+
+	len = response_build(&req, slot->buf);
+	if (len < 0) {
+		return;
+	}
+
+	slot->len = len;
+	slot->addr = addr;
+	slot->due = now + RTT_MS;
+	slot->used = true;
+}
+
+static void server_fn(void *p1, void *p2, void *p3)
+{
+	struct zsock_pollfd fds = {
+		.fd = server_sock,
+		.events = ZSOCK_POLLIN,
+	};
+
+	for (;;) {
+		int64_t now = k_uptime_get();
+		int timeout = -1;
+
+		for (int i = 0; i < PENDING_MAX; i++) {
+			if (!pending[i].used) {
+				continue;
+			}
+
+			if (pending[i].due <= now) {
+				(void)zsock_sendto(server_sock, pending[i].buf, pending[i].len, 0,
+						   (struct sockaddr *)&pending[i].addr,
+						   sizeof(pending[i].addr));
+				pending[i].used = false;
+			} else if (timeout < 0 || pending[i].due - now < timeout) {
+				timeout = pending[i].due - now;
+			}
+		}
+
+		if (zsock_poll(&fds, 1, timeout) > 0) {
+			request_receive(k_uptime_get());
+		}
+	}
+}
+
+static void post_fn(void *p1, void *p2, void *p3)
+{
+	char payload[32];
+
+	for (int i = 0; i < POSTS; i++) {
+		int len = snprintk(payload, sizeof(payload), "{\"thread\":%d,\"seq\":%d}",
+				   (int)(uintptr_t)p1, i);
+
+		if (nrf_cloud_coap_post("echo", NULL, (uint8_t *)payload, len,
+					COAP_CONTENT_FORMAT_APP_JSON, true, NULL, NULL)) {
+			atomic_inc(&failures);
+		}
+	}
+}
+
+static void blob_cb(const struct coap_client_response_data *data, void *user_data)
+{
+	struct blob_result *result = user_data;
+
+	result->result_code = data->result_code;
+
+	if (data->result_code == COAP_RESPONSE_CODE_CONTENT && data->offset == result->len &&
+	    !memcmp(data->payload, blob + data->offset, data->payload_len)) {
+		result->len += data->payload_len;
+	}
+}
+
+static void get_fn(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < GETS; i++) {
+		struct blob_result result = {0};
+		int err = nrf_cloud_coap_get("blob", NULL, NULL, 0,
+					     COAP_CONTENT_FORMAT_APP_CBOR,
+					     COAP_CONTENT_FORMAT_APP_CBOR, true, blob_cb, &result);
+
+		if (err || result.len != BLOB_SIZE) {
+			atomic_inc(&failures);
+		}
+	}
+}
+
+/* Run the requests from all threads and report the messages exchanged per second */
+static void bench(const char *name, k_thread_entry_t fn, uint32_t msgs)
+{
+	int64_t start = k_uptime_get();
+	uint32_t elapsed;
+
+	atomic_set(&failures, 0);
+
+	for (int i = 0; i < THREADS; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]), fn,
+				(void *)(uintptr_t)i, NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < THREADS; i++) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	elapsed = MAX(k_uptime_get() - start, 1);
+
+	zassert_equal(atomic_get(&failures), 0, "%s: %d requests failed", name,
+		      (int)atomic_get(&failures));
+
+	TC_PRINT("%-20s NSTART %d: %4u messages in %5u ms, %5u messages/s\n", name,
+		 CONFIG_NRF_CLOUD_COAP_NSTART, msgs, elapsed, msgs * 1000 / elapsed);
+}
+
+static void *suite_setup(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_NRF_CLOUD_COAP_SERVER_PORT),
+	};
+	int err;
+
+	for (int i = 0; i < BLOB_SIZE; i++) {
+		blob[i] = i;
+	}
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	server_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "socket failed: %d", errno);
+
+	err = zsock_bind(server_sock, (struct sockaddr *)&addr, sizeof(addr));
+	zassert_ok(err, "bind failed: %d", errno);
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(4), 0, K_NO_WAIT);
+
+	zassert_ok(nrf_cloud_coap_init());
+	zassert_ok(nrf_cloud_coap_connect(NULL));
+
+	TC_PRINT("%d threads, %d ms round trip time, %d byte blocks\n", THREADS, RTT_MS,
+		 BLOCK_SIZE);
+
+	return NULL;
+}
+
+ZTEST(suite_nrf_cloud_coap_nstart, test_post)
+{
+	bench("POST", post_fn, THREADS * POSTS);
+}
+
+ZTEST(suite_nrf_cloud_coap_nstart, test_blockwise_get)
+{
+	bench("block-wise GET", get_fn, THREADS * GETS * (BLOB_SIZE / BLOCK_SIZE));
+}
+
+ZTEST_SUITE(suite_nrf_cloud_coap_nstart, NULL, suite_setup, NULL, NULL, NULL);
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <cJSON.h>
+#include <modem/lte_lc.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_os.h>
+#include <net/wifi_location_common.h>
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_json_writer.h"
+
+#define ITERATIONS	50
+#define NCELLS		17
+#define GCI_CELLS	15
+#define WIFI_APS	20
+#define OUT_SIZE	4096
+
+/* Allocations are prefixed with their size so that the heap usage can be tracked on free */
+#define HDR_SIZE	8
+
+static struct lte_lc_ncell ncells[NCELLS];
+static struct lte_lc_cell gci_cells[GCI_CELLS];
+static struct lte_lc_cells_info cells;
+static struct wifi_scan_result aps[WIFI_APS];
+static struct wifi_scan_info wifi = {.ap_info = aps, .cnt = WIFI_APS};
+
+static char out[OUT_SIZE];
+static size_t heap_used;
+static size_t heap_peak;
+
+static void *counting_malloc(size_t size)
+{
+	uint8_t *p = k_malloc(size + HDR_SIZE);
+
+	if (!p) {
+		return NULL;
+	}
+
+	*(size_t *)p = size;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+
+	return p + HDR_SIZE;
+}
+
+static void *counting_calloc(size_t count, size_t size)
+{
+	void *p = counting_malloc(count * size);
+
+	if (p) {
+		memset(p, 0, count * size);
+	}
+
+	return p;
+}
+
+static void counting_free(void *ptr)
+{
+	uint8_t *p = (uint8_t *)ptr - HDR_SIZE;
+
+	if (!ptr) {
+		return;
+	}
+
+	heap_used -= *(size_t *)p;
+	k_free(p);
+}
+
+static struct nrf_cloud_os_mem_hooks hooks = {
+	.malloc_fn = counting_malloc,
+	.calloc_fn = counting_calloc,
+	.free_fn = counting_free,
+};
+
+typedef int (*encode_fn)(void);
+
+/* Run encode ITERATIONS times and report the cycles per message and the peak heap usage */
+static void bench(const char *name, encode_fn encode)
+{
+	uint64_t cycles = 0;
+
+	heap_peak = heap_used;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		uint32_t start = k_cycle_get_32();
+		int ret = encode();
+
+		cycles += k_cycle_get_32() - start;
+		zassert_true(ret > 0, "%s failed: %d", name, ret);
+	}
+
+	zassert_equal(heap_used, 0, "%s leaked %zu bytes", name, heap_used);
+
+	TC_PRINT("%-32s %8u cycles/msg %6zu bytes heap peak %5zu bytes out\n", name,
+		 (uint32_t)(cycles / ITERATIONS), heap_peak, strlen(out));
+}
+
+static int cjson_print(cJSON *obj)
+{
+	char *str = cJSON_PrintUnformatted(obj);
+	int len;
+
+	cJSON_Delete(obj);
+
+	if (!str) {
+		return -ENOMEM;
+	}
+
+	len = strlen(str);
+	memcpy(out, str, MIN(len + 1, OUT_SIZE));
+	cJSON_free(str);
+
+	return len;
+}
+
+static int cell_cjson(void)
+{
+	cJSON *obj = cJSON_CreateObject();
+	int err = nrf_cloud_cell_pos_req_json_encode(&cells, obj);
+
+	if (err) {
+		cJSON_Delete(obj);
+		return err;
+	}
+
+	return cjson_print(obj);
+}
+
+static int wifi_cjson(void)
+{
+	cJSON *obj = cJSON_CreateObject();
+	int err = nrf_cloud_wifi_req_json_encode(&wifi, obj);
+
+	if (err) {
+		cJSON_Delete(obj);
+		return err;
+	}
+
+	return cjson_print(obj);
+}
+
+static int cell_writer(void)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, out, OUT_SIZE, NULL, NULL);
+	nrf_cloud_json_obj_start(&w, NULL);
+	(void)nrf_cloud_cell_pos_req_json_write(&w, &cells);
+	nrf_cloud_json_obj_end(&w);
+
+	return nrf_cloud_json_writer_finish(&w);
+}
+
+static int wifi_writer(void)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, out, OUT_SIZE, NULL, NULL);
+	nrf_cloud_json_obj_start(&w, NULL);
+	(void)nrf_cloud_wifi_req_json_write(&w, &wifi);
+	nrf_cloud_json_obj_end(&w);
+
+	return nrf_cloud_json_writer_finish(&w);
+}
+
+static void *suite_setup(void)
+{
+	cells.current_cell = (struct lte_lc_cell){
+		.mcc = 242, .mnc = 1, .id = 0x1234567, .tac = 0x3039, .earfcn = 6300,
+		.timing_advance = 80, .phys_cell_id = 7, .rsrp = 40, .rsrq = 12,
+	};
+
+	for (int i = 0; i < NCELLS; i++) {
+		ncells[i] = (struct lte_lc_ncell){
+			.earfcn = 6300 + i, .time_diff = i * 10, .phys_cell_id = i,
+			.rsrp = 20 + i, .rsrq = i - 5,
+		};
+	}
+
+	for (int i = 0; i < GCI_CELLS; i++) {
+		gci_cells[i] = (struct lte_lc_cell){
+			.mcc = 242, .mnc = 2, .id = 0x100000 + i, .tac = 0x1000 + i,
+			.earfcn = 1300 + i, .timing_advance = 100 + i, .rsrp = 30 + i, .rsrq = 10,
+		};
+	}
+
+	cells.ncells_count = NCELLS;
+	cells.neighbor_cells = ncells;
+	cells.gci_cells_count = GCI_CELLS;
+	cells.gci_cells = gci_cells;
+
+	for (int i = 0; i < WIFI_APS; i++) {
+		aps[i].ssid_length = snprintk((char *)aps[i].ssid, sizeof(aps[i].ssid), "ap_%d", i);
+		aps[i].channel = 1 + (i % 13);
+		aps[i].rssi = -40 - i;
+		aps[i].mac[0] = 0x10;
+		aps[i].mac[5] = i;
+		aps[i].mac_length = WIFI_MAC_ADDR_LEN;
+	}
+
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	TC_PRINT("%d neighbor cells, %d GCI cells, %d access points, %d iterations, %u cycles/s\n",
+		 NCELLS, GCI_CELLS, WIFI_APS, ITERATIONS, sys_clock_hw_cycles_per_sec());
+
+	return NULL;
+}
+
+static void compare(encode_fn cjson, encode_fn writer)
+{
+	static char expected[OUT_SIZE];
+
+	zassert_true(cjson() > 0);
+	strcpy(expected, out);
+	zassert_true(writer() > 0);
+	zassert_str_equal(out, expected, "Writer output differs from cJSON");
+}
+
+ZTEST(suite_nrf_cloud_codec, test_cell_pos_request)
+{
+	compare(cell_cjson, cell_writer);
+
+	bench("cell request cJSON", cell_cjson);
+	bench("cell request JSON writer", cell_writer);
+}
+
+ZTEST(suite_nrf_cloud_codec, test_wifi_request)
+{
+	compare(wifi_cjson, wifi_writer);
+
+	bench("Wi-Fi request cJSON", wifi_cjson);
+	bench("Wi-Fi request JSON writer", wifi_writer);
+}
+
+ZTEST_SUITE(suite_nrf_cloud_codec, NULL, suite_setup, NULL, NULL, NULL);
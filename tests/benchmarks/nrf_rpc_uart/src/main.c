@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <nrf_rpc/nrf_rpc_uart.h>
+
+#define UART0 DT_NODELABEL(rpc_uart0)
+#define UART1 DT_NODELABEL(rpc_uart1)
+
+/* The wire moves the bytes between the UARTs every tick, at 1 Mbaud */
+#define TICK_US		100
+#define BYTES_PER_TICK	10
+/* Time it takes for a byte to reach the other side */
+#define LATENCY_TICKS	5
+/* The emulated UARTs complete the transfers at once, the bytes wait here for the line */
+#define QUEUE_SIZE	16384
+#define PACKETS		200
+#define TIMEOUT_MS	30000
+
+#if defined(CONFIG_NRF_RPC_UART_ASYNC)
+#define MODE_STR "async, window " STRINGIFY(CONFIG_NRF_RPC_UART_WINDOW_SIZE)
+#else
+#define MODE_STR "stop-and-wait"
+#endif
+
+/* One direction of the connection */
+struct wire {
+	const struct device *from;
+	const struct device *to;
+	struct ring_buf queue;
+	uint8_t queue_buf[QUEUE_SIZE];
+	uint8_t line[LATENCY_TICKS][BYTES_PER_TICK];
+	uint8_t len[LATENCY_TICKS];
+	/* Every corrupt_interval-th byte has a bit flipped, 0 to keep them intact */
+	uint32_t corrupt_interval;
+	uint32_t bytes;
+};
+
+struct receiver {
+	uint32_t expected;
+	uint32_t size;
+	uint32_t errors;
+	struct k_sem done;
+};
+
+static struct wire wires[] = {
+	{ .from = DEVICE_DT_GET(UART0), .to = DEVICE_DT_GET(UART1) },
+	{ .from = DEVICE_DT_GET(UART1), .to = DEVICE_DT_GET(UART0) },
+};
+
+static const struct nrf_rpc_tr *const tr0 = &NRF_RPC_UART_TRANSPORT(UART0);
+static const struct nrf_rpc_tr *const tr1 = &NRF_RPC_UART_TRANSPORT(UART1);
+
+static struct receiver receiver;
+static struct k_timer wire_timer;
+
+static K_THREAD_STACK_DEFINE(wire_stack, 1024);
+static struct k_thread wire_thread;
+
+static void wire_tick(struct wire *wire, uint32_t tick)
+{
+	uint32_t slot = tick % LATENCY_TICKS;
+	uint8_t *data;
+	uint32_t len;
+
+	if (wire->len[slot] > 0) {
+		uart_emul_put_rx_data(wire->to, wire->line[slot], wire->len[slot]);
+	}
+
+	do {
+		len = ring_buf_put_claim(&wire->queue, &data, QUEUE_SIZE);
+		len = len ? uart_emul_get_tx_data(wire->from, data, len) : 0;
+		ring_buf_put_finish(&wire->queue, len);
+	} while (len > 0);
+
+	wire->len[slot] = ring_buf_get(&wire->queue, wire->line[slot], BYTES_PER_TICK);
+
+	for (uint8_t i = 0; i < wire->len[slot]; i++) {
+		if (wire->corrupt_interval && ++wire->bytes % wire->corrupt_interval == 0) {
+			wire->line[slot][i] ^= BIT(wire->bytes % 8);
+		}
+	}
+}
+
+static void wire_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t tick = 0;
+
+	k_timer_start(&wire_timer, K_USEC(TICK_US), K_USEC(TICK_US));
+
+	for (;;) {
+		k_timer_status_sync(&wire_timer);
+
+		for (size_t i = 0; i < ARRAY_SIZE(wires); i++) {
+			wire_tick(&wires[i], tick);
+		}
+
+		tick++;
+	}
+}
+
+static void packet_fill(uint8_t *data, size_t size, uint32_t index)
+{
+	sys_put_le32(index, data);
+
+	for (size_t i = sizeof(index); i < size; i++) {
+		data[i] = index + i;
+	}
+}
+
+/* Packets must arrive once each, in the order they were sent */
+static void receive_cb(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t len,
+		       void *context)
+{
+	struct receiver *rx = context;
+	bool valid;
+
+	if (rx == NULL) {
+		return;
+	}
+
+	valid = (len == rx->size && sys_get_le32(data) == rx->expected);
+
+	for (size_t i = sizeof(uint32_t); valid && i < len; i++) {
+		valid = (data[i] == (uint8_t)(rx->expected + i));
+	}
+
+	if (!valid) {
+		TC_PRINT("Packet %u: unexpected data\n", rx->expected);
+		rx->errors++;
+		return;
+	}
+
+	if (++rx->expected == PACKETS) {
+		k_sem_give(&rx->done);
+	}
+}
+
+static void bench(const char *name, uint32_t size, uint32_t corrupt_interval)
+{
+	uint32_t failures = 0;
+	uint32_t elapsed;
+	int64_t start;
+	int err;
+
+	receiver.expected = 0;
+	receiver.size = size;
+	receiver.errors = 0;
+	k_sem_reset(&receiver.done);
+
+	for (size_t i = 0; i < ARRAY_SIZE(wires); i++) {
+		wires[i].corrupt_interval = corrupt_interval;
+		wires[i].bytes = 0;
+	}
+
+	start = k_uptime_get();
+
+	for (uint32_t i = 0; i < PACKETS; i++) {
+		size_t buf_size = size;
+		uint8_t *buf = tr0->api->tx_buf_alloc(tr0, &buf_size);
+
+		packet_fill(buf, size, i);
+
+		if (tr0->api->send(tr0, buf, size)) {
+			failures++;
+		}
+	}
+
+	err = k_sem_take(&receiver.done, K_MSEC(TIMEOUT_MS));
+	elapsed = MAX(k_uptime_get() - start, 1);
+
+	zassert_ok(err, "%s: %u of %u packets received", name, receiver.expected, PACKETS);
+	zassert_equal(failures, 0, "%s: %u packets failed", name, failures);
+	zassert_equal(receiver.errors, 0, "%s: %u packets unexpected", name, receiver.errors);
+
+	TC_PRINT("%-16s %s: %3u x %4u B in %5u ms, %6u B/s, %3u%% of the line rate\n", name,
+		 MODE_STR, PACKETS, size, elapsed, PACKETS * size * 1000 / elapsed,
+		 PACKETS * size * 100 / (elapsed * BYTES_PER_TICK * (1000 / TICK_US)));
+}
+
+static void *suite_setup(void)
+{
+	k_sem_init(&receiver.done, 0, 1);
+	k_timer_init(&wire_timer, NULL, NULL);
+
+	for (size_t i = 0; i < ARRAY_SIZE(wires); i++) {
+		ring_buf_init(&wires[i].queue, QUEUE_SIZE, wires[i].queue_buf);
+	}
+
+	k_thread_create(&wire_thread, wire_stack, K_THREAD_STACK_SIZEOF(wire_stack), wire_fn,
+			NULL, NULL, NULL, K_PRIO_COOP(1), 0, K_NO_WAIT);
+
+	zassert_ok(tr0->api->init(tr0, receive_cb, NULL));
+	zassert_ok(tr1->api->init(tr1, receive_cb, &receiver));
+
+	TC_PRINT("1 Mbaud, %u us latency\n", LATENCY_TICKS * TICK_US);
+
+	return NULL;
+}
+
+ZTEST(suite_nrf_rpc_uart, test_small_packets)
+{
+	bench("32 B packets", 32, 0);
+}
+
+ZTEST(suite_nrf_rpc_uart, test_large_packets)
+{
+	bench("512 B packets", 512, 0);
+}
+
+ZTEST(suite_nrf_rpc_uart, test_lossy_line)
+{
+	/* About one in ten frames is damaged */
+	bench("lossy line", 512, 5000);
+}
+
+ZTEST_SUITE(suite_nrf_rpc_uart, NULL, suite_setup, NULL, NULL, NULL);
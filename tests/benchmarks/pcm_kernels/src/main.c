@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <pcm_mix.h>
+#include <pcm_stream_channel_modifier.h>
+
+/* One 10 ms frame at 48 kHz */
+#define FRAMES		480
+#define ITERATIONS	100
+#define CHANNELS_MAX	4
+#define CHANNEL_SIZE	(FRAMES * sizeof(int32_t))
+#define BUF_SIZE	(CHANNEL_SIZE * CHANNELS_MAX)
+
+static uint8_t __aligned(4) buf_a[BUF_SIZE];
+static uint8_t __aligned(4) buf_b[BUF_SIZE];
+static uint8_t __aligned(4) channel_buf[CHANNELS_MAX][CHANNEL_SIZE];
+
+static void const *channel_in[] = {channel_buf[0], channel_buf[1], channel_buf[2],
+				   channel_buf[3]};
+static void *channel_out[] = {channel_buf[0], channel_buf[1], channel_buf[2], channel_buf[3]};
+
+static void report(const char *name, uint64_t cycles, uint64_t samples)
+{
+	uint32_t centi = (uint32_t)((cycles * 100) / samples);
+
+	TC_PRINT("%-44s %5u.%02u cycles/sample\n", name, centi / 100, centi % 100);
+}
+
+/* Run call ITERATIONS times and report the cycles per sample processed by one call */
+#define BENCH(name, samples, call)                                                                 \
+	do {                                                                                       \
+		uint64_t cycles = 0;                                                               \
+                                                                                                   \
+		for (int i = 0; i < ITERATIONS; i++) {                                             \
+			uint32_t start = k_cycle_get_32();                                         \
+			int ret = call;                                                            \
+                                                                                                   \
+			cycles += k_cycle_get_32() - start;                                        \
+			zassert_equal(ret, 0, "%s failed: %d", name, ret);                         \
+		}                                                                                  \
+		report(name, cycles, (uint64_t)ITERATIONS * (samples));                            \
+	} while (0)
+
+static void *suite_setup(void)
+{
+	for (size_t i = 0; i < BUF_SIZE; i++) {
+		buf_a[i] = i * 7;
+		buf_b[i] = i * 13;
+	}
+
+	for (size_t i = 0; i < CHANNELS_MAX; i++) {
+		memset(channel_buf[i], i + 1, CHANNEL_SIZE);
+	}
+
+	TC_PRINT("Frame of %d samples per channel, %d iterations, %u cycles/s\n", FRAMES,
+		 ITERATIONS, sys_clock_hw_cycles_per_sec());
+
+	return NULL;
+}
+
+ZTEST(suite_pcm_kernels, test_mix)
+{
+	size_t size_16 = FRAMES * 2 * sizeof(int16_t);
+	size_t size_24 = FRAMES * 2 * 3;
+	size_t size_32 = FRAMES * 2 * sizeof(int32_t);
+
+	BENCH("pcm_mix 16-bit stereo", FRAMES * 2,
+	      pcm_mix(buf_a, size_16, buf_b, size_16, B_STEREO_INTO_A_STEREO));
+	BENCH("pcm_mix 16-bit mono into stereo LR", FRAMES * 2,
+	      pcm_mix(buf_a, size_16, buf_b, size_16 / 2, B_MONO_INTO_A_STEREO_LR));
+	BENCH("pcm_mix 16-bit mono into stereo L", FRAMES,
+	      pcm_mix(buf_a, size_16, buf_b, size_16 / 2, B_MONO_INTO_A_STEREO_L));
+	BENCH("pcm_mix_channels 24-bit stereo", FRAMES * 2,
+	      pcm_mix_channels(buf_a, size_24, 2, buf_b, size_24, 2, PCM_MIX_CHANNEL_ALL, 24));
+	BENCH("pcm_mix_channels 32-bit stereo", FRAMES * 2,
+	      pcm_mix_channels(buf_a, size_32, 2, buf_b, size_32, 2, PCM_MIX_CHANNEL_ALL, 32));
+	BENCH("pcm_mix_channels 16-bit mono into 4 channels", FRAMES * 4,
+	      pcm_mix_channels(buf_a, FRAMES * 4 * sizeof(int16_t), 4, buf_b,
+			       FRAMES * sizeof(int16_t), 1, PCM_MIX_CHANNEL_ALL, 16));
+}
+
+ZTEST(suite_pcm_kernels, test_interleave)
+{
+	size_t size_16 = FRAMES * sizeof(int16_t);
+
+	BENCH("pscm_interleave 16-bit stereo, per channel", FRAMES * 2,
+	      pscm_interleave(channel_in[0], size_16, 0, 16, buf_a, BUF_SIZE, 2) ||
+		      pscm_interleave(channel_in[1], size_16, 1, 16, buf_a, BUF_SIZE, 2));
+	BENCH("pscm_interleave_channels 16-bit stereo", FRAMES * 2,
+	      pscm_interleave_channels(channel_in, size_16, 16, buf_a, BUF_SIZE, 2));
+	BENCH("pscm_interleave_channels 24-bit stereo", FRAMES * 2,
+	      pscm_interleave_channels(channel_in, FRAMES * 3, 24, buf_a, BUF_SIZE, 2));
+	BENCH("pscm_interleave_channels 32-bit stereo", FRAMES * 2,
+	      pscm_interleave_channels(channel_in, CHANNEL_SIZE, 32, buf_a, BUF_SIZE, 2));
+	BENCH("pscm_interleave_channels 16-bit 4 channels", FRAMES * 4,
+	      pscm_interleave_channels(channel_in, size_16, 16, buf_a, BUF_SIZE, 4));
+}
+
+ZTEST(suite_pcm_kernels, test_deinterleave)
+{
+	size_t size_16 = FRAMES * 2 * sizeof(int16_t);
+
+	BENCH("pscm_deinterleave 16-bit stereo, per channel", FRAMES * 2,
+	      pscm_deinterleave(buf_a, size_16, 2, 0, 16, channel_out[0], CHANNEL_SIZE) ||
+		      pscm_deinterleave(buf_a, size_16, 2, 1, 16, channel_out[1], CHANNEL_SIZE));
+	BENCH("pscm_deinterleave_channels 16-bit stereo", FRAMES * 2,
+	      pscm_deinterleave_channels(buf_a, size_16, 2, 16, channel_out, CHANNEL_SIZE));
+	BENCH("pscm_deinterleave_channels 24-bit stereo", FRAMES * 2,
+	      pscm_deinterleave_channels(buf_a, FRAMES * 2 * 3, 2, 24, channel_out,
+					 CHANNEL_SIZE));
+	BENCH("pscm_deinterleave_channels 32-bit stereo", FRAMES * 2,
+	      pscm_deinterleave_channels(buf_a, FRAMES * 2 * sizeof(int32_t), 2, 32,
+					 channel_out, CHANNEL_SIZE));
+	BENCH("pscm_deinterleave_channels 16-bit 4 channels", FRAMES * 4,
+	      pscm_deinterleave_channels(buf_a, FRAMES * 4 * sizeof(int16_t), 4, 16,
+					 channel_out, CHANNEL_SIZE));
+}
+
+ZTEST_SUITE(suite_pcm_kernels, NULL, suite_setup, NULL, NULL, NULL);
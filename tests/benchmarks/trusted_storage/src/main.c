@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <psa/crypto.h>
+#include <psa/internal_trusted_storage.h>
+#include <psa/protected_storage.h>
+
+#define ROUNDS		  16
+#define DATA_SIZE_MAX	  1024
+/* Objects stored before the measurements, so that the lookups do not run in an empty store */
+#define OTHER_OBJECTS	  8
+#define OTHER_OBJECT_SIZE 32
+#define OTHER_OBJECT_UID  0x1000
+#define PARTIAL_READ_SIZE 16
+
+#if defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_ZMS)
+#define BACKEND_STR "ZMS"
+#elif defined(CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS)
+#define BACKEND_STR "NVS"
+#else
+#define BACKEND_STR "settings"
+#endif
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+#define FORMAT_STR "chunked"
+#else
+#define FORMAT_STR "whole"
+#endif
+
+typedef psa_status_t (*set_fn)(psa_storage_uid_t uid, size_t data_length, const void *p_data,
+			       psa_storage_create_flags_t create_flags);
+typedef psa_status_t (*get_fn)(psa_storage_uid_t uid, size_t data_offset, size_t data_size,
+			       void *p_data, size_t *p_data_length);
+
+static const size_t sizes[] = {16, 64, 256, 1024};
+
+static uint8_t data[DATA_SIZE_MAX];
+static uint8_t out[DATA_SIZE_MAX];
+
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+	return k_cyc_to_us_floor32(cycles / ROUNDS);
+}
+
+/* Reports the average time of a set, of a get of the whole object, and of a get of its end */
+static void bench(const char *name, set_fn set, get_fn get, psa_storage_uid_t uid, size_t size)
+{
+	uint32_t set_cycles = 0;
+	uint32_t get_cycles = 0;
+	uint32_t partial_cycles = 0;
+	size_t out_length;
+	uint32_t start;
+	psa_status_t status;
+
+	/* Exclude the creation of the object */
+	zassert_ok(set(uid, size, data, PSA_STORAGE_FLAG_NONE));
+
+	for (uint32_t i = 0; i < ROUNDS; i++) {
+		data[0] = i;
+
+		start = k_cycle_get_32();
+		status = set(uid, size, data, PSA_STORAGE_FLAG_NONE);
+		set_cycles += k_cycle_get_32() - start;
+		zassert_ok(status, "%s %zu B: set failed: %d", name, size, status);
+
+		start = k_cycle_get_32();
+		status = get(uid, 0, size, out, &out_length);
+		get_cycles += k_cycle_get_32() - start;
+		zassert_ok(status, "%s %zu B: get failed: %d", name, size, status);
+		zassert_equal(out_length, size);
+		zassert_mem_equal(out, data, size);
+
+		start = k_cycle_get_32();
+		status = get(uid, size - PARTIAL_READ_SIZE, PARTIAL_READ_SIZE, out, &out_length);
+		partial_cycles += k_cycle_get_32() - start;
+		zassert_ok(status, "%s %zu B: partial get failed: %d", name, size, status);
+		zassert_equal(out_length, PARTIAL_READ_SIZE);
+		zassert_mem_equal(out, data + size - PARTIAL_READ_SIZE, PARTIAL_READ_SIZE);
+	}
+
+	TC_PRINT("%-3s %s, %s: %4zu B: set %6u us, get %6u us, get last %u B %6u us\n", name,
+		 BACKEND_STR, FORMAT_STR, size, cycles_to_us(set_cycles), cycles_to_us(get_cycles),
+		 PARTIAL_READ_SIZE, cycles_to_us(partial_cycles));
+}
+
+static void *suite_setup(void)
+{
+	zassert_ok(psa_crypto_init());
+
+	if (IS_ENABLED(CONFIG_SETTINGS)) {
+		zassert_ok(settings_subsys_init());
+	}
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7;
+	}
+
+	for (uint32_t i = 0; i < OTHER_OBJECTS; i++) {
+		zassert_ok(psa_its_set(OTHER_OBJECT_UID + i, OTHER_OBJECT_SIZE, data,
+				       PSA_STORAGE_FLAG_NONE));
+		zassert_ok(psa_ps_set(OTHER_OBJECT_UID + i, OTHER_OBJECT_SIZE, data,
+				      PSA_STORAGE_FLAG_NONE));
+	}
+
+	return NULL;
+}
+
+ZTEST(suite_trusted_storage, test_its)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench("ITS", psa_its_set, psa_its_get, 1 + i, sizes[i]);
+	}
+}
+
+ZTEST(suite_trusted_storage, test_ps)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		bench("PS", psa_ps_set, psa_ps_get, 1 + i, sizes[i]);
+	}
+}
+
+ZTEST_SUITE(suite_trusted_storage, NULL, suite_setup, NULL, NULL, NULL);
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <nrf_modem_at.h>
+
+#include <modem/at_monitor.h>
+
+/* at_monitor_dispatch() is implemented in the AT monitor library and is called directly,
+ * in place of the modem library.
+ */
+extern void at_monitor_dispatch(const char *notif);
+
+enum monitor_id {
+	MON_CEREG,
+	MON_CEREG_BARE,
+	MON_CEREG_STAT,
+	MON_MDMEV,
+	MON_MDMEV_BATTERY,
+	MON_ANY,
+	MON_EMPTY,
+	MON_CMT_ISR,
+	MON_PAUSED,
+	MON_XMODEMSLEEP,
+	MON_COUNT,
+};
+
+static int calls[MON_COUNT];
+static const char *kept_notif;
+
+#define MONITOR_HANDLER(id)                                                                        \
+	static void handler_##id(const char *notif)                                                \
+	{                                                                                          \
+		ARG_UNUSED(notif);                                                                 \
+		calls[id]++;                                                                       \
+	}
+
+MONITOR_HANDLER(MON_CEREG)
+MONITOR_HANDLER(MON_CEREG_BARE)
+MONITOR_HANDLER(MON_CEREG_STAT)
+MONITOR_HANDLER(MON_MDMEV)
+MONITOR_HANDLER(MON_MDMEV_BATTERY)
+MONITOR_HANDLER(MON_ANY)
+MONITOR_HANDLER(MON_EMPTY)
+MONITOR_HANDLER(MON_CMT_ISR)
+MONITOR_HANDLER(MON_PAUSED)
+
+static void handler_MON_XMODEMSLEEP(const char *notif)
+{
+	calls[MON_XMODEMSLEEP]++;
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	/* Keep the notification after returning */
+	at_monitor_notif_ref(notif);
+	kept_notif = notif;
+#endif
+}
+
+AT_MONITOR(mon_cereg, "+CEREG", handler_MON_CEREG);
+AT_MONITOR(mon_cereg_bare, "CEREG", handler_MON_CEREG_BARE);
+AT_MONITOR(mon_cereg_stat, "EREG: 5", handler_MON_CEREG_STAT);
+AT_MONITOR(mon_mdmev, "%MDMEV", handler_MON_MDMEV);
+AT_MONITOR(mon_mdmev_battery, "%MDMEV: ME BATTERY LOW", handler_MON_MDMEV_BATTERY);
+AT_MONITOR(mon_any, ANY, handler_MON_ANY);
+AT_MONITOR(mon_empty, "", handler_MON_EMPTY);
+AT_MONITOR_ISR(mon_cmt_isr, "+CMT", handler_MON_CMT_ISR);
+AT_MONITOR(mon_paused, "+CEREG", handler_MON_PAUSED, PAUSED);
+AT_MONITOR(mon_xmodemsleep, "%XMODEMSLEEP", handler_MON_XMODEMSLEEP);
+
+int nrf_modem_at_notif_handler_set(nrf_modem_at_notif_handler_t callback)
+{
+	return 0;
+}
+
+static void dispatch(const char *notif)
+{
+	at_monitor_dispatch(notif);
+
+	/* Let the system workqueue dispatch the notification */
+	k_sleep(K_MSEC(10));
+}
+
+static void calls_check(const int *expected)
+{
+	for (int i = 0; i < MON_COUNT; i++) {
+		zassert_equal(calls[i], expected[i], "Monitor %d called %d times, expected %d", i,
+			      calls[i], expected[i]);
+	}
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(calls, 0, sizeof(calls));
+	at_monitor_pause(&mon_paused);
+}
+
+ZTEST(at_monitor, test_filter_prefix)
+{
+	const int expected[MON_COUNT] = {
+		[MON_CEREG] = 1, [MON_CEREG_BARE] = 1, [MON_CEREG_STAT] = 1,
+		[MON_ANY] = 1,	 [MON_EMPTY] = 1,
+	};
+
+	dispatch("+CEREG: 5,\"76C1\",\"0102DA04\",7\r\n");
+
+	calls_check(expected);
+}
+
+ZTEST(at_monitor, test_filter_anywhere)
+{
+	const int expected[MON_COUNT] = {
+		[MON_CEREG_BARE] = 1,
+		[MON_ANY] = 1,
+		[MON_EMPTY] = 1,
+	};
+
+	/* The filter is matched anywhere in the notification */
+	dispatch("+XCEREG: 1\r\n");
+
+	calls_check(expected);
+}
+
+ZTEST(at_monitor, test_filter_overlapping)
+{
+	const int expected[MON_COUNT] = {
+		[MON_MDMEV] = 2,
+		[MON_MDMEV_BATTERY] = 1,
+		[MON_ANY] = 2,
+		[MON_EMPTY] = 2,
+	};
+
+	dispatch("%MDMEV: ME BATTERY LOW\r\n");
+	dispatch("%MDMEV: ME BATTERY HIGH\r\n");
+
+	calls_check(expected);
+}
+
+ZTEST(at_monitor, test_no_match)
+{
+	const int expected[MON_COUNT] = {
+		[MON_ANY] = 1,
+		[MON_EMPTY] = 1,
+	};
+
+	dispatch("+CSCON: 1\r\n");
+
+	calls_check(expected);
+}
+
+ZTEST(at_monitor, test_direct)
+{
+	at_monitor_dispatch("+CMT: \"+4712345678\",22\r\n");
+
+	/* Direct monitors are called before the notification is queued */
+	zassert_equal(calls[MON_CMT_ISR], 1);
+	zassert_equal(calls[MON_ANY], 0);
+
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(calls[MON_CMT_ISR], 1);
+	zassert_equal(calls[MON_ANY], 1);
+}
+
+ZTEST(at_monitor, test_pause_resume)
+{
+	const int expected[MON_COUNT] = {
+		[MON_CEREG] = 2, [MON_CEREG_BARE] = 2, [MON_ANY] = 2,
+		[MON_EMPTY] = 2, [MON_PAUSED] = 1,
+	};
+
+	dispatch("+CEREG: 1\r\n");
+
+	at_monitor_resume(&mon_paused);
+	dispatch("+CEREG: 1\r\n");
+
+	calls_check(expected);
+}
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+ZTEST(at_monitor, test_notif_ref)
+{
+	const char *notif = "%XMODEMSLEEP: 1,36000\r\n";
+
+	dispatch(notif);
+
+	zassert_equal(calls[MON_XMODEMSLEEP], 1);
+	zassert_not_null(kept_notif);
+	zassert_not_equal(kept_notif, notif, "Notification not copied");
+	zassert_str_equal(kept_notif, notif);
+
+#if CONFIG_AT_MONITOR_STATS
+	struct at_monitor_stats stats;
+
+	zassert_ok(at_monitor_stats_get(&stats));
+	zassert_equal(stats.buffers_used, 1);
+#endif
+
+	at_monitor_notif_unref(kept_notif);
+	kept_notif = NULL;
+
+#if CONFIG_AT_MONITOR_STATS
+	zassert_ok(at_monitor_stats_get(&stats));
+	zassert_equal(stats.buffers_used, 0);
+#endif
+}
+#endif /* CONFIG_AT_MONITOR_NOTIF_SLAB */
+
+#if CONFIG_AT_MONITOR_STATS
+ZTEST(at_monitor, test_stats)
+{
+	struct at_monitor_stats stats;
+
+	zassert_equal(at_monitor_stats_get(NULL), -EFAULT);
+
+	/* Queue the notifications before the workqueue can dispatch them */
+	k_sched_lock();
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	at_monitor_dispatch("+CEREG: 2\r\n");
+	at_monitor_dispatch("+CEREG: 5\r\n");
+	k_sched_unlock();
+
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(calls[MON_CEREG], 3);
+	zassert_ok(at_monitor_stats_get(&stats));
+	zassert_equal(stats.dropped, 0);
+
+#if CONFIG_AT_MONITOR_NOTIF_SLAB
+	zassert_equal(stats.buffers_used, 0);
+	zassert_true(stats.buffers_max_used >= 3);
+#else
+	zassert_equal(stats.heap.allocated_bytes, 0);
+	zassert_true(stats.heap.max_allocated_bytes > 0);
+#endif
+}
+#endif /* CONFIG_AT_MONITOR_STATS */
+
+ZTEST_SUITE(at_monitor, NULL, NULL, test_before, NULL, NULL);
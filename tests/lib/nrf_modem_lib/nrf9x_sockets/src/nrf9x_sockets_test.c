@@ -12,6 +12,7 @@
 #include <zephyr/net/socket.h>
 #include <nrf_socket.h>
 #include <nrf_gai_errors.h>
+#include <modem/nrf_modem_lib.h>
 
 #include "cmock_nrf_socket.h"
 #include "cmock_nrf_modem_os.h"
@@ -1602,21 +1603,22 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	msg.msg_iov = chunks;
 	msg.msg_iovlen = 3;
 
-	/* First send doesn't send all data of the first chunk */
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_1, sizeof(int),
+	/* The first two chunks fill the intermediate buffer and are sent together,
+	 * first send doesn't send all data of the buffer
+	 */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 2 * sizeof(int),
 					   NRF_MSG_DONTWAIT,
-					   NULL, 0, sizeof(int) - 1);
-	/* Second send will send the remaining part of the first chunk */
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, ((uint8_t *)&chunk_1) + sizeof(int) - 1, 1,
+					   NULL, 0, 2 * sizeof(int) - 1);
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* Second send will send the remaining part of the buffer */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 1,
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, 1);
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_2, sizeof(int),
-					   NRF_MSG_DONTWAIT,
-					   NULL, 0, sizeof(int));
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* The last chunk is sent alone, without copying it */
 	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_3, sizeof(int),
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, sizeof(int));
-	__cmock_nrf_sendto_IgnoreArg_message();
 
 	ret = zsock_sendmsg(fd, &msg, flags);
 
@@ -1629,6 +1631,120 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	TEST_ASSERT_EQUAL(ret, 0);
 }
 
+void test_nrf9x_socket_offload_sendmsg_large_chunk_no_copy(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = NET_AF_INET;
+	int type = NET_SOCK_STREAM;
+	int proto = NET_IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct net_msghdr msg = { 0 };
+	struct net_iovec chunks[3] = { 0 };
+	struct nrf_modem_lib_sendmsg_stats stats_before;
+	struct nrf_modem_lib_sendmsg_stats stats;
+	uint8_t header[2] = { 1, 2 };
+	uint8_t payload[16] = { 3 };
+	uint8_t trailer[2] = { 4, 5 };
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_sendmsg_stats_get(&stats_before));
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	chunks[0].iov_base = header;
+	chunks[0].iov_len = sizeof(header);
+	chunks[1].iov_base = payload;
+	chunks[1].iov_len = sizeof(payload);
+	chunks[2].iov_base = trailer;
+	chunks[2].iov_len = sizeof(trailer);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 3;
+
+	/* The payload does not fit into the intermediate buffer, so each chunk
+	 * is sent directly from the caller's memory.
+	 */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, header, sizeof(header),
+					   NRF_MSG_DONTWAIT, NULL, 0, sizeof(header));
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, payload, sizeof(payload),
+					   NRF_MSG_DONTWAIT, NULL, 0, sizeof(payload));
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, trailer, sizeof(trailer),
+					   NRF_MSG_DONTWAIT, NULL, 0, sizeof(trailer));
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, sizeof(header) + sizeof(payload) + sizeof(trailer));
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_sendmsg_stats_get(&stats));
+	TEST_ASSERT_EQUAL(stats_before.bounce_copies, stats.bounce_copies);
+	TEST_ASSERT_EQUAL(stats_before.fragmented_sends + 1, stats.fragmented_sends);
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
+void test_nrf9x_socket_offload_sendmsg_error(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = NET_AF_INET;
+	int type = NET_SOCK_STREAM;
+	int proto = NET_IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct net_msghdr msg = { 0 };
+	struct net_iovec chunks[2] = { 0 };
+	struct nrf_modem_lib_sendmsg_stats stats_before;
+	struct nrf_modem_lib_sendmsg_stats stats;
+	int chunk_1 = 42;
+	int chunk_2 = 43;
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_sendmsg_stats_get(&stats_before));
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	chunks[0].iov_base = &chunk_1;
+	chunks[0].iov_len = sizeof(int);
+	chunks[1].iov_base = &chunk_2;
+	chunks[1].iov_len = sizeof(int);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 2;
+
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 2 * sizeof(int),
+					   NRF_MSG_DONTWAIT, NULL, 0, -1);
+	__cmock_nrf_sendto_IgnoreArg_message();
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, -1);
+
+	TEST_ASSERT_EQUAL(0, nrf_modem_lib_sendmsg_stats_get(&stats));
+	TEST_ASSERT_EQUAL(stats_before.bounce_copies + 1, stats.bounce_copies);
+	TEST_ASSERT_EQUAL(stats_before.fragmented_sends, stats.fragmented_sends);
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
+void test_nrf9x_socket_offload_sendmsg_stats_efault(void)
+{
+	TEST_ASSERT_EQUAL(-EFAULT, nrf_modem_lib_sendmsg_stats_get(NULL));
+}
+
 void test_nrf9x_socket_offload_fcntl_einval(void)
 {
 	int ret;
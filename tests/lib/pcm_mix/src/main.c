@@ -127,4 +127,118 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_mix_odd_number_of_samples)
+{
+	int ret;
+	int16_t sample_a[] = { 1, 2, 3, 4, INT16_MAX };
+	int16_t sample_b[] = { 1, 1, 1, 1, 1 };
+	int16_t sample_r[] = { 2, 3, 4, 5, INT16_MAX };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b), B_MONO_INTO_A_MONO);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_mono_into_stereo_l_too_large)
+{
+	int ret;
+	int16_t sample_a[] = { 10, 10, 10, 10 };
+	int16_t sample_b[] = { -5, 5, 5 };
+	int16_t sample_r[] = { 10, 10, 10, 10 };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_L);
+	ZEQ(ret, -EPERM);
+
+	/* Buffer A must not be touched when B does not fit */
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_channels_16_mono_into_channel)
+{
+	int ret;
+	int16_t sample_a[] = { 10, 10, 10, 10, 10, 10 };
+	int16_t sample_b[] = { -5, 5 };
+	int16_t sample_r[] = { 10, 10, 5, 10, 10, 15 };
+
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 3, sample_b, sizeof(sample_b), 1, 2,
+			       16);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_channels_16_mono_into_all)
+{
+	int ret;
+	int16_t sample_a[] = { 10, 10, 10, INT16_MIN, 10, INT16_MAX };
+	int16_t sample_b[] = { -5, 5 };
+	int16_t sample_r[] = { 5, 5, 5, INT16_MIN + 5, 15, INT16_MAX };
+
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 3, sample_b, sizeof(sample_b), 1,
+			       PCM_MIX_CHANNEL_ALL, 16);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_channels_24_high_values)
+{
+	int ret;
+	/* 0x7FFFFF + 1, -0x800000 - 1, 0x000100 + 0xFFFFFF (-1) */
+	uint8_t sample_a[] = { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80, 0x00, 0x01, 0x00 };
+	uint8_t sample_b[] = { 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+	uint8_t sample_r[] = { 0xFF, 0xFF, 0x7F, 0x00, 0x00, 0x80, 0xFF, 0x00, 0x00 };
+
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 1, sample_b, sizeof(sample_b), 1,
+			       PCM_MIX_CHANNEL_ALL, 24);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r), "fail");
+}
+
+ZTEST(suite_pcm_mix, test_channels_32_stereo_high_values)
+{
+	int ret;
+	int32_t sample_a[] = { INT32_MAX, INT32_MIN, 100000, -100000 };
+	int32_t sample_b[] = { 1, -1, 100000, 100000 };
+	int32_t sample_r[] = { INT32_MAX, INT32_MIN, 200000, 0 };
+
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 2, sample_b, sizeof(sample_b), 2,
+			       PCM_MIX_CHANNEL_ALL, 32);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r), "fail");
+}
+
+ZTEST(suite_pcm_mix, test_channels_illegal_arguments)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1, 2, 3 };
+	int16_t sample_b[] = { 0, 1, 2 };
+
+	/* Bit depth not supported */
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 2, sample_b, sizeof(int16_t), 1, 0, 8);
+	ZEQ(ret, -EINVAL);
+
+	/* B has a different number of channels than A and is not mono */
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 4, sample_b, sizeof(sample_a), 2, 0,
+			       16);
+	ZEQ(ret, -EINVAL);
+
+	/* Channel outside A */
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 2, sample_b, sizeof(int16_t), 1, 2, 16);
+	ZEQ(ret, -EINVAL);
+
+	/* Size of A not a multiple of the frame size */
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 3, sample_b, sizeof(int16_t), 1, 0, 16);
+	ZEQ(ret, -EINVAL);
+
+	/* B holds more frames than A */
+	ret = pcm_mix_channels(sample_a, sizeof(sample_a), 2, sample_b, sizeof(sample_b), 1, 0,
+			       16);
+	ZEQ(ret, -EPERM);
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
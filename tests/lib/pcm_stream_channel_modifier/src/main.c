@@ -413,6 +413,131 @@ ZTEST(suite_pscm_deint, test_pscm_deinterleave_multi)
 	zassert_equal(ret, 0, "Failed de-interleave 8-bit carrier surround right: ret %d", ret);
 }
 
+ZTEST(suite_pscm_int, test_pscm_interleave_channels)
+{
+	int ret;
+	uint8_t __aligned(4) output[TEST_PCM_INT_MULTI_SIZE];
+	void const *inputs_stereo[] = {unpadded_left, unpadded_right};
+	void const *inputs_multi[] = {unpadded_left, unpadded_centre, unpadded_right};
+
+	/* 16-bit stereo is interleaved two frames at a time */
+	memset(output, 0, sizeof(output));
+	ret = pscm_interleave_channels(inputs_stereo, sizeof(unpadded_left), TEST_SAMPLE_BITS_16,
+				       output, sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, 0, "Failed interleave: ret %d", ret);
+	zassert_mem_equal(output, combine_16, sizeof(combine_16),
+			  "Failed to interleave 16-bit stereo, output != combine_16");
+
+	/* Odd number of frames, the last frame is interleaved one channel at a time */
+	memset(output, 0, sizeof(output));
+	ret = pscm_interleave_channels(inputs_stereo, 10, TEST_SAMPLE_BITS_16, output,
+				       sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, 0, "Failed interleave: ret %d", ret);
+	zassert_mem_equal(output, combine_16, 20,
+			  "Failed to interleave 16-bit stereo, output != combine_16");
+
+	memset(output, 0, sizeof(output));
+	ret = pscm_interleave_channels(inputs_stereo, sizeof(unpadded_left), TEST_SAMPLE_BITS_24,
+				       output, sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, 0, "Failed interleave: ret %d", ret);
+	zassert_mem_equal(output, combine_24, sizeof(combine_24),
+			  "Failed to interleave 24-bit stereo, output != combine_24");
+
+	memset(output, 0, sizeof(output));
+	ret = pscm_interleave_channels(inputs_stereo, sizeof(unpadded_left), TEST_SAMPLE_BITS_32,
+				       output, sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, 0, "Failed interleave: ret %d", ret);
+	zassert_mem_equal(output, combine_32, sizeof(combine_32),
+			  "Failed to interleave 32-bit stereo, output != combine_32");
+
+	/* Three channels of 8-bit, so output byte i comes from input i % 3 */
+	memset(output, 0, sizeof(output));
+	ret = pscm_interleave_channels(inputs_multi, sizeof(unpadded_left), TEST_SAMPLE_BITS_8,
+				       output, sizeof(output), TEST_CHANNELS_3);
+	zassert_equal(ret, 0, "Failed interleave: ret %d", ret);
+	for (int i = 0; i < sizeof(unpadded_left) * TEST_CHANNELS_3; i++) {
+		zassert_equal(output[i], ((uint8_t *)inputs_multi[i % 3])[i / 3],
+			      "Failed to interleave 8-bit, byte %d", i);
+	}
+
+	ret = pscm_interleave_channels(NULL, sizeof(unpadded_left), TEST_SAMPLE_BITS_16, output,
+				       sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, -EINVAL, "Failed interleave for inputs NULL: ret %d", ret);
+
+	ret = pscm_interleave_channels(inputs_stereo, sizeof(unpadded_left), TEST_SAMPLE_BITS_16,
+				       output, sizeof(unpadded_left), TEST_CHANNELS_2);
+	zassert_equal(ret, -EINVAL, "Failed interleave for output size too small: ret %d", ret);
+
+	ret = pscm_interleave_channels(inputs_stereo, 5, TEST_SAMPLE_BITS_16, output,
+				       sizeof(output), TEST_CHANNELS_2);
+	zassert_equal(ret, -EINVAL, "Failed interleave for partial sample: ret %d", ret);
+}
+
+ZTEST(suite_pscm_deint, test_pscm_deinterleave_channels)
+{
+	int ret;
+	uint8_t __aligned(4) output_left[TEST_PCM_DEINT_SIZE];
+	uint8_t __aligned(4) output_right[TEST_PCM_DEINT_SIZE];
+	uint8_t __aligned(4) output_multi[TEST_CHANNELS_5][TEST_PCM_DEINT_SIZE];
+	void *outputs_stereo[] = {output_left, output_right};
+	void *outputs_multi[] = {output_multi[0], output_multi[1], output_multi[2],
+				 output_multi[3], output_multi[4]};
+
+	ret = pscm_deinterleave_channels(combine_16, sizeof(combine_16), TEST_CHANNELS_2,
+					 TEST_SAMPLE_BITS_16, outputs_stereo,
+					 TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, 0, "Failed de-interleave: ret %d", ret);
+	zassert_mem_equal(output_left, unpadded_left, sizeof(unpadded_left),
+			  "Failed to de-interleave 16-bit left");
+	zassert_mem_equal(output_right, unpadded_right, sizeof(unpadded_right),
+			  "Failed to de-interleave 16-bit right");
+
+	/* Odd number of frames, the last frame is de-interleaved one channel at a time */
+	memset(output_left, 0, sizeof(output_left));
+	memset(output_right, 0, sizeof(output_right));
+	ret = pscm_deinterleave_channels(combine_16, 20, TEST_CHANNELS_2, TEST_SAMPLE_BITS_16,
+					 outputs_stereo, TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, 0, "Failed de-interleave: ret %d", ret);
+	zassert_mem_equal(output_left, unpadded_left, 10, "Failed to de-interleave 16-bit left");
+	zassert_mem_equal(output_right, unpadded_right, 10,
+			  "Failed to de-interleave 16-bit right");
+
+	ret = pscm_deinterleave_channels(combine_24, sizeof(combine_24), TEST_CHANNELS_2,
+					 TEST_SAMPLE_BITS_24, outputs_stereo,
+					 TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, 0, "Failed de-interleave: ret %d", ret);
+	zassert_mem_equal(output_left, unpadded_left, sizeof(unpadded_left),
+			  "Failed to de-interleave 24-bit left");
+	zassert_mem_equal(output_right, unpadded_right, sizeof(unpadded_right),
+			  "Failed to de-interleave 24-bit right");
+
+	ret = pscm_deinterleave_channels(multi_split, sizeof(multi_split), TEST_CHANNELS_5,
+					 TEST_SAMPLE_BITS_8, outputs_multi, TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, 0, "Failed de-interleave: ret %d", ret);
+	zassert_mem_equal(output_multi[TEST_AUDIO_CH_L], unpadded_left, sizeof(unpadded_left),
+			  "Failed to de-interleave 8-bit left");
+	zassert_mem_equal(output_multi[TEST_AUDIO_CH_C], unpadded_centre, sizeof(unpadded_centre),
+			  "Failed to de-interleave 8-bit centre");
+	zassert_mem_equal(output_multi[TEST_AUDIO_CH_SR], unpadded_surround_right,
+			  sizeof(unpadded_surround_right),
+			  "Failed to de-interleave 8-bit surround right");
+
+	ret = pscm_deinterleave_channels(combine_16, sizeof(combine_16), TEST_CHANNELS_2,
+					 TEST_SAMPLE_BITS_16, NULL, TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, -EINVAL, "Failed de-interleave for outputs NULL: ret %d", ret);
+
+	ret = pscm_deinterleave_channels(combine_16, sizeof(combine_16), TEST_CHANNELS_2,
+					 TEST_SAMPLE_BITS_16, outputs_stereo,
+					 TEST_PCM_DEINT_SIZE - 1);
+	zassert_equal(ret, -EINVAL, "Failed de-interleave for output size too small: ret %d",
+		      ret);
+
+	ret = pscm_deinterleave_channels(combine_16, sizeof(combine_16) - 2, TEST_CHANNELS_2,
+					 TEST_SAMPLE_BITS_16, outputs_stereo,
+					 TEST_PCM_DEINT_SIZE);
+	zassert_equal(ret, -EINVAL, "Failed de-interleave for partial frame: ret %d", ret);
+}
+
 ZTEST(suite_pscm, test_pscm_zero_pad_16)
 {
 	uint16_t left_test_list[50];
@@ -6,6 +6,7 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/tc_util.h>
+#include <zephyr/sys/crc.h>
 #include <sample_rate_converter.h>
 #include <stdlib.h>
 
@@ -1152,4 +1153,187 @@ ZTEST(suite_sample_rate_converter, test_invalid_process_output_buf_too_small)
 		      "Sample rate conversion process did not fail when output buffer is to small");
 }
 
+#if CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+#define POLYPHASE_DC_VALUE 1000
+
+/* Output samples before the filter window is filled with input samples */
+#define POLYPHASE_SETTLE_SAMPLES SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+
+static void polyphase_dc_test(uint32_t input_sample_rate, uint32_t output_sample_rate,
+			      int32_t drift_ppm, size_t num_blocks, size_t expected_total_samples)
+{
+	int ret;
+	size_t num_samples = input_sample_rate / 100;
+	size_t max_output_samples = output_sample_rate / 100 + 1;
+	int16_t input_samples[num_samples];
+	int16_t output_samples[max_output_samples];
+	size_t output_written;
+	size_t total_samples = 0;
+
+	for (int i = 0; i < num_samples; i++) {
+		input_samples[i] = POLYPHASE_DC_VALUE;
+	}
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, drift_ppm);
+	zassert_equal(ret, 0, "Setting drift failed");
+
+	for (int block = 0; block < num_blocks; block++) {
+		ret = sample_rate_converter_process(
+			&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+			num_samples * sizeof(int16_t), input_sample_rate, output_samples,
+			max_output_samples * sizeof(int16_t), &output_written, output_sample_rate);
+
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+		zassert_equal(output_written % sizeof(int16_t), 0,
+			      "Output size was not a sample multiple (%d)", output_written);
+
+		/* A constant input must pass through unchanged once the filter has settled */
+		for (int i = 0; i < output_written / sizeof(int16_t); i++) {
+			if (total_samples + i >= POLYPHASE_SETTLE_SAMPLES) {
+				zassert_equal(output_samples[i], POLYPHASE_DC_VALUE,
+					      "Output sample %d was %d", total_samples + i,
+					      output_samples[i]);
+			}
+		}
+
+		total_samples += output_written / sizeof(int16_t);
+	}
+
+	zassert_equal(conv_ctx.conversion_ratio, 0, "Conversion ratio not as expected");
+	zassert_equal(conv_ctx.filter_type, SAMPLE_RATE_FILTER_POLYPHASE,
+		      "Filter not as expected");
+	zassert_equal(total_samples, expected_total_samples,
+		      "Number of output samples was not as expected (%d)", total_samples);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_dc_44100_to_48000)
+{
+	polyphase_dc_test(44100, 48000, 0, 20, 9591);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_dc_48000_to_44100)
+{
+	polyphase_dc_test(48000, 44100, 0, 20, 8812);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_dc_32000_to_48000)
+{
+	polyphase_dc_test(32000, 48000, 0, 20, 9587);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_dc_48000_to_32000)
+{
+	polyphase_dc_test(48000, 32000, 0, 20, 6394);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_dc_drift)
+{
+	/* An input clock 1000 ppm fast gives 48 fewer output samples per second */
+	polyphase_dc_test(48000, 48000, 1000, 100, 47944);
+}
+
+static uint32_t polyphase_noise_crc(uint32_t input_sample_rate, uint32_t output_sample_rate,
+				    int32_t drift_ppm, size_t num_blocks)
+{
+	int ret;
+	uint32_t lcg = 1;
+	uint32_t crc = 0;
+	size_t num_samples = input_sample_rate / 100;
+	size_t max_output_samples = output_sample_rate / 100 + 1;
+	int16_t input_samples[num_samples];
+	int16_t output_samples[max_output_samples];
+	size_t output_written;
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, drift_ppm);
+	zassert_equal(ret, 0, "Setting drift failed");
+
+	for (int block = 0; block < num_blocks; block++) {
+		for (int i = 0; i < num_samples; i++) {
+			lcg = lcg * 1664525U + 1013904223U;
+			input_samples[i] = (int16_t)(lcg >> 16);
+		}
+
+		ret = sample_rate_converter_process(
+			&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+			num_samples * sizeof(int16_t), input_sample_rate, output_samples,
+			max_output_samples * sizeof(int16_t), &output_written, output_sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		crc = crc32_ieee_update(crc, (uint8_t *)output_samples, output_written);
+	}
+
+	return crc;
+}
+
+/* The expected checksums are from a reference model of the integer arithmetic, so all kernels
+ * must give bit identical output for full scale noise.
+ */
+ZTEST(suite_sample_rate_converter, test_polyphase_bit_exact_44100_to_48000)
+{
+	uint32_t crc = polyphase_noise_crc(44100, 48000, 0, 10);
+
+	zassert_equal(crc, 0x1e76dc0f, "Output checksum was not as expected (0x%08x)", crc);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_bit_exact_48000_to_32000_drift)
+{
+	uint32_t crc = polyphase_noise_crc(48000, 32000, 100, 10);
+
+	zassert_equal(crc, 0x8e41c510, "Output checksum was not as expected (0x%08x)", crc);
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_invalid_output_buf_too_small)
+{
+	int ret;
+
+	int16_t input_samples[441] = {0};
+	int16_t output_samples[400];
+	size_t output_written;
+
+	/* 441 samples at 44.1 kHz give about 470 samples at 48 kHz */
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 44100, output_samples,
+					    sizeof(output_samples), &output_written, 48000);
+	zassert_equal(ret, -EINVAL,
+		      "Sample rate conversion process did not fail when output buffer is to small");
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16 */
+
+ZTEST(suite_sample_rate_converter, test_polyphase_invalid_ratio)
+{
+	int ret;
+
+	uint32_t input_samples[48] = {0};
+	uint32_t output_samples[48 * 9];
+	size_t output_written;
+
+	/* Ratio below 0.6 */
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 48000, output_samples,
+					    sizeof(output_samples), &output_written, 16000);
+	zassert_equal(ret, -EINVAL, "Sample rate conversion did not fail for a ratio below 0.6");
+
+	/* Ratio above 8 */
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE, input_samples,
+					    sizeof(input_samples), 8000, output_samples,
+					    sizeof(output_samples), &output_written, 96000);
+	zassert_equal(ret, -EINVAL, "Sample rate conversion did not fail for a ratio above 8");
+}
+
+ZTEST(suite_sample_rate_converter, test_polyphase_invalid_drift)
+{
+	int ret;
+
+	ret = sample_rate_converter_drift_set(NULL, 0);
+	zassert_equal(ret, -EINVAL, "Setting drift did not fail for NULL context");
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX + 1);
+	zassert_equal(ret, -EINVAL, "Setting drift did not fail for too large drift");
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, -SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX - 1);
+	zassert_equal(ret, -EINVAL, "Setting drift did not fail for too large negative drift");
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 ZTEST_SUITE(suite_sample_rate_converter, NULL, NULL, test_setup, NULL, NULL);
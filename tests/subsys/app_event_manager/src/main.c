@@ -179,6 +179,87 @@ ZTEST(suite0, test_event_size_disabled)
 	app_event_manager_free(ev_s1);
 }
 
+ZTEST(suite0, test_slab_allocator_stats)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_ALLOCATOR_SLAB)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct app_event_manager_slab_stats stats_before;
+	struct app_event_manager_slab_stats stats;
+	struct test_size1_event *ev_s1;
+	size_t idx;
+
+	zassert_equal(-EINVAL,
+		      app_event_manager_slab_stats_get(app_event_manager_slab_class_cnt(),
+						       &stats));
+
+	/* Find the size class serving the event. */
+	for (idx = 0; idx < app_event_manager_slab_class_cnt(); idx++) {
+		zassert_ok(app_event_manager_slab_stats_get(idx, &stats_before));
+		if (sizeof(*ev_s1) <= stats_before.block_size) {
+			break;
+		}
+	}
+	zassert_true(idx < app_event_manager_slab_class_cnt(),
+		     "Event expected to fit one of the size classes");
+
+	ev_s1 = new_test_size1_event();
+	zassert_not_null(ev_s1);
+
+	zassert_ok(app_event_manager_slab_stats_get(idx, &stats));
+	zassert_equal(stats_before.used_cnt + 1, stats.used_cnt, "Block not taken from slab");
+	zassert_true(stats.max_used_cnt >= stats.used_cnt, "Invalid high-water mark");
+
+	app_event_manager_free(ev_s1);
+
+	zassert_ok(app_event_manager_slab_stats_get(idx, &stats));
+	zassert_equal(stats_before.used_cnt, stats.used_cnt, "Block not returned to slab");
+}
+
+ZTEST(suite0, test_dispatch_stats)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct app_event_manager_dispatch_stats stats;
+
+	app_event_manager_dispatch_stats_reset();
+	test_start(TEST_BASIC);
+
+	zassert_ok(app_event_manager_dispatch_stats_get(APP_EVENT_ID(test_start_event), &stats));
+	zassert_equal(1, stats.event_cnt, "Unexpected number of processed events");
+	zassert_true(stats.max_cycles <= stats.total_cycles, "Invalid processing time");
+	zassert_equal(0, stats.dropped_cnt, "Unexpected dropped events");
+
+	zassert_equal(-EINVAL, app_event_manager_dispatch_stats_get(NULL, &stats));
+}
+
+ZTEST(suite0, test_drop_unsubscribed_events)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DROP_UNSUBSCRIBED_EVENTS) ||
+	    !IS_ENABLED(CONFIG_APP_EVENT_MANAGER_DISPATCH_STATS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct app_event_manager_dispatch_stats stats;
+	struct test_size2_event *ev_s2;
+
+	app_event_manager_dispatch_stats_reset();
+
+	/* The event type has no subscribers. */
+	ev_s2 = new_test_size2_event();
+	APP_EVENT_SUBMIT(ev_s2);
+
+	zassert_ok(app_event_manager_dispatch_stats_get(APP_EVENT_ID(test_size2_event), &stats));
+	zassert_equal(1, stats.dropped_cnt, "Event not dropped on submission");
+	zassert_equal(0, stats.event_cnt, "Dropped event was processed");
+}
+
 ZTEST(suite0, test_name_style_events_sorting)
 {
 	test_start(TEST_NAME_STYLE_SORTING);
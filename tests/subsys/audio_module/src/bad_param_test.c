@@ -31,6 +31,9 @@ static struct data_fifo mod_fifo_tx, mod_fifo_rx;
 static struct audio_data test_block, test_block_tx, test_block_rx;
 static char mod_thread_stack[TEST_MOD_THREAD_STACK_SIZE];
 
+/* More buffers than the module can have in flight. */
+K_MEM_SLAB_DEFINE(big_data_slab, TEST_MOD_DATA_SIZE, CONFIG_AUDIO_MODULE_BUFFERS_IN_FLIGHT + 1, 4);
+
 /**
  * @brief Function to initialize a module's handle.
  *
@@ -1086,6 +1089,35 @@ ZTEST(suite_audio_module_bad_param, test_open_bad_description)
 		      -ECANCELED, ret);
 }
 
+ZTEST(suite_audio_module_bad_param, test_open_bad_data_slab)
+{
+	int ret;
+	char *inst_name = "TEST open";
+	struct audio_module_functions test_functions = {
+		.configuration_set = test_config_set_function,
+		.configuration_get = test_config_get_function,
+		.data_process = test_data_process_function};
+	struct audio_module_description test_description = {.name = "Module 1",
+							    .type = AUDIO_MODULE_TYPE_IN_OUT,
+							    .functions = &test_functions};
+	struct audio_module_parameters test_params = {
+		.description = &test_description,
+		.thread = {.stack = (k_thread_stack_t *)&mod_thread_stack,
+			   .stack_size = TEST_MOD_THREAD_STACK_SIZE,
+			   .priority = TEST_MOD_THREAD_PRIORITY,
+			   .data_slab = &big_data_slab,
+			   .data_size = TEST_MOD_DATA_SIZE}};
+
+	memset(&handle, 0, sizeof(handle));
+
+	ret = audio_module_open(&test_params, config, inst_name,
+				(struct audio_module_context *)&context, &handle);
+	zassert_equal(ret, -EINVAL, "Open function did not return -EINVAL (%d): ret %d", -EINVAL,
+		      ret);
+	zassert_equal(handle.state, AUDIO_MODULE_STATE_UNDEFINED,
+		      "Open returns with incorrect state: %d", handle.state);
+}
+
 ZTEST(suite_audio_module_bad_param, test_open_bad_state)
 {
 	int ret;
@@ -1170,3 +1202,117 @@ ZTEST(suite_audio_module_bad_param, test_open_null)
 	zassert_equal(handle.state, AUDIO_MODULE_STATE_UNDEFINED,
 		      "Open returns with incorrect state: %d", handle.state);
 }
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+static struct audio_module_graph graph;
+
+ZTEST(suite_audio_module_bad_param, test_graph_open_null)
+{
+	int ret;
+
+	test_initialize_description(&test_description, "Module Test", AUDIO_MODULE_TYPE_INPUT,
+				    &mod_1_functions);
+	test_initialize_handle(&handle, "TEST graph", &test_description,
+			       AUDIO_MODULE_STATE_CONFIGURED, NULL, NULL);
+
+	ret = audio_module_graph_open(NULL, &handle, (k_thread_stack_t *)&mod_thread_stack,
+				      TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_open(&graph, NULL, (k_thread_stack_t *)&mod_thread_stack,
+				      TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_open(&graph, &handle, NULL, TEST_MOD_THREAD_STACK_SIZE,
+				      TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_open(&graph, &handle, (k_thread_stack_t *)&mod_thread_stack, 0,
+				      TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_close(NULL);
+	zassert_equal(ret, -EINVAL, "Graph close function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+}
+
+ZTEST(suite_audio_module_bad_param, test_graph_open_bad_module)
+{
+	int ret;
+	struct k_thread dummy_thread;
+
+	test_initialize_description(&test_description, "Module Test", AUDIO_MODULE_TYPE_INPUT,
+				    &mod_1_functions);
+	memset(&handle, 0, sizeof(handle));
+	test_initialize_handle(&handle, "TEST graph", &test_description,
+			       AUDIO_MODULE_STATE_UNDEFINED, NULL, NULL);
+	sys_slist_init(&handle.handle_dest_list);
+
+	ret = audio_module_graph_open(&graph, &handle, (k_thread_stack_t *)&mod_thread_stack,
+				      TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -ECANCELED,
+		      "Graph open function did not return -ECANCELED (%d): ret %d", -ECANCELED,
+		      ret);
+
+	/* A module with its own thread cannot be in a graph. */
+	handle.state = AUDIO_MODULE_STATE_CONFIGURED;
+	handle.thread_id = &dummy_thread;
+	ret = audio_module_graph_open(&graph, &handle, (k_thread_stack_t *)&mod_thread_stack,
+				      TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+	zassert_is_null(handle.graph, "Graph open failed but module is in a graph");
+
+	/* A source that receives data must have an RX FIFO. */
+	test_description.type = AUDIO_MODULE_TYPE_IN_OUT;
+	handle.thread_id = NULL;
+	ret = audio_module_graph_open(&graph, &handle, (k_thread_stack_t *)&mod_thread_stack,
+				      TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, -EINVAL, "Graph open function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	/* A module in a graph cannot be connected, disconnected or closed. */
+	test_initialize_description(&test_description_1, "Module Test 1", AUDIO_MODULE_TYPE_OUTPUT,
+				    &mod_1_functions);
+	test_initialize_handle(&handle_rx, "TEST graph rx", &test_description_1,
+			       AUDIO_MODULE_STATE_CONFIGURED, NULL, NULL);
+	k_mutex_init(&handle.dest_mutex);
+	handle.graph = &graph;
+
+	ret = audio_module_connect(&handle, &handle_rx, false);
+	zassert_equal(ret, -EBUSY, "Connect function did not return -EBUSY (%d): ret %d", -EBUSY,
+		      ret);
+
+	ret = audio_module_disconnect(&handle, &handle_rx, false);
+	zassert_equal(ret, -EBUSY, "Disconnect function did not return -EBUSY (%d): ret %d",
+		      -EBUSY, ret);
+
+	ret = audio_module_close(&handle);
+	zassert_equal(ret, -EBUSY, "Close function did not return -EBUSY (%d): ret %d", -EBUSY,
+		      ret);
+
+	handle.graph = NULL;
+}
+
+ZTEST(suite_audio_module_bad_param, test_graph_latency_null)
+{
+	int ret;
+	struct audio_module_latency_hist hist;
+
+	ret = audio_module_graph_latency_get(NULL, NULL, &hist);
+	zassert_equal(ret, -EINVAL, "Latency get function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_latency_get(&graph, NULL, NULL);
+	zassert_equal(ret, -EINVAL, "Latency get function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_graph_latency_reset(NULL);
+	zassert_equal(ret, -EINVAL, "Latency reset function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
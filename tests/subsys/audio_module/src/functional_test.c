@@ -824,6 +824,44 @@ ZTEST(suite_audio_module_functional, test_connect_disconnect_fnct)
 	} while (1);
 }
 
+ZTEST(suite_audio_module_functional, test_connect_fan_out_max_fnct)
+{
+	int ret;
+	struct data_fifo fifo_tx = {0};
+	struct audio_module_handle handle_from;
+	static struct audio_module_handle handles_to[CONFIG_AUDIO_MODULE_FAN_OUT_MAX + 1];
+
+	test_from_description.type = AUDIO_MODULE_TYPE_INPUT;
+	test_to_description.type = AUDIO_MODULE_TYPE_OUTPUT;
+
+	for (int k = 0; k < ARRAY_SIZE(handles_to); k++) {
+		test_initialize_handle(&handles_to[k], &test_to_description, NULL, NULL);
+	}
+
+	test_initialize_handle(&handle_from, &test_from_description, NULL, NULL);
+	handle_from.thread.msg_tx = &fifo_tx;
+	sys_slist_init(&handle_from.handle_dest_list);
+	k_mutex_init(&handle_from.dest_mutex);
+
+	for (int k = 0; k < CONFIG_AUDIO_MODULE_FAN_OUT_MAX; k++) {
+		ret = audio_module_connect(&handle_from, &handles_to[k], false);
+		zassert_equal(ret, 0, "Connect function did not return successfully: ret %d (%d)",
+			      ret, k);
+	}
+
+	ret = audio_module_connect(&handle_from, &handles_to[CONFIG_AUDIO_MODULE_FAN_OUT_MAX],
+				   false);
+	zassert_equal(ret, -ENOMEM, "Connect function did not return -ENOMEM (%d): ret %d",
+		      -ENOMEM, ret);
+
+	/* The external TX FIFO is not limited by the fan-out. */
+	ret = audio_module_connect(&handle_from, NULL, true);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+	zassert_equal(handle_from.dest_count, CONFIG_AUDIO_MODULE_FAN_OUT_MAX + 1,
+		      "Destination count is not %d, %d", CONFIG_AUDIO_MODULE_FAN_OUT_MAX + 1,
+		      handle_from.dest_count);
+}
+
 ZTEST(suite_audio_module_functional, test_close_null_fnct)
 {
 	test_close(&ft_null, AUDIO_MODULE_TYPE_INPUT, true, true, AUDIO_MODULE_STATE_CONFIGURED);
@@ -1101,3 +1139,262 @@ ZTEST(suite_audio_module_functional, test_data_rx_fnct)
 		      "Data RX function failed to free item, data FIFO free called %d times",
 		      data_fifo_block_free_fake.call_count);
 }
+
+#if defined(CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR)
+#define GRAPH_TEST_BLOCKS_NUM (3)
+
+K_THREAD_STACK_DEFINE(graph_stack, TEST_MOD_THREAD_STACK_SIZE);
+K_MEM_SLAB_DEFINE(graph_source_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
+K_MEM_SLAB_DEFINE(graph_pass_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
+K_SEM_DEFINE(graph_sink_sem, 0, 1);
+
+static struct audio_module_graph graph;
+static struct audio_module_handle graph_source, graph_pass, graph_sink;
+static struct mod_context graph_source_context, graph_pass_context, graph_sink_context;
+static struct data_fifo graph_fifo_rx, graph_fifo_tx;
+static uint8_t graph_sink_data[TEST_MOD_DATA_SIZE];
+static size_t graph_sink_size;
+
+/**
+ * @brief Test process data function that adds one to each byte of the input.
+ *
+ * @param handle         [in/out]  The handle to the module instance.
+ * @param audio_data_rx  [in]      Pointer to the input audio data.
+ * @param audio_data_tx  [out]     Pointer to the output audio data.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_increment_process(struct audio_module_handle_private *handle,
+				   struct audio_data const *const audio_data_rx,
+				   struct audio_data *audio_data_tx)
+{
+	uint8_t const *in = (uint8_t const *)audio_data_rx->data;
+	uint8_t *out = (uint8_t *)audio_data_tx->data;
+
+	ARG_UNUSED(handle);
+
+	zassert_true(audio_data_rx->data_size <= audio_data_tx->data_size,
+		     "Output buffer smaller than the input");
+	zassert_not_equal(in, out, "Output buffer is the input buffer");
+
+	for (size_t i = 0; i < audio_data_rx->data_size; i++) {
+		out[i] = in[i] + 1;
+	}
+
+	memcpy(&audio_data_tx->meta, &audio_data_rx->meta, sizeof(struct audio_metadata));
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	return 0;
+}
+
+/**
+ * @brief Test process data function of the last module, that keeps a copy of its input.
+ *
+ * @param handle         [in/out]  The handle to the module instance.
+ * @param audio_data_rx  [in]      Pointer to the input audio data.
+ * @param audio_data_tx  [out]     NULL for an output module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_sink_process(struct audio_module_handle_private *handle,
+			      struct audio_data const *const audio_data_rx,
+			      struct audio_data *audio_data_tx)
+{
+	ARG_UNUSED(handle);
+
+	zassert_is_null(audio_data_tx, "Output module has output audio data");
+
+	memcpy(graph_sink_data, audio_data_rx->data, audio_data_rx->data_size);
+	graph_sink_size = audio_data_rx->data_size;
+
+	k_sem_give(&graph_sink_sem);
+
+	return 0;
+}
+
+static const struct audio_module_functions ft_graph_increment = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = graph_increment_process};
+static const struct audio_module_functions ft_graph_sink = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = graph_sink_process};
+static struct audio_module_description graph_source_description = {
+	.name = "Graph source", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &ft_graph_increment};
+static struct audio_module_description graph_pass_description = {
+	.name = "Graph pass", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &ft_graph_increment};
+static struct audio_module_description graph_sink_description = {
+	.name = "Graph sink", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &ft_graph_sink};
+
+/**
+ * @brief Open a module without a thread, to run in a graph.
+ *
+ * @param handle       [out]     The handle to the module instance.
+ * @param description  [in]      Pointer to the module's description.
+ * @param context      [in/out]  Pointer to the module's context.
+ * @param msg_rx       [in]      Pointer to the module's RX FIFO.
+ * @param msg_tx       [in]      Pointer to the module's TX FIFO.
+ * @param data_slab    [in]      Pointer to the module's output data slab.
+ */
+static void graph_module_open(struct audio_module_handle *handle,
+			      struct audio_module_description *description,
+			      struct mod_context *context, struct data_fifo *msg_rx,
+			      struct data_fifo *msg_tx, struct k_mem_slab *data_slab)
+{
+	int ret;
+	struct audio_module_parameters parameters = {
+		.description = description,
+		.thread = {.stack = NULL,
+			   .stack_size = 0,
+			   .msg_rx = msg_rx,
+			   .msg_tx = msg_tx,
+			   .data_slab = data_slab,
+			   .data_size = (data_slab != NULL) ? TEST_MOD_DATA_SIZE : 0}};
+
+	memset(handle, 0, sizeof(struct audio_module_handle));
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&mod_config,
+				description->name, (struct audio_module_context *)context,
+				handle);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+	zassert_is_null(handle->thread_id, "Module opened for a graph has a thread");
+
+	ret = audio_module_start(handle);
+	zassert_equal(ret, 0, "Start function did not return successfully: ret %d", ret);
+}
+
+ZTEST(suite_audio_module_functional, test_graph_data_path_fnct)
+{
+	int ret;
+	int prio = k_thread_priority_get(k_current_get());
+	uint8_t test_data[TEST_MOD_DATA_SIZE];
+	uint8_t data[TEST_MOD_DATA_SIZE];
+	struct audio_data audio_data = {0};
+	struct audio_data audio_data_out = {0};
+	struct audio_module_latency_hist hist;
+
+	/* Fake internal data FIFO success */
+	data_fifo_init_fake.custom_fake = fake_data_fifo_init__succeeds;
+	data_fifo_uninit_fake.custom_fake = fake_data_fifo_uninit__succeeds;
+	data_fifo_empty_fake.custom_fake = fake_data_fifo_empty__succeeds;
+	data_fifo_pointer_first_vacant_get_fake.custom_fake =
+		fake_data_fifo_pointer_first_vacant_get__succeeds;
+	data_fifo_block_lock_fake.custom_fake = fake_data_fifo_block_lock__succeeds;
+	data_fifo_pointer_last_filled_get_fake.custom_fake =
+		fake_data_fifo_pointer_last_filled_get__succeeds;
+	data_fifo_block_free_fake.custom_fake = fake_data_fifo_block_free__succeeds;
+	data_fifo_state_fake.custom_fake = fake_data_fifo_state__succeeds;
+
+	fake_fifo_counter_reset();
+	memset(&graph_fifo_rx, 0, sizeof(graph_fifo_rx));
+	memset(&graph_fifo_tx, 0, sizeof(graph_fifo_tx));
+	k_sem_reset(&graph_sink_sem);
+
+	/* source -> pass -> sink, and the output of pass is also returned on its TX FIFO. */
+	graph_module_open(&graph_source, &graph_source_description, &graph_source_context,
+			  &graph_fifo_rx, NULL, &graph_source_slab);
+	graph_module_open(&graph_pass, &graph_pass_description, &graph_pass_context, NULL,
+			  &graph_fifo_tx, &graph_pass_slab);
+	graph_module_open(&graph_sink, &graph_sink_description, &graph_sink_context, NULL, NULL,
+			  NULL);
+
+	ret = audio_module_connect(&graph_source, &graph_pass, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+	ret = audio_module_connect(&graph_pass, &graph_sink, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+	ret = audio_module_connect(&graph_pass, NULL, true);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	/* Let the executor process each block completely before this thread continues. */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(TEST_MOD_THREAD_PRIORITY + 1));
+
+	ret = audio_module_graph_open(&graph, &graph_source, graph_stack,
+				      K_THREAD_STACK_SIZEOF(graph_stack), TEST_MOD_THREAD_PRIORITY);
+	zassert_equal(ret, 0, "Graph open function did not return successfully: ret %d", ret);
+	zassert_equal(graph.module_num, 3, "Graph has %d modules", graph.module_num);
+	zassert_equal_ptr(graph.modules[0], &graph_source, "Source is not first in the graph");
+
+	for (int block = 0; block < GRAPH_TEST_BLOCKS_NUM; block++) {
+		for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+			test_data[i] = block * TEST_MOD_DATA_SIZE + i;
+		}
+
+		audio_data.data = test_data;
+		audio_data.data_size = TEST_MOD_DATA_SIZE;
+
+		ret = audio_module_data_tx(&graph_source, &audio_data, NULL);
+		zassert_equal(ret, 0, "Data TX function did not return successfully: ret %d",
+			      ret);
+
+		ret = k_sem_take(&graph_sink_sem, K_MSEC(100));
+		zassert_equal(ret, 0, "Audio data did not reach the last module: ret %d", ret);
+		zassert_equal(graph_sink_size, TEST_MOD_DATA_SIZE,
+			      "Last module got %zu bytes of audio data", graph_sink_size);
+
+		for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+			zassert_equal(graph_sink_data[i], (uint8_t)(test_data[i] + 2),
+				      "Audio data differs at %d in block %d", i, block);
+		}
+
+		audio_data_out.data = data;
+		audio_data_out.data_size = sizeof(data);
+
+		ret = audio_module_data_rx(&graph_pass, &audio_data_out, K_NO_WAIT);
+		zassert_equal(ret, 0, "Data RX function did not return successfully: ret %d",
+			      ret);
+		zassert_mem_equal(data, graph_sink_data, TEST_MOD_DATA_SIZE,
+				  "TX FIFO audio data differs from the last module's input");
+	}
+
+	/* A stopped module is skipped together with the modules connected from it. */
+	ret = audio_module_stop(&graph_pass);
+	zassert_equal(ret, 0, "Stop function did not return successfully: ret %d", ret);
+
+	ret = audio_module_data_tx(&graph_source, &audio_data, NULL);
+	zassert_equal(ret, 0, "Data TX function did not return successfully: ret %d", ret);
+
+	ret = k_sem_take(&graph_sink_sem, K_MSEC(10));
+	zassert_equal(ret, -EAGAIN, "Audio data passed a stopped module: ret %d", ret);
+
+	ret = audio_module_graph_latency_get(&graph, &graph_source, &hist);
+	zassert_equal(ret, 0, "Latency get function did not return successfully: ret %d", ret);
+	zassert_equal(hist.count, GRAPH_TEST_BLOCKS_NUM + 1, "Source processed %u blocks",
+		      hist.count);
+
+	ret = audio_module_graph_latency_get(&graph, &graph_sink, &hist);
+	zassert_equal(ret, 0, "Latency get function did not return successfully: ret %d", ret);
+	zassert_equal(hist.count, GRAPH_TEST_BLOCKS_NUM, "Last module processed %u blocks",
+		      hist.count);
+
+	ret = audio_module_graph_latency_get(&graph, NULL, &hist);
+	zassert_equal(ret, 0, "Latency get function did not return successfully: ret %d", ret);
+	zassert_equal(hist.count, GRAPH_TEST_BLOCKS_NUM + 1, "Graph processed %u blocks",
+		      hist.count);
+
+	ret = audio_module_graph_close(&graph);
+	zassert_equal(ret, 0, "Graph close function did not return successfully: ret %d", ret);
+
+	k_thread_priority_set(k_current_get(), prio);
+
+	/* All the output buffers and the input messages have been returned. */
+	zassert_equal(k_mem_slab_num_free_get(&graph_source_slab), FAKE_FIFO_MSG_QUEUE_SIZE,
+		      "Source output buffers were not freed");
+	zassert_equal(k_mem_slab_num_free_get(&graph_pass_slab), FAKE_FIFO_MSG_QUEUE_SIZE,
+		      "Pass output buffers were not freed");
+	zassert_equal(data_fifo_block_free_fake.call_count, 2 * GRAPH_TEST_BLOCKS_NUM + 1,
+		      "Data FIFO free called %u times", data_fifo_block_free_fake.call_count);
+
+	ret = audio_module_stop(&graph_source);
+	zassert_equal(ret, 0, "Stop function did not return successfully: ret %d", ret);
+	ret = audio_module_stop(&graph_sink);
+	zassert_equal(ret, 0, "Stop function did not return successfully: ret %d", ret);
+
+	ret = audio_module_close(&graph_source);
+	zassert_equal(ret, 0, "Close function did not return successfully: ret %d", ret);
+	ret = audio_module_close(&graph_pass);
+	zassert_equal(ret, 0, "Close function did not return successfully: ret %d", ret);
+	ret = audio_module_close(&graph_sink);
+	zassert_equal(ret, 0, "Close function did not return successfully: ret %d", ret);
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH_EXECUTOR */
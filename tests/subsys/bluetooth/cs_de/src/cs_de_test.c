@@ -16,6 +16,13 @@
 #define PI (3.14159265358979f)
 #define SPEED_OF_LIGHT_M_PER_S (299792458.0f)
 
+/* The IFFT in Q15 arithmetic has a coarser resolution than in float or Q31. */
+#if defined(CONFIG_BT_CS_DE_IFFT_Q15)
+#define IFFT_TOLERANCE_M (0.05f)
+#else
+#define IFFT_TOLERANCE_M (0.01f)
+#endif
+
 /* The unity_main is not declared in any header file. It is only defined in the generated test
  * runner because of ncs' unity configuration. It is therefore declared here to avoid a compiler
  * warning.
@@ -109,10 +116,11 @@ void test_cs_de_calc_with_ideal_iq_data(void)
 			TEST_ASSERT_TRUE(result == CS_DE_QUALITY_OK);
 
 			for (uint8_t ap = 0; ap < n_ap; ap++) {
-				/* Verify that the estimated distance is within 1 cm of the distance
+				/* Verify that the estimated distance is within the tolerance of the
+				 * IFFT arithmetic, and 1 cm for the phase slope, of the distance
 				 * used to generate the ideal IQ data.
 				 */
-				TEST_ASSERT_FLOAT_WITHIN(0.01f,
+				TEST_ASSERT_FLOAT_WITHIN(IFFT_TOLERANCE_M,
 					distance,
 					test_report.distance_estimates[ap].ifft);
 				TEST_ASSERT_FLOAT_WITHIN(0.01f,
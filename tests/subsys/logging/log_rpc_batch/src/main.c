@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "log_rpc_batch.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/cbprintf.h>
+
+#include <nrf_rpc/nrf_rpc_serialize.h>
+
+#include <string.h>
+
+#define BATCH_SIZE	256
+#define PACKAGE_SIZE	128
+#define TEXT_SIZE	64
+#define ELEM_COUNT	64
+
+/* Flags the logging subsystem creates the packages with when the backend is binary */
+#define MSG_PACKAGE_FLAGS CBPRINTF_PACKAGE_ADD_RO_STR_POS
+
+static uint8_t batch[BATCH_SIZE];
+static size_t batch_len;
+static struct nrf_rpc_cbor_ctx ctx;
+
+static uint8_t msg_package[PACKAGE_SIZE] __aligned(CBPRINTF_PACKAGE_ALIGNMENT);
+static uint8_t rx_package[PACKAGE_SIZE] __aligned(CBPRINTF_PACKAGE_ALIGNMENT);
+static char text[TEXT_SIZE];
+static size_t text_len;
+
+static int text_out(int c, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (text_len < sizeof(text) - 1) {
+		text[text_len++] = (char)c;
+	}
+
+	return c;
+}
+
+static size_t msg_package_create(const char *fmt, ...)
+{
+	va_list ap;
+	int len;
+
+	va_start(ap, fmt);
+	len = cbvprintf_package(msg_package, sizeof(msg_package), MSG_PACKAGE_FLAGS, fmt, ap);
+	va_end(ap);
+
+	zassert_true(len > 0, "Failed to create the package: %d", len);
+
+	return len;
+}
+
+static void batch_start(void)
+{
+	zcbor_new_encode_state(ctx.zs, ARRAY_SIZE(ctx.zs), batch, sizeof(batch), 0);
+}
+
+static void batch_add(const struct log_rpc_batch_record *record)
+{
+	uint16_t strl[4];
+	int size;
+
+	size = log_rpc_batch_record_size(record, strl, ARRAY_SIZE(strl));
+	zassert_true(size > 0, "Failed to size the record: %d", size);
+	zassert_true(ctx.zs[0].payload_mut + size <= batch + sizeof(batch));
+
+	log_rpc_batch_record_encode(&ctx, record, strl, ARRAY_SIZE(strl));
+	zassert_true(ctx.zs[0].payload_mut - batch <= size, "Record larger than its size bound");
+}
+
+static void batch_end(void)
+{
+	nrf_rpc_encode_null(&ctx);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	batch_len = ctx.zs[0].payload_mut - batch;
+
+	zcbor_new_decode_state(ctx.zs, ARRAY_SIZE(ctx.zs), batch, batch_len, ELEM_COUNT, NULL, 0);
+}
+
+/* Formats the received package the way the forwarder does */
+static const char *package_format(const struct log_rpc_batch_record *record)
+{
+	zassert_true(record->package_size <= sizeof(rx_package));
+	memcpy(rx_package, record->package, record->package_size);
+	zassert_true(log_rpc_batch_package_is_valid(rx_package, record->package_size));
+
+	text_len = 0;
+	cbpprintf(text_out, NULL, rx_package);
+	text[text_len] = '\0';
+
+	return text;
+}
+
+ZTEST(log_rpc_batch, test_round_trip)
+{
+	static const char source[] = "app";
+	static const uint8_t data[] = {0xde, 0xad, 0xbe, 0xef};
+	char rw_str[] = "world";
+	struct log_rpc_batch_record record = {
+		.level = LOG_RPC_LEVEL_WRN,
+		.timestamp_us = 0x123456789aULL,
+		.source = source,
+		.source_size = strlen(source),
+		.data = data,
+		.data_size = sizeof(data),
+	};
+	struct log_rpc_batch_record rx;
+
+	record.package = msg_package;
+	record.package_size = msg_package_create("hello %d %s %s", 42, "ro", rw_str);
+
+	batch_start();
+	batch_add(&record);
+	batch_end();
+
+	zassert_true(log_rpc_batch_record_decode(&ctx, &rx));
+	zassert_equal(rx.level, LOG_RPC_LEVEL_WRN);
+	zassert_equal(rx.timestamp_us, 0x123456789aULL);
+	zassert_equal(rx.source_size, strlen(source));
+	zassert_mem_equal(rx.source, source, strlen(source));
+	zassert_equal(rx.data_size, sizeof(data));
+	zassert_mem_equal(rx.data, data, sizeof(data));
+
+	/* Overwrite the strings of the sender, which the received package must not refer to */
+	memset(rw_str, 'x', sizeof(rw_str) - 1);
+	zassert_str_equal(package_format(&rx), "hello 42 ro world");
+
+	zassert_false(log_rpc_batch_record_decode(&ctx, &rx), "Null terminator not detected");
+	zassert_true(nrf_rpc_decode_is_null(&ctx));
+}
+
+ZTEST(log_rpc_batch, test_batch)
+{
+	struct log_rpc_batch_record record = {
+		.level = LOG_RPC_LEVEL_INF,
+	};
+	struct log_rpc_batch_record rx;
+
+	batch_start();
+
+	record.timestamp_us = 1;
+	record.package = msg_package;
+	record.package_size = msg_package_create("first %u", 1U);
+	batch_add(&record);
+
+	/* No source name and no hexdump data */
+	record.level = LOG_RPC_LEVEL_DBG;
+	record.timestamp_us = 2;
+	record.package_size = msg_package_create("second");
+	batch_add(&record);
+
+	batch_end();
+
+	zassert_true(log_rpc_batch_record_decode(&ctx, &rx));
+	zassert_equal(rx.level, LOG_RPC_LEVEL_INF);
+	zassert_equal(rx.timestamp_us, 1);
+	zassert_is_null(rx.source);
+	zassert_is_null(rx.data);
+	zassert_str_equal(package_format(&rx), "first 1");
+
+	zassert_true(log_rpc_batch_record_decode(&ctx, &rx));
+	zassert_equal(rx.level, LOG_RPC_LEVEL_DBG);
+	zassert_equal(rx.timestamp_us, 2);
+	zassert_str_equal(package_format(&rx), "second");
+
+	zassert_false(log_rpc_batch_record_decode(&ctx, &rx));
+}
+
+ZTEST(log_rpc_batch, test_truncated_batch)
+{
+	struct log_rpc_batch_record record = {
+		.level = LOG_RPC_LEVEL_ERR,
+	};
+	struct log_rpc_batch_record rx;
+
+	record.package = msg_package;
+	record.package_size = msg_package_create("truncated %d", -1);
+
+	batch_start();
+	batch_add(&record);
+	batch_end();
+
+	/* Cut the record in the middle of the package */
+	zcbor_new_decode_state(ctx.zs, ARRAY_SIZE(ctx.zs), batch, batch_len - 4, ELEM_COUNT, NULL,
+			       0);
+
+	zassert_false(log_rpc_batch_record_decode(&ctx, &rx));
+	zassert_false(nrf_rpc_decode_valid(&ctx));
+}
+
+/* Creates a converted package with the format string and one string argument appended */
+static size_t converted_package_create(void)
+{
+	uint16_t strl[4];
+	size_t package_size;
+	int len;
+
+	package_size = msg_package_create("%s!", "str");
+	len = cbprintf_package_copy(msg_package, package_size, rx_package, sizeof(rx_package),
+				    LOG_RPC_BATCH_PACKAGE_FLAGS, strl, ARRAY_SIZE(strl));
+	zassert_true(len > 0);
+	zassert_true(log_rpc_batch_package_is_valid(rx_package, len));
+
+	return len;
+}
+
+ZTEST(log_rpc_batch, test_package_validation)
+{
+	union cbprintf_package_hdr *hdr = (union cbprintf_package_hdr *)rx_package;
+	size_t args_size;
+	size_t len;
+
+	/* Shorter than the header */
+	len = converted_package_create();
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, 2));
+	zassert_false(log_rpc_batch_package_is_valid(rx_package,
+						     sizeof(struct cbprintf_package_hdr_ext) - 1));
+
+	/* Missing the string terminator or the whole string */
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len - 1));
+	args_size = hdr->desc.len * sizeof(int);
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, args_size));
+
+	/* Arguments larger than the package */
+	hdr->desc.len = len / sizeof(int) + 1;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* Arguments smaller than the header and the format string */
+	len = converted_package_create();
+	hdr->desc.len = 1;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* More strings than appended */
+	len = converted_package_create();
+	hdr->desc.str_cnt++;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* String locations referring to the remote memory */
+	len = converted_package_create();
+	hdr->desc.ro_str_cnt = 1;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	len = converted_package_create();
+	hdr->desc.rw_str_cnt = 1;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* String replacing an argument outside of the package */
+	len = converted_package_create();
+	args_size = hdr->desc.len * sizeof(int);
+	rx_package[args_size] = hdr->desc.len;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* String replacing the header */
+	rx_package[args_size] = 0;
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+}
+
+ZTEST(log_rpc_batch, test_format_not_appended)
+{
+	const size_t fmt_idx = sizeof(union cbprintf_package_hdr) / sizeof(int);
+	union cbprintf_package_hdr *hdr = (union cbprintf_package_hdr *)rx_package;
+	uint16_t strl[4];
+	size_t package_size;
+	size_t args_size;
+	int len;
+
+	package_size = msg_package_create("pointer %p", (void *)rx_package);
+	len = cbprintf_package_copy(msg_package, package_size, rx_package, sizeof(rx_package),
+				    LOG_RPC_BATCH_PACKAGE_FLAGS, strl, ARRAY_SIZE(strl));
+	zassert_true(len > 0);
+	zassert_equal(hdr->desc.str_cnt, 1);
+
+	args_size = hdr->desc.len * sizeof(int);
+	zassert_equal(rx_package[args_size], fmt_idx);
+	zassert_true(log_rpc_batch_package_is_valid(rx_package, len));
+
+	/* The only string replaces the pointer argument, the format string is a remote pointer */
+	rx_package[args_size] = fmt_idx + sizeof(char *) / sizeof(int);
+	zassert_false(log_rpc_batch_package_is_valid(rx_package, len));
+}
+
+ZTEST_SUITE(log_rpc_batch, NULL, NULL, NULL, NULL, NULL);
@@ -23,6 +23,7 @@
 #define HTTP_URL "http://server.com:80/path/to/file.end"
 #define HTTP_URL_FILE2 "http://server.com/path/to/file2.end"
 #define HTTP_URL_HOST2 "http://server2.com/path/to/file.end"
+#define HTTP_URL_PORT2 "http://server.com:8080/path/to/file2.end"
 #define HTTPS_URL "https://server.com/path/to/file.end"
 #define COAP_URL "coap://server.com/path/to/file.end"
 #define COAPS_URL "coaps://server.com/path/to/file.end"
@@ -2361,6 +2362,80 @@ void test_downloader_get_two_files_different_host(void)
 	TEST_ASSERT_EQUAL(2, z_impl_zsock_connect_fake.call_count);
 }
 
+void test_downloader_get_two_files_same_host_different_port(void)
+{
+	int err;
+	struct downloader_evt evt;
+
+	err = downloader_init(&dl, &dl_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_http_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_http_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_http_header_then_data;
+
+	err = downloader_get(&dl, &dl_host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	z_impl_zsock_recvfrom_fake.call_count = 0;
+
+	err = downloader_get(&dl, &dl_host_cfg, HTTP_URL_PORT2, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+
+	/* make sure we reconnected */
+	TEST_ASSERT_EQUAL(2, z_impl_zsock_connect_fake.call_count);
+}
+
+void test_downloader_get_keep_connection_idle_timeout(void)
+{
+	int err;
+	struct downloader_evt evt;
+
+	err = downloader_init(&dl, &dl_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_http_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_http_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_http_header_then_data;
+
+	err = downloader_get(&dl, &dl_host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	/* The idle connection is closed after the timeout */
+	k_sleep(K_MSEC(CONFIG_DOWNLOADER_KEEP_CONNECTION_IDLE_TIMEOUT * MSEC_PER_SEC + 500));
+	TEST_ASSERT_EQUAL(1, z_impl_zsock_close_fake.call_count);
+
+	z_impl_zsock_recvfrom_fake.call_count = 0;
+
+	err = downloader_get(&dl, &dl_host_cfg, HTTP_URL_FILE2, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+
+	/* make sure we reconnected */
+	TEST_ASSERT_EQUAL(2, z_impl_zsock_connect_fake.call_count);
+}
+
 void test_downloader_get_hdr_and_payload(void)
 {
 	int err;
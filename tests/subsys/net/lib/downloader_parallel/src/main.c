@@ -0,0 +1,495 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <unity.h>
+
+#include <net/downloader.h>
+#include <net/downloader_parallel.h>
+#include <zephyr/net/socket.h>
+
+#include <zephyr/fff.h>
+#include <sys/types.h>
+#include <stdio.h>
+#include <errno.h>
+
+#define HOSTNAME "server.com"
+#define HTTP_URL "http://server.com/path/to/file.end"
+
+/* The test server emulates a link with a high latency and a limited rate per connection,
+ * like a TCP connection over NB-IoT or NTN where the throughput is bounded by the receive
+ * window and the round trip time.
+ */
+#define FILE_SIZE	(64 * 1024)
+#define SEGMENT_SIZE	(8 * 1024)
+#define LINK_LATENCY_MS 200
+#define LINK_RATE	(32 * 1024) /* bytes per second per connection */
+#define SERVER_CONNS	CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS
+
+#define HTTP_HDR_PARTIAL_CONTENT "HTTP/1.1 206 Partial Content\r\n" \
+"Content-Type: application/octet-stream\r\n" \
+"Content-Length: %u\r\n" \
+"Connection: keep-alive\r\n" \
+"Accept-Ranges: bytes\r\n" \
+"Content-Range: bytes %u-%u/%u\r\n\r\n"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, z_impl_zsock_setsockopt, int, int, int, const void *, net_socklen_t);
+FAKE_VALUE_FUNC(int, z_impl_zsock_socket, int, int, int);
+FAKE_VALUE_FUNC(int, z_impl_zsock_connect, int, const struct net_sockaddr *, net_socklen_t);
+FAKE_VALUE_FUNC(int, z_impl_zsock_close, int)
+FAKE_VALUE_FUNC(int, zsock_getaddrinfo, const char *, const char *, const struct zsock_addrinfo *,
+		struct zsock_addrinfo **)
+FAKE_VOID_FUNC(zsock_freeaddrinfo, struct zsock_addrinfo *);
+FAKE_VALUE_FUNC(int, z_impl_zsock_inet_pton, net_sa_family_t, const char *, void *)
+FAKE_VALUE_FUNC(char *, z_impl_net_addr_ntop, net_sa_family_t, const void *, char *, size_t)
+FAKE_VALUE_FUNC(ssize_t, z_impl_zsock_sendto, int, const void *, size_t, int,
+		const struct net_sockaddr *, net_socklen_t);
+FAKE_VALUE_FUNC(ssize_t, z_impl_zsock_recvfrom, int, void *, size_t, int, struct net_sockaddr *,
+		net_socklen_t *);
+
+static struct server_conn {
+	/** Socket is open. */
+	bool open;
+	/** Response header. */
+	char hdr[256];
+	/** Response length, header and payload. */
+	size_t len;
+	/** Bytes of the response received by the client. */
+	size_t received;
+	/** Offset of the first byte of the payload in the file. */
+	size_t start;
+	/** Uptime when the first byte of the response arrives. */
+	int64_t t0;
+	/** Number of requests on the connection. */
+	int requests;
+} server[SERVER_CONNS];
+
+/* Close the connection once after receiving this many bytes, zero to disable */
+static size_t server_close_after;
+static int server_sockets;
+static int server_requests;
+
+static struct net_sockaddr server_sockaddr = {
+	.sa_family = NET_AF_INET,
+};
+
+static struct zsock_addrinfo server_addrinfo = {
+	.ai_addr = &server_sockaddr,
+	.ai_addrlen = sizeof(struct net_sockaddr),
+};
+
+static uint8_t file_byte(size_t offset)
+{
+	return (uint8_t)(offset * 31 + (offset >> 8));
+}
+
+static int zsock_getaddrinfo_server_ok(const char *host, const char *service,
+				       const struct zsock_addrinfo *hints,
+				       struct zsock_addrinfo **res)
+{
+	TEST_ASSERT_EQUAL_STRING(HOSTNAME, host);
+
+	if (hints->ai_family == NET_AF_INET6) {
+		errno = ENOPROTOOPT;
+		return DNS_EAI_SYSTEM;
+	}
+
+	*res = &server_addrinfo;
+	return 0;
+}
+
+static char *z_impl_net_addr_ntop_ok(net_sa_family_t family, const void *src, char *dst,
+				     size_t size)
+{
+	strncpy(dst, "192.0.2.1", size);
+	return dst;
+}
+
+static int z_impl_zsock_socket_server(int family, int type, int proto)
+{
+	TEST_ASSERT_EQUAL(NET_SOCK_STREAM, type);
+	TEST_ASSERT_EQUAL(NET_IPPROTO_TCP, proto);
+
+	for (int fd = 0; fd < SERVER_CONNS; fd++) {
+		if (!server[fd].open) {
+			memset(&server[fd], 0, sizeof(server[fd]));
+			server[fd].open = true;
+			server_sockets++;
+			return fd;
+		}
+	}
+
+	errno = ENFILE;
+	return -1;
+}
+
+static int z_impl_zsock_close_server(int fd)
+{
+	TEST_ASSERT(fd >= 0 && fd < SERVER_CONNS);
+	server[fd].open = false;
+
+	return 0;
+}
+
+static ssize_t z_impl_zsock_sendto_server(int fd, const void *buf, size_t len, int flags,
+					  const struct net_sockaddr *dest_addr,
+					  net_socklen_t addrlen)
+{
+	struct server_conn *conn = &server[fd];
+	unsigned int first;
+	unsigned int last;
+	const char *range;
+
+	TEST_ASSERT(fd >= 0 && fd < SERVER_CONNS);
+	TEST_ASSERT(conn->open);
+
+	range = strstr(buf, "Range: bytes=");
+	TEST_ASSERT_NOT_NULL(range);
+	TEST_ASSERT_EQUAL(2, sscanf(range, "Range: bytes=%u-%u", &first, &last));
+	TEST_ASSERT(first <= last);
+
+	last = MIN(last, FILE_SIZE - 1);
+
+	conn->start = first;
+	conn->len = snprintf(conn->hdr, sizeof(conn->hdr), HTTP_HDR_PARTIAL_CONTENT,
+			     last - first + 1, first, last, FILE_SIZE);
+	conn->len += last - first + 1;
+	conn->received = 0;
+	conn->t0 = k_uptime_get() + LINK_LATENCY_MS;
+	conn->requests++;
+	server_requests++;
+
+	return len;
+}
+
+static ssize_t z_impl_zsock_recvfrom_server(int fd, void *buf, size_t max_len, int flags,
+					    struct net_sockaddr *src_addr,
+					    net_socklen_t *addrlen)
+{
+	struct server_conn *conn = &server[fd];
+	size_t hdr_len = strlen(conn->hdr);
+	size_t arrived;
+	size_t len;
+	int64_t now;
+
+	TEST_ASSERT(fd >= 0 && fd < SERVER_CONNS);
+	TEST_ASSERT(conn->open);
+	TEST_ASSERT(conn->received < conn->len);
+
+	if (server_close_after && conn->received >= server_close_after) {
+		/* Peer closes the connection */
+		server_close_after = 0;
+		return 0;
+	}
+
+	/* The response keeps arriving while the client does not read, as into a receive window
+	 * large enough for a segment. Wait until there is data to read.
+	 */
+	while (true) {
+		now = k_uptime_get();
+		arrived = (now > conn->t0) ? ((now - conn->t0) * LINK_RATE) / MSEC_PER_SEC : 0;
+		arrived = MIN(arrived, conn->len);
+		if (arrived > conn->received) {
+			break;
+		}
+		k_sleep(K_MSEC(MAX(conn->t0 - now, 10)));
+	}
+
+	len = MIN(arrived - conn->received, max_len);
+
+	for (size_t i = 0; i < len; i++) {
+		size_t pos = conn->received + i;
+
+		((uint8_t *)buf)[i] = pos < hdr_len ? conn->hdr[pos] :
+						      file_byte(conn->start + pos - hdr_len);
+	}
+
+	conn->received += len;
+
+	return len;
+}
+
+static struct downloader_parallel pd;
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static K_SEM_DEFINE(stopped_sem, 0, 1);
+static K_SEM_DEFINE(deinit_sem, 0, 1);
+static K_SEM_DEFINE(fragment_sem, 0, 1);
+
+static size_t received;
+static int errors;
+
+static int pd_callback(const struct downloader_evt *event)
+{
+	const uint8_t *data;
+
+	TEST_ASSERT(event != NULL);
+
+	switch (event->id) {
+	case DOWNLOADER_EVT_FRAGMENT:
+		/* Fragments must come in order */
+		data = event->fragment.buf;
+		for (size_t i = 0; i < event->fragment.len; i++) {
+			TEST_ASSERT_EQUAL_UINT8(file_byte(received + i), data[i]);
+		}
+		received += event->fragment.len;
+		k_sem_give(&fragment_sem);
+		break;
+	case DOWNLOADER_EVT_ERROR:
+		printk("error %d\n", event->error);
+		errors++;
+		break;
+	case DOWNLOADER_EVT_DONE:
+		k_sem_give(&done_sem);
+		break;
+	case DOWNLOADER_EVT_STOPPED:
+		k_sem_give(&stopped_sem);
+		break;
+	case DOWNLOADER_EVT_DEINITIALIZED:
+		k_sem_give(&deinit_sem);
+		break;
+	}
+
+	return 0;
+}
+
+static struct downloader_host_cfg host_cfg = {
+	.pdn_id = 1,
+};
+
+static void pd_init(uint8_t connections)
+{
+	int err;
+	struct downloader_parallel_cfg cfg = {
+		.callback = pd_callback,
+		.connections = connections,
+		.segment_size = SEGMENT_SIZE,
+	};
+
+	err = downloader_parallel_init(&pd, &cfg);
+	TEST_ASSERT_EQUAL(0, err);
+}
+
+static void pd_deinit(void)
+{
+	int err;
+
+	err = downloader_parallel_deinit(&pd);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(0, k_sem_take(&deinit_sem, K_SECONDS(1)));
+}
+
+/* Download the whole file and return the time it took in milliseconds */
+static int64_t pd_download(uint8_t connections, size_t from)
+{
+	int err;
+	size_t size;
+	int64_t start;
+	int64_t duration;
+
+	pd_init(connections);
+
+	received = from;
+	start = k_uptime_get();
+
+	err = downloader_parallel_get(&pd, &host_cfg, HTTP_URL, from);
+	TEST_ASSERT_EQUAL(0, err);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&done_sem, K_SECONDS(30)));
+	duration = k_uptime_get() - start;
+
+	TEST_ASSERT_EQUAL(FILE_SIZE, received);
+
+	err = downloader_parallel_file_size_get(&pd, &size);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(FILE_SIZE, size);
+
+	err = downloader_parallel_downloaded_size_get(&pd, &size);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(FILE_SIZE, size);
+
+	pd_deinit();
+
+	printk("%d connection(s): %d bytes in %lld ms, %lld bytes/s, %d requests\n", connections,
+	       FILE_SIZE - from, duration, ((FILE_SIZE - from) * MSEC_PER_SEC) / duration,
+	       server_requests);
+
+	return duration;
+}
+
+void test_downloader_parallel_init_einval(void)
+{
+	int err;
+	struct downloader_parallel_cfg cfg = {
+		.callback = pd_callback,
+	};
+	struct downloader_parallel_cfg cfg_no_cb = {};
+	struct downloader_parallel_cfg cfg_too_many = {
+		.callback = pd_callback,
+		.connections = CONFIG_DOWNLOADER_PARALLEL_CONNECTIONS + 1,
+	};
+
+	err = downloader_parallel_init(NULL, &cfg);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_init(&pd, NULL);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_init(&pd, &cfg_no_cb);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_init(&pd, &cfg_too_many);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+}
+
+void test_downloader_parallel_get_einval(void)
+{
+	int err;
+	struct downloader_host_cfg host_cfg_range_end = {
+		.range_end = 1024,
+	};
+
+	pd_init(0);
+
+	err = downloader_parallel_get(NULL, &host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_get(&pd, NULL, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_get(&pd, &host_cfg, NULL, 0);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_get(&pd, &host_cfg_range_end, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_parallel_cancel(&pd);
+	TEST_ASSERT_EQUAL(-EPERM, err);
+
+	pd_deinit();
+
+	err = downloader_parallel_get(&pd, &host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(-EPERM, err);
+}
+
+void test_downloader_parallel_get(void)
+{
+	pd_download(4, 0);
+
+	/* One request per segment, and each connection is kept for the next segment */
+	TEST_ASSERT_EQUAL(FILE_SIZE / SEGMENT_SIZE, server_requests);
+	TEST_ASSERT_EQUAL(4, server_sockets);
+	TEST_ASSERT_EQUAL(0, errors);
+}
+
+void test_downloader_parallel_get_resume(void)
+{
+	/* Resume in the middle of a segment */
+	pd_download(4, SEGMENT_SIZE + 100);
+
+	TEST_ASSERT_EQUAL(FILE_SIZE / SEGMENT_SIZE - 1, server_requests);
+	TEST_ASSERT_EQUAL(0, errors);
+}
+
+void test_downloader_parallel_get_reconnect(void)
+{
+	/* The peer closes a connection in the middle of a segment, the connection resumes
+	 * from where it was.
+	 */
+	server_close_after = SEGMENT_SIZE / 2;
+
+	pd_download(4, 0);
+
+	TEST_ASSERT_EQUAL(5, server_sockets);
+	TEST_ASSERT_EQUAL(FILE_SIZE / SEGMENT_SIZE + 1, server_requests);
+}
+
+void test_downloader_parallel_cancel(void)
+{
+	int err;
+
+	pd_init(4);
+
+	received = 0;
+
+	err = downloader_parallel_get(&pd, &host_cfg, HTTP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&fragment_sem, K_SECONDS(5)));
+
+	err = downloader_parallel_cancel(&pd);
+	TEST_ASSERT_EQUAL(0, err);
+
+	TEST_ASSERT_EQUAL(0, k_sem_take(&stopped_sem, K_SECONDS(5)));
+	TEST_ASSERT_EQUAL(-EBUSY, k_sem_take(&done_sem, K_NO_WAIT));
+	TEST_ASSERT(received < FILE_SIZE);
+
+	pd_deinit();
+}
+
+void test_downloader_parallel_throughput(void)
+{
+	int64_t sequential;
+	int64_t parallel;
+
+	sequential = pd_download(1, 0);
+
+	server_requests = 0;
+	parallel = pd_download(4, 0);
+
+	/* With the latency and rate of the link, four connections are at least twice as fast */
+	TEST_ASSERT_LESS_THAN(sequential / 2, parallel);
+}
+
+void setUp(void)
+{
+	RESET_FAKE(z_impl_zsock_setsockopt);
+	RESET_FAKE(z_impl_zsock_socket);
+	RESET_FAKE(z_impl_zsock_connect);
+	RESET_FAKE(z_impl_zsock_close);
+	RESET_FAKE(zsock_getaddrinfo);
+	RESET_FAKE(zsock_freeaddrinfo);
+	RESET_FAKE(z_impl_zsock_inet_pton);
+	RESET_FAKE(z_impl_net_addr_ntop);
+	RESET_FAKE(z_impl_zsock_sendto);
+	RESET_FAKE(z_impl_zsock_recvfrom);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	z_impl_net_addr_ntop_fake.custom_fake = z_impl_net_addr_ntop_ok;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_server;
+	z_impl_zsock_close_fake.custom_fake = z_impl_zsock_close_server;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_server;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_server;
+
+	memset(server, 0, sizeof(server));
+	server_close_after = 0;
+	server_sockets = 0;
+	server_requests = 0;
+	errors = 0;
+
+	k_sem_reset(&done_sem);
+	k_sem_reset(&stopped_sem);
+	k_sem_reset(&deinit_sem);
+	k_sem_reset(&fragment_sem);
+}
+
+void tearDown(void)
+{
+}
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
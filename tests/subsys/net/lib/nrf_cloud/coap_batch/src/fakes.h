@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_coap.h>
+#include "nrf_cloud_coap_transport.h"
+
+DEFINE_FFF_GLOBALS;
+
+int date_time_now(int64_t *unix_time_ms);
+
+FAKE_VALUE_FUNC(bool, nrf_cloud_coap_is_connected);
+FAKE_VALUE_FUNC(int, nrf_cloud_coap_post, const char *, const char *, const uint8_t *, size_t,
+		enum coap_content_format, bool, coap_client_response_cb_t, void *);
+FAKE_VALUE_FUNC(int, date_time_now, int64_t *);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_msg_init, struct nrf_cloud_obj *const, const char *const,
+		const char *const);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_num_add, struct nrf_cloud_obj *const, const char *const,
+		const double, const bool);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_str_add, struct nrf_cloud_obj *const, const char *const,
+		const char *const, const bool);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_ts_add, struct nrf_cloud_obj *const, const int64_t);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_gnss_msg_create, struct nrf_cloud_obj *const,
+		const struct nrf_cloud_gnss_data *const);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_cloud_encode, struct nrf_cloud_obj *const);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_cloud_encoded_free, struct nrf_cloud_obj *const);
+FAKE_VALUE_FUNC(int, nrf_cloud_obj_free, struct nrf_cloud_obj *const);
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include "fakes.h"
+
+#define PAYLOAD_MAX CONFIG_NRF_CLOUD_COAP_BATCH_PAYLOAD_MAX
+#define MAX_AGE	    K_SECONDS(CONFIG_NRF_CLOUD_COAP_BATCH_MAX_AGE_S)
+/* Time for the batch thread to run a flush that is due now */
+#define SETTLE	    K_MSEC(100)
+
+/* Length of the test messages. Four of them fit in a batch, and eight in the buffer. */
+#define MSG_LEN	     29
+#define MSG_COUNT    16
+#define BATCH_MSGS   4
+#define BUFFER_MSGS  8
+#define POSTS_MAX    8
+
+BUILD_ASSERT(MSG_LEN * BATCH_MSGS + BATCH_MSGS + 1 <= PAYLOAD_MAX);
+BUILD_ASSERT(MSG_LEN * (BATCH_MSGS + 1) + BATCH_MSGS + 2 > PAYLOAD_MAX);
+BUILD_ASSERT((2 + MSG_LEN) * BUFFER_MSGS <= CONFIG_NRF_CLOUD_COAP_BATCH_BUF_SIZE);
+BUILD_ASSERT((2 + MSG_LEN) * (BUFFER_MSGS + 1) > CONFIG_NRF_CLOUD_COAP_BATCH_BUF_SIZE);
+
+static char msgs[MSG_COUNT][MSG_LEN + 1];
+static char big_msg[PAYLOAD_MAX];
+
+/* The encoded message is the app ID, so that the tests choose the stored bytes */
+static const char *encoded_msg;
+
+static uint8_t posted[POSTS_MAX][PAYLOAD_MAX];
+static size_t posted_len[POSTS_MAX];
+static bool posted_bulk[POSTS_MAX];
+static int post_return;
+static int post_result;
+
+static int fake_msg_init__saves_app_id(struct nrf_cloud_obj *const obj, const char *const app_id,
+				       const char *const msg_type)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(msg_type);
+
+	encoded_msg = app_id;
+	return 0;
+}
+
+static int fake_cloud_encode__app_id(struct nrf_cloud_obj *const obj)
+{
+	obj->encoded_data.ptr = encoded_msg;
+	obj->encoded_data.len = strlen(encoded_msg);
+	obj->enc_src = NRF_CLOUD_ENC_SRC_CLOUD_ENCODED;
+	return 0;
+}
+
+static int fake_post__saves_payload(const char *resource, const char *query, const uint8_t *buf,
+				    size_t len, enum coap_content_format fmt, bool reliable,
+				    coap_client_response_cb_t cb, void *user)
+{
+	const struct coap_client_response_data data = {
+		.result_code = post_result,
+	};
+	size_t i = nrf_cloud_coap_post_fake.call_count - 1;
+
+	ARG_UNUSED(query);
+	ARG_UNUSED(reliable);
+
+	/* Called from the batch thread too, so the request is checked by the test */
+	if (i < POSTS_MAX) {
+		posted_bulk[i] = !strcmp(resource, COAP_D2C_BULK_RSC) &&
+				 fmt == COAP_CONTENT_FORMAT_APP_JSON;
+		posted_len[i] = MIN(len, PAYLOAD_MAX);
+		memcpy(posted[i], buf, posted_len[i]);
+	}
+
+	if (post_return) {
+		return post_return;
+	}
+
+	cb(&data, user);
+	return 0;
+}
+
+static int add(size_t i)
+{
+	return nrf_cloud_coap_batch_sensor_add(msgs[i], 0, 1);
+}
+
+/* Check that a request sent the JSON array of count messages from first */
+static void posted_check(size_t post, size_t first, size_t count)
+{
+	char expected[PAYLOAD_MAX + 1];
+	size_t len = 0;
+
+	zassert_true(post < nrf_cloud_coap_post_fake.call_count, "Request %zu not sent", post);
+	zassert_true(posted_bulk[post], "Request %zu not sent as JSON to the bulk resource", post);
+
+	expected[len++] = '[';
+	for (size_t i = first; i < first + count; i++) {
+		len += sprintf(&expected[len], "%s%s", msgs[i], i + 1 < first + count ? "," : "]");
+	}
+
+	zassert_equal(posted_len[post], len, "Request %zu: length %zu, expected %zu", post,
+		      posted_len[post], len);
+	zassert_mem_equal(posted[post], expected, len);
+}
+
+static void connected_set(bool connected)
+{
+	nrf_cloud_coap_is_connected_fake.return_val = connected;
+}
+
+static void *suite_setup(void)
+{
+	for (size_t i = 0; i < MSG_COUNT; i++) {
+		snprintf(msgs[i], sizeof(msgs[i]), "{\"appId\":\"TEMP\",\"data\":%05zu}", i);
+		zassert_equal(strlen(msgs[i]), MSG_LEN);
+	}
+
+	return NULL;
+}
+
+static void run_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(nrf_cloud_coap_is_connected);
+	RESET_FAKE(nrf_cloud_coap_post);
+	RESET_FAKE(date_time_now);
+	RESET_FAKE(nrf_cloud_obj_msg_init);
+	RESET_FAKE(nrf_cloud_obj_num_add);
+	RESET_FAKE(nrf_cloud_obj_str_add);
+	RESET_FAKE(nrf_cloud_obj_ts_add);
+	RESET_FAKE(nrf_cloud_obj_gnss_msg_create);
+	RESET_FAKE(nrf_cloud_obj_cloud_encode);
+	RESET_FAKE(nrf_cloud_obj_cloud_encoded_free);
+	RESET_FAKE(nrf_cloud_obj_free);
+	FFF_RESET_HISTORY();
+
+	nrf_cloud_obj_msg_init_fake.custom_fake = fake_msg_init__saves_app_id;
+	nrf_cloud_obj_cloud_encode_fake.custom_fake = fake_cloud_encode__app_id;
+	nrf_cloud_coap_post_fake.custom_fake = fake_post__saves_payload;
+	post_return = 0;
+	post_result = COAP_RESPONSE_CODE_CREATED;
+
+	/* Send what a previous test left, then start counting the requests again */
+	connected_set(true);
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	RESET_FAKE(nrf_cloud_coap_post);
+	nrf_cloud_coap_post_fake.custom_fake = fake_post__saves_payload;
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_array)
+{
+	connected_set(false);
+	zassert_ok(add(0));
+	connected_set(true);
+
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+	posted_check(0, 0, 1);
+
+	connected_set(false);
+	for (size_t i = 0; i < BATCH_MSGS; i++) {
+		zassert_ok(add(i));
+	}
+	connected_set(true);
+
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+	posted_check(1, 0, BATCH_MSGS);
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_largest_message)
+{
+	/* The message fills the payload with the brackets around it */
+	memset(big_msg, 'a', PAYLOAD_MAX - 1);
+	big_msg[PAYLOAD_MAX - 1] = '\0';
+	zassert_equal(nrf_cloud_coap_batch_sensor_add(big_msg, 0, 1), -E2BIG);
+
+	big_msg[PAYLOAD_MAX - 2] = '\0';
+	connected_set(false);
+	zassert_ok(nrf_cloud_coap_batch_sensor_add(big_msg, 0, 1));
+	connected_set(true);
+
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+	zassert_true(posted_bulk[0]);
+	zassert_equal(posted_len[0], PAYLOAD_MAX);
+	zassert_equal(posted[0][0], '[');
+	zassert_mem_equal(&posted[0][1], big_msg, PAYLOAD_MAX - 2);
+	zassert_equal(posted[0][PAYLOAD_MAX - 1], ']');
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_buffer_full_drops_oldest)
+{
+	connected_set(false);
+	for (size_t i = 0; i <= BUFFER_MSGS; i++) {
+		zassert_ok(add(i));
+	}
+	connected_set(true);
+
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+	posted_check(0, 1, BATCH_MSGS);
+	posted_check(1, 1 + BATCH_MSGS, BATCH_MSGS);
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_flush_scheduling)
+{
+	/* A message is sent when it reaches the maximum age */
+	zassert_ok(add(0));
+	k_sleep(SETTLE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 0);
+
+	k_sleep(MAX_AGE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+	posted_check(0, 0, 1);
+
+	/* A full batch is sent at once, the rest when it reaches the maximum age */
+	for (size_t i = 0; i <= BATCH_MSGS; i++) {
+		zassert_ok(add(i));
+	}
+	k_sleep(SETTLE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+	posted_check(1, 0, BATCH_MSGS);
+
+	k_sleep(MAX_AGE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 3);
+	posted_check(2, BATCH_MSGS, 1);
+
+	/* Messages are kept while disconnected, and sent when connected */
+	connected_set(false);
+	zassert_ok(add(0));
+	k_sleep(MAX_AGE);
+	k_sleep(SETTLE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 3);
+
+	connected_set(true);
+	nrf_cloud_coap_batch_connected();
+	k_sleep(SETTLE);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 4);
+	posted_check(3, 0, 1);
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_transport_error_retries)
+{
+	connected_set(false);
+	zassert_ok(add(0));
+	connected_set(true);
+
+	post_return = -ETIMEDOUT;
+	zassert_equal(nrf_cloud_coap_batch_flush(), -ETIMEDOUT);
+
+	/* A server error is retried as well */
+	post_return = 0;
+	post_result = COAP_RESPONSE_CODE_SERVICE_UNAVAILABLE;
+	zassert_equal(nrf_cloud_coap_batch_flush(), COAP_RESPONSE_CODE_SERVICE_UNAVAILABLE);
+
+	post_result = COAP_RESPONSE_CODE_CREATED;
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 3);
+	posted_check(0, 0, 1);
+	posted_check(1, 0, 1);
+	posted_check(2, 0, 1);
+}
+
+ZTEST(nrf_cloud_coap_batch_test, test_rejected_batch_dropped)
+{
+	connected_set(false);
+	zassert_ok(add(0));
+	connected_set(true);
+
+	post_result = COAP_RESPONSE_CODE_BAD_REQUEST;
+	zassert_equal(nrf_cloud_coap_batch_flush(), COAP_RESPONSE_CODE_BAD_REQUEST);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+
+	post_result = COAP_RESPONSE_CODE_CREATED;
+	zassert_ok(nrf_cloud_coap_batch_flush());
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+}
+
+ZTEST_SUITE(nrf_cloud_coap_batch_test, NULL, suite_setup, run_before, NULL, NULL);
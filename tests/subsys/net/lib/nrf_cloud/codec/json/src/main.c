@@ -17,8 +17,12 @@
  *   better validated through hardware-in-the-loop and system-level
  *   integration tests.
  *
- * Coverage: JSON object lifecycle, adders, getters, bulk operations, and
- * cloud encoding.  CBOR coverage is intentionally deferred to a separate
+ * Coverage: JSON object lifecycle, adders, getters, bulk operations,
+ * cloud encoding, the streaming JSON writer (nrf_cloud_json_writer.h) and
+ * the in-place JSON reader (nrf_cloud_json_reader.h), which are compared
+ * with cJSON.  The location requests of the writer and cJSON encoders are
+ * compared in codec/location/, which links nrf_cloud_codec_internal.c.
+ * CBOR coverage is intentionally deferred to a separate
  * suite (codec/cbor/) which exercises the internal coap_codec.h layer.
  *
  * No mocks are used: cJSON is a pure heap-based library with no
@@ -31,6 +35,8 @@
 #include <net/nrf_cloud_codec.h>
 #include <net/nrf_cloud_defs.h>
 #include <cJSON.h>
+#include <nrf_cloud_json_reader.h>
+#include <nrf_cloud_json_writer.h>
 #include <math.h>
 #include <stdint.h>
 #include <string.h>
@@ -1002,3 +1008,321 @@ ZTEST(nrf_cloud_codec_encode, test_obj_cloud_encoded_free_not_encoded)
 	zassert_equal(nrf_cloud_obj_cloud_encoded_free(&obj), -EACCES);
 	nrf_cloud_obj_free(&obj);
 }
+
+/*
+ * SUITE: nrf_cloud_json_writer
+ * Tests for the streaming JSON writer. The output must be identical to
+ * cJSON_PrintUnformatted for the same document.
+ */
+
+ZTEST_SUITE(nrf_cloud_json_writer, NULL, NULL, NULL, NULL, NULL);
+
+static char writer_buf[256];
+
+struct flush_ctx {
+	char out[256];
+	size_t len;
+	int calls;
+};
+
+static int flush_to_ctx(const char *buf, size_t len, void *ctx)
+{
+	struct flush_ctx *f = ctx;
+
+	zassert_true(f->len + len < sizeof(f->out));
+	memcpy(f->out + f->len, buf, len);
+	f->len += len;
+	f->out[f->len] = '\0';
+	f->calls++;
+
+	return 0;
+}
+
+static void writer_doc_write(struct nrf_cloud_json_writer *w)
+{
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, "str", "a\"b\\c\n\t\x01");
+	nrf_cloud_json_int_add(w, "int", -42);
+	nrf_cloud_json_int_add(w, "ts", 1700000000123LL);
+	nrf_cloud_json_num_add(w, "num", -10.5);
+	nrf_cloud_json_num_add(w, "pi", 3.14159);
+	nrf_cloud_json_num_add(w, "nan", NAN);
+	nrf_cloud_json_bool_add(w, "t", true);
+	nrf_cloud_json_array_start(w, "arr");
+	nrf_cloud_json_int_add(w, NULL, 1);
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_bool_add(w, "f", false);
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_array_start(w, NULL);
+	nrf_cloud_json_array_end(w);
+	nrf_cloud_json_array_end(w);
+	nrf_cloud_json_obj_start(w, "empty");
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_obj_end(w);
+}
+
+static char *writer_doc_cjson_print(void)
+{
+	cJSON *root = cJSON_CreateObject();
+	cJSON *arr;
+	cJSON *item;
+	char *out;
+
+	cJSON_AddStringToObject(root, "str", "a\"b\\c\n\t\x01");
+	cJSON_AddNumberToObject(root, "int", -42);
+	cJSON_AddNumberToObject(root, "ts", 1700000000123LL);
+	cJSON_AddNumberToObject(root, "num", -10.5);
+	cJSON_AddNumberToObject(root, "pi", 3.14159);
+	cJSON_AddNumberToObject(root, "nan", NAN);
+	cJSON_AddBoolToObject(root, "t", true);
+	arr = cJSON_AddArrayToObject(root, "arr");
+	cJSON_AddItemToArray(arr, cJSON_CreateNumber(1));
+	item = cJSON_CreateObject();
+	cJSON_AddBoolToObject(item, "f", false);
+	cJSON_AddItemToArray(arr, item);
+	cJSON_AddItemToArray(arr, cJSON_CreateArray());
+	cJSON_AddObjectToObject(root, "empty");
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_matches_cjson)
+{
+	struct nrf_cloud_json_writer w;
+	char *expected = writer_doc_cjson_print();
+	int len;
+
+	zassert_not_null(expected);
+
+	nrf_cloud_json_writer_init(&w, writer_buf, sizeof(writer_buf), NULL, NULL);
+	writer_doc_write(&w);
+	len = nrf_cloud_json_writer_finish(&w);
+
+	zassert_equal(len, strlen(expected));
+	zassert_str_equal(writer_buf, expected);
+	cJSON_free(expected);
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_count_only)
+{
+	struct nrf_cloud_json_writer w;
+	int len;
+
+	nrf_cloud_json_writer_init(&w, writer_buf, sizeof(writer_buf), NULL, NULL);
+	writer_doc_write(&w);
+	len = nrf_cloud_json_writer_finish(&w);
+	zassert_true(len > 0);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0, NULL, NULL);
+	writer_doc_write(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), len);
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_flush)
+{
+	static struct flush_ctx f;
+	struct nrf_cloud_json_writer w;
+	char small[8];
+	int len;
+
+	memset(&f, 0, sizeof(f));
+
+	nrf_cloud_json_writer_init(&w, writer_buf, sizeof(writer_buf), NULL, NULL);
+	writer_doc_write(&w);
+	len = nrf_cloud_json_writer_finish(&w);
+
+	nrf_cloud_json_writer_init(&w, small, sizeof(small), flush_to_ctx, &f);
+	writer_doc_write(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), len);
+	zassert_equal(f.len, len);
+	zassert_true(f.calls > 1);
+	zassert_str_equal(f.out, writer_buf);
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_buffer_too_small)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, writer_buf, 16, NULL, NULL);
+	writer_doc_write(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -ENOMEM);
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_unbalanced)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, writer_buf, sizeof(writer_buf), NULL, NULL);
+	nrf_cloud_json_obj_start(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, writer_buf, sizeof(writer_buf), NULL, NULL);
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+ZTEST(nrf_cloud_json_writer, test_writer_init_invalid)
+{
+	struct nrf_cloud_json_writer w;
+
+	nrf_cloud_json_writer_init(&w, writer_buf, 1, NULL, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0, flush_to_ctx, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+/*
+ * SUITE: nrf_cloud_json_reader
+ * Tests for the in-place JSON tokenizer. Values must be read the same way
+ * as cJSON reads them.
+ */
+
+ZTEST_SUITE(nrf_cloud_json_reader, NULL, NULL, NULL, NULL, NULL);
+
+static struct nrf_cloud_json_tok reader_toks[32];
+
+static const char reader_doc[] =
+	"{\"appId\":\"GROUND\\u005fFIX\",\"arr\":[1,{\"x\":[2,3]},\"z\"],"
+	"\"data\":{\"lat\":45.52,\"unc\":3000000000,\"s\":\"\\u00e9\\n\\\"\"},"
+	"\"n\":null,\"ts\":1700000000123}";
+
+static int reader_tokenize(const char *js)
+{
+	return nrf_cloud_json_tokenize(js, strlen(js), reader_toks, ARRAY_SIZE(reader_toks));
+}
+
+ZTEST(nrf_cloud_json_reader, test_tokenize_valid)
+{
+	zassert_equal(reader_tokenize("{}"), 1);
+	zassert_equal(reader_tokenize(" [ ] "), 1);
+	zassert_equal(reader_tokenize("null"), 1);
+	zassert_equal(reader_tokenize("{\"a\":{},\"b\":[[],{}]}"), 7);
+	zassert_equal(reader_toks[0].size, 2);
+	zassert_equal(reader_toks[4].size, 2);
+}
+
+ZTEST(nrf_cloud_json_reader, test_tokenize_invalid)
+{
+	const char *const invalid[] = {
+		"", "{", "{\"a\"}", "{\"a\":1,}", "[1,]", "[1 2]", "{\"a\":tru}", "\"x",
+		"[1]]", "{\"a\":1]", "\"\\x\"", "{1:2}", "[\"\\u12\"]", "1 2",
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		zassert_equal(reader_tokenize(invalid[i]), -EBADMSG, "%s", invalid[i]);
+	}
+}
+
+ZTEST(nrf_cloud_json_reader, test_tokenize_too_many_tokens)
+{
+	zassert_equal(nrf_cloud_json_tokenize(reader_doc, strlen(reader_doc), reader_toks, 8),
+		      -E2BIG);
+}
+
+ZTEST(nrf_cloud_json_reader, test_obj_and_array_get)
+{
+	int count = reader_tokenize(reader_doc);
+	int arr;
+	int item;
+
+	zassert_true(count > 0);
+
+	zassert_true(nrf_cloud_json_tok_str_eq(
+		reader_doc, &reader_toks[nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count,
+								     0, "appId")],
+		"GROUND_FIX"));
+	zassert_equal(nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "missing"),
+		      -ENOENT);
+
+	arr = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "arr");
+	zassert_equal(nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, arr, "x"),
+		      -EINVAL);
+
+	item = nrf_cloud_json_tok_array_get(reader_toks, count, arr, 2);
+	zassert_true(nrf_cloud_json_tok_str_eq(reader_doc, &reader_toks[item], "z"));
+	zassert_equal(nrf_cloud_json_tok_array_get(reader_toks, count, arr, 3), -ENOENT);
+
+	item = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "n");
+	zassert_true(nrf_cloud_json_tok_is_null(reader_doc, &reader_toks[item]));
+}
+
+ZTEST(nrf_cloud_json_reader, test_values_match_cjson)
+{
+	cJSON *root = cJSON_Parse(reader_doc);
+	cJSON *data = cJSON_GetObjectItem(root, "data");
+	int count = reader_tokenize(reader_doc);
+	int data_tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "data");
+	int tok;
+	double num;
+	int val;
+	char str[16];
+
+	zassert_not_null(data);
+	zassert_true(data_tok > 0);
+
+	tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, data_tok, "lat");
+	zassert_ok(nrf_cloud_json_tok_num(reader_doc, &reader_toks[tok], &num));
+	zassert_equal(num, cJSON_GetObjectItem(data, "lat")->valuedouble);
+
+	tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, data_tok, "unc");
+	zassert_ok(nrf_cloud_json_tok_int(reader_doc, &reader_toks[tok], &val));
+	zassert_equal(val, cJSON_GetObjectItem(data, "unc")->valueint);
+
+	tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, data_tok, "s");
+	zassert_equal(nrf_cloud_json_tok_str_copy(reader_doc, &reader_toks[tok], str, sizeof(str)),
+		      strlen(cJSON_GetObjectItem(data, "s")->valuestring));
+	zassert_str_equal(str, cJSON_GetObjectItem(data, "s")->valuestring);
+	zassert_equal(nrf_cloud_json_tok_str_copy(reader_doc, &reader_toks[tok], str, 4),
+		      -ENOBUFS);
+
+	tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "ts");
+	zassert_ok(nrf_cloud_json_tok_num(reader_doc, &reader_toks[tok], &num));
+	zassert_equal((int64_t)num, 1700000000123LL);
+
+	tok = nrf_cloud_json_tok_obj_get(reader_doc, reader_toks, count, 0, "appId");
+	zassert_equal(nrf_cloud_json_tok_num(reader_doc, &reader_toks[tok], &num), -EINVAL);
+
+	cJSON_Delete(root);
+}
+
+ZTEST(nrf_cloud_json_reader, test_num_grammar)
+{
+	const char *const invalid[] = {
+		"0x1F", "-nan", "-inf", "01", "-01", "00", "1.", "1.e3", "-", "1e", "1e+", "-.5",
+	};
+	const char *const out_of_range[] = {"1e999", "-1e999"};
+	double num;
+	int val;
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		zassert_equal(reader_tokenize(invalid[i]), 1, "%s", invalid[i]);
+		zassert_equal(nrf_cloud_json_tok_num(invalid[i], &reader_toks[0], &num), -EINVAL,
+			      "%s", invalid[i]);
+		zassert_equal(nrf_cloud_json_tok_int(invalid[i], &reader_toks[0], &val), -EINVAL,
+			      "%s", invalid[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(out_of_range); i++) {
+		zassert_equal(reader_tokenize(out_of_range[i]), 1);
+		zassert_equal(nrf_cloud_json_tok_num(out_of_range[i], &reader_toks[0], &num),
+			      -ERANGE, "%s", out_of_range[i]);
+		zassert_equal(nrf_cloud_json_tok_int(out_of_range[i], &reader_toks[0], &val),
+			      -ERANGE, "%s", out_of_range[i]);
+	}
+
+	zassert_equal(reader_tokenize("-12.25e-3"), 1);
+	zassert_ok(nrf_cloud_json_tok_num("-12.25e-3", &reader_toks[0], &num));
+	zassert_equal(num, -12.25e-3);
+
+	zassert_equal(reader_tokenize("1E+2"), 1);
+	zassert_ok(nrf_cloud_json_tok_int("1E+2", &reader_toks[0], &val));
+	zassert_equal(val, 100);
+
+	zassert_equal(reader_tokenize("-0"), 1);
+	zassert_ok(nrf_cloud_json_tok_int("-0", &reader_toks[0], &val));
+	zassert_equal(val, 0);
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Memory wrapper fakes (mirrors of nrf_cloud_mem.c).
+ *
+ * The Zephyr kernel heap is not available in this minimal test configuration, so the
+ * nrf_cloud_calloc / nrf_cloud_free / nrf_cloud_malloc wrappers used by the codecs are
+ * thin wrappers around the standard C library allocator, which cJSON uses by default.
+ */
+
+#include <stdlib.h>
+#include <nrf_cloud_mem.h>
+
+void *nrf_cloud_calloc(size_t count, size_t size)
+{
+	return calloc(count, size);
+}
+
+void *nrf_cloud_malloc(size_t size)
+{
+	return malloc(size);
+}
+
+void nrf_cloud_free(void *ptr)
+{
+	free(ptr);
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Tests that the location request written with the streaming JSON writer
+ * (nrf_cloud_location_req_json_write) is the same, byte for byte, as the
+ * unformatted output of the cJSON request
+ * (nrf_cloud_obj_location_request_create_timestamped), and that both
+ * encoders reject the same inputs with the same error.
+ *
+ * The writer is run the way nrf_cloud_location_request() runs it: a counting
+ * pass sizes the message, then the message is written to a buffer of that size.
+ */
+
+#include <zephyr/ztest.h>
+#include <cJSON.h>
+#include <modem/lte_lc.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_location.h>
+#include <net/wifi_location_common.h>
+#include <nrf_cloud_codec_internal.h>
+#include <nrf_cloud_json_writer.h>
+#include <string.h>
+
+#define NCELLS		3
+#define GCI_CELLS	2
+#define WIFI_APS	4
+#define OUT_SIZE	1024
+
+#define TIMESTAMP	1700000000123LL
+
+static struct lte_lc_ncell ncells[NCELLS];
+static struct lte_lc_cell gci_cells[GCI_CELLS];
+static struct lte_lc_cells_info cells;
+static struct wifi_scan_result aps[WIFI_APS];
+static struct wifi_scan_info wifi;
+
+static char out[OUT_SIZE];
+
+/* Encodes the request with both encoders and checks that the outputs are the same */
+static void location_req_compare(const struct lte_lc_cells_info *const cells_inf,
+				 const struct wifi_scan_info *const wifi_inf,
+				 const struct nrf_cloud_location_config *const config,
+				 const int64_t timestamp)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	struct nrf_cloud_json_writer w;
+	char *expected;
+	int len;
+
+	zassert_ok(nrf_cloud_obj_location_request_create_timestamped(&obj, cells_inf, wifi_inf,
+								     config, timestamp));
+	expected = cJSON_PrintUnformatted(obj.json);
+	zassert_not_null(expected);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0, NULL, NULL);
+	zassert_ok(nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config, timestamp));
+	len = nrf_cloud_json_writer_finish(&w);
+	zassert_equal(len, strlen(expected), "Counted %d bytes, cJSON printed %zu", len,
+		      strlen(expected));
+	zassert_true(len < sizeof(out));
+
+	nrf_cloud_json_writer_init(&w, out, len + 1, NULL, NULL);
+	zassert_ok(nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, config, timestamp));
+	zassert_equal(nrf_cloud_json_writer_finish(&w), len);
+	zassert_str_equal(out, expected, "Writer output differs from cJSON");
+
+	cJSON_free(expected);
+	(void)nrf_cloud_obj_free(&obj);
+}
+
+/* Checks that both encoders fail with the expected error, without writing anything */
+static void location_req_error_compare(const struct lte_lc_cells_info *const cells_inf,
+				       const struct wifi_scan_info *const wifi_inf,
+				       const int expected_err)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(obj);
+	struct nrf_cloud_json_writer w;
+
+	/* The object is freed by the encoder on error */
+	zassert_equal(nrf_cloud_obj_location_request_create_timestamped(&obj, cells_inf,
+									 wifi_inf, NULL, 0),
+		      expected_err);
+	zassert_is_null(obj.json);
+
+	nrf_cloud_json_writer_init(&w, NULL, 0, NULL, NULL);
+	zassert_equal(nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, NULL, 0),
+		      expected_err);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), 0);
+
+	nrf_cloud_json_writer_init(&w, out, sizeof(out), NULL, NULL);
+	zassert_equal(nrf_cloud_location_req_json_write(&w, cells_inf, wifi_inf, NULL, 0),
+		      expected_err);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), 0);
+	zassert_str_equal(out, "");
+}
+
+static void location_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	cells = (struct lte_lc_cells_info){
+		.current_cell = {
+			.mcc = 242, .mnc = 1, .id = 0x1234567, .tac = 0x3039, .earfcn = 6300,
+			.timing_advance = 80, .phys_cell_id = 7, .rsrp = 40, .rsrq = 12,
+		},
+		.ncells_count = NCELLS,
+		.neighbor_cells = ncells,
+		.gci_cells_count = GCI_CELLS,
+		.gci_cells = gci_cells,
+	};
+
+	for (int i = 0; i < NCELLS; i++) {
+		/* Odd RSRQ indexes are fractional dB values */
+		ncells[i] = (struct lte_lc_ncell){
+			.earfcn = 6300 + i, .time_diff = i * 10, .phys_cell_id = i,
+			.rsrp = 20 + i, .rsrq = i - 5,
+		};
+	}
+
+	for (int i = 0; i < GCI_CELLS; i++) {
+		gci_cells[i] = (struct lte_lc_cell){
+			.mcc = 242, .mnc = 2, .id = 0x100000 + i, .tac = 0x1000 + i,
+			.earfcn = 1300 + i, .timing_advance = 100 + i, .rsrp = 30 + i, .rsrq = 10,
+		};
+	}
+
+	for (int i = 0; i < WIFI_APS; i++) {
+		aps[i] = (struct wifi_scan_result){
+			.channel = 1 + i, .rssi = -40 - i, .mac_length = WIFI_MAC_ADDR_LEN,
+			.mac = {0x10, 0x20, 0x30, 0x40, 0x50, i},
+		};
+		aps[i].ssid_length = snprintk((char *)aps[i].ssid, sizeof(aps[i].ssid), "ap_%d", i);
+	}
+
+	wifi = (struct wifi_scan_info){.ap_info = aps, .cnt = WIFI_APS};
+
+	memset(out, 0, sizeof(out));
+}
+
+ZTEST_SUITE(nrf_cloud_location_req, NULL, NULL, location_before, NULL, NULL);
+
+ZTEST(nrf_cloud_location_req, test_cell)
+{
+	location_req_compare(&cells, NULL, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_current_only)
+{
+	cells.ncells_count = 0;
+	cells.gci_cells_count = 0;
+
+	location_req_compare(&cells, NULL, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_gci_only)
+{
+	/* With a GCI search there is sometimes no current cell */
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+
+	location_req_compare(&cells, NULL, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_optional_omitted)
+{
+	cells.current_cell.earfcn = NRF_CLOUD_LOCATION_CELL_OMIT_EARFCN;
+	cells.current_cell.rsrp = NRF_CLOUD_LOCATION_CELL_OMIT_RSRP;
+	cells.current_cell.rsrq = NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ;
+	cells.current_cell.timing_advance = NRF_CLOUD_LOCATION_CELL_OMIT_TIME_ADV;
+	ncells[0].rsrp = NRF_CLOUD_LOCATION_CELL_OMIT_RSRP;
+	ncells[0].rsrq = NRF_CLOUD_LOCATION_CELL_OMIT_RSRQ;
+	ncells[0].time_diff = LTE_LC_CELL_TIME_DIFF_INVALID;
+
+	/* Clamped to the maximum by both encoders */
+	gci_cells[0].timing_advance = NRF_CLOUD_LOCATION_CELL_TIME_ADV_MAX + 1;
+
+	location_req_compare(&cells, NULL, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_wifi)
+{
+	location_req_compare(NULL, &wifi, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_wifi_local_mac_skipped)
+{
+	/* Locally administered and reserved IANA unicast addresses */
+	aps[0].mac[0] = 0x02;
+	aps[1].mac[0] = 0x00;
+	aps[1].mac[1] = 0x00;
+	aps[1].mac[2] = 0x5E;
+
+	location_req_compare(NULL, &wifi, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_and_wifi)
+{
+	location_req_compare(&cells, &wifi, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_without_data_and_wifi)
+{
+	/* The cellular data is excluded from the request */
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	cells.gci_cells_count = 0;
+
+	location_req_compare(&cells, &wifi, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_and_wifi_without_data)
+{
+	/* The Wi-Fi data is excluded from the request */
+	for (int i = 1; i < WIFI_APS; i++) {
+		aps[i].mac[0] = 0x02;
+	}
+
+	location_req_compare(&cells, &wifi, NULL, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_config)
+{
+	struct nrf_cloud_location_config config = {
+		.do_reply = NRF_CLOUD_LOCATION_DOREPLY_DEFAULT,
+		.hi_conf = NRF_CLOUD_LOCATION_HICONF_DEFAULT,
+		.fallback = NRF_CLOUD_LOCATION_FALLBACK_DEFAULT,
+	};
+
+	/* Only the values that differ from the defaults are added */
+	location_req_compare(&cells, &wifi, &config, 0);
+
+	config.hi_conf = !NRF_CLOUD_LOCATION_HICONF_DEFAULT;
+	location_req_compare(&cells, &wifi, &config, 0);
+
+	config.do_reply = !NRF_CLOUD_LOCATION_DOREPLY_DEFAULT;
+	config.fallback = !NRF_CLOUD_LOCATION_FALLBACK_DEFAULT;
+	location_req_compare(&cells, &wifi, &config, 0);
+}
+
+ZTEST(nrf_cloud_location_req, test_timestamp)
+{
+	location_req_compare(&cells, &wifi, NULL, TIMESTAMP);
+}
+
+ZTEST(nrf_cloud_location_req, test_no_input)
+{
+	location_req_error_compare(NULL, NULL, -EINVAL);
+}
+
+ZTEST(nrf_cloud_location_req, test_cell_without_data)
+{
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	cells.gci_cells_count = 0;
+
+	location_req_error_compare(&cells, NULL, -ENODATA);
+}
+
+ZTEST(nrf_cloud_location_req, test_wifi_too_few_aps)
+{
+	wifi.cnt = NRF_CLOUD_LOCATION_WIFI_AP_CNT_MIN - 1;
+
+	location_req_error_compare(NULL, &wifi, -EDOM);
+}
+
+ZTEST(nrf_cloud_location_req, test_wifi_without_data)
+{
+	for (int i = 1; i < WIFI_APS; i++) {
+		aps[i].mac[0] = 0x02;
+	}
+
+	location_req_error_compare(NULL, &wifi, -ENODATA);
+}
+
+ZTEST(nrf_cloud_location_req, test_no_data)
+{
+	cells.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+	cells.gci_cells_count = 0;
+	wifi.cnt = 1;
+
+	location_req_error_compare(&cells, &wifi, -ENODATA);
+}
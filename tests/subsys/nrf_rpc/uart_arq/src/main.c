@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <nrf_rpc/nrf_rpc_uart.h>
+
+#define UART0 DT_NODELABEL(rpc_uart0)
+
+#define ACK_TIME	CONFIG_NRF_RPC_UART_ACK_WAITING_TIME
+#define SEQ_MASK	0x7fu
+#define SEQ_SYNC	0x80u
+#define FRAME_MAX	16
+#define DELIVERED_MAX	16
+
+/* Frame sent by the transport, with the delimiters and escaping removed */
+struct frame {
+	uint8_t data[FRAME_MAX];
+	size_t len;
+};
+
+static const struct device *const uart = DEVICE_DT_GET(UART0);
+static const struct nrf_rpc_tr *const tr = &NRF_RPC_UART_TRANSPORT(UART0);
+
+static struct frame rx_frame;
+static bool rx_escape;
+
+/* The first byte of each packet passed to nRF RPC */
+static uint8_t delivered[DELIVERED_MAX];
+static size_t delivered_count;
+
+/* Sequence number of the next frame sent by the transport, once the reset is acknowledged */
+static uint8_t tx_seq;
+static bool tx_ready;
+static uint32_t tx_resets;
+static uint32_t tx_frames_before_reset_ack;
+
+static void receive_cb(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t len,
+		       void *context)
+{
+	if (len == 1 && delivered_count < DELIVERED_MAX) {
+		delivered[delivered_count] = data[0];
+	}
+
+	delivered_count++;
+}
+
+static void peer_write(const uint8_t *data, size_t len)
+{
+	uint8_t buf[2 * FRAME_MAX + 2];
+	size_t n = 0;
+
+	buf[n++] = 0x7e;
+
+	for (size_t i = 0; i < len; i++) {
+		if (data[i] == 0x7e || data[i] == 0x7d) {
+			buf[n++] = 0x7d;
+			buf[n++] = data[i] ^ 0x20;
+		} else {
+			buf[n++] = data[i];
+		}
+	}
+
+	buf[n++] = 0x7e;
+
+	zassert_equal(uart_emul_put_rx_data(uart, buf, n), n);
+}
+
+/* Frame with a one byte packet, or a reset without a packet */
+static void peer_send(uint8_t seq_byte, const uint8_t *packet, size_t len)
+{
+	uint8_t frame[FRAME_MAX];
+	uint16_t crc = crc16_ccitt(0xffff, packet, len);
+
+	frame[0] = seq_byte;
+
+	if (len > 0) {
+		memcpy(frame + 1, packet, len);
+	}
+
+	sys_put_le16(crc16_ccitt(crc, frame, 1), frame + 1 + len);
+
+	peer_write(frame, len + 1 + sizeof(crc));
+}
+
+static void peer_send_packet(uint8_t seq_byte, uint8_t id)
+{
+	peer_send(seq_byte, &id, 1);
+}
+
+static void peer_ack(uint8_t seq_byte)
+{
+	uint8_t ack[] = {seq_byte, ~seq_byte};
+
+	peer_write(ack, sizeof(ack));
+}
+
+/* Reads the next frame sent by the transport */
+static bool peer_read(struct frame *frame, int64_t timeout_ms)
+{
+	int64_t end = k_uptime_get() + timeout_ms;
+	uint8_t byte;
+
+	do {
+		while (uart_emul_get_tx_data(uart, &byte, 1) == 1) {
+			if (byte == 0x7e) {
+				if (rx_frame.len > 0) {
+					*frame = rx_frame;
+					rx_frame.len = 0;
+					return true;
+				}
+				continue;
+			} else if (byte == 0x7d) {
+				rx_escape = true;
+				continue;
+			}
+
+			zassert_true(rx_frame.len < FRAME_MAX, "Frame too long");
+			rx_frame.data[rx_frame.len++] = rx_escape ? byte ^ 0x20 : byte;
+			rx_escape = false;
+		}
+
+		k_sleep(K_MSEC(1));
+	} while (k_uptime_get() < end);
+
+	return false;
+}
+
+static bool frame_is_ack(const struct frame *frame)
+{
+	return frame->len == 2 && frame->data[1] == (uint8_t)~frame->data[0];
+}
+
+static void frame_check(const struct frame *frame, uint8_t seq_byte, const uint8_t *packet,
+			size_t len)
+{
+	uint16_t crc = crc16_ccitt(0xffff, packet, len);
+
+	zassert_equal(frame->len, len + 3, "Frame of %zu bytes", frame->len);
+	zassert_equal(frame->data[0], seq_byte, "Frame %02x instead of %02x", frame->data[0],
+		      seq_byte);
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(frame->data[1 + i], packet[i]);
+	}
+
+	zassert_equal(sys_get_le16(frame->data + 1 + len), crc16_ccitt(crc, frame->data, 1));
+}
+
+static void expect_frame(uint8_t seq_byte, uint8_t id)
+{
+	struct frame frame;
+
+	zassert_true(peer_read(&frame, 2 * ACK_TIME), "No frame %02x", seq_byte);
+	frame_check(&frame, seq_byte, &id, 1);
+}
+
+/* Acknowledgments of several frames may be sent in any order */
+static void expect_acks(const uint8_t *seq_bytes, size_t count)
+{
+	uint32_t pending = BIT_MASK(count);
+	struct frame frame;
+
+	while (pending != 0) {
+		size_t i;
+
+		zassert_true(peer_read(&frame, ACK_TIME), "Acknowledgments %x missing", pending);
+		zassert_true(frame_is_ack(&frame), "Not an acknowledgment");
+
+		for (i = 0; i < count; i++) {
+			if ((pending & BIT(i)) && frame.data[0] == seq_bytes[i]) {
+				break;
+			}
+		}
+
+		zassert_true(i < count, "Unexpected acknowledgment %02x", frame.data[0]);
+		pending &= ~BIT(i);
+	}
+}
+
+static void expect_ack(uint8_t seq_byte)
+{
+	expect_acks(&seq_byte, 1);
+}
+
+static void expect_silence(int64_t timeout_ms)
+{
+	struct frame frame;
+
+	zassert_false(peer_read(&frame, timeout_ms), "Unexpected frame %02x", frame.data[0]);
+}
+
+/* Checks the packets passed to nRF RPC since the last check, in order */
+static void expect_delivered(const uint8_t *ids, size_t count)
+{
+	int64_t end = k_uptime_get() + ACK_TIME;
+
+	while (delivered_count < count && k_uptime_get() < end) {
+		k_sleep(K_MSEC(1));
+	}
+
+	k_sleep(K_MSEC(2));
+
+	zassert_equal(delivered_count, count, "%zu packets delivered instead of %zu",
+		      delivered_count, count);
+
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(delivered[i], ids[i], "Packet %02x instead of %02x", delivered[i],
+			      ids[i]);
+	}
+
+	delivered_count = 0;
+}
+
+static void peer_reset(uint8_t seq)
+{
+	peer_send(seq | SEQ_SYNC, NULL, 0);
+	expect_ack(seq | SEQ_SYNC);
+}
+
+static void tx_packet(uint8_t id)
+{
+	size_t size = 1;
+	uint8_t *buf = tr->api->tx_buf_alloc(tr, &size);
+
+	buf[0] = id;
+	zassert_ok(tr->api->send(tr, buf, 1));
+}
+
+/* The transport starts with a reset, which must be acknowledged before anything else is sent */
+static void tx_handshake(void)
+{
+	struct frame frame;
+	uint8_t reset;
+
+	if (tx_ready) {
+		return;
+	}
+
+	zassert_true(peer_read(&frame, 2 * ACK_TIME), "No reset");
+	frame_check(&frame, frame.data[0], NULL, 0);
+	zassert_true(frame.data[0] & SEQ_SYNC);
+	reset = frame.data[0];
+	tx_resets++;
+
+	tx_packet(0xa0);
+
+	/* The reset was lost, the packet waits */
+	while (tx_resets < 3 && peer_read(&frame, 2 * ACK_TIME)) {
+		if (frame.len == 3 && frame.data[0] == reset) {
+			tx_resets++;
+		} else {
+			tx_frames_before_reset_ack++;
+		}
+	}
+
+	/* An acknowledgment of another reset is ignored */
+	peer_ack(((reset + 1) & SEQ_MASK) | SEQ_SYNC);
+	zassert_true(peer_read(&frame, 2 * ACK_TIME));
+	zassert_equal(frame.data[0], reset, "Reset not sent again");
+
+	peer_ack(reset);
+
+	tx_seq = reset & SEQ_MASK;
+	expect_frame(tx_seq, 0xa0);
+	peer_ack(tx_seq);
+	tx_seq = (tx_seq + 1) & SEQ_MASK;
+
+	expect_silence(2 * ACK_TIME);
+	tx_ready = true;
+}
+
+static void *suite_setup(void)
+{
+	zassert_ok(tr->api->init(tr, receive_cb, NULL));
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	tx_handshake();
+	delivered_count = 0;
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_tx_reset)
+{
+	zassert_true(tx_resets >= 3, "Reset sent %u times", tx_resets);
+	zassert_equal(tx_frames_before_reset_ack, 0);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_tx_loss)
+{
+	uint8_t seq = tx_seq;
+	uint8_t next = (seq + 1) & SEQ_MASK;
+	uint8_t last = (seq + 2) & SEQ_MASK;
+
+	tx_packet(0x10);
+	tx_packet(0x11);
+	tx_packet(0x12);
+
+	expect_frame(seq, 0x10);
+	expect_frame(next, 0x11);
+	expect_frame(last, 0x12);
+
+	/* Only the frame whose acknowledgment is missing is sent again */
+	peer_ack(last);
+	peer_ack(seq);
+	expect_frame(next, 0x11);
+	peer_ack(next);
+
+	expect_silence(2 * ACK_TIME);
+	tx_seq = (seq + 3) & SEQ_MASK;
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_tx_drop)
+{
+	uint8_t seq = tx_seq;
+	uint8_t next = (seq + 1) & SEQ_MASK;
+
+	tx_packet(0x20);
+
+	for (int i = 0; i < CONFIG_NRF_RPC_UART_TX_ATTEMPTS; i++) {
+		expect_frame(seq, 0x20);
+	}
+
+	/* Dropped after the last attempt, the next frame tells the peer to skip it */
+	expect_silence(2 * ACK_TIME);
+	tx_packet(0x21);
+	expect_frame(next | SEQ_SYNC, 0x21);
+
+	/* The flag stays in the frame when it is sent again */
+	expect_frame(next | SEQ_SYNC, 0x21);
+	peer_ack(next);
+
+	tx_packet(0x22);
+	expect_frame((seq + 2) & SEQ_MASK, 0x22);
+	peer_ack((seq + 2) & SEQ_MASK);
+
+	expect_silence(2 * ACK_TIME);
+	tx_seq = (seq + 3) & SEQ_MASK;
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_in_order)
+{
+	peer_reset(10);
+	peer_send_packet(10, 0x01);
+	peer_send_packet(11, 0x02);
+
+	expect_acks((uint8_t[]){10, 11}, 2);
+	expect_delivered((uint8_t[]){0x01, 0x02}, 2);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_loss)
+{
+	peer_reset(20);
+	peer_send_packet(20, 0x01);
+	peer_send_packet(22, 0x03);
+	peer_send_packet(23, 0x04);
+
+	/* The packets after the missing one are kept */
+	expect_acks((uint8_t[]){20, 22, 23}, 3);
+	expect_delivered((uint8_t[]){0x01}, 1);
+
+	peer_send_packet(21, 0x02);
+	expect_ack(21);
+	expect_delivered((uint8_t[]){0x02, 0x03, 0x04}, 3);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_reorder)
+{
+	/* Across the wrap of the sequence numbers */
+	peer_reset(126);
+	peer_send_packet(1, 0x04);
+	peer_send_packet(0, 0x03);
+	peer_send_packet(127, 0x02);
+
+	expect_acks((uint8_t[]){1, 0, 127}, 3);
+	expect_delivered(NULL, 0);
+
+	peer_send_packet(126, 0x01);
+	expect_ack(126);
+	expect_delivered((uint8_t[]){0x01, 0x02, 0x03, 0x04}, 4);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_duplicate)
+{
+	peer_reset(40);
+	peer_send_packet(40, 0x01);
+	expect_ack(40);
+	expect_delivered((uint8_t[]){0x01}, 1);
+
+	/* The acknowledgment was lost */
+	peer_send_packet(40, 0x01);
+	expect_ack(40);
+	expect_delivered(NULL, 0);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_restart)
+{
+	peer_reset(50);
+
+	for (uint8_t seq = 50; seq < 54; seq++) {
+		peer_send_packet(seq, seq);
+		expect_ack(seq);
+	}
+
+	expect_delivered((uint8_t[]){50, 51, 52, 53}, 4);
+
+	/* The peer restarts at a sequence number that was just delivered */
+	peer_reset(51);
+	/* The acknowledgment of the reset was lost */
+	peer_reset(51);
+
+	peer_send_packet(51, 0x01);
+	expect_ack(51);
+	expect_delivered((uint8_t[]){0x01}, 1);
+
+	peer_send_packet(51, 0x01);
+	expect_ack(51);
+	expect_delivered(NULL, 0);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_reset_drops_kept)
+{
+	peer_reset(70);
+	peer_send_packet(71, 0x02);
+	expect_ack(71);
+
+	/* The packet kept from before the restart is not delivered */
+	peer_reset(72);
+	peer_send_packet(72, 0x03);
+	expect_ack(72);
+	expect_delivered((uint8_t[]){0x03}, 1);
+
+	peer_send_packet(73, 0x04);
+	expect_ack(73);
+	expect_delivered((uint8_t[]){0x04}, 1);
+}
+
+ZTEST(suite_nrf_rpc_uart_arq, test_rx_sync)
+{
+	peer_reset(60);
+	peer_send_packet(60, 0x01);
+	expect_ack(60);
+	expect_delivered((uint8_t[]){0x01}, 1);
+
+	/* The peer has given up on the two frames before */
+	peer_send_packet(63 | SEQ_SYNC, 0x04);
+	expect_ack(63);
+	expect_delivered((uint8_t[]){0x04}, 1);
+
+	/* The acknowledgment was lost */
+	peer_send_packet(63 | SEQ_SYNC, 0x04);
+	expect_ack(63);
+	expect_delivered(NULL, 0);
+
+	/* A frame that was skipped arrives late */
+	peer_send_packet(61, 0x02);
+	expect_ack(61);
+	expect_delivered(NULL, 0);
+
+	peer_send_packet(64, 0x05);
+	expect_ack(64);
+	expect_delivered((uint8_t[]){0x05}, 1);
+}
+
+ZTEST_SUITE(suite_nrf_rpc_uart_arq, NULL, suite_setup, test_before, NULL, NULL);
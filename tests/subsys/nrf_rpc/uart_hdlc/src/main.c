@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "nrf_rpc_uart.c"
+
+#define STREAM_SIZE	8192
+/* Each frame takes at least two bytes, its content and a delimiter */
+#define FRAMES_MAX	(STREAM_SIZE / 2)
+#define FUZZ_ROUNDS	2000
+#define BENCH_ROUNDS	64
+#define BENCH_PACKET	256
+/* Frames of BENCH_PACKET bytes that fit in the stream even if all bytes are escaped */
+#define BENCH_FRAMES	(STREAM_SIZE / (BENCH_PACKET * 4))
+
+struct frame {
+	uint16_t offset;
+	uint16_t len;
+	uint16_t crc;
+};
+
+struct decoded {
+	struct frame frames[FRAMES_MAX];
+	uint8_t data[STREAM_SIZE];
+	size_t count;
+	size_t len;
+};
+
+static uint8_t stream[STREAM_SIZE];
+static uint8_t out[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+static struct decoded expected;
+static struct decoded actual;
+static uint32_t rand_state = 1;
+
+static uint32_t rand_next(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+/* Random bytes, with the special octets, and the bytes which differ from them by a bit,
+ * much more common than in a uniform distribution.
+ */
+static void stream_fill(size_t len)
+{
+	static const uint8_t special[] = {0x7e, 0x7d, 0x7c, 0x7f, 0x5e, 0x5d, 0xfe};
+	uint8_t percent = rand_next() % 40;
+
+	for (size_t i = 0; i < len; i++) {
+		if (rand_next() % 100 < percent) {
+			stream[i] = special[rand_next() % ARRAY_SIZE(special)];
+		} else {
+			stream[i] = rand_next();
+		}
+	}
+}
+
+/* HDLC encoded frames of random packets, as sent by the transport */
+static size_t stream_encode(size_t frames, size_t packet_len)
+{
+	size_t len = 0;
+
+	for (size_t i = 0; i < frames; i++) {
+		uint8_t packet[BENCH_PACKET + CRC_SIZE];
+
+		for (size_t j = 0; j < packet_len; j++) {
+			packet[j] = rand_next();
+		}
+
+		sys_put_le16(crc16_ccitt(0xffff, packet, packet_len), packet + packet_len);
+		stream[len++] = HDLC_CHAR_DELIMITER;
+
+		for (size_t j = 0; j < packet_len + CRC_SIZE; j++) {
+			if (packet[j] == HDLC_CHAR_DELIMITER || packet[j] == HDLC_CHAR_ESCAPE) {
+				stream[len++] = HDLC_CHAR_ESCAPE;
+				packet[j] ^= 0x20;
+			}
+
+			stream[len++] = packet[j];
+		}
+	}
+
+	stream[len++] = HDLC_CHAR_DELIMITER;
+
+	return len;
+}
+
+static void frame_add(struct decoded *result, const struct hdlc_decode_ctx *ctx, uint16_t crc)
+{
+	struct frame *frame = &result->frames[result->count++];
+
+	frame->offset = result->len;
+	frame->len = ctx->len;
+	frame->crc = crc;
+
+	memcpy(result->data + result->len, out, ctx->len);
+	result->len += ctx->len;
+}
+
+/* The decoder used before, one byte at a time followed by the CRC of the whole packet */
+static void decode_bytes(struct hdlc_decode_ctx *ctx, size_t len, struct decoded *result)
+{
+	for (size_t i = 0; i < len; i++) {
+		hdlc_decode_byte(ctx, out, stream[i]);
+
+		if (ctx->state == HDLC_STATE_FRAME_FOUND) {
+			uint16_t crc = 0;
+
+			if (ctx->len >= ctx->crc_skip + CRC_SIZE) {
+				crc = crc16_ccitt(0xffff, out + ctx->crc_skip,
+						  ctx->len - ctx->crc_skip - CRC_SIZE);
+			}
+
+			frame_add(result, ctx, crc);
+		}
+	}
+}
+
+static void decode_words(struct hdlc_decode_ctx *ctx, size_t len, size_t chunk_max,
+			 struct decoded *result)
+{
+	size_t i = 0;
+
+	while (i < len) {
+		size_t chunk = 1 + rand_next() % chunk_max;
+		size_t end = i + MIN(chunk, len - i);
+
+		while (i < end) {
+			i += hdlc_decode(ctx, out, stream + i, end - i);
+
+			if (ctx->state == HDLC_STATE_FRAME_FOUND) {
+				bool covered = ctx->len >= ctx->crc_skip + CRC_SIZE;
+
+				frame_add(result, ctx, covered ? ctx->crc : 0);
+			}
+		}
+	}
+}
+
+static void decoded_compare(size_t round)
+{
+	zassert_equal(actual.count, expected.count, "Round %zu: %zu frames instead of %zu",
+		      round, actual.count, expected.count);
+
+	for (size_t i = 0; i < expected.count; i++) {
+		const struct frame *a = &actual.frames[i];
+		const struct frame *e = &expected.frames[i];
+
+		zassert_equal(a->len, e->len, "Round %zu, frame %zu: length %u instead of %u",
+			      round, i, a->len, e->len);
+		zassert_mem_equal(actual.data + a->offset, expected.data + e->offset, e->len,
+				  "Round %zu, frame %zu: different data", round, i);
+		zassert_equal(a->crc, e->crc, "Round %zu, frame %zu: CRC %04x instead of %04x",
+			      round, i, a->crc, e->crc);
+	}
+}
+
+ZTEST(nrf_rpc_uart_hdlc, test_decode_equivalence)
+{
+	for (size_t round = 0; round < FUZZ_ROUNDS; round++) {
+		struct hdlc_decode_ctx ctx = {
+			.state = (rand_next() % 2) ? HDLC_STATE_UNSYNC : HDLC_STATE_FRAME,
+			.capacity = 1 + rand_next() % 64,
+			.crc = 0xffff,
+		};
+		struct hdlc_decode_ctx ref;
+		size_t len = rand_next() % STREAM_SIZE;
+
+		ctx.crc_skip = rand_next() % 2;
+		ctx.crc_len = ctx.crc_skip;
+		ref = ctx;
+
+		if (round % 4 == 0) {
+			ctx.capacity = sizeof(out);
+			ref.capacity = sizeof(out);
+			len = stream_encode(1 + rand_next() % BENCH_FRAMES,
+					    rand_next() % BENCH_PACKET);
+		} else {
+			stream_fill(len);
+		}
+
+		expected.count = 0;
+		expected.len = 0;
+		actual.count = 0;
+		actual.len = 0;
+
+		decode_bytes(&ref, len, &expected);
+		decode_words(&ctx, len, (round % 2) ? 8 : STREAM_SIZE, &actual);
+		decoded_compare(round);
+	}
+}
+
+ZTEST(nrf_rpc_uart_hdlc, test_decode_speed)
+{
+	struct hdlc_decode_ctx ctx = {
+		.state = HDLC_STATE_UNSYNC,
+		.capacity = sizeof(out),
+	};
+	size_t len = stream_encode(BENCH_FRAMES, BENCH_PACKET);
+	size_t frames = 0;
+	uint32_t bytes_cycles = 0;
+	uint32_t words_cycles = 0;
+	uint32_t start;
+
+	for (size_t round = 0; round < BENCH_ROUNDS; round++) {
+		start = k_cycle_get_32();
+
+		for (size_t i = 0; i < len; i++) {
+			hdlc_decode_byte(&ctx, out, stream[i]);
+
+			if (ctx.state == HDLC_STATE_FRAME_FOUND) {
+				frames += (crc16_ccitt(0xffff, out, ctx.len) == 0);
+			}
+		}
+
+		bytes_cycles += k_cycle_get_32() - start;
+		start = k_cycle_get_32();
+
+		for (size_t i = 0; i < len;) {
+			i += hdlc_decode(&ctx, out, stream + i, len - i);
+
+			if (ctx.state == HDLC_STATE_FRAME_FOUND) {
+				frames += (ctx.crc == sys_get_le16(out + ctx.len - CRC_SIZE));
+			}
+		}
+
+		words_cycles += k_cycle_get_32() - start;
+	}
+
+	zassert_equal(frames, 2 * BENCH_ROUNDS * BENCH_FRAMES, "Frames lost: %zu", frames);
+
+	TC_PRINT("Byte at a time: %u cycles per 1000 bytes\n",
+		 (uint32_t)((uint64_t)bytes_cycles * 1000 / (len * BENCH_ROUNDS)));
+	TC_PRINT("Word at a time: %u cycles per 1000 bytes\n",
+		 (uint32_t)((uint64_t)words_cycles * 1000 / (len * BENCH_ROUNDS)));
+}
+
+ZTEST_SUITE(nrf_rpc_uart_hdlc, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <psa/crypto.h>
+#include <psa/protected_storage.h>
+
+#include "storage_backend.h"
+#include "aead_key.h"
+#include "aead_nonce.h"
+#include "aead_crypt.h"
+
+#define MAX_DATA_SIZE CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE
+#define CHUNK_SIZE    CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE
+#define CHUNKS	      (MAX_DATA_SIZE / CHUNK_SIZE)
+#define KEY_TIMEOUT   CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_TIMEOUT_MS
+
+#define NONCE_SIZE 12
+#define TAG_SIZE   16
+
+BUILD_ASSERT(CHUNKS >= 2 && MAX_DATA_SIZE % CHUNK_SIZE == 0);
+
+/*
+ * Stored formats, see trusted_backend_aead.c. The offsets are those of an object of
+ * MAX_DATA_SIZE bytes in the chunked format.
+ */
+struct legacy_header {
+	psa_storage_create_flags_t create_flags;
+	size_t data_size;
+};
+
+struct chunked_header {
+	struct legacy_header header;
+	size_t capacity;
+};
+
+#define STORED_FLAG_CHUNKED BIT(31)
+#define NONCE_OFFSET(chunk) (sizeof(struct chunked_header) + (chunk) * NONCE_SIZE)
+#define INDEX_OFFSET	    NONCE_OFFSET(CHUNKS)
+#define CHUNK_OFFSET(chunk)                                                                       \
+	(INDEX_OFFSET + NONCE_SIZE + TAG_SIZE + (chunk) * (CHUNK_SIZE + TAG_SIZE))
+#define OBJECT_SIZE	    CHUNK_OFFSET(CHUNKS)
+
+#define UID	    1
+#define OTHER_UID   2
+#define OBJECTS_MAX 4
+
+/* Objects stored in RAM, so that the tests can read and modify them */
+struct ram_object {
+	psa_storage_uid_t uid;
+	const char *prefix;
+	size_t length;
+	uint8_t data[OBJECT_SIZE];
+};
+
+static struct ram_object objects[OBJECTS_MAX];
+static size_t key_derivations;
+
+static uint8_t data[MAX_DATA_SIZE];
+static uint8_t out[MAX_DATA_SIZE];
+
+static struct ram_object *ram_object_find(psa_storage_uid_t uid, const char *prefix)
+{
+	for (size_t i = 0; i < OBJECTS_MAX; i++) {
+		if (objects[i].prefix && objects[i].uid == uid && !strcmp(objects[i].prefix, prefix)) {
+			return &objects[i];
+		}
+	}
+
+	return NULL;
+}
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	struct ram_object *object = ram_object_find(uid, prefix);
+
+	if (object == NULL) {
+		return PSA_ERROR_DOES_NOT_EXIST;
+	}
+
+	*object_length = MIN(object_size, object->length);
+	memcpy(object_data, object->data, *object_length);
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	struct ram_object *object = ram_object_find(uid, prefix);
+
+	if (object_size > sizeof(object->data)) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	for (size_t i = 0; object == NULL && i < OBJECTS_MAX; i++) {
+		if (objects[i].prefix == NULL) {
+			object = &objects[i];
+		}
+	}
+
+	if (object == NULL) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	object->uid = uid;
+	object->prefix = prefix;
+	object->length = object_size;
+	memcpy(object->data, object_data, object_size);
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	struct ram_object *object = ram_object_find(uid, prefix);
+
+	if (object == NULL) {
+		return PSA_ERROR_DOES_NOT_EXIST;
+	}
+
+	memset(object, 0, sizeof(*object));
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t trusted_storage_get_key(psa_storage_uid_t uid, uint8_t *key_buf, size_t key_length)
+{
+	for (size_t i = 0; i < key_length; i++) {
+		key_buf[i] = uid * 31 + i;
+	}
+
+	key_derivations++;
+
+	return PSA_SUCCESS;
+}
+
+static struct ram_object *stored(psa_storage_uid_t uid)
+{
+	struct ram_object *object = ram_object_find(uid, CONFIG_PSA_PROTECTED_STORAGE_PREFIX);
+
+	zassert_not_null(object, "Object %u not stored", (unsigned int)uid);
+
+	return object;
+}
+
+/* Stores the data in the format used before the chunked one */
+static void legacy_store(psa_storage_uid_t uid, size_t size)
+{
+	struct {
+		struct legacy_header header;
+		uint8_t nonce[NONCE_SIZE];
+		uint8_t data[MAX_DATA_SIZE + TAG_SIZE];
+	} object = {
+		.header.data_size = size,
+	};
+	uint8_t key[AEAD_KEY_SIZE];
+	size_t length;
+
+	zassert_ok(trusted_storage_get_key(uid, key, sizeof(key)));
+	zassert_ok(trusted_storage_get_nonce(object.nonce, NONCE_SIZE));
+	zassert_ok(trusted_storage_aead_encrypt(key, sizeof(key), object.nonce, NONCE_SIZE,
+						&object.header, sizeof(object.header), data, size,
+						object.data, sizeof(object.data), &length));
+	zassert_ok(storage_set_object(uid, CONFIG_PSA_PROTECTED_STORAGE_PREFIX, &object,
+				      offsetof(typeof(object), data) + length));
+}
+
+static void get_check(psa_storage_uid_t uid, size_t offset, size_t length, const uint8_t *expected)
+{
+	size_t out_length;
+
+	zassert_ok(psa_ps_get(uid, offset, length, out, &out_length), "Get of %zu B at %zu",
+		   length, offset);
+	zassert_equal(out_length, length);
+	zassert_mem_equal(out, expected, length);
+}
+
+static void get_fails(psa_storage_uid_t uid, size_t offset, size_t length)
+{
+	size_t out_length;
+
+	zassert_not_ok(psa_ps_get(uid, offset, length, out, &out_length),
+		       "Get of %zu B at %zu succeeded", length, offset);
+}
+
+static void info_check(psa_storage_uid_t uid, size_t size, size_t capacity,
+		       psa_storage_create_flags_t flags)
+{
+	struct psa_storage_info_t info;
+
+	zassert_ok(psa_ps_get_info(uid, &info));
+	zassert_equal(info.size, size, "Size %zu, expected %zu", info.size, size);
+	zassert_equal(info.capacity, capacity, "Capacity %zu, expected %zu", info.capacity,
+		      capacity);
+	zassert_equal(info.flags, flags);
+}
+
+static void *suite_setup(void)
+{
+	zassert_ok(psa_crypto_init());
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7 + 1;
+	}
+
+	return NULL;
+}
+
+static void run_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(objects, 0, sizeof(objects));
+	key_derivations = 0;
+}
+
+ZTEST(trusted_storage_aead_test, test_create)
+{
+	zassert_equal(psa_ps_get_support(), PSA_STORAGE_SUPPORT_SET_EXTENDED);
+
+	zassert_equal(psa_ps_create(UID, MAX_DATA_SIZE + 1, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_INSUFFICIENT_STORAGE);
+	zassert_equal(psa_ps_create(UID, MAX_DATA_SIZE, PSA_STORAGE_FLAG_WRITE_ONCE),
+		      PSA_ERROR_NOT_SUPPORTED);
+
+	zassert_ok(psa_ps_create(UID, MAX_DATA_SIZE, PSA_STORAGE_FLAG_NONE));
+	info_check(UID, 0, MAX_DATA_SIZE, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(stored(UID)->length, OBJECT_SIZE);
+
+	zassert_equal(psa_ps_create(UID, CHUNK_SIZE, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_ALREADY_EXISTS);
+	info_check(UID, 0, MAX_DATA_SIZE, PSA_STORAGE_FLAG_NONE);
+}
+
+ZTEST(trusted_storage_aead_test, test_set_extended)
+{
+	const size_t capacity = CHUNK_SIZE + CHUNK_SIZE / 2;
+	uint8_t expected[MAX_DATA_SIZE];
+
+	zassert_equal(psa_ps_set_extended(UID, 0, 1, data), PSA_ERROR_DOES_NOT_EXIST);
+
+	zassert_ok(psa_ps_create(UID, capacity, PSA_STORAGE_FLAG_NONE));
+	zassert_ok(psa_ps_set_extended(UID, 0, 4, data));
+	info_check(UID, 4, capacity, PSA_STORAGE_FLAG_NONE);
+
+	/* Writing may not leave a gap, nor go beyond the capacity */
+	zassert_equal(psa_ps_set_extended(UID, 5, 1, data), PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(psa_ps_set_extended(UID, 4, capacity - 3, data),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	info_check(UID, 4, capacity, PSA_STORAGE_FLAG_NONE);
+
+	/* Append across the chunk boundary, then rewrite the middle */
+	zassert_ok(psa_ps_set_extended(UID, 4, capacity - 4, data + 4));
+	info_check(UID, capacity, capacity, PSA_STORAGE_FLAG_NONE);
+	get_check(UID, 0, capacity, data);
+
+	memcpy(expected, data, capacity);
+	memset(expected + CHUNK_SIZE - 2, 0xaa, 4);
+	zassert_ok(psa_ps_set_extended(UID, CHUNK_SIZE - 2, 4, expected + CHUNK_SIZE - 2));
+	info_check(UID, capacity, capacity, PSA_STORAGE_FLAG_NONE);
+	get_check(UID, 0, capacity, expected);
+	get_check(UID, CHUNK_SIZE, capacity - CHUNK_SIZE, expected + CHUNK_SIZE);
+
+	/* The data of objects that are set is at full capacity */
+	zassert_ok(psa_ps_set(OTHER_UID, CHUNK_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	zassert_equal(psa_ps_set_extended(OTHER_UID, 1, CHUNK_SIZE, data),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_ok(psa_ps_set_extended(OTHER_UID, 1, CHUNK_SIZE - 1, expected));
+	get_check(OTHER_UID, 1, CHUNK_SIZE - 1, expected);
+}
+
+ZTEST(trusted_storage_aead_test, test_write_once)
+{
+	zassert_ok(psa_ps_set(UID, CHUNK_SIZE, data, PSA_STORAGE_FLAG_WRITE_ONCE));
+	info_check(UID, CHUNK_SIZE, CHUNK_SIZE, PSA_STORAGE_FLAG_WRITE_ONCE);
+
+	zassert_equal(psa_ps_set_extended(UID, 0, 1, out), PSA_ERROR_NOT_PERMITTED);
+	zassert_equal(psa_ps_set(UID, CHUNK_SIZE, out, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_NOT_PERMITTED);
+	get_check(UID, 0, CHUNK_SIZE, data);
+
+	/* Also for an object in the previous format */
+	legacy_store(OTHER_UID, CHUNK_SIZE);
+	((struct legacy_header *)stored(OTHER_UID)->data)->create_flags =
+		PSA_STORAGE_FLAG_WRITE_ONCE;
+	zassert_equal(psa_ps_set_extended(OTHER_UID, 0, 1, out), PSA_ERROR_NOT_PERMITTED);
+}
+
+ZTEST(trusted_storage_aead_test, test_legacy_conversion)
+{
+	uint8_t expected[MAX_DATA_SIZE];
+	struct chunked_header *header;
+
+	legacy_store(UID, MAX_DATA_SIZE);
+	info_check(UID, MAX_DATA_SIZE, MAX_DATA_SIZE, PSA_STORAGE_FLAG_NONE);
+	get_check(UID, 0, MAX_DATA_SIZE, data);
+	get_check(UID, CHUNK_SIZE + 3, CHUNK_SIZE, data + CHUNK_SIZE + 3);
+
+	/* The capacity of the object is its size */
+	zassert_equal(psa_ps_set_extended(UID, MAX_DATA_SIZE - 1, 2, data),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(stored(UID)->length, sizeof(struct legacy_header) + NONCE_SIZE +
+						   MAX_DATA_SIZE + TAG_SIZE);
+
+	/* The first partial write converts the whole object */
+	memcpy(expected, data, sizeof(expected));
+	memset(expected + CHUNK_SIZE - 1, 0x55, 2);
+	zassert_ok(psa_ps_set_extended(UID, CHUNK_SIZE - 1, 2, expected + CHUNK_SIZE - 1));
+
+	header = (struct chunked_header *)stored(UID)->data;
+	zassert_equal(stored(UID)->length, OBJECT_SIZE);
+	zassert_equal(header->header.create_flags, STORED_FLAG_CHUNKED);
+	zassert_equal(header->capacity, MAX_DATA_SIZE);
+
+	info_check(UID, MAX_DATA_SIZE, MAX_DATA_SIZE, PSA_STORAGE_FLAG_NONE);
+	get_check(UID, 0, MAX_DATA_SIZE, expected);
+
+	/* The converted object is written in place from then on */
+	zassert_ok(psa_ps_set_extended(UID, MAX_DATA_SIZE - 1, 1, data));
+	expected[MAX_DATA_SIZE - 1] = data[0];
+	get_check(UID, 0, MAX_DATA_SIZE, expected);
+}
+
+ZTEST(trusted_storage_aead_test, test_tamper_chunk)
+{
+	zassert_ok(psa_ps_set(UID, MAX_DATA_SIZE, data, PSA_STORAGE_FLAG_NONE));
+
+	stored(UID)->data[CHUNK_OFFSET(1) + 3] ^= 1;
+
+	/* Only the reads of the modified chunk fail */
+	get_check(UID, 0, CHUNK_SIZE, data);
+	get_check(UID, 2 * CHUNK_SIZE, CHUNK_SIZE, data + 2 * CHUNK_SIZE);
+	get_fails(UID, CHUNK_SIZE, 1);
+	get_fails(UID, 0, MAX_DATA_SIZE);
+	zassert_not_ok(psa_ps_set_extended(UID, CHUNK_SIZE + 1, 1, data));
+
+	/* Its tag is authenticated as well */
+	stored(UID)->data[CHUNK_OFFSET(1) + 3] ^= 1;
+	stored(UID)->data[CHUNK_OFFSET(1) + CHUNK_SIZE] ^= 1;
+	get_fails(UID, CHUNK_SIZE, 1);
+
+	stored(UID)->data[CHUNK_OFFSET(1) + CHUNK_SIZE] ^= 1;
+	get_check(UID, 0, MAX_DATA_SIZE, data);
+}
+
+ZTEST(trusted_storage_aead_test, test_tamper_nonce)
+{
+	zassert_ok(psa_ps_set(UID, MAX_DATA_SIZE, data, PSA_STORAGE_FLAG_NONE));
+
+	/* The nonces are part of the index, so that no chunk can be read */
+	stored(UID)->data[NONCE_OFFSET(1)] ^= 1;
+	get_fails(UID, 0, 1);
+	get_fails(UID, CHUNK_SIZE, 1);
+	zassert_not_ok(psa_ps_set_extended(UID, 0, 1, data));
+
+	stored(UID)->data[NONCE_OFFSET(1)] ^= 1;
+	get_check(UID, 0, MAX_DATA_SIZE, data);
+}
+
+ZTEST(trusted_storage_aead_test, test_tamper_index)
+{
+	struct ram_object previous;
+
+	zassert_ok(psa_ps_set(UID, MAX_DATA_SIZE, data, PSA_STORAGE_FLAG_NONE));
+
+	/* The index tag and the header */
+	stored(UID)->data[INDEX_OFFSET + NONCE_SIZE] ^= 1;
+	get_fails(UID, 0, 1);
+	stored(UID)->data[INDEX_OFFSET + NONCE_SIZE] ^= 1;
+
+	((struct chunked_header *)stored(UID)->data)->header.data_size--;
+	get_fails(UID, 0, 1);
+	((struct chunked_header *)stored(UID)->data)->header.data_size++;
+	get_check(UID, 0, MAX_DATA_SIZE, data);
+
+	/* A chunk cannot be replaced with an older one, even with its nonce */
+	previous = *stored(UID);
+	zassert_ok(psa_ps_set_extended(UID, CHUNK_SIZE, CHUNK_SIZE, out));
+	memcpy(stored(UID)->data + NONCE_OFFSET(1), previous.data + NONCE_OFFSET(1), NONCE_SIZE);
+	memcpy(stored(UID)->data + CHUNK_OFFSET(1), previous.data + CHUNK_OFFSET(1),
+	       CHUNK_SIZE + TAG_SIZE);
+	get_fails(UID, CHUNK_SIZE, 1);
+
+	/* Nor with another chunk of the object */
+	zassert_ok(psa_ps_set(UID, MAX_DATA_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	memcpy(stored(UID)->data + CHUNK_OFFSET(0), stored(UID)->data + CHUNK_OFFSET(1),
+	       CHUNK_SIZE + TAG_SIZE);
+	get_fails(UID, 0, 1);
+}
+
+ZTEST(trusted_storage_aead_test, test_key_cache_expiry)
+{
+	/* Start without cached keys */
+	k_sleep(K_MSEC(KEY_TIMEOUT));
+
+	zassert_ok(psa_ps_set(UID, CHUNK_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	zassert_equal(key_derivations, 1);
+
+	get_check(UID, 0, CHUNK_SIZE, data);
+	zassert_ok(psa_ps_set_extended(UID, 0, 1, data));
+	zassert_equal(key_derivations, 1);
+
+	/* The timeout is not extended by the use of the key */
+	k_sleep(K_MSEC(KEY_TIMEOUT / 2));
+	get_check(UID, 0, CHUNK_SIZE, data);
+	zassert_equal(key_derivations, 1);
+
+	k_sleep(K_MSEC(KEY_TIMEOUT / 2 + 1));
+	get_check(UID, 0, CHUNK_SIZE, data);
+	zassert_equal(key_derivations, 2);
+
+	/* Another UID has a key of its own */
+	zassert_ok(psa_ps_set(OTHER_UID, CHUNK_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	get_check(OTHER_UID, 0, CHUNK_SIZE, data);
+	get_check(UID, 0, CHUNK_SIZE, data);
+	zassert_equal(key_derivations, 3);
+}
+
+ZTEST_SUITE(trusted_storage_aead_test, NULL, suite_setup, run_before, NULL, NULL);
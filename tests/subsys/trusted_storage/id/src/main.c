@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <psa/crypto.h>
+#include <psa/internal_trusted_storage.h>
+#include <psa/protected_storage.h>
+
+#include "storage_backend.h"
+
+/* Objects of the tests, removed at the end of each test */
+#define OBJECT_UID  0x2000
+#define OBJECT_SIZE 100
+
+typedef psa_status_t (*get_fn)(psa_storage_uid_t uid, size_t data_offset, size_t data_size,
+			       void *p_data, size_t *p_data_length);
+
+static uint8_t data[OBJECT_SIZE + 4];
+static uint8_t out[OBJECT_SIZE];
+
+/*
+ * The backend hashes the UID followed by the prefix to a slot with a CRC-32. The UIDs
+ * of the following functions are hashed to the same slot as others, so that the objects are
+ * stored in the slots after the one they are hashed to.
+ */
+static uint32_t crc_table_entry(uint8_t index)
+{
+	uint32_t entry = index;
+
+	for (int bit = 0; bit < 8; bit++) {
+		entry = (entry >> 1) ^ (0xedb88320U & -(entry & 1));
+	}
+
+	return entry;
+}
+
+static uint32_t crc_state(uint32_t state, const void *bytes, size_t length)
+{
+	return ~crc32_ieee_update(~state, bytes, length);
+}
+
+/* Changes the last four bytes of the UID, so that the CRC state after it is the wanted one */
+static psa_storage_uid_t uid_forge(psa_storage_uid_t uid, uint32_t wanted)
+{
+	uint8_t bytes[sizeof(uid)];
+	uint32_t state;
+
+	memcpy(bytes, &uid, sizeof(bytes));
+	state = crc_state(~0U, bytes, 4);
+
+	/* Go back from the wanted state over the last four bytes */
+	for (int i = 0; i < 4; i++) {
+		uint8_t index = 0;
+
+		while ((crc_table_entry(index) >> 24) != (wanted >> 24)) {
+			index++;
+		}
+
+		wanted = ((wanted ^ crc_table_entry(index)) << 8) | index;
+	}
+
+	sys_put_le32(wanted ^ state, &bytes[4]);
+	memcpy(&uid, bytes, sizeof(uid));
+
+	return uid;
+}
+
+/* Returns another UID with the same hash as the given one */
+static psa_storage_uid_t uid_colliding(psa_storage_uid_t uid, uint8_t change)
+{
+	psa_storage_uid_t other = uid_forge(uid ^ change, crc_state(~0U, &uid, sizeof(uid)));
+
+	zassert_equal(crc_state(~0U, &other, sizeof(other)), crc_state(~0U, &uid, sizeof(uid)));
+	zassert_not_equal(other, uid);
+
+	return other;
+}
+
+static uint32_t prefix_state_diff(uint32_t state)
+{
+	return crc_state(state, CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX,
+			 strlen(CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX)) ^
+	       crc_state(state, CONFIG_PSA_PROTECTED_STORAGE_PREFIX,
+			 strlen(CONFIG_PSA_PROTECTED_STORAGE_PREFIX));
+}
+
+/*
+ * Returns a UID with the same hash under ITS and PS. The difference of the CRC states after the
+ * two prefixes is affine in the state before them, so the state that makes it zero is found
+ * by solving the linear system over GF(2).
+ */
+static psa_storage_uid_t uid_same_its_ps_hash(psa_storage_uid_t uid)
+{
+	uint32_t basis[32] = {0};
+	uint32_t combination[32] = {0};
+	uint32_t target = prefix_state_diff(0);
+	uint32_t state = 0;
+
+	for (int bit = 0; bit < 32; bit++) {
+		uint32_t column = prefix_state_diff(BIT(bit)) ^ target;
+		uint32_t bits = BIT(bit);
+
+		for (int pivot = 31; pivot >= 0 && column != 0; pivot--) {
+			if ((column & BIT(pivot)) == 0) {
+				continue;
+			}
+
+			if (basis[pivot] == 0) {
+				basis[pivot] = column;
+				combination[pivot] = bits;
+				break;
+			}
+
+			column ^= basis[pivot];
+			bits ^= combination[pivot];
+		}
+	}
+
+	for (int pivot = 31; pivot >= 0; pivot--) {
+		if ((target & BIT(pivot)) != 0) {
+			zassert_not_equal(basis[pivot], 0, "No UID with the same ITS and PS hash");
+			target ^= basis[pivot];
+			state ^= combination[pivot];
+		}
+	}
+
+	uid = uid_forge(uid, state);
+	zassert_equal(prefix_state_diff(crc_state(~0U, &uid, sizeof(uid))), 0);
+
+	return uid;
+}
+
+static void object_check(get_fn get, psa_storage_uid_t uid, const uint8_t *expected)
+{
+	size_t out_length;
+
+	zassert_ok(get(uid, 0, OBJECT_SIZE, out, &out_length), "Get of %llx failed",
+		   (unsigned long long)uid);
+	zassert_equal(out_length, OBJECT_SIZE);
+	zassert_mem_equal(out, expected, OBJECT_SIZE);
+}
+
+static void *objects_setup(void)
+{
+	zassert_ok(psa_crypto_init());
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i * 7;
+	}
+
+	return NULL;
+}
+
+ZTEST(trusted_storage_id, test_its_ps_same_uid)
+{
+	/* The PS object is stored in the slot after the ITS one */
+	const psa_storage_uid_t uid = uid_same_its_ps_hash(OBJECT_UID);
+	size_t out_length;
+
+	zassert_ok(psa_its_set(uid, OBJECT_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	zassert_ok(psa_ps_set(uid, OBJECT_SIZE, data + 1, PSA_STORAGE_FLAG_NONE));
+
+	object_check(psa_its_get, uid, data);
+	object_check(psa_ps_get, uid, data + 1);
+
+	zassert_ok(psa_its_remove(uid));
+	zassert_equal(psa_its_get(uid, 0, OBJECT_SIZE, out, &out_length),
+		      PSA_ERROR_DOES_NOT_EXIST);
+	object_check(psa_ps_get, uid, data + 1);
+
+	zassert_ok(psa_its_set(uid, OBJECT_SIZE, data + 2, PSA_STORAGE_FLAG_NONE));
+	object_check(psa_its_get, uid, data + 2);
+	object_check(psa_ps_get, uid, data + 1);
+
+	zassert_ok(psa_ps_remove(uid));
+	zassert_equal(psa_ps_get(uid, 0, OBJECT_SIZE, out, &out_length),
+		      PSA_ERROR_DOES_NOT_EXIST);
+	object_check(psa_its_get, uid, data + 2);
+
+	zassert_ok(psa_its_remove(uid));
+}
+
+ZTEST(trusted_storage_id, test_colliding_uids)
+{
+	const psa_storage_uid_t uids[] = {
+		OBJECT_UID,
+		uid_colliding(OBJECT_UID, 1),
+		uid_colliding(OBJECT_UID, 2),
+	};
+	size_t out_length;
+
+	/* Each object is stored in the slot after the previous one */
+	for (size_t i = 0; i < ARRAY_SIZE(uids); i++) {
+		zassert_ok(psa_its_set(uids[i], OBJECT_SIZE, data + i, PSA_STORAGE_FLAG_NONE));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(uids); i++) {
+		object_check(psa_its_get, uids[i], data + i);
+	}
+
+	/* The objects after a removed one are still found */
+	zassert_ok(psa_its_remove(uids[1]));
+	zassert_equal(psa_its_get(uids[1], 0, OBJECT_SIZE, out, &out_length),
+		      PSA_ERROR_DOES_NOT_EXIST);
+	zassert_equal(psa_its_remove(uids[1]), PSA_ERROR_DOES_NOT_EXIST);
+	object_check(psa_its_get, uids[0], data);
+	object_check(psa_its_get, uids[2], data + 2);
+
+	/* The object after the removed one is written in its slot, not stored again before it */
+	zassert_ok(psa_its_set(uids[2], OBJECT_SIZE, data + 4, PSA_STORAGE_FLAG_NONE));
+	object_check(psa_its_get, uids[2], data + 4);
+	zassert_ok(psa_its_remove(uids[2]));
+	zassert_equal(psa_its_get(uids[2], 0, OBJECT_SIZE, out, &out_length),
+		      PSA_ERROR_DOES_NOT_EXIST);
+
+	/* The removed slot is used again */
+	zassert_ok(psa_its_set(uids[1], OBJECT_SIZE, data + 3, PSA_STORAGE_FLAG_NONE));
+	object_check(psa_its_get, uids[1], data + 3);
+	object_check(psa_its_get, uids[0], data);
+
+	zassert_ok(psa_its_remove(uids[0]));
+	object_check(psa_its_get, uids[1], data + 3);
+	zassert_ok(psa_its_remove(uids[1]));
+
+	for (size_t i = 0; i < ARRAY_SIZE(uids); i++) {
+		zassert_equal(psa_its_get(uids[i], 0, OBJECT_SIZE, out, &out_length),
+			      PSA_ERROR_DOES_NOT_EXIST);
+	}
+}
+
+ZTEST(trusted_storage_id, test_partial_reads)
+{
+	const psa_storage_uid_t uid = uid_colliding(OBJECT_UID, 1);
+	size_t out_length;
+
+	/* Also of an object that is not in the slot its UID is hashed to */
+	zassert_ok(psa_ps_set(OBJECT_UID, OBJECT_SIZE, data + 1, PSA_STORAGE_FLAG_NONE));
+	zassert_ok(psa_ps_set(uid, OBJECT_SIZE, data, PSA_STORAGE_FLAG_NONE));
+
+	zassert_ok(psa_ps_get(uid, 10, 20, out, &out_length));
+	zassert_equal(out_length, 20);
+	zassert_mem_equal(out, data + 10, 20);
+
+	/* The read stops at the end of the object */
+	zassert_ok(psa_ps_get(uid, OBJECT_SIZE - 10, 20, out, &out_length));
+	zassert_equal(out_length, 10);
+	zassert_mem_equal(out, data + OBJECT_SIZE - 10, 10);
+
+	zassert_equal(psa_ps_get(uid, OBJECT_SIZE + 1, 1, out, &out_length),
+		      PSA_ERROR_INVALID_ARGUMENT);
+
+	zassert_ok(psa_ps_remove(OBJECT_UID));
+	zassert_ok(psa_ps_get(uid, 1, OBJECT_SIZE - 1, out, &out_length));
+	zassert_equal(out_length, OBJECT_SIZE - 1);
+	zassert_mem_equal(out, data + 1, OBJECT_SIZE - 1);
+
+	zassert_ok(psa_ps_remove(uid));
+}
+
+ZTEST(trusted_storage_id, test_invalid_uid)
+{
+	size_t out_length;
+
+	/* The UID of the tags of the removed objects */
+	zassert_equal(storage_set_object(0, CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX, data,
+					 OBJECT_SIZE),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(storage_get_object(0, CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX, out,
+					 OBJECT_SIZE, &out_length),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(storage_remove_object(0, CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX),
+		      PSA_ERROR_INVALID_ARGUMENT);
+
+	/* A removed object does not make its tag match the UID */
+	zassert_ok(psa_its_set(OBJECT_UID, OBJECT_SIZE, data, PSA_STORAGE_FLAG_NONE));
+	zassert_ok(psa_its_set(uid_colliding(OBJECT_UID, 1), OBJECT_SIZE, data,
+			       PSA_STORAGE_FLAG_NONE));
+	zassert_ok(psa_its_remove(OBJECT_UID));
+	zassert_equal(storage_get_object(0, CONFIG_PSA_INTERNAL_TRUSTED_STORAGE_PREFIX, out,
+					 OBJECT_SIZE, &out_length),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_ok(psa_its_remove(uid_colliding(OBJECT_UID, 1)));
+}
+
+ZTEST(trusted_storage_id, test_long_prefix)
+{
+	size_t out_length;
+
+	zassert_equal(storage_set_object(OBJECT_UID, "0123456789abcdefg", data, OBJECT_SIZE),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_equal(storage_get_object(OBJECT_UID, "0123456789abcdefg", out, OBJECT_SIZE,
+					 &out_length),
+		      PSA_ERROR_INVALID_ARGUMENT);
+	zassert_ok(storage_set_object(OBJECT_UID, "0123456789abcdef", data, OBJECT_SIZE));
+	zassert_ok(storage_get_object(OBJECT_UID, "0123456789abcdef", out, OBJECT_SIZE,
+				      &out_length));
+	zassert_equal(out_length, OBJECT_SIZE);
+	zassert_mem_equal(out, data, OBJECT_SIZE);
+	zassert_ok(storage_remove_object(OBJECT_UID, "0123456789abcdef"));
+}
+
+ZTEST_SUITE(trusted_storage_id, NULL, objects_setup, NULL, NULL, NULL);